@@ -0,0 +1,125 @@
+/**
+ * Benchmark harness on top of vitest.
+ *
+ * A benchmark is a vitest test that records metrics instead of asserting; the
+ * metrics travel in the test meta data to the JSON reporter (reporter.ts).
+ * Shared by the benchmark suites of the browser and workers packages.
+ */
+
+import { existsSync, readFileSync } from 'node:fs';
+import { dirname, join } from 'node:path';
+import { fileURLToPath } from 'node:url';
+import { it } from 'vitest';
+import type { BenchMetric } from './reporter';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+
+/** Shared benchmark inputs, next to this module at the repository root */
+export const benchRoot = __dirname;
+
+/** Timed iterations per metric, after one warmup run */
+const ITERATIONS = Number(process.env.BENCH_ITERATIONS ?? 5);
+
+/** TPC-H scale factors to run, when their data exists (see `make bench-data`) */
+export const TPCH_SCALE_FACTORS = (process.env.BENCH_TPCH_SF ?? '0.1 1')
+  .split(/[\s,]+/)
+  .filter(Boolean);
+
+export const TPCH_TABLES = [
+  'customer',
+  'lineitem',
+  'nation',
+  'orders',
+  'part',
+  'partsupp',
+  'region',
+  'supplier',
+];
+
+export interface TimeOptions {
+  iterations?: number;
+  warmup?: number;
+}
+
+/**
+ * Records the metrics of one benchmark.
+ */
+export interface Recorder {
+  /** Run `fn` repeatedly and record the median time in milliseconds */
+  time(metric: string, fn: () => Promise<unknown>, options?: TimeOptions): Promise<number>;
+  /** Record a measured value */
+  value(metric: string, value: number, unit: string): void;
+}
+
+function median(samples: number[]): number {
+  const sorted = samples.slice().sort((a, b) => a - b);
+  const mid = sorted.length >> 1;
+  return sorted.length % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+}
+
+function round(value: number): number {
+  return Math.round(value * 1000) / 1000;
+}
+
+/**
+ * Define a benchmark.
+ *
+ * @param name - Benchmark name, reported with its suite
+ * @param fn - Runs the scenario and records its metrics
+ * @param options - `skip` skips the benchmark (reported as skipped)
+ */
+export function benchmark(
+  name: string,
+  fn: (bench: Recorder) => Promise<void>,
+  options: { skip?: boolean } = {},
+): void {
+  it.skipIf(options.skip ?? false)(name, async ({ task }) => {
+    const metrics: BenchMetric[] = [];
+    const recorder: Recorder = {
+      async time(metric, op, timeOptions = {}) {
+        for (let i = 0; i < (timeOptions.warmup ?? 1); i++) {
+          await op();
+        }
+        const samples: number[] = [];
+        for (let i = 0; i < (timeOptions.iterations ?? ITERATIONS); i++) {
+          const start = performance.now();
+          await op();
+          samples.push(performance.now() - start);
+        }
+        const value = median(samples);
+        metrics.push({ metric, unit: 'ms', value: round(value), samples: samples.map(round) });
+        return value;
+      },
+      value(metric, value, unit) {
+        metrics.push({ metric, unit, value: round(value) });
+      },
+    };
+    try {
+      await fn(recorder);
+    } finally {
+      task.meta.bench = metrics;
+    }
+  });
+}
+
+/**
+ * Directory with the TPC-H Parquet files of a scale factor, or null when not generated.
+ */
+export function tpchDataDir(scaleFactor: string): string | null {
+  const dir = join(benchRoot, 'data', `tpch-sf${scaleFactor}`);
+  return existsSync(join(dir, 'lineitem.parquet')) ? dir : null;
+}
+
+/**
+ * The TPC-H queries from bench/tpch-queries.sql, by name.
+ */
+export function tpchQueries(): { name: string; sql: string }[] {
+  const source = readFileSync(join(benchRoot, 'tpch-queries.sql'), 'utf8');
+  // Splitting on the capture group yields [preamble, name, sql, name, sql, ...]
+  const parts = source.split(/^-- (Q\d+)$/m);
+  const queries: { name: string; sql: string }[] = [];
+  for (let i = 1; i < parts.length; i += 2) {
+    queries.push({ name: parts[i], sql: parts[i + 1].trim() });
+  }
+  return queries;
+}
@@ -0,0 +1,97 @@
+/**
+ * Vitest reporter that writes the benchmark results as JSON.
+ *
+ * Benchmarks attach their metrics to the test meta data (see harness.ts); the
+ * reporter collects them after the run into `bench/results/<package>-<commit>.json`
+ * at the repository root, or the file named by `BENCH_OUTPUT`.
+ */
+
+import { execSync } from 'node:child_process';
+import { mkdirSync, readFileSync, writeFileSync } from 'node:fs';
+import { cpus } from 'node:os';
+import { basename, dirname, join } from 'node:path';
+import { fileURLToPath } from 'node:url';
+import type { Reporter, TestModule, Vitest } from 'vitest/node';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+
+/**
+ * A single measurement of a benchmark.
+ */
+export interface BenchMetric {
+  metric: string;
+  unit: string;
+  value: number;
+  /** Raw samples of timed metrics, in milliseconds */
+  samples?: number[];
+}
+
+declare module 'vitest' {
+  interface TaskMeta {
+    bench?: BenchMetric[];
+  }
+}
+
+function git(args: string): string | null {
+  try {
+    return execSync(`git ${args}`, { cwd: __dirname, encoding: 'utf8' }).trim();
+  } catch {
+    return null;
+  }
+}
+
+export default class JsonBenchReporter implements Reporter {
+  /** Directory of the package whose benchmarks run (the vitest root) */
+  private packageDir = process.cwd();
+
+  onInit(vitest: Vitest): void {
+    this.packageDir = vitest.config.root;
+  }
+
+  onTestRunEnd(testModules: ReadonlyArray<TestModule>): void {
+    const results: ({ suite: string; benchmark: string } & BenchMetric)[] = [];
+    const skipped: string[] = [];
+    const failed: string[] = [];
+
+    for (const testModule of testModules) {
+      const suite = basename(testModule.moduleId).replace(/\.bench\.ts$/, '');
+      for (const test of testModule.children.allTests()) {
+        const state = test.result().state;
+        if (state === 'skipped') {
+          skipped.push(`${suite} > ${test.fullName}`);
+        } else if (state === 'failed') {
+          failed.push(`${suite} > ${test.fullName}`);
+        }
+        for (const metric of test.meta().bench ?? []) {
+          results.push({ suite, benchmark: test.fullName, ...metric });
+        }
+      }
+    }
+
+    const pkg = JSON.parse(readFileSync(join(this.packageDir, 'package.json'), 'utf8'));
+    const commit = git('rev-parse --short HEAD') ?? 'unknown';
+    const report = {
+      package: pkg.name,
+      version: pkg.version,
+      commit,
+      dirty: (git('status --porcelain') ?? '') !== '',
+      createdAt: new Date().toISOString(),
+      runtime: {
+        node: process.version,
+        platform: process.platform,
+        arch: process.arch,
+        cpu: cpus()[0]?.model ?? 'unknown',
+      },
+      results,
+      skipped,
+      failed,
+    };
+
+    const output =
+      process.env.BENCH_OUTPUT ??
+      join(__dirname, 'results', `${basename(pkg.name)}-${commit}.json`);
+    mkdirSync(dirname(output), { recursive: true });
+    writeFileSync(output, `${JSON.stringify(report, null, 2)}\n`);
+    console.log(`Benchmark results written to ${output}`);
+  }
+}
@@ -0,0 +1,46 @@
+/**
+ * Binary size and time to first query.
+ *
+ * Does not use test/testDb.ts: this file times the startup that testDb.ts performs
+ * on import. Each bench file gets a fresh module, so this is a real cold start.
+ */
+import { readFile } from 'node:fs/promises';
+import { dirname, join } from 'node:path';
+import { fileURLToPath, pathToFileURL } from 'node:url';
+import { gzipSync } from 'node:zlib';
+import { describe } from 'vitest';
+import { benchmark } from '../../../bench/harness';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+const distDir = join(__dirname, '../dist');
+
+describe('cold start', () => {
+  benchmark('duckdb.wasm', async (bench) => {
+    const wasmBytes = await readFile(join(distDir, 'wasm/duckdb.wasm'));
+    bench.value('wasm size', wasmBytes.byteLength, 'bytes');
+    bench.value('wasm size (gzip)', gzipSync(wasmBytes).byteLength, 'bytes');
+
+    const start = performance.now();
+    const wasmModule = await WebAssembly.compile(wasmBytes);
+    const compiled = performance.now();
+    bench.value('compile', compiled - start, 'ms');
+
+    // Same setup as test/testDb.ts: hand the compiled module and factory to the worker
+    const factory = (await import(pathToFileURL(join(distDir, 'wasm/duckdb.js')).href)).default;
+    const globals = globalThis as unknown as Record<string, unknown>;
+    globals.__DUCKDB_WASM_MODULE__ = wasmModule;
+    globals.__DUCKDB_MODULE_FACTORY__ = factory;
+
+    const duckdb = await import('../dist/index.js');
+    await duckdb.init({ wasmModule, workerUrl: pathToFileURL(join(distDir, 'worker.js')).href });
+    const initialized = performance.now();
+    bench.value('init', initialized - compiled, 'ms');
+
+    const conn = await duckdb.getDB().connect();
+    await conn.query('SELECT 42 AS answer');
+    const queried = performance.now();
+    bench.value('first query', queried - initialized, 'ms');
+    bench.value('time to first query', queried - start, 'ms');
+    await conn.close();
+  });
+});
@@ -0,0 +1,58 @@
+import { afterAll, beforeAll, describe } from 'vitest';
+import { type Connection, getDB } from '../test/testDb';
+import { benchmark } from '../../../bench/harness';
+
+const ROWS = 1_000_000;
+
+describe('extraction', () => {
+  let conn: Connection;
+
+  beforeAll(async () => {
+    conn = await getDB().connect();
+    await conn.execute(`
+      CREATE TABLE extraction AS
+      SELECT range AS id, range * 0.5 AS score, 'name_' || (range % 1000) AS name,
+             range % 7 = 0 AS flag
+      FROM range(${ROWS})
+    `);
+  });
+
+  afterAll(async () => {
+    await conn.execute('DROP TABLE extraction');
+    await conn.close();
+  });
+
+  benchmark('query', async (bench) => {
+    const ms = await bench.time('query', () => conn.query('SELECT * FROM extraction'));
+    bench.value('query throughput', ROWS / (ms / 1000), 'rows/s');
+  });
+
+  benchmark('queryArrow', async (bench) => {
+    const ms = await bench.time('queryArrow', () => conn.queryArrow('SELECT * FROM extraction'));
+    bench.value('queryArrow throughput', ROWS / (ms / 1000), 'rows/s');
+  });
+
+  benchmark('queryStreaming rows', async (bench) => {
+    const ms = await bench.time('queryStreaming rows', async () => {
+      const stream = await conn.queryStreaming('SELECT * FROM extraction');
+      for await (const chunk of stream) {
+        chunk.toArray();
+      }
+      await stream.close();
+    });
+    bench.value('queryStreaming rows throughput', ROWS / (ms / 1000), 'rows/s');
+  });
+
+  benchmark('queryStreaming columns', async (bench) => {
+    const ms = await bench.time('queryStreaming columns', async () => {
+      const stream = await conn.queryStreaming('SELECT * FROM extraction');
+      for await (const chunk of stream) {
+        for (let i = 0; i < chunk.columnCount; i++) {
+          chunk.getColumnVector(i);
+        }
+      }
+      await stream.close();
+    });
+    bench.value('queryStreaming columns throughput', ROWS / (ms / 1000), 'rows/s');
+  });
+});
@@ -0,0 +1,40 @@
+import { bool, float64, int32, tableFromArrays, tableToIPC, utf8 } from '@uwdata/flechette';
+import { afterAll, beforeAll, describe } from 'vitest';
+import { type Connection, getDB } from '../test/testDb';
+import { benchmark } from '../../../bench/harness';
+
+const ROWS = 1_000_000;
+
+describe('ingest', () => {
+  let conn: Connection;
+  let ipc: Uint8Array;
+  let run = 0;
+
+  beforeAll(async () => {
+    conn = await getDB().connect();
+    const ids = Int32Array.from({ length: ROWS }, (_, i) => i);
+    const table = tableFromArrays(
+      {
+        id: ids,
+        score: Float64Array.from(ids, (i) => i * 0.5),
+        name: Array.from(ids, (i) => `name_${i % 1000}`),
+        flag: Array.from(ids, (i) => i % 7 === 0),
+      },
+      { types: { id: int32(), score: float64(), name: utf8(), flag: bool() } },
+    );
+    ipc = tableToIPC(table, { format: 'stream' }) as Uint8Array;
+  });
+
+  afterAll(async () => {
+    await conn.close();
+  });
+
+  benchmark('insertArrowFromIPCStream', async (bench) => {
+    const ms = await bench.time('insertArrowFromIPCStream', async () => {
+      // The buffer is transferred to the worker, so every run sends its own copy
+      await conn.insertArrowFromIPCStream(`ingest_${run++}`, ipc.slice());
+    });
+    bench.value('IPC size', ipc.byteLength, 'bytes');
+    bench.value('insertArrowFromIPCStream throughput', ipc.byteLength / 1e6 / (ms / 1000), 'MB/s');
+  });
+});
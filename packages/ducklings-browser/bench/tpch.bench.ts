@@ -0,0 +1,42 @@
+import { readFile } from 'node:fs/promises';
+import { join } from 'node:path';
+import { beforeAll, describe } from 'vitest';
+import { type Connection, getDB } from '../test/testDb';
+import {
+  benchmark,
+  TPCH_SCALE_FACTORS,
+  TPCH_TABLES,
+  tpchDataDir,
+  tpchQueries,
+} from '../../../bench/harness';
+
+const ITERATIONS = Number(process.env.BENCH_TPCH_ITERATIONS ?? 3);
+
+for (const scaleFactor of TPCH_SCALE_FACTORS) {
+  const dataDir = tpchDataDir(scaleFactor);
+
+  // Skipped (and reported as skipped) until `make bench-data` generated the files
+  describe.skipIf(!dataDir)(`TPC-H SF${scaleFactor}`, () => {
+    let conn: Connection;
+
+    beforeAll(async () => {
+      const db = getDB();
+      conn = await db.connect();
+      const schema = `tpch_sf${scaleFactor.replace('.', '_')}`;
+      await conn.execute(`CREATE SCHEMA ${schema}`);
+      for (const table of TPCH_TABLES) {
+        const name = `${schema}_${table}.parquet`;
+        const bytes = await readFile(join(dataDir as string, `${table}.parquet`));
+        await db.registerFileBuffer(name, bytes);
+        await conn.execute(`CREATE VIEW ${schema}.${table} AS SELECT * FROM '${name}'`);
+      }
+      await conn.execute(`SET search_path = '${schema}'`);
+    });
+
+    for (const { name, sql } of tpchQueries()) {
+      benchmark(name, async (bench) => {
+        await bench.time(name, () => conn.query(sql), { iterations: ITERATIONS });
+      });
+    }
+  });
+}
@@ -0,0 +1,110 @@
+/**
+ * Arrow IPC Ingest class
+ *
+ * @packageDocumentation
+ */
+
+import { DuckDBError } from '../errors.js';
+import { WorkerRequestType } from '../worker/protocol.js';
+import type { DuckDB } from './bindings.js';
+
+/**
+ * An incremental Arrow IPC ingest into a table.
+ *
+ * Bytes of an Arrow IPC stream can be pushed in pieces of any size, e.g. as
+ * they arrive from the network. Each record batch is written to the table as
+ * soon as it is complete, so the worker only holds one batch at a time.
+ *
+ * @category Data Insertion
+ * @example
+ * ```typescript
+ * const ingest = await conn.openArrowIPCIngest('events', { append: true });
+ * try {
+ *   const response = await fetch('/events.arrows');
+ *   for await (const bytes of response.body!) {
+ *     await ingest.push(bytes);
+ *   }
+ *   await ingest.finish();
+ * } finally {
+ *   await ingest.close();
+ * }
+ * ```
+ */
+export class ArrowIPCIngest {
+  private db: DuckDB;
+  private connectionId: number;
+  private ingestId: number;
+  private closed = false;
+
+  /**
+   * @internal
+   */
+  constructor(db: DuckDB, connectionId: number, ingestId: number) {
+    this.db = db;
+    this.connectionId = connectionId;
+    this.ingestId = ingestId;
+  }
+
+  private checkClosed(): void {
+    if (this.closed) {
+      throw new DuckDBError('Arrow IPC ingest is closed');
+    }
+  }
+
+  /**
+   * Push the next bytes of the IPC stream.
+   *
+   * When `bytes` spans its whole buffer, the buffer is transferred to the
+   * worker and can no longer be used by the caller; a view into a larger
+   * buffer is copied instead, so the rest of that buffer stays usable.
+   *
+   * @param bytes - The next part of the Arrow IPC stream
+   * @throws When a completed batch cannot be decoded or written
+   */
+  async push(bytes: Uint8Array): Promise<void> {
+    this.checkClosed();
+
+    const whole = bytes.byteOffset === 0 && bytes.byteLength === bytes.buffer.byteLength;
+    const data = whole ? bytes : bytes.slice();
+    await this.db.postTask(
+      WorkerRequestType.ARROW_INGEST_PUSH,
+      { connectionId: this.connectionId, ingestId: this.ingestId, bytes: data },
+      [data.buffer],
+    );
+  }
+
+  /**
+   * Finish the ingest and release it.
+   *
+   * @throws When the stream ended in the middle of a message or had no schema
+   */
+  async finish(): Promise<void> {
+    this.checkClosed();
+
+    try {
+      await this.db.postTask(WorkerRequestType.ARROW_INGEST_FINISH, {
+        connectionId: this.connectionId,
+        ingestId: this.ingestId,
+      });
+    } finally {
+      await this.close();
+    }
+  }
+
+  /**
+   * Release the ingest without finishing it.
+   *
+   * Batches that were already written stay in the table.
+   */
+  async close(): Promise<void> {
+    if (this.closed) {
+      return;
+    }
+
+    this.closed = true;
+    await this.db.postTask(WorkerRequestType.ARROW_INGEST_CLOSE, {
+      connectionId: this.connectionId,
+      ingestId: this.ingestId,
+    });
+  }
+}
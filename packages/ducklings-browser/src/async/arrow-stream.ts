@@ -0,0 +1,155 @@
+/**
+ * Arrow IPC Stream class
+ *
+ * @packageDocumentation
+ */
+
+import { DuckDBError } from '../errors.js';
+import { type ArrowIPCResponse, WorkerRequestType } from '../worker/protocol.js';
+import type { DuckDB } from './bindings.js';
+
+/**
+ * A query result read as an Arrow IPC stream, one part at a time.
+ *
+ * The worker encodes the record batches of each part only when it is requested, so
+ * neither the whole result nor its IPC bytes are held at once. The first part starts
+ * with the schema message and the last one ends with the end-of-stream marker;
+ * concatenated in order, the parts form a complete Arrow IPC stream.
+ *
+ * Implements AsyncIterable for use with `for await...of`.
+ *
+ * @category Query Results
+ * @example
+ * ```typescript
+ * const stream = await conn.queryArrowStream('SELECT * FROM large_table');
+ *
+ * // Using for await...of
+ * for await (const bytes of stream) {
+ *   socket.send(bytes);
+ * }
+ *
+ * // Or as a ReadableStream, e.g. to cache the result as a file
+ * const body = (await conn.queryArrowStream('SELECT * FROM large_table')).toReadableStream();
+ * await cache.put('/large_table.arrows', new Response(body));
+ * ```
+ */
+export class ArrowIPCStream implements AsyncIterable<Uint8Array> {
+  private db: DuckDB;
+  private connectionId: number;
+  private arrowStreamId: number;
+  private closed = false;
+  private done = false;
+
+  /**
+   * @internal
+   */
+  constructor(db: DuckDB, connectionId: number, arrowStreamId: number) {
+    this.db = db;
+    this.connectionId = connectionId;
+    this.arrowStreamId = arrowStreamId;
+  }
+
+  /**
+   * Check if the stream has been fully read.
+   */
+  isDone(): boolean {
+    return this.done;
+  }
+
+  /**
+   * Check if the stream is closed.
+   */
+  isClosed(): boolean {
+    return this.closed;
+  }
+
+  /**
+   * Read the next part of the stream.
+   *
+   * @returns Promise resolving to the next IPC bytes, or null once the stream is complete
+   */
+  async next(): Promise<Uint8Array | null> {
+    if (this.closed) {
+      throw new DuckDBError('Arrow IPC stream is closed');
+    }
+    if (this.done) {
+      return null;
+    }
+
+    const response = await this.db.postTask<ArrowIPCResponse>(WorkerRequestType.FETCH_ARROW_BATCH, {
+      connectionId: this.connectionId,
+      arrowStreamId: this.arrowStreamId,
+    });
+
+    if (response.ipcBuffer.byteLength === 0) {
+      this.done = true;
+      return null;
+    }
+    return response.ipcBuffer;
+  }
+
+  /**
+   * Close the stream and release the query result in the worker.
+   */
+  async close(): Promise<void> {
+    if (this.closed) {
+      return;
+    }
+
+    this.closed = true;
+    await this.db.postTask(WorkerRequestType.CLOSE_ARROW_STREAM, {
+      connectionId: this.connectionId,
+      arrowStreamId: this.arrowStreamId,
+    });
+  }
+
+  /**
+   * Expose the stream as a `ReadableStream` of IPC bytes.
+   *
+   * Each pull reads the next part; cancelling the stream closes it.
+   */
+  toReadableStream(): ReadableStream<Uint8Array> {
+    return new ReadableStream<Uint8Array>(
+      {
+        pull: async (controller) => {
+          try {
+            const bytes = await this.next();
+            if (bytes) {
+              controller.enqueue(bytes);
+              return;
+            }
+            controller.close();
+          } catch (error) {
+            controller.error(error);
+          }
+          await this.close();
+        },
+        cancel: () => this.close(),
+      },
+      // Only read ahead when the consumer asks for the next part
+      { highWaterMark: 0 },
+    );
+  }
+
+  // ============================================================================
+  // AsyncIterable implementation
+  // ============================================================================
+
+  /**
+   * Returns an async iterator over the parts of this stream.
+   */
+  async *[Symbol.asyncIterator](): AsyncIterator<Uint8Array> {
+    try {
+      let bytes = await this.next();
+      while (bytes !== null) {
+        yield bytes;
+        bytes = await this.next();
+      }
+    } finally {
+      // Auto-close when iteration completes
+      if (!this.closed) {
+        await this.close();
+      }
+    }
+  }
+}
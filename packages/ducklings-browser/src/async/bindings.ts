@@ -4,14 +4,26 @@
  * @packageDocumentation
  */
 
-import { createWorker } from '../cdn.js';
+import { createWorker, isSimdSupported } from '../cdn.js';
 import { DuckDBError } from '../errors.js';
-import type { DuckDBConfig, FileInfo, InitOptions } from '../types.js';
+import type {
+  DuckDBConfig,
+  FileInfo,
+  InitOptions,
+  LogLevel,
+  MemoryOptions,
+  QueryOptions,
+} from '../types.js';
 import {
   type ConnectionIdResponse,
   type ErrorResponse,
+  type ExecuteRequest,
   type FileBufferResponse,
   type FileInfoListResponse,
+  type QueryControl,
+  type QueryProgressResponse,
+  type QueryRequest,
+  type SnapshotResponse,
   type VersionResponse,
   type WorkerRequest,
   WorkerRequestType,
@@ -19,12 +31,79 @@ import {
   WorkerResponseType,
   WorkerTask,
 } from '../worker/protocol.js';
+import { readSnapshotHeader } from '../worker/snapshot.js';
 import { Connection } from './connection.js';
+import { Pipeline } from './pipeline.js';
 
 // Module state
 let globalDB: DuckDB | null = null;
 let initPromise: Promise<void> | null = null;
 
+/**
+ * Whether the multithreaded build can run in this context.
+ * Its pthreads share memory through SharedArrayBuffer, which browsers only
+ * expose on cross-origin isolated pages (COOP/COEP headers).
+ */
+function canUseThreads(): boolean {
+  return (
+    typeof crossOriginIsolated !== 'undefined' &&
+    crossOriginIsolated &&
+    typeof SharedArrayBuffer !== 'undefined'
+  );
+}
+
+/** Default minimum time between progress callbacks (ms) */
+const DEFAULT_PROGRESS_INTERVAL = 100;
+
+/**
+ * A query posted with {@link DuckDB.postQueryTask}.
+ * @internal
+ */
+export interface QueryTask<T> {
+  promise: Promise<T>;
+  /** Interrupt the query in the worker (if possible) and reject the promise right away */
+  cancel(): void;
+}
+
+/**
+ * What the database uses of its worker: a dedicated Worker, or the port of a SharedWorker,
+ * which has `close()` where a Worker has `terminate()` and no error event.
+ */
+interface WorkerEndpoint extends EventTarget {
+  onmessage: ((event: MessageEvent) => void) | null;
+  onerror?: ((event: ErrorEvent) => void) | null;
+  postMessage(message: unknown, transfer?: Transferable[]): void;
+  terminate?(): void;
+  close?(): void;
+}
+
+/** URLs of one WASM build */
+interface WasmBuild {
+  wasmUrl: string;
+  wasmJsUrl: string;
+  /** 'mt', 'simd' or 'baseline' */
+  variant: string;
+}
+
+/**
+ * Resolve the URLs of an optional build variant (wasm/duckdb-<suffix>.*).
+ * Overridden baseline URLs mean a custom layout, so the variant is only
+ * used if its own URLs are given too.
+ */
+function resolveVariant(
+  opts: InitOptions,
+  baseUrl: string,
+  suffix: string,
+  wasmUrl: string | undefined,
+  wasmJsUrl: string | undefined,
+): WasmBuild | null {
+  const wasm =
+    wasmUrl ?? (opts.wasmUrl ? undefined : new URL(`wasm/duckdb-${suffix}.wasm`, baseUrl).href);
+  const js =
+    wasmJsUrl ?? (opts.wasmJsUrl ? undefined : new URL(`wasm/duckdb-${suffix}.js`, baseUrl).href);
+  return wasm && js ? { wasmUrl: wasm, wasmJsUrl: js, variant: suffix } : null;
+}
+
 /**
  * Initialize the DuckDB WASM module.
  *
@@ -73,10 +152,55 @@ export async function init(options?: string | InitOptions): Promise<void> {
     const wasmUrl = opts.wasmUrl ?? new URL('wasm/duckdb.wasm', baseUrl).href;
     const wasmJsUrl = opts.wasmJsUrl ?? new URL('wasm/duckdb.js', baseUrl).href;
 
+    // Preferred builds first: multithreaded, then SIMD, then the baseline
+    let builds: WasmBuild[] = [];
+    if (opts.threads ?? canUseThreads()) {
+      const build = resolveVariant(opts, baseUrl, 'mt', opts.wasmThreadsUrl, opts.wasmThreadsJsUrl);
+      if (build) builds.push(build);
+    }
+    if (opts.simd ?? isSimdSupported()) {
+      const build = resolveVariant(opts, baseUrl, 'simd', opts.wasmSimdUrl, opts.wasmSimdJsUrl);
+      if (build) builds.push(build);
+    }
+    builds.push({ wasmUrl, wasmJsUrl, variant: 'baseline' });
+
+    // A snapshot can only be restored into the build it was taken with
+    const snapshot =
+      opts.snapshot instanceof ArrayBuffer ? new Uint8Array(opts.snapshot) : opts.snapshot;
+    if (snapshot) {
+      if (opts.config) {
+        throw new DuckDBError('config cannot be combined with snapshot, which fixes it');
+      }
+      const { variant } = readSnapshotHeader(snapshot).header;
+      builds = builds.filter((build) => build.variant === variant);
+      if (builds.length === 0) {
+        throw new DuckDBError(`The ${variant} build of the snapshot is not available here`);
+      }
+    }
+
     // Create worker - use provided worker, or create one automatically
     // Auto-detect cross-origin (CDN) and use Blob URL workaround if needed
-    let worker: Worker;
-    if (opts.worker) {
+    let worker: WorkerEndpoint;
+    if (opts.sharedWorker) {
+      let shared = opts.sharedWorker;
+      if (shared === true) {
+        const sharedWorkerUrl = new URL('shared-worker.js', baseUrl).href;
+        // A Blob URL would give every page its own shared worker, defeating the point
+        if (new URL(sharedWorkerUrl).origin !== location.origin) {
+          throw new DuckDBError('The shared worker must be served from the page origin');
+        }
+        shared = new SharedWorker(sharedWorkerUrl, { type: 'module', name: 'ducklings' });
+      }
+      const port = shared.port;
+      port.start();
+      // Leave the shared worker when the page goes away for good
+      addEventListener('pagehide', (event) => {
+        if (!event.persisted) {
+          port.postMessage({ messageId: 0, type: WorkerRequestType.DETACH, data: undefined });
+        }
+      });
+      worker = port;
+    } else if (opts.worker) {
       worker = opts.worker;
     } else {
       // Check if cross-origin (only in browser environment where location exists)
@@ -99,8 +223,8 @@ export async function init(options?: string | InitOptions): Promise<void> {
         reject(new DuckDBError('Worker initialization timeout'));
       }, 30000);
 
-      const handler = (event: MessageEvent) => {
-        if (event.data?.type === 'WORKER_READY') {
+      const handler = (event: Event) => {
+        if ((event as MessageEvent).data?.type === 'WORKER_READY') {
           clearTimeout(timeout);
           worker.removeEventListener('message', handler);
           resolve();
@@ -112,11 +236,31 @@ export async function init(options?: string | InitOptions): Promise<void> {
     // Create the global DB instance
     globalDB = new DuckDB(worker);
 
-    // Instantiate WASM in worker
-    await globalDB.instantiate(wasmUrl, wasmJsUrl);
+    // Instantiate WASM in worker, falling back to the next build if one fails to load
+    for (let i = 0; i < builds.length; i++) {
+      try {
+        const { wasmUrl, wasmJsUrl, variant } = builds[i];
+        await globalDB.instantiate(
+          wasmUrl,
+          wasmJsUrl,
+          variant,
+          snapshot,
+          opts.logLevel,
+          opts.fetchWorker,
+          opts.memory,
+        );
+        break;
+      } catch (error) {
+        if (i === builds.length - 1) {
+          throw error;
+        }
+      }
+    }
 
-    // Open database with config
-    await globalDB.open(opts.config);
+    // Open database with config (a restored snapshot already holds one)
+    if (!snapshot) {
+      await globalDB.open(opts.config);
+    }
   })();
 
   await initPromise;
@@ -174,18 +318,20 @@ export function getDB(): DuckDB {
  * ```
  */
 export class DuckDB {
-  private worker: Worker;
+  /** A dedicated worker, or the port of a shared worker */
+  private worker: WorkerEndpoint;
   private pendingRequests: Map<number, WorkerTask> = new Map();
   private nextMessageId = 1;
   private closed = false;
+  private logLevel: LogLevel = 'warn';
 
   /**
    * Creates a new DuckDB instance.
    *
-   * @param worker - The Web Worker to use for DuckDB operations
+   * @param worker - The Web Worker (or SharedWorker port) to use for DuckDB operations
    * @internal Use init() instead of creating directly
    */
-  constructor(worker?: Worker) {
+  constructor(worker?: WorkerEndpoint) {
     if (worker) {
       this.worker = worker;
       this.setupMessageHandler();
@@ -205,6 +351,12 @@ export class DuckDB {
       const response = event.data as WorkerResponse;
       const task = this.pendingRequests.get(response.requestId);
 
+      if (response.type === WorkerResponseType.QUERY_PROGRESS) {
+        // Intermediate response; the request stays pending
+        task?.onProgress?.(response.data as QueryProgressResponse);
+        return;
+      }
+
       if (task) {
         this.pendingRequests.delete(response.requestId);
 
@@ -214,9 +366,19 @@ export class DuckDB {
         } else {
           task.resolve(response.data);
         }
+      } else if (response.type === WorkerResponseType.ERROR) {
+        // A post-and-forget request failed; nothing is waiting for it
+        const errorData = response.data as ErrorResponse;
+        if (this.logLevel !== 'silent') {
+          console.error('[Ducklings] Request without reply failed:', errorData.message);
+        }
       }
     };
 
+    if (!this.worker.terminate) {
+      // A port has no error event; the shared worker answers every request instead
+      return;
+    }
     this.worker.onerror = (error: ErrorEvent) => {
       // Reject all pending requests
       for (const [, task] of this.pendingRequests) {
@@ -255,13 +417,133 @@ export class DuckDB {
     return task.promise;
   }
 
+  /**
+   * Post a query that can be cancelled and reports progress.
+   *
+   * The worker can only be interrupted mid-query through a SharedArrayBuffer flag, which
+   * needs a cross-origin isolated page and a dedicated worker. Elsewhere cancelling
+   * rejects the promise and the worker's eventual result is dropped.
+   *
+   * @internal
+   */
+  postQueryTask<T>(
+    type: WorkerRequestType.QUERY | WorkerRequestType.EXECUTE,
+    data: QueryRequest | ExecuteRequest,
+    options: QueryOptions = {},
+  ): QueryTask<T> {
+    if (this.closed) {
+      return { promise: Promise.reject(new DuckDBError('Database is closed')), cancel: () => {} };
+    }
+
+    // A SharedArrayBuffer cannot be posted to a shared worker
+    const dedicated = this.worker.terminate !== undefined;
+    const interrupt =
+      dedicated && canUseThreads() ? new Int32Array(new SharedArrayBuffer(4)) : undefined;
+    const progressInterval = options.onProgress
+      ? (options.progressInterval ?? DEFAULT_PROGRESS_INTERVAL)
+      : undefined;
+    const control: QueryControl | undefined =
+      interrupt || progressInterval !== undefined ? { interrupt, progressInterval } : undefined;
+
+    const messageId = this.nextMessageId++;
+    const task = new WorkerTask<T>(messageId, type);
+    task.onProgress = options.onProgress;
+    this.pendingRequests.set(messageId, task as WorkerTask);
+
+    const request: WorkerRequest = {
+      messageId,
+      type,
+      data: { ...data, control },
+    };
+    this.worker.postMessage(request);
+
+    return {
+      promise: task.promise,
+      cancel: () => {
+        if (interrupt) {
+          Atomics.store(interrupt, 0, 1);
+        }
+        // The request stays registered so its late response is consumed silently
+        task.onProgress = undefined;
+        task.reject(new DuckDBError('Query was cancelled', 'INTERRUPTED', data.sql));
+      },
+    };
+  }
+
+  /**
+   * Post a request without waiting for its response.
+   *
+   * The worker runs it in order with other requests and only responds if it fails.
+   *
+   * @internal
+   */
+  postTaskNoReply(type: WorkerRequestType, data?: unknown): void {
+    if (this.closed) {
+      throw new DuckDBError('Database is closed');
+    }
+
+    const request: WorkerRequest = {
+      messageId: this.nextMessageId++,
+      type,
+      data,
+      noReply: true,
+    };
+    this.worker.postMessage(request);
+  }
+
   /**
    * Instantiate the WASM module in the worker.
    *
    * @internal
    */
-  async instantiate(wasmUrl?: string, wasmJsUrl?: string): Promise<void> {
-    await this.postTask(WorkerRequestType.INSTANTIATE, { wasmUrl, wasmJsUrl });
+  async instantiate(
+    wasmUrl?: string,
+    wasmJsUrl?: string,
+    variant?: string,
+    snapshot?: Uint8Array,
+    logLevel: LogLevel = 'warn',
+    fetchWorker?: boolean,
+    memory?: MemoryOptions,
+  ): Promise<void> {
+    this.logLevel = logLevel;
+    await this.postTask(WorkerRequestType.INSTANTIATE, {
+      wasmUrl,
+      wasmJsUrl,
+      variant,
+      snapshot,
+      logLevel,
+      fetchWorker,
+      memory,
+    });
+  }
+
+  /**
+   * Take a memory snapshot of the database for {@link InitOptions.snapshot}.
+   *
+   * The snapshot holds the database as it is now, including tables, views, settings and
+   * loaded extensions, so passing it to `init()` skips opening the database and running
+   * setup SQL again. Close all connections first. Files registered with `registerFile*()`
+   * are not part of it; register them again after restoring. Snapshots need the
+   * single-threaded build and an in-memory database, and only restore into the exact
+   * build (package version and variant) they were taken with.
+   *
+   * @returns The snapshot bytes
+   *
+   * @example
+   * ```typescript
+   * await init({ threads: false });
+   * const conn = await getDB().connect();
+   * await conn.execute("CREATE TABLE cities AS SELECT * FROM 'cities.parquet'");
+   * await conn.close();
+   * const snapshot = await getDB().createSnapshot();
+   *
+   * // Later, e.g. on the next page load
+   * await init({ threads: false, snapshot });
+   * ```
+   */
+  async createSnapshot(): Promise<Uint8Array> {
+    const response = await this.postTask<SnapshotResponse>(WorkerRequestType.CREATE_SNAPSHOT);
+    return response.snapshot;
   }
 
   /**
@@ -295,6 +577,25 @@ export class DuckDB {
     return new Connection(this, response.connectionId);
   }
 
+  /**
+   * Create a pipeline that sends several operations to the worker in one message.
+   *
+   * @returns A new pipeline
+   *
+   * @example
+   * ```typescript
+   * const pipeline = db.pipeline();
+   * const conn = pipeline.connect();
+   * pipeline.execute(conn, 'SET threads = 1');
+   * const rows = pipeline.query(conn, 'SELECT 42 AS answer');
+   * const results = await pipeline.run();
+   * console.log(results.get(rows)); // [{ answer: 42 }]
+   * ```
+   */
+  pipeline(): Pipeline {
+    return new Pipeline(this);
+  }
+
   /**
    * Creates a new DuckDB database and initializes the WASM module if needed.
    *
@@ -372,6 +673,48 @@ export class DuckDB {
     await this.postTask(WorkerRequestType.REGISTER_FILE_TEXT, { name, text });
   }
 
+  /**
+   * Register a `File`, `Blob` or `FileSystemFileHandle` as a virtual file without copying it.
+   *
+   * Unlike {@link DuckDB.registerFileBuffer}, the contents are not loaded into WASM memory:
+   * each read DuckDB makes fetches exactly the requested byte range with `Blob.slice`, so
+   * scanning a few columns of a large Parquet file only reads those columns. The file must
+   * stay readable while it is registered; drop it with {@link DuckDB.dropFile}.
+   *
+   * @param name - The virtual file name to use in queries
+   * @param handle - The file to read from
+   *
+   * @example
+   * ```typescript
+   * const file = (document.getElementById('file') as HTMLInputElement).files![0];
+   * await db.registerFileHandle('upload.parquet', file);
+   * const rows = await conn.query("SELECT count(*) FROM 'upload.parquet'");
+   * ```
+   */
+  async registerFileHandle(name: string, handle: Blob | FileSystemFileHandle): Promise<void> {
+    await this.postTask(WorkerRequestType.REGISTER_FILE_HANDLE, { name, handle });
+  }
+
+  /**
+   * Register a file in the Origin Private File System as `opfs://<name>`.
+   *
+   * The file is created if it does not exist yet. DuckDB reads it with positional
+   * reads on an OPFS sync access handle, so it is never loaded into memory as a whole.
+   * Register a file before writing to it (e.g. with `COPY ... TO`) so that its
+   * contents are kept under that name.
+   *
+   * @param name - The file path inside OPFS (e.g. `'data/events.parquet'`)
+   *
+   * @example
+   * ```typescript
+   * await db.registerOPFSFile('events.parquet');
+   * const rows = await conn.query("SELECT count(*) FROM 'opfs://events.parquet'");
+   * ```
+   */
+  async registerOPFSFile(name: string): Promise<void> {
+    await this.postTask(WorkerRequestType.REGISTER_OPFS_FILE, { name });
+  }
+
   // ============================================================================
   // File Operations
   // ============================================================================
@@ -379,6 +722,9 @@ export class DuckDB {
   /**
    * Remove a registered file.
    *
+   * Files registered with {@link DuckDB.registerFileHandle} are released, and passing an
+   * `opfs://` path closes a file registered with {@link DuckDB.registerOPFSFile}.
+   *
    * @param name - The virtual file name to remove
    */
   async dropFile(name: string): Promise<void> {
@@ -445,7 +791,13 @@ export class DuckDB {
     }
 
     await this.postTask(WorkerRequestType.CLOSE);
-    this.worker.terminate();
+    if (this.worker.terminate) {
+      this.worker.terminate();
+    } else {
+      // The shared worker keeps serving other pages; only leave it
+      this.worker.postMessage({ messageId: 0, type: WorkerRequestType.DETACH, data: undefined });
+      this.worker.close?.();
+    }
     this.closed = true;
 
     if (globalDB === this) {
@@ -0,0 +1,206 @@
+/**
+ * Columnar query result
+ *
+ * @packageDocumentation
+ */
+
+import type { ColumnInfo, QueryProfile } from '../types.js';
+import type { ResultChunk } from '../worker/protocol.js';
+import { DataChunk } from './data-chunk.js';
+
+/** Key of the row index on a row proxy's target */
+const ROW = Symbol('row');
+
+type RowTarget = { [ROW]: number };
+
+/**
+ * A query result that keeps its columns the way they came from the worker.
+ *
+ * Numeric columns are the typed arrays copied from DuckDB's vectors and VARCHAR
+ * columns are UTF-8 bytes, all transferred from the worker without cloning. Values are
+ * only converted when they are read, so the cost of a wide or long result follows what
+ * is accessed rather than its size. Rows are read-only proxies over the columns;
+ * `toArray()` returns plain objects, the same as `query()`.
+ *
+ * @category Query Results
+ * @example
+ * ```typescript
+ * const result = await conn.queryColumnar<{ id: number; name: string }>(
+ *   'SELECT * FROM users',
+ * );
+ * console.log(result.rowCount);
+ *
+ * // Only the rows a table view shows are converted
+ * for (let i = first; i < first + pageSize; i++) {
+ *   const row = result.get(i);
+ *   render(row.id, row.name);
+ * }
+ *
+ * // Or read a column's typed arrays directly
+ * for (const chunk of result.getChunks()) {
+ *   const vector = chunk.getColumnVector(0);
+ * }
+ * ```
+ */
+export class ColumnarResult<T = Record<string, unknown>> implements Iterable<T> {
+  /** Query profile, when the query ran with `profile: true` */
+  readonly profile?: QueryProfile;
+
+  private columns: ColumnInfo[];
+  private chunks: DataChunk[];
+  /** First row of each chunk, followed by the total row count */
+  private offsets: number[];
+  /** Column index by name; with duplicate names the last column wins, as in `query()` */
+  private columnIndex: Map<string, number> = new Map();
+  private handler: ProxyHandler<RowTarget>;
+
+  /**
+   * @internal
+   */
+  constructor(columns: ColumnInfo[], chunks: ResultChunk[], profile?: QueryProfile) {
+    this.columns = columns;
+    this.chunks = chunks.map((chunk) => new DataChunk(columns, chunk.vectors, chunk.rowCount));
+    this.offsets = [0];
+    for (const chunk of chunks) {
+      this.offsets.push(this.offsets[this.offsets.length - 1] + chunk.rowCount);
+    }
+    columns.forEach((column, index) => this.columnIndex.set(column.name, index));
+    if (profile) {
+      this.profile = profile;
+    }
+
+    const keys = [...this.columnIndex.keys()];
+    const column = (key: string | symbol) =>
+      typeof key === 'string' ? this.columnIndex.get(key) : undefined;
+    this.handler = {
+      get: (target, key) => {
+        const index = column(key);
+        return index === undefined ? undefined : this.getValue(target[ROW], index);
+      },
+      has: (_target, key) => column(key) !== undefined,
+      ownKeys: () => keys,
+      getOwnPropertyDescriptor: (target, key) => {
+        const index = column(key);
+        if (index === undefined) {
+          return undefined;
+        }
+        const value = this.getValue(target[ROW], index);
+        return { value, enumerable: true, configurable: true, writable: false };
+      },
+      set: () => false,
+      deleteProperty: () => false,
+      defineProperty: () => false,
+    };
+  }
+
+  /**
+   * Get the number of rows.
+   */
+  get rowCount(): number {
+    return this.offsets[this.offsets.length - 1];
+  }
+
+  /**
+   * Get the number of columns.
+   */
+  get columnCount(): number {
+    return this.columns.length;
+  }
+
+  /**
+   * Get the column information.
+   */
+  getColumns(): ColumnInfo[] {
+    return this.columns;
+  }
+
+  /**
+   * Get the result's chunks, for reading their column vectors without conversion.
+   */
+  getChunks(): DataChunk[] {
+    return this.chunks;
+  }
+
+  /**
+   * Get a single value, converting only that value.
+   *
+   * @param row - The 0-based row index
+   * @param column - The 0-based column index
+   * @returns The value, or null for NULL
+   */
+  getValue(row: number, column: number): unknown {
+    if (row < 0 || row >= this.rowCount) {
+      throw new Error(`Row index ${row} out of bounds`);
+    }
+    // Binary search for the chunk holding the row
+    let low = 0;
+    let high = this.chunks.length - 1;
+    while (low < high) {
+      const mid = (low + high + 1) >> 1;
+      if (this.offsets[mid] <= row) {
+        low = mid;
+      } else {
+        high = mid - 1;
+      }
+    }
+    return this.chunks[low].getValue(row - this.offsets[low], column);
+  }
+
+  /**
+   * Get a single column's values.
+   *
+   * @param index - The 0-based column index
+   * @returns Array of values for that column
+   */
+  getColumn(index: number): unknown[] {
+    if (index < 0 || index >= this.columns.length) {
+      throw new Error(`Column index ${index} out of bounds`);
+    }
+    return this.chunks.flatMap((chunk) => chunk.getColumn(index));
+  }
+
+  /**
+   * Get a single column's values by name.
+   *
+   * @param name - The column name
+   * @returns Array of values for that column
+   */
+  getColumnByName(name: string): unknown[] {
+    const index = this.columnIndex.get(name);
+    if (index === undefined) {
+      throw new Error(`Column "${name}" not found`);
+    }
+    return this.getColumn(index);
+  }
+
+  /**
+   * Get a row as a read-only proxy that converts values when its properties are read.
+   *
+   * @param index - The 0-based row index
+   * @returns The row, keyed by column name
+   */
+  get(index: number): T {
+    if (index < 0 || index >= this.rowCount) {
+      throw new Error(`Row index ${index} out of bounds`);
+    }
+    return new Proxy({ [ROW]: index }, this.handler) as T;
+  }
+
+  /**
+   * Convert all rows to plain objects, as returned by `query()`.
+   *
+   * @returns Array of row objects with column names as keys
+   */
+  toArray(): T[] {
+    return this.chunks.flatMap((chunk) => chunk.toArray<T>());
+  }
+
+  /**
+   * Iterate over rows as proxies.
+   */
+  *[Symbol.iterator](): Iterator<T> {
+    for (let i = 0; i < this.rowCount; i++) {
+      yield this.get(i);
+    }
+  }
+}
@@ -6,16 +6,29 @@
 
 import { type Table, tableFromIPC } from '@uwdata/flechette';
 import { DuckDBError } from '../errors.js';
-import type { CSVInsertOptions, JSONInsertOptions } from '../types.js';
+import type {
+  ArrowIPCInsertOptions,
+  ArrowStreamOptions,
+  CSVInsertOptions,
+  JSONInsertOptions,
+  ProfiledRows,
+  QueryOptions,
+  QueryRowsOptions,
+} from '../types.js';
 import {
+  type ArrowIngestIdResponse,
   type ArrowIPCResponse,
+  type ArrowStreamIdResponse,
   type PreparedStatementIdResponse,
   type QueryResultResponse,
   type RowsChangedResponse,
   type StreamingResultInfoResponse,
   WorkerRequestType,
 } from '../worker/protocol.js';
-import type { DuckDB } from './bindings.js';
+import { ArrowIPCIngest } from './arrow-ingest.js';
+import { ArrowIPCStream } from './arrow-stream.js';
+import type { DuckDB, QueryTask } from './bindings.js';
+import { ColumnarResult } from './columnar-result.js';
 import { PreparedStatement } from './prepared-statement.js';
 import { AsyncStreamingResult } from './streaming-result.js';
 
@@ -49,6 +62,8 @@ export class Connection {
   private db: DuckDB;
   private connectionId: number;
   private closed = false;
+  /** Queries and statements that {@link Connection.cancel} stops */
+  private running: Set<QueryTask<unknown>> = new Set();
 
   /**
    * @internal
@@ -80,6 +95,32 @@ export class Connection {
     }
   }
 
+  /**
+   * Post a cancellable query, tied to the options' signal and to cancel().
+   */
+  private async runQueryTask<T>(
+    type: WorkerRequestType.QUERY | WorkerRequestType.EXECUTE,
+    sql: string,
+    options?: QueryRowsOptions,
+  ): Promise<T> {
+    const signal = options?.signal;
+    if (signal?.aborted) {
+      throw new DuckDBError('Query was cancelled', 'INTERRUPTED', sql);
+    }
+
+    const data = { connectionId: this.connectionId, sql, profile: options?.profile };
+    const task = this.db.postQueryTask<T>(type, data, options);
+    const onAbort = () => task.cancel();
+    this.running.add(task);
+    signal?.addEventListener('abort', onAbort, { once: true });
+    try {
+      return await task.promise;
+    } finally {
+      this.running.delete(task);
+      signal?.removeEventListener('abort', onAbort);
+    }
+  }
+
   // ============================================================================
   // Query Operations
   // ============================================================================
@@ -88,7 +129,9 @@ export class Connection {
    * Executes a SQL query and returns the results as an array of objects.
    *
    * @param sql - The SQL query to execute
-   * @returns Promise resolving to array of result rows as objects
+   * @param options - Optional abort signal, progress callback and profiling
+   * @returns Promise resolving to array of result rows as objects, with a `profile`
+   *   property when `options.profile` is set
    *
    * @example
    * ```typescript
@@ -98,25 +141,68 @@ export class Connection {
    * for (const row of rows) {
    *   console.log(row.id, row.name);
    * }
+   *
+   * // Give up after 5 seconds and show progress meanwhile
+   * const totals = await conn.query('SELECT sum(amount) FROM sales', {
+   *   signal: AbortSignal.timeout(5000),
+   *   onProgress: ({ percentage }) => console.log(`${percentage.toFixed(0)}%`),
+   * });
+   *
+   * // See where a remote scan spends its time
+   * const result = await conn.query("SELECT count(*) FROM 'https://example.com/data.parquet'", {
+   *   profile: true,
+   * });
+   * console.log(result.profile.httpTimeMs, result.profile.http.urls);
    * ```
    */
-  async query<T = Record<string, unknown>>(sql: string): Promise<T[]> {
+  query<T = Record<string, unknown>>(
+    sql: string,
+    options: QueryRowsOptions & { profile: true },
+  ): Promise<ProfiledRows<T>>;
+  query<T = Record<string, unknown>>(sql: string, options?: QueryRowsOptions): Promise<T[]>;
+  async query<T = Record<string, unknown>>(sql: string, options?: QueryRowsOptions): Promise<T[]> {
     this.checkClosed();
 
-    const response = await this.db.postTask<QueryResultResponse>(WorkerRequestType.QUERY, {
-      connectionId: this.connectionId,
-      sql,
-    });
+    const result = await this.queryColumnar<T>(sql, options);
+    const objects = result.toArray();
+    if (result.profile) {
+      return Object.assign(objects, { profile: result.profile });
+    }
+    return objects;
+  }
 
-    // Convert row arrays to objects
-    const { columns, rows } = response;
-    return rows.map((row) => {
-      const obj: Record<string, unknown> = {};
-      for (let i = 0; i < columns.length; i++) {
-        obj[columns[i].name] = row[i];
-      }
-      return obj as T;
-    });
+  /**
+   * Executes a SQL query and returns the result as columns, converting values only when
+   * they are read.
+   *
+   * The columns are transferred from the worker as typed arrays and UTF-8 bytes, so a
+   * wide or long result costs little until rows are accessed. Rows from `get(i)` or
+   * iteration are read-only proxies; `toArray()` returns the same objects as `query()`.
+   *
+   * @param sql - The SQL query to execute
+   * @param options - Optional abort signal, progress callback and profiling
+   * @returns Promise resolving to the columnar result
+   *
+   * @example
+   * ```typescript
+   * const result = await conn.queryColumnar<{ id: number; name: string }>(
+   *   'SELECT * FROM users',
+   * );
+   * const page = Array.from({ length: 50 }, (_, i) => result.get(offset + i));
+   * ```
+   */
+  async queryColumnar<T = Record<string, unknown>>(
+    sql: string,
+    options?: QueryRowsOptions,
+  ): Promise<ColumnarResult<T>> {
+    this.checkClosed();
+
+    const response = await this.runQueryTask<QueryResultResponse>(
+      WorkerRequestType.QUERY,
+      sql,
+      options,
+    );
+    return new ColumnarResult<T>(response.columns, response.chunks, response.profile);
   }
 
   /**
@@ -145,6 +231,38 @@ export class Connection {
     return tableFromIPC(response.ipcBuffer);
   }
 
+  /**
+   * Executes a SQL query and reads its result as an Arrow IPC stream.
+   *
+   * Unlike `queryArrow()`, the result is not built up in the worker: the query runs with
+   * a streaming result and each part's record batches are encoded when it is read, so
+   * the first bytes arrive before the query has finished and memory stays bounded by
+   * the part size. Running other statements on the connection before the stream is read
+   * to the end makes the worker encode the rest of it first.
+   *
+   * @param sql - The SQL query to execute
+   * @param options - Rows per part of the stream
+   * @returns Promise resolving to an ArrowIPCStream of IPC bytes
+   *
+   * @example
+   * ```typescript
+   * const stream = await conn.queryArrowStream('SELECT * FROM large_table');
+   * for await (const bytes of stream) {
+   *   socket.send(bytes);
+   * }
+   * ```
+   */
+  async queryArrowStream(sql: string, options?: ArrowStreamOptions): Promise<ArrowIPCStream> {
+    this.checkClosed();
+
+    const response = await this.db.postTask<ArrowStreamIdResponse>(
+      WorkerRequestType.QUERY_ARROW_STREAM,
+      { connectionId: this.connectionId, sql, batchRows: options?.batchRows },
+    );
+
+    return new ArrowIPCStream(this.db, this.connectionId, response.arrowStreamId);
+  }
+
   /**
    * Executes a SQL query and returns a streaming result.
    *
@@ -189,6 +307,7 @@ export class Connection {
    * don't need to read result rows.
    *
    * @param sql - The SQL statement to execute
+   * @param options - Optional abort signal and progress callback
    * @returns Promise resolving to the number of rows affected
    *
    * @example
@@ -197,17 +316,58 @@ export class Connection {
    * console.log(`Deleted ${deleted} users`);
    * ```
    */
-  async execute(sql: string): Promise<number> {
+  async execute(sql: string, options?: QueryOptions): Promise<number> {
     this.checkClosed();
 
-    const response = await this.db.postTask<RowsChangedResponse>(WorkerRequestType.EXECUTE, {
-      connectionId: this.connectionId,
+    const response = await this.runQueryTask<RowsChangedResponse>(
+      WorkerRequestType.EXECUTE,
       sql,
-    });
+      options,
+    );
 
     return response.rowsChanged;
   }
 
+  /**
+   * Cancels the queries and statements of this connection that are still running.
+   *
+   * Their promises reject with a {@link DuckDBError} with code `INTERRUPTED`. On cross-origin
+   * isolated pages the worker interrupts the running query between execution tasks;
+   * elsewhere it runs to completion and its result is discarded.
+   *
+   * Covers `query()` and `execute()`; other operations are not interrupted.
+   */
+  cancel(): void {
+    for (const task of this.running) {
+      task.cancel();
+    }
+  }
+
+  /**
+   * Executes a SQL statement without waiting for it to finish.
+   *
+   * The statement is queued in the worker in order with the connection's other
+   * requests, so a later `query()` sees its effects, but no response is sent back
+   * for it. Use it for statements whose results are not needed, such as settings.
+   * A failure is logged to the console rather than thrown.
+   *
+   * @param sql - The SQL statement to execute
+   *
+   * @example
+   * ```typescript
+   * conn.executeAndForget("SET TimeZone = 'UTC'");
+   * conn.executeAndForget('SET threads = 2');
+   * const rows = await conn.query("SELECT current_setting('TimeZone') AS tz");
+   * ```
+   */
+  executeAndForget(sql: string): void {
+    this.checkClosed();
+    this.db.postTaskNoReply(WorkerRequestType.EXECUTE, {
+      connectionId: this.connectionId,
+      sql,
+    });
+  }
+
   // ============================================================================
   // Prepared Statements
   // ============================================================================
@@ -324,6 +484,7 @@ export class Connection {
    *
    * Creates a new table with the given name from the Arrow IPC data. If the table
    * already exists, the call is a no-op (uses `CREATE TABLE IF NOT EXISTS`).
+   * Pass `{ append: true }` to insert the rows into an existing table instead.
    *
    * **Important:** The IPC stream must not contain dictionary-encoded columns.
    * Flechette's `tableFromArrays()` defaults to `dictionary(utf8())` for string
@@ -331,6 +492,7 @@ export class Connection {
    *
    * @param tableName - The name of the table to create
    * @param ipcBuffer - Arrow IPC stream bytes (use `tableToIPC(table, { format: 'stream' })`)
+   * @param options - Optional insertion options
    * @throws When the connection is closed or the IPC data is invalid
    *
    * @example
@@ -343,20 +505,65 @@ export class Connection {
    * );
    * const ipcBuffer = tableToIPC(table, { format: 'stream' });
    * await conn.insertArrowFromIPCStream('users', ipcBuffer);
+   *
+   * // Add more rows later
+   * await conn.insertArrowFromIPCStream('users', moreIpcBuffer, { append: true });
    * ```
    *
    * @category Data Insertion
    */
-  async insertArrowFromIPCStream(tableName: string, ipcBuffer: Uint8Array): Promise<void> {
+  async insertArrowFromIPCStream(
+    tableName: string,
+    ipcBuffer: Uint8Array,
+    options?: ArrowIPCInsertOptions,
+  ): Promise<void> {
     this.checkClosed();
 
     await this.db.postTask(
       WorkerRequestType.INSERT_ARROW_FROM_IPC,
-      { connectionId: this.connectionId, tableName, ipcBuffer },
+      { connectionId: this.connectionId, tableName, ipcBuffer, append: options?.append },
       [ipcBuffer.buffer],
     );
   }
 
+  /**
+   * Start an incremental Arrow IPC ingest into a table.
+   *
+   * Unlike {@link Connection.insertArrowFromIPCStream}, the IPC stream does not
+   * have to be held in one buffer: push it in pieces and each record batch is
+   * written as soon as it is complete. Without `append`, the table is created
+   * from the stream schema and must not exist yet.
+   *
+   * @param tableName - The name of the table to write to
+   * @param options - Optional insertion options
+   * @returns Promise resolving to an ArrowIPCIngest to push bytes into
+   * @throws When the connection is closed
+   *
+   * @example
+   * ```typescript
+   * const ingest = await conn.openArrowIPCIngest('events', { append: true });
+   * for (const part of parts) {
+   *   await ingest.push(part);
+   * }
+   * await ingest.finish();
+   * ```
+   *
+   * @category Data Insertion
+   */
+  async openArrowIPCIngest(
+    tableName: string,
+    options?: ArrowIPCInsertOptions,
+  ): Promise<ArrowIPCIngest> {
+    this.checkClosed();
+
+    const response = await this.db.postTask<ArrowIngestIdResponse>(
+      WorkerRequestType.ARROW_INGEST_OPEN,
+      { connectionId: this.connectionId, tableName, append: options?.append },
+    );
+
+    return new ArrowIPCIngest(this.db, this.connectionId, response.ingestId);
+  }
+
   /**
    * Insert data from a CSV file.
    *
@@ -4,13 +4,45 @@
  * @packageDocumentation
  */
 
-import type { ColumnInfo } from '../types.js';
+import type { ColumnInfo, ColumnVector, DuckDBTypeId } from '../types.js';
+import { DuckDBType } from '../types.js';
+
+const utf8Decoder = new TextDecoder();
+
+/**
+ * Convert one row of a column vector to the JS value `query()` returns for it.
+ * @internal
+ */
+export function decodeValue(vector: ColumnVector, type: DuckDBTypeId, row: number): unknown {
+  if (vector.kind === 'values') {
+    return vector.values[row];
+  }
+  const validity = vector.validity;
+  if (validity && ((validity[row >> 3] >> (row & 7)) & 1) === 0) {
+    return null;
+  }
+  if (vector.kind === 'string') {
+    return utf8Decoder.decode(vector.bytes.subarray(vector.offsets[row], vector.offsets[row + 1]));
+  }
+  if (type === DuckDBType.BOOLEAN) {
+    return vector.data[row] !== 0;
+  }
+  if (typeof vector.data[row] === 'bigint') {
+    // Return as number if within safe integer range, otherwise as string for JSON compatibility
+    const big = vector.data[row] as bigint;
+    const num = Number(big);
+    return Number.isSafeInteger(num) ? num : big.toString();
+  }
+  return vector.data[row];
+}
 
 /**
  * A chunk of data from a streaming query result.
  *
  * DataChunks contain a fixed number of rows and provide methods to
- * access the data in various formats.
+ * access the data in various formats. Data arrives columnar: numeric
+ * columns are typed arrays copied straight from DuckDB's vectors, and
+ * row values are only built when a row-oriented method is called.
  *
  * @category Query Results
  * @example
@@ -26,20 +58,27 @@ import type { ColumnInfo } from '../types.js';
  *   // Or access raw columnar data
  *   const column = chunk.getColumn(0);
  *   console.log(column);
+ *
+ *   // Or read the typed array without any conversion
+ *   const vector = chunk.getColumnVector(0);
+ *   if (vector.kind === 'fixed') {
+ *     console.log(vector.data);
+ *   }
  * }
  * ```
  */
 export class DataChunk {
   private columns: ColumnInfo[];
-  private rows: unknown[][];
+  private vectors: ColumnVector[];
   private _rowCount: number;
+  private rows: unknown[][] | null = null;
 
   /**
    * @internal
    */
-  constructor(columns: ColumnInfo[], rows: unknown[][], rowCount: number) {
+  constructor(columns: ColumnInfo[], vectors: ColumnVector[], rowCount: number) {
     this.columns = columns;
-    this.rows = rows;
+    this.vectors = vectors;
     this._rowCount = rowCount;
   }
 
@@ -70,9 +109,53 @@ export class DataChunk {
    * Each row is an array of values in column order.
    */
   getRows(): unknown[][] {
+    if (!this.rows) {
+      const columnValues = this.columns.map((_, index) => this.getColumn(index));
+      const rows: unknown[][] = new Array(this._rowCount);
+      for (let rowIdx = 0; rowIdx < this._rowCount; rowIdx++) {
+        const row: unknown[] = new Array(columnValues.length);
+        for (let colIdx = 0; colIdx < columnValues.length; colIdx++) {
+          row[colIdx] = columnValues[colIdx][rowIdx];
+        }
+        rows[rowIdx] = row;
+      }
+      this.rows = rows;
+    }
     return this.rows;
   }
 
+  /**
+   * Get the columnar data of a column without converting it to JS values.
+   *
+   * Fixed-width columns expose a typed array over the copied vector data,
+   * VARCHAR columns expose UTF-8 bytes with row offsets. Check `validity`
+   * (or use {@link DataChunk.isNull}) before reading a row.
+   *
+   * @param index - The 0-based column index
+   * @returns The column vector
+   */
+  getColumnVector(index: number): ColumnVector {
+    if (index < 0 || index >= this.columns.length) {
+      throw new Error(`Column index ${index} out of bounds`);
+    }
+    return this.vectors[index];
+  }
+
+  /**
+   * Check whether a value is NULL.
+   *
+   * @param row - The 0-based row index
+   * @param column - The 0-based column index
+   * @returns True if the value is NULL
+   */
+  isNull(row: number, column: number): boolean {
+    const vector = this.getColumnVector(column);
+    if (vector.kind === 'values') {
+      return vector.values[row] === null;
+    }
+    return vector.validity !== null && ((vector.validity[row >> 3] >> (row & 7)) & 1) === 0;
+  }
+
   /**
    * Get a single column's values.
    *
@@ -80,10 +163,31 @@ export class DataChunk {
    * @returns Array of values for that column
    */
   getColumn(index: number): unknown[] {
-    if (index < 0 || index >= this.columns.length) {
-      throw new Error(`Column index ${index} out of bounds`);
+    const vector = this.getColumnVector(index);
+    if (vector.kind === 'values') {
+      return vector.values.slice();
+    }
+
+    const type = this.columns[index].type;
+    const values: unknown[] = new Array(this._rowCount);
+    for (let row = 0; row < this._rowCount; row++) {
+      values[row] = decodeValue(vector, type, row);
+    }
+    return values;
+  }
+
+  /**
+   * Get a single value, converting only that value.
+   *
+   * @param row - The 0-based row index
+   * @param column - The 0-based column index
+   * @returns The value, or null for NULL
+   */
+  getValue(row: number, column: number): unknown {
+    if (row < 0 || row >= this._rowCount) {
+      throw new Error(`Row index ${row} out of bounds`);
     }
-    return this.rows.map((row) => row[index]);
+    return decodeValue(this.getColumnVector(column), this.columns[column].type, row);
   }
 
   /**
@@ -110,7 +214,7 @@ export class DataChunk {
     if (index < 0 || index >= this._rowCount) {
       throw new Error(`Row index ${index} out of bounds`);
     }
-    return this.rows[index];
+    return this.getRows()[index];
   }
 
   /**
@@ -134,7 +238,7 @@ export class DataChunk {
    * @returns Array of row objects with column names as keys
    */
   toArray<T = Record<string, unknown>>(): T[] {
-    return this.rows.map((row) => {
+    return this.getRows().map((row) => {
       const obj: Record<string, unknown> = {};
       for (let i = 0; i < this.columns.length; i++) {
         obj[this.columns[i].name] = row[i];
@@ -0,0 +1,182 @@
+/**
+ * Pipelined requests
+ *
+ * @packageDocumentation
+ */
+
+import { DuckDBError } from '../errors.js';
+import {
+  type ConnectionIdResponse,
+  type ErrorResponse,
+  type PipelineOperation,
+  type PipelineRef,
+  type PipelineResultResponse,
+  type QueryResultResponse,
+  type RowsChangedResponse,
+  WorkerRequestType,
+  WorkerResponseType,
+} from '../worker/protocol.js';
+import type { DuckDB } from './bindings.js';
+import { ColumnarResult } from './columnar-result.js';
+import { Connection } from './connection.js';
+
+/**
+ * An operation added to a {@link Pipeline}; pass it to {@link PipelineResults.get} for its
+ * result, or to later operations in place of a connection.
+ *
+ * @category Connection
+ */
+export interface PipelineStep<T> {
+  /** Position of the operation in the pipeline */
+  readonly index: number;
+  /** @internal */
+  readonly convert: (data: unknown) => T;
+}
+
+/**
+ * Results of a pipeline run.
+ *
+ * @category Connection
+ */
+export class PipelineResults {
+  private results: PipelineResultResponse['results'];
+
+  /**
+   * @internal
+   */
+  constructor(results: PipelineResultResponse['results']) {
+    this.results = results;
+  }
+
+  /**
+   * Get the result of a step.
+   *
+   * @throws DuckDBError if the step failed, or was skipped because an earlier step failed
+   */
+  get<T>(step: PipelineStep<T>): T {
+    const result = this.results[step.index];
+    if (result.type === WorkerResponseType.ERROR) {
+      const error = result.data as ErrorResponse;
+      throw new DuckDBError(error.message, error.code, error.query);
+    }
+    return step.convert(result.data);
+  }
+
+  /**
+   * Whether every step succeeded.
+   */
+  get ok(): boolean {
+    return this.results.every((result) => result.type !== WorkerResponseType.ERROR);
+  }
+}
+
+function toObjects<T>(data: unknown): T[] {
+  const { columns, chunks } = data as QueryResultResponse;
+  return new ColumnarResult<T>(columns, chunks).toArray();
+}
+
+/**
+ * A list of operations sent to the worker in one message.
+ *
+ * Each `await` on a connection method costs a round trip to the worker. A pipeline
+ * records operations instead and runs them in order with a single message, returning
+ * all results in one response. Later operations can use a connection opened earlier
+ * in the same pipeline. After the first failure, the remaining operations are skipped.
+ *
+ * @category Connection
+ * @example
+ * ```typescript
+ * const pipeline = db.pipeline();
+ * const conn = pipeline.connect();
+ * pipeline.execute(conn, "SET TimeZone = 'UTC'");
+ * pipeline.execute(conn, 'CREATE TABLE IF NOT EXISTS events (id INTEGER)');
+ * const counts = pipeline.query(conn, 'SELECT count(*) AS n FROM events');
+ *
+ * const results = await pipeline.run();
+ * const connection = results.get(conn);
+ * console.log(results.get(counts));
+ * ```
+ */
+export class Pipeline {
+  private db: DuckDB;
+  private operations: PipelineOperation[] = [];
+  private sent = false;
+
+  /**
+   * @internal
+   */
+  constructor(db: DuckDB) {
+    this.db = db;
+  }
+
+  private add<T>(
+    type: WorkerRequestType,
+    data: unknown,
+    convert: (data: unknown) => T,
+  ): PipelineStep<T> {
+    if (this.sent) {
+      throw new DuckDBError('Pipeline has already been run');
+    }
+    this.operations.push({ type, data });
+    return { index: this.operations.length - 1, convert };
+  }
+
+  private connectionId(connection: Connection | PipelineStep<Connection>): number | PipelineRef {
+    if (connection instanceof Connection) {
+      return connection.getConnectionId();
+    }
+    return { $ref: connection.index, field: 'connectionId' };
+  }
+
+  /**
+   * Open a connection.
+   */
+  connect(): PipelineStep<Connection> {
+    return this.add(
+      WorkerRequestType.CONNECT,
+      undefined,
+      (data) => new Connection(this.db, (data as ConnectionIdResponse).connectionId),
+    );
+  }
+
+  /**
+   * Execute a statement, resolving to the number of rows changed.
+   */
+  execute(connection: Connection | PipelineStep<Connection>, sql: string): PipelineStep<number> {
+    return this.add(
+      WorkerRequestType.EXECUTE,
+      { connectionId: this.connectionId(connection), sql },
+      (data) => (data as RowsChangedResponse).rowsChanged,
+    );
+  }
+
+  /**
+   * Run a query, resolving to its rows as objects.
+   */
+  query<T = Record<string, unknown>>(
+    connection: Connection | PipelineStep<Connection>,
+    sql: string,
+  ): PipelineStep<T[]> {
+    return this.add(
+      WorkerRequestType.QUERY,
+      { connectionId: this.connectionId(connection), sql },
+      (data) => toObjects<T>(data),
+    );
+  }
+
+  /**
+   * Send all operations to the worker and wait for their results.
+   *
+   * A pipeline can only be run once.
+   */
+  async run(): Promise<PipelineResults> {
+    if (this.sent) {
+      throw new DuckDBError('Pipeline has already been run');
+    }
+    this.sent = true;
+    const response = await this.db.postTask<PipelineResultResponse>(WorkerRequestType.PIPELINE, {
+      operations: this.operations,
+    });
+    return new PipelineResults(response.results);
+  }
+}
@@ -6,12 +6,149 @@
 
 import { DuckDBError } from '../errors.js';
 import {
+  type ColumnarParam,
+  type ColumnarParams,
+  type ColumnarParamValues,
+  DuckDBType,
+  type DuckDBTypeId,
+} from '../types.js';
+import {
+  type BatchParamColumn,
   type PreparedStatementBinding,
   type QueryResultResponse,
   type RowsChangedResponse,
   WorkerRequestType,
 } from '../worker/protocol.js';
 import type { DuckDB } from './bindings.js';
+import { ColumnarResult } from './columnar-result.js';
+
+const utf8Encoder = new TextEncoder();
+
+function typedArrayType(values: ArrayBufferView): DuckDBTypeId {
+  if (values instanceof Int8Array) return DuckDBType.TINYINT;
+  if (values instanceof Uint8Array) return DuckDBType.UTINYINT;
+  if (values instanceof Int16Array) return DuckDBType.SMALLINT;
+  if (values instanceof Uint16Array) return DuckDBType.USMALLINT;
+  if (values instanceof Int32Array) return DuckDBType.INTEGER;
+  if (values instanceof Uint32Array) return DuckDBType.UINTEGER;
+  if (values instanceof BigInt64Array) return DuckDBType.BIGINT;
+  if (values instanceof BigUint64Array) return DuckDBType.UBIGINT;
+  if (values instanceof Float32Array) return DuckDBType.FLOAT;
+  if (values instanceof Float64Array) return DuckDBType.DOUBLE;
+  throw new DuckDBError(`Unsupported parameter array: ${values.constructor.name}`);
+}
+
+/**
+ * Concatenate byte strings into one buffer with `length + 1` offsets.
+ */
+function packBytes(parts: (Uint8Array | null)[]): { data: Uint8Array; offsets: Uint32Array } {
+  const offsets = new Uint32Array(parts.length + 1);
+  for (let i = 0; i < parts.length; i++) {
+    offsets[i + 1] = offsets[i] + (parts[i]?.length ?? 0);
+  }
+  const data = new Uint8Array(offsets[parts.length]);
+  for (let i = 0; i < parts.length; i++) {
+    const part = parts[i];
+    if (part) {
+      data.set(part, offsets[i]);
+    }
+  }
+  return { data, offsets };
+}
+
+/**
+ * Convert a plain array column to typed arrays, deriving the type from its values.
+ */
+function encodeArrayColumn(values: readonly unknown[], parameter: number): BatchParamColumn {
+  const first = values.find((value) => value !== null && value !== undefined);
+  const checkType = (check: (value: unknown) => boolean, name: string) => {
+    for (const value of values) {
+      if (value !== null && value !== undefined && !check(value)) {
+        throw new DuckDBError(`Parameter ${parameter} mixes ${name} values with other types`);
+      }
+    }
+  };
+
+  let nulls: Uint8Array | undefined;
+  if (values.some((value) => value === null || value === undefined)) {
+    nulls = Uint8Array.from(values, (value) => (value === null || value === undefined ? 1 : 0));
+  }
+
+  if (typeof first === 'boolean') {
+    checkType((value) => typeof value === 'boolean', 'boolean');
+    return { type: DuckDBType.BOOLEAN, data: Uint8Array.from(values, (v) => (v ? 1 : 0)), nulls };
+  }
+  if (typeof first === 'number') {
+    checkType((value) => typeof value === 'number', 'number');
+    return {
+      type: DuckDBType.DOUBLE,
+      data: Float64Array.from(values, (v) => (v as number | null) ?? 0),
+      nulls,
+    };
+  }
+  if (typeof first === 'bigint') {
+    checkType((value) => typeof value === 'bigint', 'bigint');
+    return {
+      type: DuckDBType.BIGINT,
+      data: BigInt64Array.from(values, (v) => (v as bigint | null) ?? BigInt(0)),
+      nulls,
+    };
+  }
+  if (first instanceof Uint8Array) {
+    checkType((value) => value instanceof Uint8Array, 'Uint8Array');
+    return { type: DuckDBType.BLOB, ...packBytes(values as (Uint8Array | null)[]), nulls };
+  }
+
+  checkType((value) => typeof value === 'string', 'string');
+  const encoded = values.map((value) =>
+    typeof value === 'string' ? utf8Encoder.encode(value) : null,
+  );
+  return { type: DuckDBType.VARCHAR, ...packBytes(encoded), nulls };
+}
+
+/**
+ * Convert parameter columns to the layout the worker copies into WASM memory.
+ *
+ * Buffers created here are transferred to the worker. Typed arrays passed by the caller
+ * are structured-cloned instead, so they stay usable after the call.
+ */
+function encodeColumnarParams(params: ColumnarParams): {
+  rowCount: number;
+  columns: BatchParamColumn[];
+  transfer: Transferable[];
+} {
+  let rowCount = -1;
+  const transfer = new Set<ArrayBuffer>();
+  const columns = params.map((param, index) => {
+    const { values, nulls } =
+      ArrayBuffer.isView(param) || Array.isArray(param)
+        ? { values: param as ColumnarParamValues, nulls: undefined }
+        : (param as ColumnarParam);
+
+    if (rowCount === -1) {
+      rowCount = values.length;
+    } else if (values.length !== rowCount) {
+      throw new DuckDBError(
+        `Parameter ${index + 1} has ${values.length} rows, expected ${rowCount}`,
+      );
+    }
+    if (nulls && nulls.length < values.length) {
+      throw new DuckDBError(`Parameter ${index + 1} has fewer NULL flags than rows`);
+    }
+
+    if (ArrayBuffer.isView(values)) {
+      return { type: typedArrayType(values), data: values, nulls };
+    }
+    const column = encodeArrayColumn(values, index + 1);
+    for (const view of [column.data, column.offsets, column.nulls]) {
+      if (view && view.buffer instanceof ArrayBuffer) {
+        transfer.add(view.buffer);
+      }
+    }
+    return nulls ? { ...column, nulls } : column;
+  });
+  return { rowCount: Math.max(rowCount, 0), columns, transfer: [...transfer] };
+}
 
 /**
  * A prepared SQL statement with parameter binding.
@@ -245,15 +382,7 @@ export class PreparedStatement {
       bindings: this.bindings,
     });
 
-    // Convert row arrays to objects
-    const { columns, rows } = response;
-    return rows.map((row) => {
-      const obj: Record<string, unknown> = {};
-      for (let i = 0; i < columns.length; i++) {
-        obj[columns[i].name] = row[i];
-      }
-      return obj as T;
-    });
+    return new ColumnarResult<T>(response.columns, response.chunks).toArray();
   }
 
   /**
@@ -285,6 +414,44 @@ export class PreparedStatement {
     return response.rowsChanged;
   }
 
+  /**
+   * Execute the statement once per row of columnar parameters.
+   *
+   * The whole batch is sent to the worker in one message and bound and executed in a
+   * loop inside WASM, so inserting 100k rows costs one round trip instead of 100k.
+   * Outside an explicit transaction the batch runs in a transaction of its own, so
+   * either all rows are applied or none are. Bindings set with the bind methods are
+   * not used.
+   *
+   * @param params - One column of values per parameter, all with the same number of rows
+   * @returns The number of rows changed, summed over all executions
+   *
+   * @example
+   * ```typescript
+   * const stmt = await conn.prepare('INSERT INTO events VALUES (?, ?, ?)');
+   * const changed = await stmt.executeBatch([
+   *   new Int32Array([1, 2, 3]),
+   *   ['click', 'view', null],
+   *   new Float64Array([0.5, 1.25, 2]),
+   * ]);
+   * ```
+   */
+  async executeBatch(params: ColumnarParams): Promise<number> {
+    this.checkClosed();
+    const { rowCount, columns, transfer } = encodeColumnarParams(params);
+    const response = await this.db.postTask<RowsChangedResponse>(
+      WorkerRequestType.EXECUTE_BATCH,
+      {
+        connectionId: this.connectionId,
+        preparedStatementId: this.preparedStatementId,
+        rowCount,
+        columns,
+      },
+      transfer,
+    );
+    return response.rowsChanged;
+  }
+
   /**
    * Close the prepared statement and release resources.
    */
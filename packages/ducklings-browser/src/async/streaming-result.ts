@@ -112,7 +112,7 @@ export class AsyncStreamingResult implements AsyncIterable<DataChunk> {
       this.done = true;
     }
 
-    return new DataChunk(response.columns, response.rows, response.rowCount);
+    return new DataChunk(response.columns, response.vectors, response.rowCount);
   }
 
   /**
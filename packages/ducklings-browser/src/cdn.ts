@@ -23,6 +23,32 @@ export interface DuckDBBundle {
   wasmModule: string;
   /** URL to the Emscripten JS glue */
   wasmJs: string;
+  /** URL to the SIMD WASM binary (use when {@link isSimdSupported} returns true) */
+  wasmSimdModule: string;
+  /** URL to the Emscripten JS glue of the SIMD build */
+  wasmSimdJs: string;
+}
+
+// Minimal module using a v128 instruction (i8x16.splat + i8x16.popcnt)
+const SIMD_PROBE = new Uint8Array([
+  0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253, 15,
+  253, 98, 11,
+]);
+
+/**
+ * Check whether the runtime supports WebAssembly SIMD (simd128).
+ *
+ * {@link init} uses this to decide whether to load the SIMD build.
+ *
+ * @category CDN
+ * @returns True if a module using simd128 instructions validates
+ */
+export function isSimdSupported(): boolean {
+  try {
+    return typeof WebAssembly !== 'undefined' && WebAssembly.validate(SIMD_PROBE);
+  } catch {
+    return false;
+  }
 }
 
 /**
@@ -43,6 +69,8 @@ export interface DuckDBBundle {
  *   worker,
  *   wasmUrl: bundle.wasmModule,
  *   wasmJsUrl: bundle.wasmJs,
+ *   wasmSimdUrl: bundle.wasmSimdModule,
+ *   wasmSimdJsUrl: bundle.wasmSimdJs,
  * });
  * ```
  */
@@ -55,6 +83,8 @@ export function getJsDelivrBundle(version?: string): DuckDBBundle {
     mainWorker: `${base}worker.js`,
     wasmModule: `${base}wasm/duckdb.wasm`,
     wasmJs: `${base}wasm/duckdb.js`,
+    wasmSimdModule: `${base}wasm/duckdb-simd.wasm`,
+    wasmSimdJs: `${base}wasm/duckdb-simd.js`,
   };
 }
 
@@ -74,6 +104,8 @@ export function getUnpkgBundle(version?: string): DuckDBBundle {
     mainWorker: `${base}worker.js`,
     wasmModule: `${base}wasm/duckdb.wasm`,
     wasmJs: `${base}wasm/duckdb.js`,
+    wasmSimdModule: `${base}wasm/duckdb-simd.wasm`,
+    wasmSimdJs: `${base}wasm/duckdb-simd.js`,
   };
 }
 
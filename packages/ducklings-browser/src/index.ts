@@ -62,26 +62,54 @@
 // Re-export flechette types for convenience
 export type { Table } from '@uwdata/flechette';
 // Main API
+export { ArrowIPCIngest } from './async/arrow-ingest.js';
+export { ArrowIPCStream } from './async/arrow-stream.js';
 export { DuckDB, getDB, init, version } from './async/bindings.js';
+export { ColumnarResult } from './async/columnar-result.js';
 export { Connection } from './async/connection.js';
 export { DataChunk } from './async/data-chunk.js';
+export { Pipeline, PipelineResults, type PipelineStep } from './async/pipeline.js';
 export { PreparedStatement } from './async/prepared-statement.js';
 export { AsyncStreamingResult as StreamingResult } from './async/streaming-result.js';
 // CDN utilities
-export { createWorker, type DuckDBBundle, getJsDelivrBundle, getUnpkgBundle } from './cdn.js';
+export {
+  createWorker,
+  type DuckDBBundle,
+  getJsDelivrBundle,
+  getUnpkgBundle,
+  isSimdSupported,
+} from './cdn.js';
 // Errors
 export { DuckDBError } from './errors.js';
 // Types
 export {
   AccessMode,
+  type ArrowIPCInsertOptions,
+  type ArrowStreamOptions,
+  type ColumnarParam,
+  type ColumnarParams,
+  type ColumnarParamValues,
   type ColumnInfo,
+  type ColumnVector,
   type CSVInsertOptions,
   type DuckDBConfig,
   DuckDBType,
   type DuckDBTypeId,
   type FileInfo,
+  type FixedColumnVector,
+  type HTTPProfile,
+  type HTTPURLProfile,
   type InitOptions,
   type JSONInsertOptions,
+  type LogLevel,
+  type MemoryOptions,
+  type ProfiledRows,
+  type QueryOptions,
+  type QueryProfile,
+  type QueryProgress,
+  type QueryRowsOptions,
+  type StringColumnVector,
+  type ValueColumnVector,
 } from './types.js';
 // Version info
 export { PACKAGE_NAME, PACKAGE_VERSION } from './version.js';
@@ -96,6 +96,27 @@ export interface DuckDBConfig {
    * @see https://duckdb.org/docs/configuration/overview
    */
   customConfig?: Record<string, string>;
+
+  /**
+   * Database file path.
+   * Use an `opfs://` path (e.g. `opfs://app.duckdb`) to persist the database in the
+   * Origin Private File System; reads and writes go through OPFS sync access handles.
+   * @default ':memory:'
+   */
+  path?: string;
+
+  /**
+   * Directory DuckDB spills to when operators exceed the memory limit.
+   * Use an `opfs://` path (e.g. `opfs://tmp`) to spill to the Origin Private File System.
+   */
+  tempDirectory?: string;
+
+  /**
+   * Number of spare OPFS files opened for files DuckDB creates on its own, such as
+   * spill files. Only used with an `opfs://` path or temp directory.
+   * @default 8
+   */
+  opfsTempFiles?: number;
 }
 
 /**
@@ -111,6 +132,60 @@ export interface ColumnInfo {
   alias?: string;
 }
 
+/**
+ * Columnar view of a fixed-width column, copied from the DuckDB vector's data buffer.
+ *
+ * BOOLEAN columns use a Uint8Array (0 or 1); 64-bit integers use BigInt64Array / BigUint64Array.
+ * @category Types
+ */
+export interface FixedColumnVector {
+  kind: 'fixed';
+  /** Raw values, one per row (entries for NULL rows are undefined garbage) */
+  data:
+    | Int8Array
+    | Uint8Array
+    | Int16Array
+    | Uint16Array
+    | Int32Array
+    | Uint32Array
+    | BigInt64Array
+    | BigUint64Array
+    | Float32Array
+    | Float64Array;
+  /** DuckDB validity bitmask (bit `i` set means row `i` is valid), or null if all rows are valid */
+  validity: Uint8Array | null;
+}
+
+/**
+ * Columnar view of a VARCHAR column as UTF-8 bytes plus row offsets.
+ * @category Types
+ */
+export interface StringColumnVector {
+  kind: 'string';
+  /** Row `i` spans `bytes[offsets[i]]` to `bytes[offsets[i + 1]]` */
+  offsets: Int32Array;
+  /** Concatenated UTF-8 bytes of all rows */
+  bytes: Uint8Array;
+  /** DuckDB validity bitmask (bit `i` set means row `i` is valid), or null if all rows are valid */
+  validity: Uint8Array | null;
+}
+
+/**
+ * Column of already-converted values, used for types without a columnar mapping.
+ * @category Types
+ */
+export interface ValueColumnVector {
+  kind: 'values';
+  /** One value per row (null for NULL) */
+  values: unknown[];
+}
+
+/**
+ * Column data of a streamed DataChunk.
+ * @category Types
+ */
+export type ColumnVector = FixedColumnVector | StringColumnVector | ValueColumnVector;
+
 /**
  * Options for initializing the DuckDB WASM module.
  * @category Types
@@ -128,6 +203,47 @@ export interface InitOptions {
    */
   wasmJsUrl?: string;
 
+  /**
+   * Whether to load the multithreaded build (duckdb-mt.wasm).
+   * Defaults to true when the page is cross-origin isolated (`crossOriginIsolated`),
+   * which is required for SharedArrayBuffer. Falls back to the single-threaded
+   * build if the multithreaded one fails to load. When `wasmUrl`/`wasmJsUrl` are
+   * overridden, the multithreaded build is only used if its URLs are given too.
+   */
+  threads?: boolean;
+
+  /**
+   * URL to the multithreaded WASM file.
+   * If not provided, uses the default bundled location.
+   */
+  wasmThreadsUrl?: string;
+
+  /**
+   * URL to the multithreaded Emscripten JS file (duckdb-mt.js).
+   * If not provided, uses the default bundled location.
+   */
+  wasmThreadsJsUrl?: string;
+  /**
+   * Whether to load the SIMD build (duckdb-simd.wasm).
+   * Defaults to true when the runtime validates WebAssembly SIMD
+   * (see {@link isSimdSupported}). Used when the multithreaded build is not,
+   * and falls back to the baseline build if it fails to load. Like `threads`,
+   * it is only used with overridden `wasmUrl`/`wasmJsUrl` if its URLs are given too.
+   */
+  simd?: boolean;
+
+  /**
+   * URL to the SIMD WASM file.
+   * If not provided, uses the default bundled location.
+   */
+  wasmSimdUrl?: string;
+
+  /**
+   * URL to the SIMD Emscripten JS file (duckdb-simd.js).
+   * If not provided, uses the default bundled location.
+   */
+  wasmSimdJsUrl?: string;
+
   /**
    * URL to the worker script (for browser environments).
    * If not provided, uses the default bundled worker location.
@@ -149,6 +265,30 @@ export interface InitOptions {
    */
   worker?: Worker;
 
+  /**
+   * Host the database in a SharedWorker, so every page of the origin that passes this
+   * option uses one engine: a single WASM heap, one set of registered files and one
+   * HTTP block cache. `true` starts the bundled shared-worker.js (which, unlike the
+   * dedicated worker, must be served from the page's origin); a SharedWorker instance
+   * created from it can be passed instead. Takes precedence over `worker`.
+   *
+   * The first page to call `init()` loads and opens the database with its options;
+   * later pages get that database as it is. Each page can only use the connections it
+   * opened, and its queries take turns with those of the other pages. `db.close()`
+   * releases the page's connections while the database stays open for the others.
+   * Queries cannot be interrupted mid-run, as SharedArrayBuffer cannot be shared with
+   * a SharedWorker; cancelling only rejects the promise. OPFS cannot be used either:
+   * its sync access handles only exist in dedicated workers, so `opfs://` paths and
+   * `registerOPFSFile()` are rejected.
+   *
+   * @example
+   * ```typescript
+   * await init({ sharedWorker: true });
+   * const db = new DuckDB();
+   * ```
+   */
+  sharedWorker?: boolean | SharedWorker;
+
   /**
    * Pre-compiled WebAssembly.Module (for Cloudflare Workers).
    * In Workers, import the WASM file directly and pass it here.
@@ -167,8 +307,60 @@ export interface InitOptions {
    * Controls access mode, security settings, and custom configuration.
    */
   config?: DuckDBConfig;
+
+  /**
+   * Memory snapshot from {@link DuckDB.createSnapshot} to restore instead of opening a
+   * new database. The database comes back with the tables, settings and extensions it
+   * had when the snapshot was taken, so `config` cannot be passed as well. Only the
+   * build the snapshot was taken with is loaded.
+   */
+  snapshot?: Uint8Array | ArrayBuffer;
+
+  /**
+   * How much the library writes to the console (default: `'warn'`).
+   * `'debug'` also traces every HTTP request and response.
+   */
+  logLevel?: LogLevel;
+
+  /**
+   * Run the HTTP range reads of a query as concurrent `fetch()` calls in a helper worker
+   * (default: `true`). The DuckDB worker waits for them with `Atomics.wait`, so this
+   * needs a cross-origin isolated page; elsewhere reads use synchronous XMLHttpRequest,
+   * one at a time.
+   */
+  fetchWorker?: boolean;
+
+  /**
+   * Initial and maximum size of the WebAssembly memory. DuckDB's `memory_limit` defaults
+   * to 75% of the maximum, so large queries spill or fail with an out-of-memory error
+   * before the heap runs out; set `memory_limit` in `config.customConfig` to override it.
+   */
+  memory?: MemoryOptions;
 }
 
+/**
+ * Size of the WebAssembly memory, in bytes.
+ *
+ * @category Types
+ * @example
+ * ```typescript
+ * // Reserve 512 MB up front to avoid growing the heap step by step, and stop at 2 GB
+ * await init({ memory: { initial: 512 * 1024 ** 2, maximum: 2 * 1024 ** 3 } });
+ * ```
+ */
+export interface MemoryOptions {
+  /** Memory allocated at startup; at least 16 MB (default: 16 MB) */
+  initial?: number;
+  /** Largest size the memory may grow to; at most 4 GB (default: 4 GB) */
+  maximum?: number;
+}
+
+/**
+ * Console output levels, from none to every HTTP request.
+ * @category Types
+ */
+export type LogLevel = 'silent' | 'error' | 'warn' | 'debug';
+
 /**
  * Emscripten module interface for DuckDB WASM.
  * @internal
@@ -188,7 +380,7 @@ export interface EmscriptenModule {
   ) => (...args: unknown[]) => unknown;
   getValue: (ptr: number, type: string) => number;
   setValue: (ptr: number, value: number, type: string) => void;
-  UTF8ToString: (ptr: number) => string;
+  UTF8ToString: (ptr: number, maxBytesToRead?: number) => string;
   stringToUTF8: (str: string, outPtr: number, maxBytesToWrite: number) => void;
   lengthBytesUTF8: (str: string) => number;
   _malloc: (size: number) => number;
@@ -217,6 +409,109 @@ export interface FileInfo {
   size: number;
 }
 
+/**
+ * Progress of a running query, as estimated by DuckDB.
+ * @category Types
+ */
+export interface QueryProgress {
+  /** Estimated completion in percent (0-100), or -1 when DuckDB cannot estimate it */
+  percentage: number;
+  /** Rows processed so far */
+  rowsProcessed: number;
+  /** Estimated number of rows to process */
+  totalRows: number;
+}
+
+/**
+ * Options for cancelling a query and following its progress.
+ * @category Types
+ */
+export interface QueryOptions {
+  /** Cancels the query when aborted */
+  signal?: AbortSignal;
+  /** Called while the query runs, at most every {@link QueryOptions.progressInterval} ms */
+  onProgress?: (progress: QueryProgress) => void;
+  /** Minimum time between progress callbacks in milliseconds (default: 100) */
+  progressInterval?: number;
+}
+
+/**
+ * Options of {@link Connection.query}.
+ * @category Types
+ */
+export interface QueryRowsOptions extends QueryOptions {
+  /** Collect a {@link QueryProfile} and attach it to the rows as `profile` */
+  profile?: boolean;
+}
+
+/**
+ * HTTP traffic to one URL during a profiled query.
+ * @category Types
+ */
+export interface HTTPURLProfile {
+  url: string;
+  /** Requests sent, including HEAD requests */
+  requests: number;
+  /** HEAD requests sent */
+  headRequests: number;
+  /** Requests that failed or returned an error status */
+  errors: number;
+  /** Response body bytes received */
+  bytesReceived: number;
+  /** Request body bytes sent */
+  bytesSent: number;
+  /** Range reads answered from the HTTP block cache */
+  rangeCacheHits: number;
+  /** HEAD requests answered from the metadata cache */
+  metadataCacheHits: number;
+  /** Summed latency of all requests in milliseconds */
+  totalLatencyMs: number;
+  /** Requests per latency bucket; see {@link HTTPProfile.latencyBoundsMs} */
+  latencyHistogram: number[];
+}
+
+/**
+ * HTTP traffic during a profiled query.
+ * @category Types
+ */
+export interface HTTPProfile {
+  /**
+   * Upper bounds of the latency buckets in milliseconds. Bucket `i` counts requests up to
+   * `latencyBoundsMs[i]`; the last bucket counts the slower ones.
+   */
+  latencyBoundsMs: number[];
+  /** Traffic per URL, in no particular order */
+  urls: HTTPURLProfile[];
+}
+
+/**
+ * Where a query spent its time.
+ *
+ * HTTP counters are process-wide: queries profiled at the same time share them.
+ * Latencies are measured around each request and include the time the module waited
+ * for the response to be handed back.
+ * @category Types
+ */
+export interface QueryProfile {
+  /** Wall time of the query, including HTTP waits, in milliseconds */
+  totalTimeMs: number;
+  /** Time spent waiting on HTTP requests (overlapping requests are summed) */
+  httpTimeMs: number;
+  /**
+   * DuckDB's profiler tree (operators with timings and cardinalities), or null when the
+   * statement produced none
+   */
+  execution: Record<string, unknown> | null;
+  /** HTTP counters per URL */
+  http: HTTPProfile;
+}
+
+/**
+ * Rows returned by `query()` with `profile: true`.
+ * @category Types
+ */
+export type ProfiledRows<T> = T[] & { profile: QueryProfile };
+
 /**
  * Options for CSV insertion.
  * @category Types
@@ -236,6 +531,27 @@ export interface CSVInsertOptions {
   columns?: string[];
 }
 
+/**
+ * Options for Arrow IPC insertion.
+ * @category Types
+ */
+export interface ArrowIPCInsertOptions {
+  /** Append to an existing table instead of creating it */
+  append?: boolean;
+}
+
+/**
+ * Options for `queryArrowStream()`.
+ * @category Types
+ */
+export interface ArrowStreamOptions {
+  /**
+   * Rows to encode into each part of the stream (default: one DuckDB chunk, 2048 rows).
+   * Larger parts need fewer round trips and hold more memory.
+   */
+  batchRows?: number;
+}
+
 /**
  * Options for JSON insertion.
  * @category Types
@@ -246,3 +562,47 @@ export interface JSONInsertOptions {
   /** Column names */
   columns?: string[];
 }
+
+/**
+ * Values of one parameter for {@link PreparedStatement.executeBatch}, one entry per row.
+ *
+ * Typed arrays bind as the matching DuckDB type (Int32Array as INTEGER, Float64Array as
+ * DOUBLE, BigInt64Array as BIGINT, Uint8Array as UTINYINT, ...). Plain arrays bind by
+ * element type: strings as VARCHAR, booleans as BOOLEAN, numbers as DOUBLE, bigints as
+ * BIGINT and Uint8Arrays as BLOB, with `null` entries binding NULL.
+ * @category Types
+ */
+export type ColumnarParamValues =
+  | Int8Array
+  | Uint8Array
+  | Int16Array
+  | Uint16Array
+  | Int32Array
+  | Uint32Array
+  | BigInt64Array
+  | BigUint64Array
+  | Float32Array
+  | Float64Array
+  | readonly (string | null)[]
+  | readonly (boolean | null)[]
+  | readonly (number | null)[]
+  | readonly (bigint | null)[]
+  | readonly (Uint8Array | null)[];
+
+/**
+ * A typed array parameter column with NULLs.
+ * @category Types
+ */
+export interface ColumnarParam {
+  /** Values, one per row (entries for NULL rows are ignored) */
+  values: ColumnarParamValues;
+  /** One byte per row, non-zero for NULL */
+  nulls: Uint8Array;
+}
+
+/**
+ * Parameter columns for {@link PreparedStatement.executeBatch}, in parameter order.
+ * All columns must have the same number of rows.
+ * @category Types
+ */
+export type ColumnarParams = readonly (ColumnarParamValues | ColumnarParam)[];
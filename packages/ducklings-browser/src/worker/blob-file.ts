@@ -0,0 +1,40 @@
+/**
+ * Blob-backed files for the worker's JS-backed file system
+ *
+ * A registered `File` or `Blob` stays outside the WASM heap: every read DuckDB makes
+ * slices exactly the requested byte range and reads it with FileReaderSync, so memory
+ * use follows the columns and row groups a query touches rather than the file size.
+ *
+ * @packageDocumentation
+ */
+
+import type { JSFile } from './opfs.js';
+
+// Only typed in the webworker lib
+declare const FileReaderSync: {
+  new (): { readAsArrayBuffer(blob: Blob): ArrayBuffer };
+};
+
+/**
+ * Wrap a Blob as a read-only JS file.
+ *
+ * FileReaderSync is only available in dedicated workers, which is where the
+ * dispatcher runs.
+ */
+export function blobFile(blob: Blob): JSFile {
+  const reader = new FileReaderSync();
+  return {
+    read(buffer, options) {
+      const at = options?.at ?? 0;
+      const end = Math.min(at + buffer.length, blob.size);
+      if (end <= at) {
+        return 0;
+      }
+      const bytes = new Uint8Array(reader.readAsArrayBuffer(blob.slice(at, end)));
+      buffer.set(bytes);
+      return bytes.length;
+    },
+    getSize: () => blob.size,
+    close: () => {},
+  };
+}
@@ -5,29 +5,35 @@
  * @packageDocumentation
  */
 
-import {
-  bool,
-  type DataType,
-  dateDay,
-  float32,
-  float64,
-  int8,
-  int16,
-  int32,
-  int64,
-  TimeUnit,
-  tableFromArrays,
-  tableToIPC,
-  timestamp,
-  uint8,
-  uint16,
-  uint32,
-  uint64,
-  utf8,
-} from '@uwdata/flechette';
-import type { ColumnInfo, DuckDBTypeId, EmscriptenModule } from '../types.js';
+import type {
+  ColumnInfo,
+  ColumnVector,
+  DuckDBTypeId,
+  EmscriptenModule,
+  FixedColumnVector,
+  HTTPProfile,
+  LogLevel,
+  MemoryOptions,
+  QueryProfile,
+} from '../types.js';
 import { AccessMode, DuckDBType } from '../types.js';
+import { blobFile } from './blob-file.js';
+import { startFetchHelper } from './fetch-helper.js';
+import {
+  DEFAULT_OPFS_TEMP_FILES,
+  isOPFSPath,
+  type JSFileRegistry,
+  OPFSTempPool,
+  OPFS_PREFIX,
+  openOPFSFile,
+} from './opfs.js';
 import {
+  type ArrowIngestCloseRequest,
+  type ArrowIngestFinishRequest,
+  type ArrowIngestOpenRequest,
+  type ArrowIngestPushRequest,
+  type ArrowStreamIdResponse,
+  type CloseArrowStreamRequest,
   type ClosePreparedRequest,
   type CloseStreamingResultRequest,
   type CopyFileToBufferRequest,
@@ -36,8 +42,10 @@ import {
   type DisconnectRequest,
   type DropFileRequest,
   type ErrorResponse,
+  type ExecuteBatchRequest,
   type ExecutePreparedRequest,
   type ExecuteRequest,
+  type FetchArrowBatchRequest,
   type FetchChunkRequest,
   type GlobFilesRequest,
   type InsertArrowFromIPCRequest,
@@ -45,16 +53,27 @@ import {
   type InsertJSONFromPathRequest,
   type InstantiateRequest,
   type OpenRequest,
+  type PipelineOperationResult,
+  type PipelineRef,
+  type PipelineRequest,
+  type PipelineResultResponse,
   type PreparedStatementBinding,
   type PrepareRequest,
   type QueryArrowRequest,
+  type QueryArrowStreamRequest,
+  type QueryControl,
+  type QueryProgressResponse,
   type QueryRequest,
   type QueryResultResponse,
   type QueryStreamingRequest,
   type RegisterFileBufferRequest,
+  type RegisterFileHandleRequest,
   type RegisterFileTextRequest,
   type RegisterFileURLRequest,
+  type RegisterOPFSFileRequest,
+  type ResultChunk,
   type RunPreparedRequest,
+  type SnapshotResponse,
   type StreamingResultInfoResponse,
   type TransactionRequest,
   type WorkerRequest,
@@ -62,6 +81,7 @@ import {
   type WorkerResponse,
   WorkerResponseType,
 } from './protocol.js';
+import { captureSnapshot, restoreSnapshot } from './snapshot.js';
 
 /**
  * Stored prepared statement info.
@@ -72,16 +92,131 @@ interface PreparedStatementInfo {
   sql: string;
 }
 
+/**
+ * Response of a request run inside a pipeline or without reply.
+ */
+interface CapturedResponse {
+  type: WorkerResponseType;
+  data: unknown;
+  transfer?: Transferable[];
+}
+
 /**
  * Stored streaming result info.
  */
 interface StreamingResultInfo {
   resultPtr: number;
+  /** Prepared statement backing a streaming result (0 for materialized fallbacks) */
+  stmtPtr: number;
   connectionId: number;
   columns: ColumnInfo[];
-  currentChunk: number;
+  /** Chunks pulled ahead of time when another query needed the connection */
+  bufferedChunks: number[];
+  /** No more chunks can be fetched from the result itself */
+  exhausted: boolean;
+}
+
+/**
+ * Stored Arrow IPC ingest info.
+ */
+interface ArrowIngestInfo {
+  ingestPtr: number;
+  connectionId: number;
+}
+
+/**
+ * Sends a response to the client the dispatcher serves.
+ */
+export type ResponseSink = (response: WorkerResponse, transfer?: Transferable[]) => void;
+
+/**
+ * Stored Arrow IPC stream info.
+ */
+interface ArrowStreamInfo {
+  streamPtr: number;
+  connectionId: number;
+  /** Rows to encode into each batch response (0: one DuckDB chunk) */
+  batchRows: number;
+  /** Rest of the stream, encoded ahead of time when another query needed the connection */
+  buffered: Uint8Array | null;
+}
+
+/**
+ * Constructor shape shared by the fixed-width typed arrays.
+ */
+interface FixedWidthArrayConstructor {
+  new (buffer: ArrayBuffer): FixedColumnVector['data'];
+  readonly BYTES_PER_ELEMENT: number;
+}
+
+/**
+ * Typed array used to copy each fixed-width DuckDB vector type.
+ */
+const FIXED_WIDTH_ARRAYS: Partial<Record<DuckDBTypeId, FixedWidthArrayConstructor>> = {
+  [DuckDBType.BOOLEAN]: Uint8Array,
+  [DuckDBType.TINYINT]: Int8Array,
+  [DuckDBType.SMALLINT]: Int16Array,
+  [DuckDBType.INTEGER]: Int32Array,
+  [DuckDBType.BIGINT]: BigInt64Array,
+  [DuckDBType.UTINYINT]: Uint8Array,
+  [DuckDBType.USMALLINT]: Uint16Array,
+  [DuckDBType.UINTEGER]: Uint32Array,
+  [DuckDBType.UBIGINT]: BigUint64Array,
+  [DuckDBType.FLOAT]: Float32Array,
+  [DuckDBType.DOUBLE]: Float64Array,
+};
+
+/** Module['logLevel'] values read by DucklingsLog (src/http/http_async.js) */
+const LOG_LEVELS: Record<LogLevel, number> = { silent: 0, error: 1, warn: 2, debug: 3 };
+
+/** Memory ceiling of the browser builds (MAXIMUM_MEMORY in scripts/build-duckdb.sh) */
+const MAX_MEMORY = 4 * 1024 ** 3;
+/** Smallest memory the builds instantiate with (Emscripten's default INITIAL_MEMORY) */
+const MIN_MEMORY = 16 * 1024 ** 2;
+const WASM_PAGE_SIZE = 65536;
+
+/**
+ * Share of the memory ceiling given to DuckDB as memory_limit, so its buffer manager
+ * evicts and spills before the heap runs out. The rest is left for what it does not
+ * track: the stack, allocator overhead and results being copied out of WASM memory.
+ */
+const MEMORY_LIMIT_SHARE = 0.75;
+
+/**
+ * Create the module's memory with the requested initial and maximum size.
+ */
+function createMemory(options: MemoryOptions | undefined, shared: boolean): WebAssembly.Memory {
+  const initial = options?.initial ?? MIN_MEMORY;
+  const maximum = options?.maximum ?? MAX_MEMORY;
+  if (maximum > MAX_MEMORY) {
+    throw new Error(`Maximum memory cannot exceed ${MAX_MEMORY / 1024 ** 2} MB`);
+  }
+  if (initial < MIN_MEMORY || initial > maximum) {
+    throw new Error(
+      `Initial memory must be between ${MIN_MEMORY / 1024 ** 2} MB and the maximum memory`,
+    );
+  }
+  return new WebAssembly.Memory({
+    initial: Math.ceil(initial / WASM_PAGE_SIZE),
+    maximum: Math.floor(maximum / WASM_PAGE_SIZE),
+    shared,
+  });
+}
+
+/**
+ * The memory_limit setting for a memory ceiling, in MiB.
+ */
+function memoryLimit(ceiling: number): string {
+  return `${Math.floor((ceiling * MEMORY_LIMIT_SHARE) / 1024 ** 2)}MiB`;
 }
 
+/** min_rows for duckdb_wasm_arrow_ipc_stream_next that encodes the whole rest (SIZE_MAX) */
+const ARROW_STREAM_REST = 0xffffffff;
+
+/** duckdb_pending_state values of a query that still has tasks to run */
+const PENDING_RESULT_NOT_READY = 1;
+const PENDING_NO_TASKS_AVAILABLE = 3;
+
 /**
  * DuckDB Worker Dispatcher.
  *
@@ -89,15 +224,42 @@ interface StreamingResultInfo {
  * and sends responses back.
  */
 export class DuckDBDispatcher {
+  private post: ResponseSink;
   private module: EmscriptenModule | null = null;
   private dbPtr: number = 0;
   private connections: Map<number, number> = new Map();
   private preparedStatements: Map<number, PreparedStatementInfo> = new Map();
   private streamingResults: Map<number, StreamingResultInfo> = new Map();
+  /** Live (still fetching from the pipeline) streaming result per connection */
+  private activeStreams: Map<number, number> = new Map();
+  /** Incremental Arrow IPC ingest handles by ingest id */
+  private arrowIngests: Map<number, ArrowIngestInfo> = new Map();
+  private arrowStreams: Map<number, ArrowStreamInfo> = new Map();
+  /** Live (still reading from the query) Arrow IPC stream per connection */
+  private activeArrowStreams: Map<number, number> = new Map();
+  /** Responses of requests run by dispatchCaptured, by request id (null until posted) */
+  private capturedResponses: Map<number, CapturedResponse | null> = new Map();
+  private nextInternalRequestId = -1;
+  /** Build the module was loaded from, recorded in snapshots */
+  private variant = 'baseline';
+  /** Largest size the module's memory can grow to */
+  private memoryCeiling = MAX_MEMORY;
+  /** Spare OPFS handles for files DuckDB creates under opfs:// paths */
+  private opfsTempPool: OPFSTempPool | null = null;
 
   private nextConnectionId = 1;
   private nextPreparedStatementId = 1;
   private nextStreamingResultId = 1;
+  private nextArrowIngestId = 1;
+  private nextArrowStreamId = 1;
+
+  /**
+   * @param post - Where responses go; defaults to the worker's own `postMessage`
+   */
+  constructor(post?: ResponseSink) {
+    this.post =
+      post ?? ((response, transfer) => self.postMessage(response, transfer ? { transfer } : {}));
+  }
 
   /**
    * Handle an incoming message from the main thread.
@@ -106,6 +268,22 @@ export class DuckDBDispatcher {
     const request = event.data as WorkerRequest;
     const { messageId, type, data } = request;
 
+    if (request.noReply) {
+      // Post-and-forget: only a failure is reported back
+      const response = await this.dispatchCaptured(messageId, type, data);
+      if (response.type === WorkerResponseType.ERROR) {
+        this.postResponse(messageId, WorkerResponseType.ERROR, response.data);
+      }
+      return;
+    }
+
+    await this.dispatch(messageId, type, data);
+  }
+
+  /**
+   * Run a request, posting its response (or an ERROR) under messageId.
+   */
+  private async dispatch(messageId: number, type: WorkerRequestType, data: unknown): Promise<void> {
     try {
       switch (type) {
         case WorkerRequestType.PING:
@@ -121,13 +299,17 @@ export class DuckDBDispatcher {
           break;
 
         case WorkerRequestType.OPEN:
-          this.handleOpen(messageId, data as OpenRequest);
+          await this.handleOpen(messageId, data as OpenRequest);
           break;
 
         case WorkerRequestType.CLOSE:
           this.handleClose(messageId);
           break;
 
+        case WorkerRequestType.CREATE_SNAPSHOT:
+          this.handleCreateSnapshot(messageId);
+          break;
+
         case WorkerRequestType.CONNECT:
           this.handleConnect(messageId);
           break;
@@ -160,6 +342,18 @@ export class DuckDBDispatcher {
           this.handleCloseStreamingResult(messageId, data as CloseStreamingResultRequest);
           break;
 
+        case WorkerRequestType.QUERY_ARROW_STREAM:
+          this.handleQueryArrowStream(messageId, data as QueryArrowStreamRequest);
+          break;
+
+        case WorkerRequestType.FETCH_ARROW_BATCH:
+          this.handleFetchArrowBatch(messageId, data as FetchArrowBatchRequest);
+          break;
+
+        case WorkerRequestType.CLOSE_ARROW_STREAM:
+          this.handleCloseArrowStream(messageId, data as CloseArrowStreamRequest);
+          break;
+
         case WorkerRequestType.PREPARE:
           this.handlePrepare(messageId, data as PrepareRequest);
           break;
@@ -172,6 +366,10 @@ export class DuckDBDispatcher {
           this.handleExecutePrepared(messageId, data as ExecutePreparedRequest);
           break;
 
+        case WorkerRequestType.EXECUTE_BATCH:
+          this.handleExecuteBatch(messageId, data as ExecuteBatchRequest);
+          break;
+
         case WorkerRequestType.CLOSE_PREPARED:
           this.handleClosePrepared(messageId, data as ClosePreparedRequest);
           break;
@@ -200,6 +398,14 @@ export class DuckDBDispatcher {
           this.handleRegisterFileText(messageId, data as RegisterFileTextRequest);
           break;
 
+        case WorkerRequestType.REGISTER_FILE_HANDLE:
+          await this.handleRegisterFileHandle(messageId, data as RegisterFileHandleRequest);
+          break;
+
+        case WorkerRequestType.REGISTER_OPFS_FILE:
+          await this.handleRegisterOPFSFile(messageId, data as RegisterOPFSFileRequest);
+          break;
+
         case WorkerRequestType.DROP_FILE:
           this.handleDropFile(messageId, data as DropFileRequest);
           break;
@@ -236,6 +442,26 @@ export class DuckDBDispatcher {
           this.handleInsertJSONFromPath(messageId, data as InsertJSONFromPathRequest);
           break;
 
+        case WorkerRequestType.ARROW_INGEST_OPEN:
+          this.handleArrowIngestOpen(messageId, data as ArrowIngestOpenRequest);
+          break;
+
+        case WorkerRequestType.ARROW_INGEST_PUSH:
+          this.handleArrowIngestPush(messageId, data as ArrowIngestPushRequest);
+          break;
+
+        case WorkerRequestType.ARROW_INGEST_FINISH:
+          this.handleArrowIngestFinish(messageId, data as ArrowIngestFinishRequest);
+          break;
+
+        case WorkerRequestType.ARROW_INGEST_CLOSE:
+          this.handleArrowIngestClose(messageId, data as ArrowIngestCloseRequest);
+          break;
+
+        case WorkerRequestType.PIPELINE:
+          await this.handlePipeline(messageId, data as PipelineRequest);
+          break;
+
         default:
           this.postError(messageId, `Unknown request type: ${type}`);
       }
@@ -255,17 +481,21 @@ export class DuckDBDispatcher {
     data: unknown,
     transfer?: Transferable[],
   ): void {
+    if (this.capturedResponses.has(requestId)) {
+      // Keep the first response of a request run by dispatchCaptured
+      if (!this.capturedResponses.get(requestId)) {
+        this.capturedResponses.set(requestId, { type, data, transfer });
+      }
+      return;
+    }
+
     const response: WorkerResponse<T> = {
       messageId: requestId, // Use requestId as messageId for simple correlation
       requestId,
       type,
       data,
     };
-    if (transfer && transfer.length > 0) {
-      self.postMessage(response, { transfer });
-    } else {
-      self.postMessage(response);
-    }
+    this.post(response, transfer && transfer.length > 0 ? transfer : undefined);
   }
 
   private postError(requestId: number, message: string, code?: string, query?: string): void {
@@ -277,6 +507,101 @@ export class DuckDBDispatcher {
     this.postResponse(requestId, WorkerResponseType.OK, undefined);
   }
 
+  /**
+   * Run a request and return its response instead of posting it.
+   */
+  private async dispatchCaptured(
+    requestId: number,
+    type: WorkerRequestType,
+    data: unknown,
+  ): Promise<CapturedResponse> {
+    this.capturedResponses.set(requestId, null);
+    try {
+      await this.dispatch(requestId, type, data);
+      return (
+        this.capturedResponses.get(requestId) ?? { type: WorkerResponseType.OK, data: undefined }
+      );
+    } finally {
+      this.capturedResponses.delete(requestId);
+    }
+  }
+
+  // ============================================================================
+  // Pipelining
+  // ============================================================================
+
+  private async handlePipeline(requestId: number, data: PipelineRequest): Promise<void> {
+    const results: PipelineOperationResult[] = [];
+    const transfer: Transferable[] = [];
+    let failed = -1;
+
+    for (let i = 0; i < data.operations.length; i++) {
+      const operation = data.operations[i];
+      if (failed >= 0) {
+        results.push({
+          type: WorkerResponseType.ERROR,
+          data: { message: `Skipped because pipelined operation ${failed} failed` },
+        });
+        continue;
+      }
+
+      let response: CapturedResponse;
+      if (operation.type === WorkerRequestType.PIPELINE) {
+        response = {
+          type: WorkerResponseType.ERROR,
+          data: { message: 'Pipelines cannot be nested' },
+        };
+      } else {
+        try {
+          const payload = this.resolvePipelineRefs(operation.data, results);
+          // Internal ids are negative so they never collide with client message ids
+          response = await this.dispatchCaptured(
+            this.nextInternalRequestId--,
+            operation.type,
+            payload,
+          );
+        } catch (error) {
+          const message = error instanceof Error ? error.message : String(error);
+          response = { type: WorkerResponseType.ERROR, data: { message } };
+        }
+      }
+
+      results.push({ type: response.type, data: response.data });
+      if (response.transfer) {
+        transfer.push(...response.transfer);
+      }
+      if (response.type === WorkerResponseType.ERROR) {
+        failed = i;
+      }
+    }
+
+    const response: PipelineResultResponse = { results };
+    this.postResponse(requestId, WorkerResponseType.PIPELINE_RESULT, response, transfer);
+  }
+
+  /**
+   * Replace PipelineRefs in the top-level fields of a payload with earlier results.
+   */
+  private resolvePipelineRefs(data: unknown, results: PipelineOperationResult[]): unknown {
+    if (!data || typeof data !== 'object' || Array.isArray(data) || ArrayBuffer.isView(data)) {
+      return data;
+    }
+    const resolved: Record<string, unknown> = {};
+    for (const [key, value] of Object.entries(data)) {
+      const ref = value as PipelineRef | null;
+      if (ref && typeof ref === 'object' && typeof ref.$ref === 'number') {
+        const result = results[ref.$ref];
+        if (!result) {
+          throw new Error(`Pipeline reference to operation ${ref.$ref}, which has not run yet`);
+        }
+        resolved[key] = (result.data as Record<string, unknown>)[ref.field];
+      } else {
+        resolved[key] = value;
+      }
+    }
+    return resolved;
+  }
+
   // ============================================================================
   // Module helpers
   // ============================================================================
@@ -288,11 +613,17 @@ export class DuckDBDispatcher {
     return this.module;
   }
 
+  private getJSFiles(): JSFileRegistry {
+    return (this.getModule() as unknown as { jsFiles: JSFileRegistry }).jsFiles;
+  }
+
   private getConnectionPtr(connectionId: number): number {
     const connPtr = this.connections.get(connectionId);
     if (!connPtr) {
       throw new Error(`Connection ${connectionId} not found`);
     }
+    // Any new statement on this connection would invalidate a live stream
+    this.bufferActiveStream(connectionId);
     return connPtr;
   }
 
@@ -324,7 +655,19 @@ export class DuckDBDispatcher {
     }
 
     // Initialize the Emscripten module
-    const config: Record<string, unknown> = {};
+    // The pthreads build imports shared memory that its workers attach to
+    const memory = createMemory(data.memory, data.variant === 'mt');
+    const config: Record<string, unknown> = {
+      logLevel: LOG_LEVELS[data.logLevel ?? 'warn'],
+      wasmMemory: memory,
+    };
+    if (data.fetchWorker !== false) {
+      // Range reads then run as concurrent fetch() calls instead of one sync XHR at a time
+      const helper = startFetchHelper();
+      if (helper) {
+        config.fetchHelper = helper;
+      }
+    }
 
     // Check for pre-compiled WASM module (for testing environments)
     const preloadedWasmModule = (
@@ -350,10 +693,59 @@ export class DuckDBDispatcher {
       };
     }
 
-    this.module = (await DuckDBModule(config)) as EmscriptenModule;
+    const mod = (await DuckDBModule(config)) as EmscriptenModule;
+    this.variant = data.variant ?? 'baseline';
+    this.memoryCeiling = data.memory?.maximum ?? MAX_MEMORY;
+    if (data.snapshot) {
+      // The restored memory already holds an open database, set up when it was taken
+      if (this.hasSharedMemory(mod)) {
+        throw new Error('Snapshots need a single-threaded build');
+      }
+      this.dbPtr = restoreSnapshot(mod, data.snapshot, this.variant);
+    }
+    this.module = mod;
     this.postOK(requestId);
   }
 
+  /**
+   * Whether the module's memory is shared with pthreads, whose state lives outside it.
+   */
+  private hasSharedMemory(mod: EmscriptenModule): boolean {
+    return (
+      typeof SharedArrayBuffer !== 'undefined' && mod.HEAPU8.buffer instanceof SharedArrayBuffer
+    );
+  }
+
+  private handleCreateSnapshot(requestId: number): void {
+    const mod = this.getModule();
+    if (!this.dbPtr) {
+      throw new Error('Database not open');
+    }
+    if (this.hasSharedMemory(mod)) {
+      throw new Error('Snapshots need a single-threaded build');
+    }
+    // Handles held by the worker would not exist after a restore
+    if (
+      this.connections.size > 0 ||
+      this.preparedStatements.size > 0 ||
+      this.streamingResults.size > 0 ||
+      this.arrowIngests.size > 0 ||
+      this.arrowStreams.size > 0
+    ) {
+      throw new Error('Close all connections before creating a snapshot');
+    }
+    if (this.opfsTempPool) {
+      throw new Error('Databases using OPFS cannot be snapshotted');
+    }
+
+    const response: SnapshotResponse = {
+      snapshot: captureSnapshot(mod, this.dbPtr, this.variant),
+    };
+    this.postResponse(requestId, WorkerResponseType.SNAPSHOT, response, [
+      response.snapshot.buffer,
+    ]);
+  }
+
   private handleGetVersion(requestId: number): void {
     const mod = this.getModule();
     const versionPtr = mod.ccall('duckdb_library_version', 'number', [], []) as number;
@@ -361,7 +753,7 @@ export class DuckDBDispatcher {
     this.postResponse(requestId, WorkerResponseType.VERSION, { version });
   }
 
-  private handleOpen(requestId: number, data?: OpenRequest): void {
+  private async handleOpen(requestId: number, data?: OpenRequest): Promise<void> {
     const mod = this.getModule();
     const config = data?.config ?? {};
 
@@ -371,96 +763,185 @@ export class DuckDBDispatcher {
       enableExternalAccess: config.enableExternalAccess ?? true,
       lockConfiguration: config.lockConfiguration ?? true,
       customConfig: config.customConfig ?? {},
+      path: config.path ?? ':memory:',
+      tempDirectory: config.tempDirectory,
+      opfsTempFiles: config.opfsTempFiles ?? DEFAULT_OPFS_TEMP_FILES,
     };
 
-    // Create config object
-    const configPtrPtr = mod._malloc(4);
-    const createResult = mod.ccall(
-      'duckdb_create_config',
-      'number',
-      ['number'],
-      [configPtrPtr],
-    ) as number;
+    // OPFS handles must exist before DuckDB opens files synchronously
+    const usesOPFS =
+      isOPFSPath(finalConfig.path) ||
+      (finalConfig.tempDirectory !== undefined && isOPFSPath(finalConfig.tempDirectory));
+    let dbOpened = false;
+    try {
+      if (usesOPFS) {
+        await this.prepareOPFS(finalConfig.path, finalConfig.opfsTempFiles);
+      }
+
+      // Create config object
+      const configPtrPtr = mod._malloc(4);
+      const createResult = mod.ccall(
+        'duckdb_create_config',
+        'number',
+        ['number'],
+        [configPtrPtr],
+      ) as number;
+
+      if (createResult !== 0) {
+        mod._free(configPtrPtr);
+        throw new Error('Failed to create DuckDB configuration');
+      }
 
-    if (createResult !== 0) {
+      const configPtr = mod.getValue(configPtrPtr, 'i32');
       mod._free(configPtrPtr);
-      throw new Error('Failed to create DuckDB configuration');
-    }
 
-    const configPtr = mod.getValue(configPtrPtr, 'i32');
-    mod._free(configPtrPtr);
+      try {
+        // Helper to set config option
+        const setConfig = (name: string, value: string) => {
+          const setResult = mod.ccall(
+            'duckdb_set_config',
+            'number',
+            ['number', 'string', 'string'],
+            [configPtr, name, value],
+          ) as number;
+          if (setResult !== 0) {
+            throw new Error(`Failed to set config option: ${name}`);
+          }
+        };
 
-    try {
-      // Helper to set config option
-      const setConfig = (name: string, value: string) => {
-        const setResult = mod.ccall(
-          'duckdb_set_config',
-          'number',
-          ['number', 'string', 'string'],
-          [configPtr, name, value],
-        ) as number;
-        if (setResult !== 0) {
-          throw new Error(`Failed to set config option: ${name}`);
+        // Apply access mode
+        if (finalConfig.accessMode !== AccessMode.AUTOMATIC) {
+          setConfig('access_mode', finalConfig.accessMode);
         }
-      };
 
-      // Apply access mode
-      if (finalConfig.accessMode !== AccessMode.AUTOMATIC) {
-        setConfig('access_mode', finalConfig.accessMode);
-      }
+        // Apply external access setting
+        if (finalConfig.enableExternalAccess === false) {
+          setConfig('enable_external_access', 'false');
+        }
 
-      // Apply external access setting
-      if (finalConfig.enableExternalAccess === false) {
-        setConfig('enable_external_access', 'false');
-      }
+        // Apply spill directory
+        if (finalConfig.tempDirectory !== undefined) {
+          setConfig('temp_directory', finalConfig.tempDirectory);
+        }
 
-      // Apply custom config options
-      for (const [key, value] of Object.entries(finalConfig.customConfig)) {
-        setConfig(key, value);
-      }
+        // Keep the buffer manager below the memory ceiling; customConfig may override it
+        setConfig('memory_limit', memoryLimit(this.memoryCeiling));
 
-      // Open database with config
-      const dbPtrPtr = mod._malloc(4);
-      const errorPtrPtr = mod._malloc(4);
+        // Apply custom config options
+        for (const [key, value] of Object.entries(finalConfig.customConfig)) {
+          setConfig(key, value);
+        }
 
-      try {
-        const openResult = mod.ccall(
-          'duckdb_open_ext',
-          'number',
-          ['string', 'number', 'number', 'number'],
-          [':memory:', dbPtrPtr, configPtr, errorPtrPtr],
-        ) as number;
+        // Route opfs:// paths to the JS-backed file system
+        mod.ccall('duckdb_wasm_fs_configure', null, ['number'], [configPtr]);
+
+        // Open database with config
+        const dbPtrPtr = mod._malloc(4);
+        const errorPtrPtr = mod._malloc(4);
+
+        try {
+          const openResult = mod.ccall(
+            'duckdb_open_ext',
+            'number',
+            ['string', 'number', 'number', 'number'],
+            [finalConfig.path, dbPtrPtr, configPtr, errorPtrPtr],
+          ) as number;
+
+          if (openResult !== 0) {
+            const errorPtr = mod.getValue(errorPtrPtr, 'i32');
+            const errorMsg = errorPtr ? mod.UTF8ToString(errorPtr) : 'Unknown error';
+            throw new Error(`Failed to open database: ${errorMsg}`);
+          }
+
+          this.dbPtr = mod.getValue(dbPtrPtr, 'i32');
+          dbOpened = true;
+        } finally {
+          mod._free(dbPtrPtr);
+          mod._free(errorPtrPtr);
+        }
 
-        if (openResult !== 0) {
-          const errorPtr = mod.getValue(errorPtrPtr, 'i32');
-          const errorMsg = errorPtr ? mod.UTF8ToString(errorPtr) : 'Unknown error';
-          throw new Error(`Failed to open database: ${errorMsg}`);
+        // Initialize httpfs (only if external access enabled)
+        if (finalConfig.enableExternalAccess !== false) {
+          mod.ccall('duckdb_wasm_httpfs_init', null, ['number'], [this.dbPtr]);
         }
 
-        this.dbPtr = mod.getValue(dbPtrPtr, 'i32');
+        // Lock configuration (secure default)
+        if (finalConfig.lockConfiguration !== false) {
+          this.executeSQLInternal('SET lock_configuration = true');
+        }
       } finally {
-        mod._free(dbPtrPtr);
-        mod._free(errorPtrPtr);
+        // Destroy config object
+        const configPtrPtrForDestroy = mod._malloc(4);
+        mod.setValue(configPtrPtrForDestroy, configPtr, 'i32');
+        mod.ccall('duckdb_destroy_config', null, ['number'], [configPtrPtrForDestroy]);
+        mod._free(configPtrPtrForDestroy);
       }
-
-      // Initialize httpfs (only if external access enabled)
-      if (finalConfig.enableExternalAccess !== false) {
-        mod.ccall('duckdb_wasm_httpfs_init', null, ['number'], [this.dbPtr]);
+    } catch (error) {
+      // A failed open must not keep a half-initialized database or lock the OPFS files
+      if (dbOpened) {
+        this.closeDatabase();
       }
+      if (usesOPFS) {
+        this.releaseJSFiles();
+      }
+      throw error;
+    }
+
+    this.postOK(requestId);
+  }
 
-      // Lock configuration (secure default)
-      if (finalConfig.lockConfiguration !== false) {
-        this.executeSQLInternal('SET lock_configuration = true');
+  /**
+   * Open the OPFS handles DuckDB needs: the database file and its WAL, and a pool of
+   * spare handles for files it creates on its own (e.g. spill files).
+   */
+  private async prepareOPFS(path: string, tempFiles: number): Promise<void> {
+    const jsFiles = this.getJSFiles();
+    if (isOPFSPath(path)) {
+      for (const filePath of [path, `${path}.wal`]) {
+        const { file, existed } = await openOPFSFile(filePath);
+        jsFiles.register(filePath, file, existed);
       }
+    }
+    if (!this.opfsTempPool) {
+      const pool = await OPFSTempPool.open(tempFiles);
+      this.opfsTempPool = pool;
+      jsFiles.setCreator(OPFS_PREFIX, () => pool.take());
+    }
+  }
 
-      this.postOK(requestId);
+  /**
+   * Close the database, if one is open.
+   */
+  private closeDatabase(): void {
+    if (!this.dbPtr) {
+      return;
+    }
+    const mod = this.getModule();
+    const dbPtrPtr = mod._malloc(4);
+    try {
+      mod.setValue(dbPtrPtr, this.dbPtr, '*');
+      mod.ccall('duckdb_close', null, ['number'], [dbPtrPtr]);
     } finally {
-      // Destroy config object
-      const configPtrPtrForDestroy = mod._malloc(4);
-      mod.setValue(configPtrPtrForDestroy, configPtr, 'i32');
-      mod.ccall('duckdb_destroy_config', null, ['number'], [configPtrPtrForDestroy]);
-      mod._free(configPtrPtrForDestroy);
+      mod._free(dbPtrPtr);
+    }
+    this.dbPtr = 0;
+  }
+
+  /**
+   * Unregister and close every JS-backed file.
+   */
+  private releaseJSFiles(): void {
+    const jsFiles = this.getJSFiles();
+    for (const file of jsFiles.unregisterAll()) {
+      try {
+        file.close();
+      } catch {
+        // Already closed
+      }
     }
+    jsFiles.setCreator(OPFS_PREFIX, null);
+    this.opfsTempPool?.close();
+    this.opfsTempPool = null;
   }
 
   /**
@@ -529,21 +1010,28 @@ export class DuckDBDispatcher {
 
     // Close all streaming results
     for (const [, info] of this.streamingResults) {
-      mod.ccall('duckdb_destroy_result', null, ['number'], [info.resultPtr]);
+      this.releaseStreamingResult(mod, info);
     }
     this.streamingResults.clear();
+    this.activeStreams.clear();
 
-    // Close database
-    if (this.dbPtr) {
-      const dbPtrPtr = mod._malloc(4);
-      try {
-        mod.setValue(dbPtrPtr, this.dbPtr, '*');
-        mod.ccall('duckdb_close', null, ['number'], [dbPtrPtr]);
-      } finally {
-        mod._free(dbPtrPtr);
-      }
-      this.dbPtr = 0;
+    // Close all Arrow IPC ingests
+    for (const [, info] of this.arrowIngests) {
+      mod.ccall('duckdb_wasm_arrow_ipc_ingest_destroy', null, ['number'], [info.ingestPtr]);
+    }
+    this.arrowIngests.clear();
+
+    // Close all Arrow IPC streams
+    for (const [, info] of this.arrowStreams) {
+      mod.ccall('duckdb_wasm_arrow_ipc_stream_destroy', null, ['number'], [info.streamPtr]);
     }
+    this.arrowStreams.clear();
+    this.activeArrowStreams.clear();
+
+    this.closeDatabase();
+
+    // Release OPFS handles so the files can be opened again
+    this.releaseJSFiles();
 
     this.postOK(requestId);
   }
@@ -580,10 +1068,43 @@ export class DuckDBDispatcher {
 
   private handleDisconnect(requestId: number, data: DisconnectRequest): void {
     const mod = this.getModule();
-    const connPtr = this.getConnectionPtr(data.connectionId);
+    const { connectionId } = data;
+    // Not getConnectionPtr: a live stream is released below rather than buffered
+    const connPtr = this.connections.get(connectionId);
+    if (!connPtr) {
+      throw new Error(`Connection ${connectionId} not found`);
+    }
+
+    // Release what the client left open on the connection, e.g. a tab that went away
+    for (const [id, info] of this.streamingResults) {
+      if (info.connectionId === connectionId) {
+        this.releaseStreamingResult(mod, info);
+        this.streamingResults.delete(id);
+      }
+    }
+    this.activeStreams.delete(connectionId);
+    for (const [id, info] of this.arrowStreams) {
+      if (info.connectionId === connectionId) {
+        mod.ccall('duckdb_wasm_arrow_ipc_stream_destroy', null, ['number'], [info.streamPtr]);
+        this.arrowStreams.delete(id);
+      }
+    }
+    this.activeArrowStreams.delete(connectionId);
+    for (const [id, info] of this.arrowIngests) {
+      if (info.connectionId === connectionId) {
+        mod.ccall('duckdb_wasm_arrow_ipc_ingest_destroy', null, ['number'], [info.ingestPtr]);
+        this.arrowIngests.delete(id);
+      }
+    }
+    for (const [id, info] of this.preparedStatements) {
+      if (info.connectionId === connectionId) {
+        this.destroyPrepared(mod, info.stmtPtr);
+        this.preparedStatements.delete(id);
+      }
+    }
 
     mod.ccall('duckdb_disconnect', null, ['number'], [connPtr]);
-    this.connections.delete(data.connectionId);
+    this.connections.delete(connectionId);
 
     this.postOK(requestId);
   }
@@ -598,12 +1119,19 @@ export class DuckDBDispatcher {
 
     const resultPtr = mod._malloc(64);
     try {
-      const status = mod.ccall(
-        'duckdb_query',
-        'number',
-        ['number', 'string', 'number'],
-        [connPtr, data.sql, resultPtr],
-      ) as number;
+      const start = performance.now();
+      const previous = data.profile
+        ? (mod.ccall('duckdb_wasm_profile_begin', 'number', ['number'], [connPtr]) as number)
+        : 0;
+      let status: number;
+      let profile: QueryProfile | undefined;
+      try {
+        status = this.runQuery(mod, requestId, connPtr, data.sql, resultPtr, data.control);
+      } finally {
+        if (data.profile) {
+          profile = this.endProfile(mod, connPtr, previous, performance.now() - start);
+        }
+      }
 
       if (status !== 0) {
         const errorPtr = mod.ccall(
@@ -618,11 +1146,19 @@ export class DuckDBDispatcher {
       }
 
       // Extract results
-      const { columns, rows } = this.extractQueryResult(mod, resultPtr);
-      mod.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
+      let result: ReturnType<DuckDBDispatcher['extractQueryResult']>;
+      try {
+        result = this.extractQueryResult(mod, resultPtr);
+      } finally {
+        mod.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
+      }
 
-      const response: QueryResultResponse = { columns, rows };
-      this.postResponse(requestId, WorkerResponseType.QUERY_RESULT, response);
+      const response: QueryResultResponse = {
+        columns: result.columns,
+        chunks: result.chunks,
+        profile,
+      };
+      this.postResponse(requestId, WorkerResponseType.QUERY_RESULT, response, result.transfer);
     } finally {
       mod._free(resultPtr);
     }
@@ -632,38 +1168,39 @@ export class DuckDBDispatcher {
     const mod = this.getModule();
     const connPtr = this.getConnectionPtr(data.connectionId);
 
-    const resultPtr = mod._malloc(64);
+    // Out-params: uint8_t** buffer, size_t* length, char** error
+    const outPtr = mod._malloc(12);
     try {
+      mod.setValue(outPtr, 0, 'i32');
+      mod.setValue(outPtr + 4, 0, 'i32');
+      mod.setValue(outPtr + 8, 0, 'i32');
+
+      // DuckDB converts each chunk to Arrow, nanoarrow serializes the IPC stream
       const status = mod.ccall(
-        'duckdb_query',
+        'duckdb_wasm_query_arrow_ipc',
         'number',
-        ['number', 'string', 'number'],
-        [connPtr, data.sql, resultPtr],
+        ['number', 'string', 'number', 'number', 'number'],
+        [connPtr, data.sql, outPtr, outPtr + 4, outPtr + 8],
       ) as number;
 
       if (status !== 0) {
-        const errorPtr = mod.ccall(
-          'duckdb_result_error',
-          'number',
-          ['number'],
-          [resultPtr],
-        ) as number;
+        const errorPtr = mod.getValue(outPtr + 8, 'i32');
         const error = errorPtr ? mod.UTF8ToString(errorPtr) : 'Query failed';
-        mod.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
+        if (errorPtr) {
+          mod._free(errorPtr);
+        }
         throw new Error(error);
       }
 
-      // Build Arrow table and serialize to IPC
-      const table = this.buildArrowTable(mod, resultPtr);
-      mod.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
+      const bufPtr = mod.getValue(outPtr, 'i32');
+      const bufLen = mod.getValue(outPtr + 4, 'i32');
+      // Copy out of the WASM heap so the buffer can be transferred
+      const ipcBuffer = mod.HEAPU8.slice(bufPtr, bufPtr + bufLen);
+      mod._free(bufPtr);
 
-      const ipcBuffer = tableToIPC(table, { format: 'stream' });
-      if (!ipcBuffer) {
-        throw new Error('Failed to serialize Arrow table to IPC');
-      }
       this.postResponse(requestId, WorkerResponseType.ARROW_IPC, { ipcBuffer }, [ipcBuffer.buffer]);
     } finally {
-      mod._free(resultPtr);
+      mod._free(outPtr);
     }
   }
 
@@ -671,14 +1208,20 @@ export class DuckDBDispatcher {
     const mod = this.getModule();
     const connPtr = this.getConnectionPtr(data.connectionId);
 
+    // Prefer a pending streaming execution so chunks are produced on demand.
+    // Statements that cannot be prepared (e.g. multiple statements) fall back
+    // to a materialized result, which is read through the same chunk API.
+    const stmtPtr = this.tryPrepare(mod, connPtr, data.sql);
     const resultPtr = mod._malloc(64);
     try {
-      const status = mod.ccall(
-        'duckdb_query',
-        'number',
-        ['number', 'string', 'number'],
-        [connPtr, data.sql, resultPtr],
-      ) as number;
+      const status = stmtPtr
+        ? this.executePendingStreaming(mod, stmtPtr, resultPtr)
+        : (mod.ccall(
+            'duckdb_query',
+            'number',
+            ['number', 'string', 'number'],
+            [connPtr, data.sql, resultPtr],
+          ) as number);
 
       if (status !== 0) {
         const errorPtr = mod.ccall(
@@ -699,117 +1242,574 @@ export class DuckDBDispatcher {
       const streamingResultId = this.nextStreamingResultId++;
       this.streamingResults.set(streamingResultId, {
         resultPtr,
+        stmtPtr,
         connectionId: data.connectionId,
         columns,
-        currentChunk: 0,
+        bufferedChunks: [],
+        exhausted: false,
       });
+      if (stmtPtr) {
+        this.activeStreams.set(data.connectionId, streamingResultId);
+      }
 
       const response: StreamingResultInfoResponse = { streamingResultId, columns };
       this.postResponse(requestId, WorkerResponseType.STREAMING_RESULT_INFO, response);
     } catch (e) {
       mod._free(resultPtr);
+      if (stmtPtr) {
+        this.destroyPrepared(mod, stmtPtr);
+      }
       throw e;
     }
-  }
+  }
+
+  private handleExecute(requestId: number, data: ExecuteRequest): void {
+    const mod = this.getModule();
+    const connPtr = this.getConnectionPtr(data.connectionId);
+
+    const resultPtr = mod._malloc(64);
+    try {
+      const status = this.runQuery(mod, requestId, connPtr, data.sql, resultPtr, data.control);
+
+      if (status !== 0) {
+        const errorPtr = mod.ccall(
+          'duckdb_result_error',
+          'number',
+          ['number'],
+          [resultPtr],
+        ) as number;
+        const error = errorPtr ? mod.UTF8ToString(errorPtr) : 'Query failed';
+        mod.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
+        throw new Error(error);
+      }
+
+      // Get rows changed
+      const rowsChanged = mod.ccall(
+        'duckdb_rows_changed',
+        'number',
+        ['number'],
+        [resultPtr],
+      ) as number;
+
+      mod.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
+
+      this.postResponse(requestId, WorkerResponseType.ROWS_CHANGED, { rowsChanged });
+    } finally {
+      mod._free(resultPtr);
+    }
+  }
+
+  private handleFetchChunk(requestId: number, data: FetchChunkRequest): void {
+    const mod = this.getModule();
+    const info = this.streamingResults.get(data.streamingResultId);
+
+    // Results of other connections look the same as results that do not exist
+    if (!info || info.connectionId !== data.connectionId) {
+      throw new Error(`Streaming result ${data.streamingResultId} not found`);
+    }
+
+    // Each fetch pulls exactly one DataChunk, either buffered or from the pipeline
+    const chunkPtr = info.bufferedChunks.shift() ?? this.fetchResultChunk(mod, info);
+
+    if (!chunkPtr) {
+      if (this.activeStreams.get(info.connectionId) === data.streamingResultId) {
+        this.activeStreams.delete(info.connectionId);
+      }
+      const response: DataChunkResponse = {
+        columns: info.columns,
+        vectors: [],
+        rowCount: 0,
+        done: true,
+      };
+      this.postResponse(requestId, WorkerResponseType.DATA_CHUNK, response);
+      return;
+    }
+
+    let chunk: ReturnType<DuckDBDispatcher['extractChunkVectors']>;
+    try {
+      chunk = this.extractChunkVectors(mod, chunkPtr, info.columns);
+    } finally {
+      this.destroyDataChunk(mod, chunkPtr);
+    }
+
+    const response: DataChunkResponse = {
+      columns: info.columns,
+      vectors: chunk.vectors,
+      rowCount: chunk.rowCount,
+      done: info.exhausted && info.bufferedChunks.length === 0,
+    };
+    this.postResponse(requestId, WorkerResponseType.DATA_CHUNK, response, chunk.transfer);
+  }
+
+  private handleCloseStreamingResult(requestId: number, data: CloseStreamingResultRequest): void {
+    const mod = this.getModule();
+    const info = this.streamingResults.get(data.streamingResultId);
+
+    if (info && info.connectionId === data.connectionId) {
+      if (this.activeStreams.get(info.connectionId) === data.streamingResultId) {
+        this.activeStreams.delete(info.connectionId);
+      }
+      this.releaseStreamingResult(mod, info);
+      this.streamingResults.delete(data.streamingResultId);
+    }
+
+    this.postOK(requestId);
+  }
+
+  private handleQueryArrowStream(requestId: number, data: QueryArrowStreamRequest): void {
+    const mod = this.getModule();
+    const connPtr = this.getConnectionPtr(data.connectionId);
+
+    // The query runs with a streaming result; batches are encoded as they are fetched
+    const streamPtr = mod.ccall(
+      'duckdb_wasm_arrow_ipc_stream_open',
+      'number',
+      ['number', 'string'],
+      [connPtr, data.sql],
+    ) as number;
+    if (!streamPtr) {
+      throw new Error('Failed to open Arrow IPC stream');
+    }
+    const errorPtr = mod.ccall(
+      'duckdb_wasm_arrow_ipc_stream_error',
+      'number',
+      ['number'],
+      [streamPtr],
+    ) as number;
+    if (errorPtr) {
+      const error = mod.UTF8ToString(errorPtr);
+      mod.ccall('duckdb_wasm_arrow_ipc_stream_destroy', null, ['number'], [streamPtr]);
+      throw new Error(error);
+    }
+
+    const arrowStreamId = this.nextArrowStreamId++;
+    this.arrowStreams.set(arrowStreamId, {
+      streamPtr,
+      connectionId: data.connectionId,
+      batchRows: data.batchRows ?? 0,
+      buffered: null,
+    });
+    this.activeArrowStreams.set(data.connectionId, arrowStreamId);
+
+    const response: ArrowStreamIdResponse = { arrowStreamId };
+    this.postResponse(requestId, WorkerResponseType.ARROW_STREAM_ID, response);
+  }
+
+  private handleFetchArrowBatch(requestId: number, data: FetchArrowBatchRequest): void {
+    const mod = this.getModule();
+    const info = this.arrowStreams.get(data.arrowStreamId);
+
+    // Streams of other connections look the same as streams that do not exist
+    if (!info || info.connectionId !== data.connectionId) {
+      throw new Error(`Arrow IPC stream ${data.arrowStreamId} not found`);
+    }
+
+    const ipcBuffer = info.buffered ?? this.readArrowStream(mod, info.streamPtr, info.batchRows);
+    info.buffered = null;
+    const complete = ipcBuffer.byteLength === 0;
+    if (complete && this.activeArrowStreams.get(info.connectionId) === data.arrowStreamId) {
+      this.activeArrowStreams.delete(info.connectionId);
+    }
+
+    this.postResponse(requestId, WorkerResponseType.ARROW_IPC, { ipcBuffer }, [ipcBuffer.buffer]);
+  }
+
+  private handleCloseArrowStream(requestId: number, data: CloseArrowStreamRequest): void {
+    const mod = this.getModule();
+    const info = this.arrowStreams.get(data.arrowStreamId);
+
+    if (info && info.connectionId === data.connectionId) {
+      if (this.activeArrowStreams.get(info.connectionId) === data.arrowStreamId) {
+        this.activeArrowStreams.delete(info.connectionId);
+      }
+      mod.ccall('duckdb_wasm_arrow_ipc_stream_destroy', null, ['number'], [info.streamPtr]);
+      this.arrowStreams.delete(data.arrowStreamId);
+    }
+
+    this.postOK(requestId);
+  }
+
+  // ============================================================================
+  // Streaming helpers
+  // ============================================================================
+
+  /**
+   * Prepare a statement, returning 0 if it cannot be prepared.
+   */
+  private tryPrepare(mod: EmscriptenModule, connPtr: number, sql: string): number {
+    const stmtPtrPtr = mod._malloc(4);
+    try {
+      const status = mod.ccall(
+        'duckdb_prepare',
+        'number',
+        ['number', 'string', 'number'],
+        [connPtr, sql, stmtPtrPtr],
+      ) as number;
+      const stmtPtr = mod.getValue(stmtPtrPtr, 'i32');
+      if (status !== 0) {
+        if (stmtPtr) {
+          this.destroyPrepared(mod, stmtPtr);
+        }
+        return 0;
+      }
+      return stmtPtr;
+    } finally {
+      mod._free(stmtPtrPtr);
+    }
+  }
+
+  /**
+   * Run a query into resultPtr, returning its duckdb_state.
+   *
+   * Without a control the query runs in a single duckdb_query call. With one it is
+   * executed task by task, so the interrupt flag is checked and progress reported in
+   * between. SQL that cannot be prepared as one statement still runs in a single call.
+   */
+  private runQuery(
+    mod: EmscriptenModule,
+    requestId: number,
+    connPtr: number,
+    sql: string,
+    resultPtr: number,
+    control?: QueryControl,
+  ): number {
+    const stmtPtr = control ? this.tryPrepare(mod, connPtr, sql) : 0;
+    if (!stmtPtr) {
+      return mod.ccall(
+        'duckdb_query',
+        'number',
+        ['number', 'string', 'number'],
+        [connPtr, sql, resultPtr],
+      ) as number;
+    }
+
+    const pendingPtrPtr = mod._malloc(4);
+    mod.setValue(pendingPtrPtr, 0, 'i32');
+    try {
+      const status = mod.ccall(
+        'duckdb_pending_prepared',
+        'number',
+        ['number', 'number'],
+        [stmtPtr, pendingPtrPtr],
+      ) as number;
+      const pendingPtr = mod.getValue(pendingPtrPtr, 'i32');
+
+      if (status !== 0) {
+        const errorPtr = pendingPtr
+          ? (mod.ccall('duckdb_pending_error', 'number', ['number'], [pendingPtr]) as number)
+          : 0;
+        const error = errorPtr ? mod.UTF8ToString(errorPtr) : 'Query failed';
+        throw new Error(error);
+      }
+
+      this.runPendingTasks(mod, requestId, connPtr, pendingPtr, control as QueryControl);
+
+      // Materializes the result, or reports the error (including an interrupt)
+      return mod.ccall(
+        'duckdb_execute_pending',
+        'number',
+        ['number', 'number'],
+        [pendingPtr, resultPtr],
+      ) as number;
+    } finally {
+      // Also reached when running the tasks or reporting progress throws
+      if (mod.getValue(pendingPtrPtr, 'i32')) {
+        mod.ccall('duckdb_destroy_pending', null, ['number'], [pendingPtrPtr]);
+      }
+      mod._free(pendingPtrPtr);
+      this.destroyPrepared(mod, stmtPtr);
+    }
+  }
+
+  /**
+   * Execute the tasks of a pending query until it is finished or failed.
+   */
+  private runPendingTasks(
+    mod: EmscriptenModule,
+    requestId: number,
+    connPtr: number,
+    pendingPtr: number,
+    control: QueryControl,
+  ): void {
+    const { interrupt, progressInterval } = control;
+    let interrupted = false;
+    let lastProgress = performance.now();
+
+    for (;;) {
+      if (interrupt && !interrupted && Atomics.load(interrupt, 0) !== 0) {
+        // The next task fails, ending the query with an INTERRUPT error
+        mod.ccall('duckdb_interrupt', null, ['number'], [connPtr]);
+        interrupted = true;
+      }
+
+      const state = mod.ccall(
+        'duckdb_pending_execute_task',
+        'number',
+        ['number'],
+        [pendingPtr],
+      ) as number;
+      if (state !== PENDING_RESULT_NOT_READY && state !== PENDING_NO_TASKS_AVAILABLE) {
+        return;
+      }
+
+      if (progressInterval !== undefined && !interrupted) {
+        const now = performance.now();
+        if (now - lastProgress >= progressInterval) {
+          lastProgress = now;
+          this.postQueryProgress(mod, requestId, connPtr);
+        }
+      }
+    }
+  }
+
+  /**
+   * Stop profiling a connection and collect the profile of its last query.
+   */
+  private endProfile(
+    mod: EmscriptenModule,
+    connPtr: number,
+    previous: number,
+    totalTimeMs: number,
+  ): QueryProfile {
+    const jsonPtr = mod.ccall(
+      'duckdb_wasm_profile_end',
+      'number',
+      ['number', 'number'],
+      [connPtr, previous],
+    ) as number;
+    if (!jsonPtr) {
+      throw new Error('Failed to collect the query profile');
+    }
+    const json = mod.UTF8ToString(jsonPtr);
+    mod._free(jsonPtr);
+
+    const { execution, http } = JSON.parse(json) as {
+      execution: Record<string, unknown> | null;
+      http: HTTPProfile;
+    };
+    const httpTimeMs = http.urls.reduce((sum, url) => sum + url.totalLatencyMs, 0);
+    return { totalTimeMs, httpTimeMs, execution, http };
+  }
+
+  /**
+   * Post the progress of the query running on a connection.
+   */
+  private postQueryProgress(mod: EmscriptenModule, requestId: number, connPtr: number): void {
+    if (this.capturedResponses.has(requestId)) {
+      // Only final responses are captured
+      return;
+    }
+
+    const outPtr = mod._malloc(24);
+    try {
+      mod.ccall(
+        'duckdb_wasm_query_progress',
+        null,
+        ['number', 'number', 'number', 'number'],
+        [connPtr, outPtr, outPtr + 8, outPtr + 16],
+      );
+      const progress: QueryProgressResponse = {
+        percentage: mod.getValue(outPtr, 'double'),
+        rowsProcessed: mod.getValue(outPtr + 8, 'double'),
+        totalRows: mod.getValue(outPtr + 16, 'double'),
+      };
+      this.postResponse(requestId, WorkerResponseType.QUERY_PROGRESS, progress);
+    } finally {
+      mod._free(outPtr);
+    }
+  }
+
+  /**
+   * Execute a prepared statement as a streaming pending query.
+   */
+  private executePendingStreaming(mod: EmscriptenModule, stmtPtr: number, resultPtr: number): number {
+    const pendingPtrPtr = mod._malloc(4);
+    mod.setValue(pendingPtrPtr, 0, 'i32');
+    try {
+      const status = mod.ccall(
+        'duckdb_pending_prepared_streaming',
+        'number',
+        ['number', 'number'],
+        [stmtPtr, pendingPtrPtr],
+      ) as number;
+      const pendingPtr = mod.getValue(pendingPtrPtr, 'i32');
+
+      if (status !== 0) {
+        const errorPtr = pendingPtr
+          ? (mod.ccall('duckdb_pending_error', 'number', ['number'], [pendingPtr]) as number)
+          : 0;
+        const error = errorPtr ? mod.UTF8ToString(errorPtr) : 'Query failed';
+        throw new Error(error);
+      }
+
+      return mod.ccall(
+        'duckdb_execute_pending',
+        'number',
+        ['number', 'number'],
+        [pendingPtr, resultPtr],
+      ) as number;
+    } finally {
+      // Also reached when executing the pending query throws
+      if (mod.getValue(pendingPtrPtr, 'i32')) {
+        mod.ccall('duckdb_destroy_pending', null, ['number'], [pendingPtrPtr]);
+      }
+      mod._free(pendingPtrPtr);
+    }
+  }
+
+  /**
+   * Pull the next chunk from a result, returning 0 once it is exhausted.
+   */
+  private fetchResultChunk(mod: EmscriptenModule, info: StreamingResultInfo): number {
+    while (!info.exhausted) {
+      const chunkPtr = mod.ccall('duckdb_fetch_chunk', 'number', ['number'], [info.resultPtr]) as number;
+      if (!chunkPtr) {
+        info.exhausted = true;
+        const errorPtr = mod.ccall(
+          'duckdb_result_error',
+          'number',
+          ['number'],
+          [info.resultPtr],
+        ) as number;
+        if (errorPtr) {
+          throw new Error(mod.UTF8ToString(errorPtr));
+        }
+        break;
+      }
+
+      const size = mod.ccall('duckdb_data_chunk_get_size', 'number', ['number'], [chunkPtr]) as number;
+      if (size > 0) {
+        return chunkPtr;
+      }
+      this.destroyDataChunk(mod, chunkPtr);
+    }
+    return 0;
+  }
+
+  /**
+   * DuckDB allows a single live streaming result per connection. Before the
+   * connection runs anything else, pull the remaining chunks of its live
+   * stream into memory so that stream can still be read afterwards.
+   */
+  private bufferActiveStream(connectionId: number): void {
+    this.bufferActiveArrowStream(connectionId);
+    const streamingResultId = this.activeStreams.get(connectionId);
+    if (streamingResultId === undefined) {
+      return;
+    }
+    this.activeStreams.delete(connectionId);
+
+    const info = this.streamingResults.get(streamingResultId);
+    if (!info) {
+      return;
+    }
+
+    const mod = this.getModule();
+    try {
+      let chunkPtr = this.fetchResultChunk(mod, info);
+      while (chunkPtr) {
+        info.bufferedChunks.push(chunkPtr);
+        chunkPtr = this.fetchResultChunk(mod, info);
+      }
+    } catch {
+      // The error surfaces again on the stream's next fetch
+      info.exhausted = false;
+    }
+  }
+
+  /**
+   * Encode the rest of a connection's live Arrow IPC stream, like bufferActiveStream.
+   */
+  private bufferActiveArrowStream(connectionId: number): void {
+    const arrowStreamId = this.activeArrowStreams.get(connectionId);
+    if (arrowStreamId === undefined) {
+      return;
+    }
+    this.activeArrowStreams.delete(connectionId);
+
+    const info = this.arrowStreams.get(arrowStreamId);
+    if (!info) {
+      return;
+    }
 
-  private handleExecute(requestId: number, data: ExecuteRequest): void {
-    const mod = this.getModule();
-    const connPtr = this.getConnectionPtr(data.connectionId);
+    try {
+      info.buffered = this.readArrowStream(this.getModule(), info.streamPtr, ARROW_STREAM_REST);
+    } catch {
+      // The stream keeps its error, which surfaces again on its next fetch
+    }
+  }
 
-    const resultPtr = mod._malloc(64);
+  /**
+   * Encode the next record batches of an Arrow IPC stream, at least minRows rows or one
+   * chunk. Returns an empty buffer once the stream is complete.
+   */
+  private readArrowStream(mod: EmscriptenModule, streamPtr: number, minRows: number): Uint8Array {
+    // Out-params: uint8_t** buffer, size_t* length
+    const outPtr = mod._malloc(8);
     try {
+      mod.setValue(outPtr, 0, 'i32');
+      mod.setValue(outPtr + 4, 0, 'i32');
       const status = mod.ccall(
-        'duckdb_query',
+        'duckdb_wasm_arrow_ipc_stream_next',
         'number',
-        ['number', 'string', 'number'],
-        [connPtr, data.sql, resultPtr],
+        ['number', 'number', 'number', 'number'],
+        [streamPtr, minRows, outPtr, outPtr + 4],
       ) as number;
 
       if (status !== 0) {
         const errorPtr = mod.ccall(
-          'duckdb_result_error',
+          'duckdb_wasm_arrow_ipc_stream_error',
           'number',
           ['number'],
-          [resultPtr],
+          [streamPtr],
         ) as number;
-        const error = errorPtr ? mod.UTF8ToString(errorPtr) : 'Query failed';
-        mod.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
-        throw new Error(error);
+        throw new Error(errorPtr ? mod.UTF8ToString(errorPtr) : 'Query failed');
       }
 
-      // Get rows changed
-      const rowsChanged = mod.ccall(
-        'duckdb_rows_changed',
-        'number',
-        ['number'],
-        [resultPtr],
-      ) as number;
-
-      mod.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
-
-      this.postResponse(requestId, WorkerResponseType.ROWS_CHANGED, { rowsChanged });
+      const bufPtr = mod.getValue(outPtr, 'i32');
+      const bufLen = mod.getValue(outPtr + 4, 'i32');
+      if (!bufPtr) {
+        return new Uint8Array(0);
+      }
+      // Copy out of the WASM heap so the buffer can be transferred
+      const ipcBuffer = mod.HEAPU8.slice(bufPtr, bufPtr + bufLen);
+      mod._free(bufPtr);
+      return ipcBuffer;
     } finally {
-      mod._free(resultPtr);
+      mod._free(outPtr);
     }
   }
 
-  private handleFetchChunk(requestId: number, data: FetchChunkRequest): void {
-    const mod = this.getModule();
-    const info = this.streamingResults.get(data.streamingResultId);
-
-    if (!info) {
-      throw new Error(`Streaming result ${data.streamingResultId} not found`);
+  private releaseStreamingResult(mod: EmscriptenModule, info: StreamingResultInfo): void {
+    for (const chunkPtr of info.bufferedChunks) {
+      this.destroyDataChunk(mod, chunkPtr);
     }
-
-    // For DuckDB C API, results are materialized, so we simulate chunking
-    // by reading rows in batches
-    const CHUNK_SIZE = 2048;
-    const rowCount = mod.ccall(
-      'duckdb_row_count',
-      'number',
-      ['number'],
-      [info.resultPtr],
-    ) as number;
-
-    const startRow = info.currentChunk * CHUNK_SIZE;
-    const endRow = Math.min(startRow + CHUNK_SIZE, rowCount);
-    const chunkRowCount = endRow - startRow;
-    const done = endRow >= rowCount;
-
-    if (chunkRowCount === 0) {
-      const response: DataChunkResponse = {
-        columns: info.columns,
-        rows: [],
-        rowCount: 0,
-        done: true,
-      };
-      this.postResponse(requestId, WorkerResponseType.DATA_CHUNK, response);
-      return;
+    info.bufferedChunks = [];
+    mod.ccall('duckdb_destroy_result', null, ['number'], [info.resultPtr]);
+    mod._free(info.resultPtr);
+    if (info.stmtPtr) {
+      this.destroyPrepared(mod, info.stmtPtr);
     }
-
-    // Extract rows for this chunk
-    const rows = this.extractRows(mod, info.resultPtr, info.columns, startRow, endRow);
-    info.currentChunk++;
-
-    const response: DataChunkResponse = {
-      columns: info.columns,
-      rows,
-      rowCount: chunkRowCount,
-      done,
-    };
-    this.postResponse(requestId, WorkerResponseType.DATA_CHUNK, response);
   }
 
-  private handleCloseStreamingResult(requestId: number, data: CloseStreamingResultRequest): void {
-    const mod = this.getModule();
-    const info = this.streamingResults.get(data.streamingResultId);
-
-    if (info) {
-      mod.ccall('duckdb_destroy_result', null, ['number'], [info.resultPtr]);
-      this.streamingResults.delete(data.streamingResultId);
+  private destroyDataChunk(mod: EmscriptenModule, chunkPtr: number): void {
+    const chunkPtrPtr = mod._malloc(4);
+    try {
+      mod.setValue(chunkPtrPtr, chunkPtr, 'i32');
+      mod.ccall('duckdb_destroy_data_chunk', null, ['number'], [chunkPtrPtr]);
+    } finally {
+      mod._free(chunkPtrPtr);
     }
+  }
 
-    this.postOK(requestId);
+  private destroyPrepared(mod: EmscriptenModule, stmtPtr: number): void {
+    const stmtPtrPtr = mod._malloc(4);
+    try {
+      mod.setValue(stmtPtrPtr, stmtPtr, 'i32');
+      mod.ccall('duckdb_destroy_prepare', null, ['number'], [stmtPtrPtr]);
+    } finally {
+      mod._free(stmtPtrPtr);
+    }
   }
 
   // ============================================================================
@@ -867,11 +1867,10 @@ export class DuckDBDispatcher {
 
   private handleRunPrepared(requestId: number, data: RunPreparedRequest): void {
     const mod = this.getModule();
-    const info = this.preparedStatements.get(data.preparedStatementId);
+    const info = this.getPreparedStatement(data.connectionId, data.preparedStatementId);
 
-    if (!info) {
-      throw new Error(`Prepared statement ${data.preparedStatementId} not found`);
-    }
+    // Executing on the statement's connection would invalidate a live stream
+    this.bufferActiveStream(info.connectionId);
 
     // Apply bindings
     this.applyBindings(mod, info.stmtPtr, data.bindings);
@@ -898,11 +1897,15 @@ export class DuckDBDispatcher {
         throw new Error(error);
       }
 
-      const { columns, rows } = this.extractQueryResult(mod, resultPtr);
-      mod.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
+      let result: ReturnType<DuckDBDispatcher['extractQueryResult']>;
+      try {
+        result = this.extractQueryResult(mod, resultPtr);
+      } finally {
+        mod.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
+      }
 
-      const response: QueryResultResponse = { columns, rows };
-      this.postResponse(requestId, WorkerResponseType.QUERY_RESULT, response);
+      const response: QueryResultResponse = { columns: result.columns, chunks: result.chunks };
+      this.postResponse(requestId, WorkerResponseType.QUERY_RESULT, response, result.transfer);
     } finally {
       mod._free(resultPtr);
     }
@@ -910,11 +1913,10 @@ export class DuckDBDispatcher {
 
   private handleExecutePrepared(requestId: number, data: ExecutePreparedRequest): void {
     const mod = this.getModule();
-    const info = this.preparedStatements.get(data.preparedStatementId);
+    const info = this.getPreparedStatement(data.connectionId, data.preparedStatementId);
 
-    if (!info) {
-      throw new Error(`Prepared statement ${data.preparedStatementId} not found`);
-    }
+    // Executing on the statement's connection would invalidate a live stream
+    this.bufferActiveStream(info.connectionId);
 
     // Apply bindings
     this.applyBindings(mod, info.stmtPtr, data.bindings);
@@ -955,11 +1957,85 @@ export class DuckDBDispatcher {
     }
   }
 
+  private handleExecuteBatch(requestId: number, data: ExecuteBatchRequest): void {
+    const mod = this.getModule();
+    const info = this.getPreparedStatement(data.connectionId, data.preparedStatementId);
+
+    // Executing on the statement's connection would invalidate a live stream
+    this.bufferActiveStream(info.connectionId);
+
+    // Copy every column into the heap and describe it with a duckdb_wasm_batch_column
+    // (4 x i32: type, data, offsets, nulls)
+    const allocations: number[] = [];
+    const copyToHeap = (view: ArrayBufferView | undefined): number => {
+      if (!view) {
+        return 0;
+      }
+      const ptr = mod._malloc(Math.max(view.byteLength, 1));
+      allocations.push(ptr);
+      mod.HEAPU8.set(new Uint8Array(view.buffer, view.byteOffset, view.byteLength), ptr);
+      return ptr;
+    };
+
+    const columnsPtr = mod._malloc(Math.max(data.columns.length * 16, 16));
+    const outRowsPtr = mod._malloc(8);
+    const outErrorPtr = mod._malloc(4);
+    try {
+      for (let i = 0; i < data.columns.length; i++) {
+        const column = data.columns[i];
+        const base = columnsPtr + i * 16;
+        mod.setValue(base, column.type, 'i32');
+        mod.setValue(base + 4, copyToHeap(column.data), 'i32');
+        mod.setValue(base + 8, copyToHeap(column.offsets), 'i32');
+        mod.setValue(base + 12, copyToHeap(column.nulls), 'i32');
+      }
+
+      // idx_t arguments are passed as (low, high) pairs
+      const status = mod.ccall(
+        'duckdb_wasm_execute_batch',
+        'number',
+        ['number', 'number', 'number', 'number', 'number', 'number', 'number', 'number', 'number'],
+        [
+          this.getConnectionPtr(info.connectionId),
+          info.stmtPtr,
+          columnsPtr,
+          data.columns.length,
+          0,
+          data.rowCount,
+          0,
+          outRowsPtr,
+          outErrorPtr,
+        ],
+      ) as number;
+
+      if (status !== 0) {
+        const errorPtr = mod.getValue(outErrorPtr, '*');
+        const error = errorPtr ? mod.UTF8ToString(errorPtr) : 'Execute batch failed';
+        if (errorPtr) {
+          mod._free(errorPtr);
+        }
+        throw new Error(error);
+      }
+
+      const rowsChanged =
+        (mod.getValue(outRowsPtr, 'i32') >>> 0) +
+        (mod.getValue(outRowsPtr + 4, 'i32') >>> 0) * 0x100000000;
+      this.postResponse(requestId, WorkerResponseType.ROWS_CHANGED, { rowsChanged });
+    } finally {
+      for (const ptr of allocations) {
+        mod._free(ptr);
+      }
+      mod._free(columnsPtr);
+      mod._free(outRowsPtr);
+      mod._free(outErrorPtr);
+    }
+  }
+
   private handleClosePrepared(requestId: number, data: ClosePreparedRequest): void {
     const mod = this.getModule();
     const info = this.preparedStatements.get(data.preparedStatementId);
 
-    if (info) {
+    if (info && info.connectionId === data.connectionId) {
       // duckdb_destroy_prepare expects a pointer to the statement pointer
       const stmtPtrPtr = mod._malloc(4);
       try {
@@ -974,6 +2050,18 @@ export class DuckDBDispatcher {
     this.postOK(requestId);
   }
 
+  private getPreparedStatement(
+    connectionId: number,
+    preparedStatementId: number,
+  ): PreparedStatementInfo {
+    const info = this.preparedStatements.get(preparedStatementId);
+    // Statements of other connections look the same as statements that do not exist
+    if (!info || info.connectionId !== connectionId) {
+      throw new Error(`Prepared statement ${preparedStatementId} not found`);
+    }
+    return info;
+  }
+
   private applyBindings(
     mod: EmscriptenModule,
     stmtPtr: number,
@@ -1186,9 +2274,37 @@ export class DuckDBDispatcher {
     this.postOK(requestId);
   }
 
+  private async handleRegisterFileHandle(
+    requestId: number,
+    data: RegisterFileHandleRequest,
+  ): Promise<void> {
+    // Read ranges straight from the Blob instead of copying it into MEMFS
+    const blob = data.handle instanceof Blob ? data.handle : await data.handle.getFile();
+    this.getJSFiles().register(data.name, blobFile(blob));
+    this.postOK(requestId);
+  }
+
+  private async handleRegisterOPFSFile(
+    requestId: number,
+    data: RegisterOPFSFileRequest,
+  ): Promise<void> {
+    const path = `${OPFS_PREFIX}${data.name}`;
+    const { file, existed } = await openOPFSFile(path);
+    this.getJSFiles().register(path, file, existed);
+    this.postOK(requestId);
+  }
+
   private handleDropFile(requestId: number, data: DropFileRequest): void {
     const mod = this.getModule();
 
+    // Blob and OPFS files live in the JS-backed file system
+    const file = this.getJSFiles().unregister(data.name);
+    if (file) {
+      file.close();
+      this.postOK(requestId);
+      return;
+    }
+
     try {
       const path = `/${data.name}`;
       (mod as unknown as { FS: { unlink: (path: string) => void } }).FS.unlink(path);
@@ -1279,17 +2395,73 @@ export class DuckDBDispatcher {
 
     const bufPtr = mod._malloc(data.ipcBuffer.length);
     mod.HEAPU8.set(data.ipcBuffer, bufPtr);
+    const outErrorPtr = mod._malloc(4);
+    mod.setValue(outErrorPtr, 0, '*');
+
+    try {
+      const result = mod.ccall(
+        data.append ? 'duckdb_wasm_append_arrow_ipc' : 'duckdb_wasm_insert_arrow_ipc',
+        'number',
+        ['number', 'string', 'number', 'number', 'number'],
+        [connPtr, data.tableName, bufPtr, data.ipcBuffer.length, outErrorPtr],
+      ) as number;
+
+      if (result !== 0) {
+        const errorPtr = mod.getValue(outErrorPtr, '*');
+        const error = errorPtr ? mod.UTF8ToString(errorPtr) : 'Arrow IPC insert failed';
+        if (errorPtr) {
+          mod._free(errorPtr);
+        }
+        throw new Error(`Failed to insert Arrow IPC data into "${data.tableName}": ${error}`);
+      }
+    } finally {
+      mod._free(bufPtr);
+      mod._free(outErrorPtr);
+    }
+
+    this.postOK(requestId);
+  }
+
+  private handleArrowIngestOpen(requestId: number, data: ArrowIngestOpenRequest): void {
+    const mod = this.getModule();
+    const connPtr = this.getConnectionPtr(data.connectionId);
+
+    const ingestPtr = mod.ccall(
+      'duckdb_wasm_arrow_ipc_ingest_open',
+      'number',
+      ['number', 'string', 'number'],
+      [connPtr, data.tableName, data.append ? 1 : 0],
+    ) as number;
+
+    if (!ingestPtr) {
+      throw new Error(`Failed to start Arrow IPC ingest into "${data.tableName}"`);
+    }
+
+    const ingestId = this.nextArrowIngestId++;
+    this.arrowIngests.set(ingestId, { ingestPtr, connectionId: data.connectionId });
+
+    this.postResponse(requestId, WorkerResponseType.ARROW_INGEST_ID, { ingestId });
+  }
+
+  private handleArrowIngestPush(requestId: number, data: ArrowIngestPushRequest): void {
+    const mod = this.getModule();
+    // Ingest runs queries on the connection; buffer any live stream first
+    this.getConnectionPtr(data.connectionId);
+    const ingestPtr = this.getArrowIngestPtr(data.connectionId, data.ingestId);
+
+    const bufPtr = mod._malloc(data.bytes.length);
+    mod.HEAPU8.set(data.bytes, bufPtr);
 
     try {
       const result = mod.ccall(
-        'duckdb_wasm_insert_arrow_ipc',
+        'duckdb_wasm_arrow_ipc_ingest_push',
         'number',
-        ['number', 'string', 'number', 'number'],
-        [connPtr, data.tableName, bufPtr, data.ipcBuffer.length],
+        ['number', 'number', 'number'],
+        [ingestPtr, bufPtr, data.bytes.length],
       ) as number;
 
       if (result !== 0) {
-        throw new Error(`Failed to insert Arrow IPC data into "${data.tableName}"`);
+        throw new Error(this.getArrowIngestError(ingestPtr));
       }
     } finally {
       mod._free(bufPtr);
@@ -1298,6 +2470,57 @@ export class DuckDBDispatcher {
     this.postOK(requestId);
   }
 
+  private handleArrowIngestFinish(requestId: number, data: ArrowIngestFinishRequest): void {
+    const mod = this.getModule();
+    this.getConnectionPtr(data.connectionId);
+    const ingestPtr = this.getArrowIngestPtr(data.connectionId, data.ingestId);
+
+    const result = mod.ccall(
+      'duckdb_wasm_arrow_ipc_ingest_finish',
+      'number',
+      ['number'],
+      [ingestPtr],
+    ) as number;
+
+    if (result !== 0) {
+      throw new Error(this.getArrowIngestError(ingestPtr));
+    }
+
+    this.postOK(requestId);
+  }
+
+  private handleArrowIngestClose(requestId: number, data: ArrowIngestCloseRequest): void {
+    const mod = this.getModule();
+    const info = this.arrowIngests.get(data.ingestId);
+
+    if (info && info.connectionId === data.connectionId) {
+      mod.ccall('duckdb_wasm_arrow_ipc_ingest_destroy', null, ['number'], [info.ingestPtr]);
+      this.arrowIngests.delete(data.ingestId);
+    }
+
+    this.postOK(requestId);
+  }
+
+  private getArrowIngestPtr(connectionId: number, ingestId: number): number {
+    const info = this.arrowIngests.get(ingestId);
+    // Ingests of other connections look the same as ingests that do not exist
+    if (!info || info.connectionId !== connectionId) {
+      throw new Error(`Arrow IPC ingest ${ingestId} not found`);
+    }
+    return info.ingestPtr;
+  }
+
+  private getArrowIngestError(ingestPtr: number): string {
+    const mod = this.getModule();
+    const errorPtr = mod.ccall(
+      'duckdb_wasm_arrow_ipc_ingest_error',
+      'number',
+      ['number'],
+      [ingestPtr],
+    ) as number;
+    return errorPtr ? mod.UTF8ToString(errorPtr) : 'Arrow IPC ingest failed';
+  }
+
   private handleInsertCSVFromPath(requestId: number, data: InsertCSVFromPathRequest): void {
     let sql = `CREATE TABLE IF NOT EXISTS "${data.tableName}" AS SELECT * FROM read_csv('/${data.path}'`;
 
@@ -1372,255 +2595,135 @@ export class DuckDBDispatcher {
     return columns;
   }
 
+  /**
+   * Copy every chunk of a materialized result into columnar vectors.
+   */
   private extractQueryResult(
     mod: EmscriptenModule,
     resultPtr: number,
-  ): { columns: ColumnInfo[]; rows: unknown[][] } {
+  ): { columns: ColumnInfo[]; chunks: ResultChunk[]; transfer: ArrayBuffer[] } {
     const columns = this.getColumnInfo(mod, resultPtr);
-    const rowCount = mod.ccall('duckdb_row_count', 'number', ['number'], [resultPtr]) as number;
-    const rows = this.extractRows(mod, resultPtr, columns, 0, rowCount);
-    return { columns, rows };
-  }
-
-  private extractRows(
-    mod: EmscriptenModule,
-    resultPtr: number,
-    columns: ColumnInfo[],
-    startRow: number,
-    endRow: number,
-  ): unknown[][] {
-    const rows: unknown[][] = [];
-    const columnCount = columns.length;
-
-    for (let rowIdx = startRow; rowIdx < endRow; rowIdx++) {
-      const row: unknown[] = [];
-      for (let colIdx = 0; colIdx < columnCount; colIdx++) {
-        const col = columns[colIdx];
-
-        // Check for null
-        const isNull = mod.ccall(
-          'duckdb_value_is_null',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
-
-        if (isNull) {
-          row.push(null);
-        } else {
-          row.push(this.extractValue(mod, resultPtr, colIdx, rowIdx, col.type));
-        }
-      }
-      rows.push(row);
-    }
-
-    return rows;
-  }
-
-  private extractValue(
-    mod: EmscriptenModule,
-    resultPtr: number,
-    colIdx: number,
-    rowIdx: number,
-    type: DuckDBTypeId,
-  ): unknown {
-    // idx_t parameters need to be passed as two i32 values (low, high)
-    switch (type) {
-      case DuckDBType.BOOLEAN: {
-        const val = mod.ccall(
-          'duckdb_value_boolean',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
-        return val !== 0;
-      }
-      case DuckDBType.TINYINT:
-        return mod.ccall(
-          'duckdb_value_int8',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
-      case DuckDBType.SMALLINT:
-        return mod.ccall(
-          'duckdb_value_int16',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
-      case DuckDBType.INTEGER:
-        return mod.ccall(
-          'duckdb_value_int32',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
-      case DuckDBType.BIGINT: {
-        // Return as number if within safe integer range, otherwise as string for JSON compatibility
-        const strPtr = mod.ccall(
-          'duckdb_value_varchar',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
-        if (strPtr) {
-          const val = mod.UTF8ToString(strPtr);
-          mod._free(strPtr);
-          const num = Number(val);
-          // Return as number if it fits safely, otherwise keep as string
-          return Number.isSafeInteger(num) ? num : val;
-        }
-        return null;
-      }
-      case DuckDBType.UTINYINT:
-        return mod.ccall(
-          'duckdb_value_uint8',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
-      case DuckDBType.USMALLINT:
-        return mod.ccall(
-          'duckdb_value_uint16',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
-      case DuckDBType.UINTEGER: {
-        // Convert signed i32 to unsigned using >>> 0
-        const signed = mod.ccall(
-          'duckdb_value_uint32',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
-        return signed >>> 0;
+    const chunks: ResultChunk[] = [];
+    const transfer: ArrayBuffer[] = [];
+    while (true) {
+      const chunkPtr = mod.ccall('duckdb_fetch_chunk', 'number', ['number'], [resultPtr]) as number;
+      if (!chunkPtr) {
+        break;
       }
-      case DuckDBType.UBIGINT: {
-        // Return as number if within safe integer range, otherwise as string for JSON compatibility
-        const strPtr = mod.ccall(
-          'duckdb_value_varchar',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
-        if (strPtr) {
-          const val = mod.UTF8ToString(strPtr);
-          mod._free(strPtr);
-          const num = Number(val);
-          // Return as number if it fits safely, otherwise keep as string
-          return Number.isSafeInteger(num) ? num : val;
-        }
-        return null;
-      }
-      case DuckDBType.FLOAT:
-        return mod.ccall(
-          'duckdb_value_float',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
-      case DuckDBType.DOUBLE:
-        return mod.ccall(
-          'duckdb_value_double',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
-      default: {
-        // Fallback to varchar for all other types
-        const strPtr = mod.ccall(
-          'duckdb_value_varchar',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
-        if (strPtr) {
-          const val = mod.UTF8ToString(strPtr);
-          mod._free(strPtr);
-          return val;
+      try {
+        const chunk = this.extractChunkVectors(mod, chunkPtr, columns);
+        if (chunk.rowCount > 0) {
+          chunks.push({ vectors: chunk.vectors, rowCount: chunk.rowCount });
+          transfer.push(...chunk.transfer);
         }
-        return null;
+      } finally {
+        this.destroyDataChunk(mod, chunkPtr);
       }
     }
+    return { columns, chunks, transfer };
   }
 
-  private buildArrowTable(
+  /**
+   * Copy a data chunk into columnar vectors.
+   *
+   * Fixed-width data and validity buffers are memcpy'd out of the heap and
+   * VARCHARs are packed as offsets + bytes. Other types are converted to
+   * DuckDB's VARCHAR rendering.
+   */
+  private extractChunkVectors(
     mod: EmscriptenModule,
-    resultPtr: number,
-  ): ReturnType<typeof tableFromArrays> {
-    const columns = this.getColumnInfo(mod, resultPtr);
-    const rowCount = mod.ccall('duckdb_row_count', 'number', ['number'], [resultPtr]) as number;
-    const columnCount = columns.length;
+    chunkPtr: number,
+    columns: ColumnInfo[],
+  ): { vectors: ColumnVector[]; rowCount: number; transfer: ArrayBuffer[] } {
+    const rowCount = mod.ccall(
+      'duckdb_data_chunk_get_size',
+      'number',
+      ['number'],
+      [chunkPtr],
+    ) as number;
+
+    const vectors: ColumnVector[] = [];
+    const transfer: ArrayBuffer[] = [];
 
-    const columnArrays: Record<string, { type: DataType; values: unknown[] }> = {};
+    for (let colIdx = 0; colIdx < columns.length; colIdx++) {
+      // idx_t parameters need to be passed as two i32 values (low, high)
+      const vectorPtr = mod.ccall(
+        'duckdb_data_chunk_get_vector',
+        'number',
+        ['number', 'number', 'number'],
+        [chunkPtr, colIdx, 0],
+      ) as number;
+      const dataPtr = mod.ccall('duckdb_vector_get_data', 'number', ['number'], [vectorPtr]) as number;
+      const validityPtr = mod.ccall(
+        'duckdb_vector_get_validity',
+        'number',
+        ['number'],
+        [vectorPtr],
+      ) as number;
 
-    for (let colIdx = 0; colIdx < columnCount; colIdx++) {
-      const col = columns[colIdx];
-      const flechetteType = this.getFlechetteType(col.type);
-      const values: unknown[] = [];
+      // Validity is a uint64_t bitmask; a NULL pointer means all rows are valid
+      const validity = validityPtr
+        ? mod.HEAPU8.slice(validityPtr, validityPtr + Math.ceil(rowCount / 64) * 8)
+        : null;
+      const isValid = (row: number) => !validity || ((validity[row >> 3] >> (row & 7)) & 1) === 1;
+
+      const type = columns[colIdx].type;
+      const fixed = FIXED_WIDTH_ARRAYS[type];
+      if (fixed) {
+        const bytes = mod.HEAPU8.slice(dataPtr, dataPtr + rowCount * fixed.BYTES_PER_ELEMENT);
+        vectors.push({ kind: 'fixed', data: new fixed(bytes.buffer), validity });
+        transfer.push(bytes.buffer);
+      } else if (type === DuckDBType.VARCHAR) {
+        // duckdb_string_t: 4-byte length, then 12 inlined bytes or a 4-byte prefix + pointer
+        const offsets = new Int32Array(rowCount + 1);
+        let total = 0;
+        for (let row = 0; row < rowCount; row++) {
+          if (isValid(row)) {
+            total += mod.HEAPU32[(dataPtr + row * 16) >> 2];
+          }
+          offsets[row + 1] = total;
+        }
 
-      for (let rowIdx = 0; rowIdx < rowCount; rowIdx++) {
-        const isNull = mod.ccall(
-          'duckdb_value_is_null',
-          'number',
-          ['number', 'number', 'number', 'number', 'number'],
-          [resultPtr, colIdx, 0, rowIdx, 0],
-        ) as number;
+        const bytes = new Uint8Array(total);
+        for (let row = 0; row < rowCount; row++) {
+          const length = offsets[row + 1] - offsets[row];
+          if (length > 0) {
+            const strBase = dataPtr + row * 16;
+            const strPtr = length <= 12 ? strBase + 4 : mod.HEAPU32[(strBase + 8) >> 2];
+            bytes.set(mod.HEAPU8.subarray(strPtr, strPtr + length), offsets[row]);
+          }
+        }
 
-        if (isNull) {
-          values.push(null);
-        } else {
-          values.push(this.extractValue(mod, resultPtr, colIdx, rowIdx, col.type));
+        vectors.push({ kind: 'string', offsets, bytes, validity });
+        transfer.push(offsets.buffer, bytes.buffer);
+      } else {
+        const values: unknown[] = new Array(rowCount);
+        for (let row = 0; row < rowCount; row++) {
+          values[row] = isValid(row) ? this.readVectorVarchar(mod, vectorPtr, row) : null;
         }
+        vectors.push({ kind: 'values', values });
+      }
+
+      if (validity) {
+        transfer.push(validity.buffer);
       }
+    }
 
-      columnArrays[col.name] = { type: flechetteType, values };
-    }
-
-    // Build arrays for tableFromArrays
-    const arrays: Record<string, unknown[]> = {};
-    for (const [name, { values }] of Object.entries(columnArrays)) {
-      arrays[name] = values;
-    }
-
-    return tableFromArrays(arrays);
-  }
-
-  private getFlechetteType(duckdbType: DuckDBTypeId): DataType {
-    switch (duckdbType) {
-      case DuckDBType.BOOLEAN:
-        return bool();
-      case DuckDBType.TINYINT:
-        return int8();
-      case DuckDBType.SMALLINT:
-        return int16();
-      case DuckDBType.INTEGER:
-        return int32();
-      case DuckDBType.BIGINT:
-        return int64();
-      case DuckDBType.UTINYINT:
-        return uint8();
-      case DuckDBType.USMALLINT:
-        return uint16();
-      case DuckDBType.UINTEGER:
-        return uint32();
-      case DuckDBType.UBIGINT:
-        return uint64();
-      case DuckDBType.FLOAT:
-        return float32();
-      case DuckDBType.DOUBLE:
-        return float64();
-      case DuckDBType.VARCHAR:
-        return utf8();
-      case DuckDBType.DATE:
-        return dateDay();
-      case DuckDBType.TIMESTAMP:
-      case DuckDBType.TIMESTAMP_TZ:
-        return timestamp(TimeUnit.MICROSECOND);
-      default:
-        return utf8(); // Fallback to string
+    return { vectors, rowCount, transfer };
+  }
+
+  private readVectorVarchar(mod: EmscriptenModule, vectorPtr: number, rowIdx: number): unknown {
+    const strPtr = mod.ccall(
+      'duckdb_wasm_vector_value_varchar',
+      'number',
+      ['number', 'number'],
+      [vectorPtr, rowIdx],
+    ) as number;
+    if (strPtr) {
+      const val = mod.UTF8ToString(strPtr);
+      mod._free(strPtr);
+      return val;
     }
+    return null;
   }
 }
@@ -0,0 +1,81 @@
+/**
+ * Fetch helper worker for concurrent HTTP range reads
+ *
+ * The dispatcher runs DuckDB synchronously, so without Asyncify every range read is a
+ * blocking XMLHttpRequest and a Parquet scan fetches one block after the other. With
+ * cross-origin isolation the module can instead hand a batch of range requests to this
+ * helper: it posts them with a SharedArrayBuffer, the helper runs them as concurrent
+ * `fetch()` calls and writes the bodies into the buffer, and the calling thread sleeps in
+ * `Atomics.wait` until the batch is done (see em_helper_batch_request in
+ * src/http/http_async.js).
+ *
+ * Buffer layout: an Int32 state (0 while running, 1 when done), one Int32 length per
+ * request (-1 on failure), then the bodies at the offsets their ranges add up to.
+ *
+ * @packageDocumentation
+ */
+
+/** A batch of range requests posted to the helper. */
+export interface FetchHelperBatch {
+  url: string;
+  headers: Record<string, string>;
+  /** Inclusive [start, end] byte ranges */
+  ranges: [number, number][];
+  buffer: SharedArrayBuffer;
+}
+
+/**
+ * Body of the helper worker. It is started from its source text, so it must not refer
+ * to anything outside itself.
+ */
+function fetchHelperMain(): void {
+  self.onmessage = (event: MessageEvent<FetchHelperBatch>) => {
+    const { url, headers, ranges, buffer } = event.data;
+    const control = new Int32Array(buffer, 0, ranges.length + 1);
+    const bytes = new Uint8Array(buffer);
+    let offset = 4 * (ranges.length + 1);
+
+    const requests = ranges.map(([start, end], i) => {
+      const at = offset;
+      const expected = end - start + 1;
+      offset += expected;
+      return fetch(url, { headers: { ...headers, Range: `bytes=${start}-${end}` } })
+        .then((response) => (response.ok ? response.arrayBuffer() : null))
+        .then((body) => {
+          // A server that ignores Range sends more than the slot holds; the module
+          // retries such ranges with XMLHttpRequest
+          if (!body || body.byteLength > expected) {
+            control[i + 1] = -1;
+            return;
+          }
+          bytes.set(new Uint8Array(body), at);
+          control[i + 1] = body.byteLength;
+        })
+        .catch(() => {
+          control[i + 1] = -1;
+        });
+    });
+
+    Promise.all(requests).then(() => {
+      Atomics.store(control, 0, 1);
+      Atomics.notify(control, 0);
+    });
+  };
+}
+
+/**
+ * Start the helper worker, or return null where it cannot work: without cross-origin
+ * isolation there is no SharedArrayBuffer, and a CSP may forbid blob: workers.
+ */
+export function startFetchHelper(): Worker | null {
+  if (typeof SharedArrayBuffer === 'undefined' || !globalThis.crossOriginIsolated) {
+    return null;
+  }
+  try {
+    const source = `(${fetchHelperMain.toString()})();`;
+    const url = URL.createObjectURL(new Blob([source], { type: 'text/javascript' }));
+    return new Worker(url);
+  } catch {
+    return null;
+  }
+}
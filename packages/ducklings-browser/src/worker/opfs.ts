@@ -0,0 +1,165 @@
+/**
+ * Origin Private File System (OPFS) files for the worker's JS-backed file system
+ *
+ * DuckDB reads and writes `opfs://` paths through JSFileSystem, which calls into the
+ * file objects registered in the module's `jsFiles` registry (see src/fs/js_files.js).
+ * Sync access handles can only be created asynchronously, so every file has to be
+ * opened before DuckDB touches it: the database file and its WAL when the database is
+ * opened, explicitly registered files, and a pool of spare handles for files DuckDB
+ * creates on its own (spill files in `temp_directory`).
+ *
+ * @packageDocumentation
+ */
+
+/** Path prefix handled by JSFileSystem for OPFS files. */
+export const OPFS_PREFIX = 'opfs://';
+
+/** Number of spare OPFS handles for files DuckDB creates on its own. */
+export const DEFAULT_OPFS_TEMP_FILES = 8;
+
+/** OPFS directory holding the spare handles. */
+const TEMP_POOL_DIRECTORY = '.ducklings-tmp';
+
+/**
+ * The synchronous file interface JSFileSystem calls into.
+ * Matches FileSystemSyncAccessHandle, which is only typed in worker libs.
+ */
+export interface JSFile {
+  read(buffer: Uint8Array, options?: { at?: number }): number;
+  write?(buffer: Uint8Array, options?: { at?: number }): number;
+  getSize(): number;
+  truncate?(size: number): void;
+  flush?(): void;
+  close(): void;
+  /** Called instead of close() when a file made by a creator is removed */
+  release?(): void;
+}
+
+/**
+ * Registry of JS-backed files exposed by the Emscripten module.
+ * @internal
+ */
+export interface JSFileRegistry {
+  register(path: string, file: JSFile, exists?: boolean): number;
+  unregister(path: string): JSFile | null;
+  unregisterAll(): JSFile[];
+  setCreator(prefix: string, creator: ((path: string) => JSFile | null) | null): void;
+}
+
+interface OPFSFileHandle extends FileSystemFileHandle {
+  createSyncAccessHandle(): Promise<JSFile>;
+}
+
+/**
+ * Check whether a path is stored in OPFS.
+ */
+export function isOPFSPath(path: string): boolean {
+  return path.startsWith(OPFS_PREFIX);
+}
+
+/**
+ * Resolve an `opfs://dir/file` path to its OPFS directory handle and file name.
+ */
+async function resolveOPFSPath(
+  path: string,
+): Promise<{ directory: FileSystemDirectoryHandle; name: string }> {
+  if (typeof navigator === 'undefined' || !navigator.storage?.getDirectory) {
+    throw new Error('OPFS is not available in this environment');
+  }
+  const parts = path.slice(OPFS_PREFIX.length).split('/').filter(Boolean);
+  const name = parts.pop();
+  if (!name) {
+    throw new Error(`Invalid OPFS path: ${path}`);
+  }
+  let directory = await navigator.storage.getDirectory();
+  for (const part of parts) {
+    directory = await directory.getDirectoryHandle(part, { create: true });
+  }
+  return { directory, name };
+}
+
+/**
+ * Open a sync access handle for an OPFS path, creating the file if needed.
+ *
+ * @returns The handle and whether the file existed before
+ */
+export async function openOPFSFile(path: string): Promise<{ file: JSFile; existed: boolean }> {
+  const { directory, name } = await resolveOPFSPath(path);
+  let handle: FileSystemFileHandle;
+  let existed = true;
+  try {
+    handle = await directory.getFileHandle(name);
+  } catch {
+    handle = await directory.getFileHandle(name, { create: true });
+    existed = false;
+  }
+  const file = await (handle as OPFSFileHandle).createSyncAccessHandle();
+  return { file, existed };
+}
+
+/**
+ * Spare OPFS handles handed to files DuckDB creates without registration.
+ *
+ * The OPFS names of pooled files are internal, so their contents only live as long
+ * as DuckDB keeps them; that fits spill files, which DuckDB removes when done.
+ */
+export class OPFSTempPool {
+  private free: JSFile[];
+  private all: JSFile[];
+
+  private constructor(files: JSFile[]) {
+    this.all = files;
+    this.free = files.slice();
+  }
+
+  /**
+   * Open and empty `count` pooled handles.
+   */
+  static async open(count: number): Promise<OPFSTempPool> {
+    const files: JSFile[] = [];
+    for (let i = 0; i < count; i++) {
+      const { file } = await openOPFSFile(`${OPFS_PREFIX}${TEMP_POOL_DIRECTORY}/slot-${i}`);
+      file.truncate?.(0);
+      files.push(file);
+    }
+    return new OPFSTempPool(files);
+  }
+
+  /**
+   * Take a free handle, or null when all are in use.
+   */
+  take(): JSFile | null {
+    const handle = this.free.pop();
+    if (!handle) {
+      return null;
+    }
+    const pool = this.free;
+    // Wrap so that removing the file returns the handle to the pool instead of closing it
+    return {
+      read: (buffer, options) => handle.read(buffer, options),
+      write: (buffer, options) => handle.write?.(buffer, options) ?? 0,
+      getSize: () => handle.getSize(),
+      truncate: (size) => handle.truncate?.(size),
+      flush: () => handle.flush?.(),
+      close: () => {},
+      release: () => {
+        pool.push(handle);
+      },
+    };
+  }
+
+  /**
+   * Close all pooled handles.
+   */
+  close(): void {
+    for (const handle of this.all) {
+      try {
+        handle.close();
+      } catch {
+        // Already closed
+      }
+    }
+    this.all = [];
+    this.free = [];
+  }
+}
@@ -3,7 +3,18 @@
  * @packageDocumentation
  */
 
-import type { ColumnInfo, CSVInsertOptions, DuckDBConfig, JSONInsertOptions } from '../types.js';
+import type {
+  ColumnInfo,
+  ColumnVector,
+  CSVInsertOptions,
+  DuckDBConfig,
+  DuckDBTypeId,
+  JSONInsertOptions,
+  LogLevel,
+  MemoryOptions,
+  QueryProfile,
+  QueryProgress,
+} from '../types.js';
 
 /**
  * Request types sent from main thread to worker.
@@ -15,8 +26,11 @@ export enum WorkerRequestType {
   GET_VERSION = 'GET_VERSION',
   OPEN = 'OPEN',
   CLOSE = 'CLOSE',
+  CREATE_SNAPSHOT = 'CREATE_SNAPSHOT',
   CONNECT = 'CONNECT',
   DISCONNECT = 'DISCONNECT',
+  /** Sent by a client leaving a shared worker; handled by the shared worker itself */
+  DETACH = 'DETACH',
 
   // Query operations
   QUERY = 'QUERY',
@@ -26,11 +40,15 @@ export enum WorkerRequestType {
   FETCH_CHUNK = 'FETCH_CHUNK',
   CLOSE_STREAMING_RESULT = 'CLOSE_STREAMING_RESULT',
   RESET_STREAMING_RESULT = 'RESET_STREAMING_RESULT',
+  QUERY_ARROW_STREAM = 'QUERY_ARROW_STREAM',
+  FETCH_ARROW_BATCH = 'FETCH_ARROW_BATCH',
+  CLOSE_ARROW_STREAM = 'CLOSE_ARROW_STREAM',
 
   // Prepared statements
   PREPARE = 'PREPARE',
   RUN_PREPARED = 'RUN_PREPARED',
   EXECUTE_PREPARED = 'EXECUTE_PREPARED',
+  EXECUTE_BATCH = 'EXECUTE_BATCH',
   CLOSE_PREPARED = 'CLOSE_PREPARED',
 
   // Transactions
@@ -43,6 +61,7 @@ export enum WorkerRequestType {
   REGISTER_FILE_BUFFER = 'REGISTER_FILE_BUFFER',
   REGISTER_FILE_HANDLE = 'REGISTER_FILE_HANDLE',
   REGISTER_FILE_TEXT = 'REGISTER_FILE_TEXT',
+  REGISTER_OPFS_FILE = 'REGISTER_OPFS_FILE',
 
   // File operations
   DROP_FILE = 'DROP_FILE',
@@ -56,6 +75,13 @@ export enum WorkerRequestType {
   INSERT_ARROW_FROM_IPC = 'INSERT_ARROW_FROM_IPC',
   INSERT_CSV_FROM_PATH = 'INSERT_CSV_FROM_PATH',
   INSERT_JSON_FROM_PATH = 'INSERT_JSON_FROM_PATH',
+  ARROW_INGEST_OPEN = 'ARROW_INGEST_OPEN',
+  ARROW_INGEST_PUSH = 'ARROW_INGEST_PUSH',
+  ARROW_INGEST_FINISH = 'ARROW_INGEST_FINISH',
+  ARROW_INGEST_CLOSE = 'ARROW_INGEST_CLOSE',
+
+  // Pipelining
+  PIPELINE = 'PIPELINE',
 }
 
 /**
@@ -74,6 +100,12 @@ export enum WorkerResponseType {
   PREPARED_STATEMENT_ID = 'PREPARED_STATEMENT_ID',
   FILE_BUFFER = 'FILE_BUFFER',
   FILE_INFO_LIST = 'FILE_INFO_LIST',
+  ARROW_INGEST_ID = 'ARROW_INGEST_ID',
+  ARROW_STREAM_ID = 'ARROW_STREAM_ID',
+  PIPELINE_RESULT = 'PIPELINE_RESULT',
+  SNAPSHOT = 'SNAPSHOT',
+  /** Sent while a query runs; the request stays pending until its final response */
+  QUERY_PROGRESS = 'QUERY_PROGRESS',
 }
 
 // ============================================================================
@@ -83,15 +115,41 @@ export enum WorkerResponseType {
 export interface InstantiateRequest {
   wasmUrl?: string;
   wasmJsUrl?: string;
+  /** Build being loaded ('mt', 'simd' or 'baseline'), recorded in snapshots */
+  variant?: string;
+  /** Memory snapshot to restore instead of opening a database */
+  snapshot?: Uint8Array;
+  /** Console output of the module (default: 'warn') */
+  logLevel?: LogLevel;
+  /** Serve HTTP range reads from a fetch helper worker where possible (default: true) */
+  fetchWorker?: boolean;
+  /** Initial and maximum size of the WebAssembly memory */
+  memory?: MemoryOptions;
 }
 
 export interface OpenRequest {
   config?: DuckDBConfig;
 }
 
+/**
+ * Cancellation and progress for a running query.
+ *
+ * With a control the worker drives the query task by task instead of in one call,
+ * checking the interrupt flag and reporting progress between tasks.
+ */
+export interface QueryControl {
+  /** Flag in a SharedArrayBuffer; the main thread stores a non-zero value to interrupt */
+  interrupt?: Int32Array;
+  /** Post QUERY_PROGRESS responses at most this often (ms) while the query runs */
+  progressInterval?: number;
+}
+
 export interface QueryRequest {
   connectionId: number;
   sql: string;
+  control?: QueryControl;
+  /** Collect a profile of the query and return it with the rows */
+  profile?: boolean;
 }
 
 export interface QueryArrowRequest {
@@ -99,6 +157,23 @@ export interface QueryArrowRequest {
   sql: string;
 }
 
+export interface QueryArrowStreamRequest {
+  connectionId: number;
+  sql: string;
+  /** Rows to encode into each batch response (0: one DuckDB chunk) */
+  batchRows?: number;
+}
+
+export interface FetchArrowBatchRequest {
+  connectionId: number;
+  arrowStreamId: number;
+}
+
+export interface CloseArrowStreamRequest {
+  connectionId: number;
+  arrowStreamId: number;
+}
+
 export interface QueryStreamingRequest {
   connectionId: number;
   sql: string;
@@ -107,6 +182,7 @@ export interface QueryStreamingRequest {
 export interface ExecuteRequest {
   connectionId: number;
   sql: string;
+  control?: QueryControl;
 }
 
 export interface FetchChunkRequest {
@@ -141,6 +217,25 @@ export interface ExecutePreparedRequest {
   bindings: PreparedStatementBinding[];
 }
 
+/**
+ * One parameter column of a batch, in the layout duckdb_wasm_execute_batch reads.
+ * VARCHAR and BLOB columns hold their bytes back to back with `rowCount + 1` offsets.
+ */
+export interface BatchParamColumn {
+  type: DuckDBTypeId;
+  data: ArrayBufferView;
+  offsets?: Uint32Array;
+  /** One byte per row, non-zero for NULL */
+  nulls?: Uint8Array;
+}
+
+export interface ExecuteBatchRequest {
+  connectionId: number;
+  preparedStatementId: number;
+  rowCount: number;
+  columns: BatchParamColumn[];
+}
+
 export interface ClosePreparedRequest {
   connectionId: number;
   preparedStatementId: number;
@@ -164,9 +259,8 @@ export interface RegisterFileBufferRequest {
 
 export interface RegisterFileHandleRequest {
   name: string;
-  handle: FileSystemFileHandle;
-  protocol?: string;
-  directIO?: boolean;
+  /** Blobs and file handles are structured-cloned to the worker without copying the data */
+  handle: Blob | FileSystemFileHandle;
 }
 
 export interface RegisterFileTextRequest {
@@ -174,6 +268,10 @@ export interface RegisterFileTextRequest {
   text: string;
 }
 
+export interface RegisterOPFSFileRequest {
+  name: string;
+}
+
 export interface DropFileRequest {
   name: string;
 }
@@ -195,6 +293,29 @@ export interface InsertArrowFromIPCRequest {
   connectionId: number;
   tableName: string;
   ipcBuffer: Uint8Array;
+  append?: boolean;
+}
+
+export interface ArrowIngestOpenRequest {
+  connectionId: number;
+  tableName: string;
+  append?: boolean;
+}
+
+export interface ArrowIngestPushRequest {
+  connectionId: number;
+  ingestId: number;
+  bytes: Uint8Array;
+}
+
+export interface ArrowIngestFinishRequest {
+  connectionId: number;
+  ingestId: number;
+}
+
+export interface ArrowIngestCloseRequest {
+  connectionId: number;
+  ingestId: number;
 }
 
 export interface InsertCSVFromPathRequest {
@@ -233,15 +354,28 @@ export interface ConnectionIdResponse {
   connectionId: number;
 }
 
+/** The column vectors of one DataChunk of a result */
+export interface ResultChunk {
+  vectors: ColumnVector[];
+  rowCount: number;
+}
+
 export interface QueryResultResponse {
   columns: ColumnInfo[];
-  rows: unknown[][];
+  /** Buffers are transferred, not cloned; values are converted on the main thread */
+  chunks: ResultChunk[];
+  profile?: QueryProfile;
 }
 
 export interface ArrowIPCResponse {
+  /** IPC bytes; for FETCH_ARROW_BATCH the next messages, empty once the stream is complete */
   ipcBuffer: Uint8Array;
 }
 
+export interface ArrowStreamIdResponse {
+  arrowStreamId: number;
+}
+
 export interface StreamingResultInfoResponse {
   streamingResultId: number;
   columns: ColumnInfo[];
@@ -249,7 +383,8 @@ export interface StreamingResultInfoResponse {
 
 export interface DataChunkResponse {
   columns: ColumnInfo[];
-  rows: unknown[][];
+  /** One vector per column; buffers are transferred, not cloned */
+  vectors: ColumnVector[];
   rowCount: number;
   done: boolean;
 }
@@ -270,6 +405,53 @@ export interface FileInfoListResponse {
   files: { name: string; size: number }[];
 }
 
+export interface ArrowIngestIdResponse {
+  ingestId: number;
+}
+
+export interface SnapshotResponse {
+  snapshot: Uint8Array;
+}
+
+export type QueryProgressResponse = QueryProgress;
+
+export interface PipelineResultResponse {
+  /** One result per operation, in order; failed and skipped operations carry an ERROR */
+  results: PipelineOperationResult[];
+}
+
+// ============================================================================
+// Pipelining
+// ============================================================================
+
+/**
+ * Placeholder in a pipelined operation's payload for a field of an earlier result,
+ * e.g. `{ $ref: 0, field: 'connectionId' }` for the connection opened by operation 0.
+ */
+export interface PipelineRef {
+  $ref: number;
+  field: string;
+}
+
+export interface PipelineOperation {
+  type: WorkerRequestType;
+  /** Request payload; top-level fields may be PipelineRefs */
+  data?: unknown;
+}
+
+/**
+ * Operations run in order in one worker message. After the first failure the
+ * remaining operations are skipped.
+ */
+export interface PipelineRequest {
+  operations: PipelineOperation[];
+}
+
+export interface PipelineOperationResult {
+  type: WorkerResponseType;
+  data: unknown;
+}
+
 // ============================================================================
 // Prepared statement binding
 // ============================================================================
@@ -311,6 +493,8 @@ export interface WorkerRequest<T extends WorkerRequestType = WorkerRequestType,
   messageId: number;
   type: T;
   data: D;
+  /** Post-and-forget: the worker only responds if the request fails */
+  noReply?: boolean;
 }
 
 /**
@@ -337,6 +521,8 @@ export class WorkerTask<T = unknown> {
   private _resolve: (value: T) => void;
   private _reject: (error: Error) => void;
   readonly promise: Promise<T>;
+  /** Receives QUERY_PROGRESS responses for this request */
+  onProgress?: (progress: QueryProgress) => void;
 
   constructor(messageId: number, type: WorkerRequestType) {
     this.messageId = messageId;
@@ -377,8 +563,10 @@ export type RequestPayloadMap = {
   [WorkerRequestType.GET_VERSION]: undefined;
   [WorkerRequestType.OPEN]: OpenRequest;
   [WorkerRequestType.CLOSE]: undefined;
+  [WorkerRequestType.CREATE_SNAPSHOT]: undefined;
   [WorkerRequestType.CONNECT]: undefined;
   [WorkerRequestType.DISCONNECT]: DisconnectRequest;
+  [WorkerRequestType.DETACH]: undefined;
   [WorkerRequestType.QUERY]: QueryRequest;
   [WorkerRequestType.QUERY_ARROW]: QueryArrowRequest;
   [WorkerRequestType.QUERY_STREAMING]: QueryStreamingRequest;
@@ -386,9 +574,13 @@ export type RequestPayloadMap = {
   [WorkerRequestType.FETCH_CHUNK]: FetchChunkRequest;
   [WorkerRequestType.CLOSE_STREAMING_RESULT]: CloseStreamingResultRequest;
   [WorkerRequestType.RESET_STREAMING_RESULT]: ResetStreamingResultRequest;
+  [WorkerRequestType.QUERY_ARROW_STREAM]: QueryArrowStreamRequest;
+  [WorkerRequestType.FETCH_ARROW_BATCH]: FetchArrowBatchRequest;
+  [WorkerRequestType.CLOSE_ARROW_STREAM]: CloseArrowStreamRequest;
   [WorkerRequestType.PREPARE]: PrepareRequest;
   [WorkerRequestType.RUN_PREPARED]: RunPreparedRequest;
   [WorkerRequestType.EXECUTE_PREPARED]: ExecutePreparedRequest;
+  [WorkerRequestType.EXECUTE_BATCH]: ExecuteBatchRequest;
   [WorkerRequestType.CLOSE_PREPARED]: ClosePreparedRequest;
   [WorkerRequestType.BEGIN_TRANSACTION]: TransactionRequest;
   [WorkerRequestType.COMMIT]: TransactionRequest;
@@ -397,6 +589,7 @@ export type RequestPayloadMap = {
   [WorkerRequestType.REGISTER_FILE_BUFFER]: RegisterFileBufferRequest;
   [WorkerRequestType.REGISTER_FILE_HANDLE]: RegisterFileHandleRequest;
   [WorkerRequestType.REGISTER_FILE_TEXT]: RegisterFileTextRequest;
+  [WorkerRequestType.REGISTER_OPFS_FILE]: RegisterOPFSFileRequest;
   [WorkerRequestType.DROP_FILE]: DropFileRequest;
   [WorkerRequestType.DROP_FILES]: undefined;
   [WorkerRequestType.FLUSH_FILES]: undefined;
@@ -406,4 +599,9 @@ export type RequestPayloadMap = {
   [WorkerRequestType.INSERT_ARROW_FROM_IPC]: InsertArrowFromIPCRequest;
   [WorkerRequestType.INSERT_CSV_FROM_PATH]: InsertCSVFromPathRequest;
   [WorkerRequestType.INSERT_JSON_FROM_PATH]: InsertJSONFromPathRequest;
+  [WorkerRequestType.ARROW_INGEST_OPEN]: ArrowIngestOpenRequest;
+  [WorkerRequestType.ARROW_INGEST_PUSH]: ArrowIngestPushRequest;
+  [WorkerRequestType.ARROW_INGEST_FINISH]: ArrowIngestFinishRequest;
+  [WorkerRequestType.ARROW_INGEST_CLOSE]: ArrowIngestCloseRequest;
+  [WorkerRequestType.PIPELINE]: PipelineRequest;
 };
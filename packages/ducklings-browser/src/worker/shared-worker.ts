@@ -0,0 +1,355 @@
+/**
+ * DuckDB SharedWorker Entry Point
+ *
+ * Hosts a single DuckDBDispatcher for every page of the origin that connects to it, so
+ * the pages share one WASM instance, its registered files and its HTTP block cache.
+ *
+ * Each page talks to the dispatcher through its own MessagePort:
+ * - Message ids are rewritten, so the ids of different pages never collide.
+ * - Connection ids are handed out by the one dispatcher, and a page can only use the
+ *   connections it opened itself.
+ * - Requests run one at a time, taking turns between the pages that have requests
+ *   waiting, so one page's long queue cannot hold back the others.
+ * - The first page instantiates and opens the database; later pages find it ready.
+ *   When a page closes its database or goes away, only its own connections (and what
+ *   is still open on them) are released. After the last page leaves, the database is
+ *   closed, so the next page opens it with its own options.
+ * - OPFS is not available: sync access handles only exist in dedicated workers, so
+ *   OPFS database paths, OPFS temp directories and registered OPFS files are rejected.
+ *
+ * @packageDocumentation
+ */
+
+import { DuckDBDispatcher } from './dispatcher.js';
+import { isOPFSPath } from './opfs.js';
+import {
+  type ConnectionIdResponse,
+  type InstantiateRequest,
+  type OpenRequest,
+  type PipelineRef,
+  type PipelineRequest,
+  type PipelineResultResponse,
+  type WorkerRequest,
+  WorkerRequestType,
+  type WorkerResponse,
+  WorkerResponseType,
+} from './protocol.js';
+
+/** A page connected to the shared worker */
+interface Client {
+  port: MessagePort;
+  /** Requests waiting for their turn */
+  queue: (() => Promise<void>)[];
+  /** Connections the page opened */
+  connections: Set<number>;
+  /** The page has left; it is removed once its connections are released */
+  detached: boolean;
+}
+
+/** Request forwarded to the dispatcher, by the message id it was forwarded under */
+interface Route {
+  client: Client;
+  request: WorkerRequest;
+}
+
+/** Requests that change the database for every page, so they cannot be pipelined here */
+const LIFECYCLE_REQUESTS = new Set<WorkerRequestType>([
+  WorkerRequestType.INSTANTIATE,
+  WorkerRequestType.OPEN,
+  WorkerRequestType.CLOSE,
+]);
+
+/** Error for requests that need OPFS sync access handles */
+const OPFS_UNAVAILABLE =
+  'OPFS needs a dedicated worker: sync access handles are not available in a SharedWorker';
+
+const clients: Client[] = [];
+const routes: Map<number, Route> = new Map();
+let nextMessageId = 1;
+/** Index of the client whose turn comes next */
+let turn = 0;
+let running = false;
+let instantiated = false;
+let opened = false;
+
+const dispatcher = new DuckDBDispatcher((response, transfer) => {
+  const route = routes.get(response.requestId);
+  if (!route) {
+    // A request the shared worker made itself
+    return;
+  }
+  const { client, request } = route;
+  track(client, request.type, request.data, response);
+  const forwarded: WorkerResponse = {
+    ...response,
+    messageId: request.messageId,
+    requestId: request.messageId,
+  };
+  client.port.postMessage(forwarded, transfer ?? []);
+});
+
+/**
+ * Record what a successful response changes about the database or the client.
+ */
+function track(
+  client: Client,
+  type: WorkerRequestType,
+  data: unknown,
+  response: WorkerResponse,
+): void {
+  if (response.type === WorkerResponseType.ERROR) {
+    return;
+  }
+  switch (type) {
+    case WorkerRequestType.INSTANTIATE:
+      instantiated = true;
+      // A restored snapshot comes with its database open
+      opened ||= Boolean((data as InstantiateRequest).snapshot);
+      break;
+    case WorkerRequestType.OPEN:
+      opened = true;
+      break;
+    case WorkerRequestType.CONNECT:
+      client.connections.add((response.data as ConnectionIdResponse).connectionId);
+      break;
+    case WorkerRequestType.DISCONNECT:
+      client.connections.delete((data as { connectionId: number }).connectionId);
+      break;
+    case WorkerRequestType.PIPELINE: {
+      const { results } = response.data as PipelineResultResponse;
+      (data as PipelineRequest).operations.forEach((operation, i) => {
+        const payload = resolveRefs(operation.data, results);
+        track(client, operation.type, payload, { ...response, ...results[i] });
+      });
+      break;
+    }
+  }
+}
+
+/**
+ * Resolve the PipelineRefs of a pipelined operation's payload against the results.
+ */
+function resolveRefs(data: unknown, results: PipelineResultResponse['results']): unknown {
+  if (!data || typeof data !== 'object' || Array.isArray(data) || ArrayBuffer.isView(data)) {
+    return data;
+  }
+  const resolved: Record<string, unknown> = {};
+  for (const [key, value] of Object.entries(data)) {
+    const ref = value as PipelineRef | null;
+    resolved[key] =
+      ref && typeof ref === 'object' && typeof ref.$ref === 'number'
+        ? (results[ref.$ref]?.data as Record<string, unknown> | undefined)?.[ref.field]
+        : value;
+  }
+  return resolved;
+}
+
+/**
+ * Connection ids a request names directly (PipelineRefs resolve inside the pipeline).
+ */
+function connectionIds(type: WorkerRequestType, data: unknown): number[] {
+  if (type === WorkerRequestType.PIPELINE) {
+    return (data as PipelineRequest).operations.flatMap((operation) =>
+      connectionIds(operation.type, operation.data),
+    );
+  }
+  const connectionId = (data as { connectionId?: unknown } | undefined)?.connectionId;
+  return typeof connectionId === 'number' ? [connectionId] : [];
+}
+
+/**
+ * Answer a request from the shared worker itself.
+ */
+function reply(
+  client: Client,
+  request: WorkerRequest,
+  type: WorkerResponseType,
+  data?: unknown,
+): void {
+  if (request.noReply && type !== WorkerResponseType.ERROR) {
+    return;
+  }
+  const { messageId } = request;
+  const response: WorkerResponse = { messageId, requestId: messageId, type, data };
+  client.port.postMessage(response);
+}
+
+/**
+ * Run a request for the dispatcher without a client waiting for it.
+ */
+async function runInternal(type: WorkerRequestType, data?: unknown): Promise<void> {
+  const request: WorkerRequest = { messageId: nextMessageId++, type, data };
+  await dispatcher.onMessage({ data: request } as MessageEvent);
+}
+
+/**
+ * Disconnect the connections a client still holds.
+ */
+async function release(client: Client): Promise<void> {
+  for (const connectionId of client.connections) {
+    await runInternal(WorkerRequestType.DISCONNECT, { connectionId });
+  }
+  client.connections.clear();
+}
+
+/**
+ * Run one request of a client.
+ */
+async function run(client: Client, request: WorkerRequest): Promise<void> {
+  const { type, data } = request;
+
+  switch (type) {
+    case WorkerRequestType.INSTANTIATE:
+      if (instantiated) {
+        // A snapshot would replace the database the other pages are using
+        if ((data as InstantiateRequest).snapshot) {
+          const message = 'A snapshot cannot be restored into a database shared with other pages';
+          reply(client, request, WorkerResponseType.ERROR, { message });
+        } else {
+          reply(client, request, WorkerResponseType.OK);
+        }
+        return;
+      }
+      break;
+
+    case WorkerRequestType.OPEN: {
+      const { path, tempDirectory } = (data as OpenRequest).config ?? {};
+      if ((path && isOPFSPath(path)) || (tempDirectory && isOPFSPath(tempDirectory))) {
+        reply(client, request, WorkerResponseType.ERROR, { message: OPFS_UNAVAILABLE });
+        return;
+      }
+      if (opened) {
+        // The database keeps the configuration of the page that opened it
+        reply(client, request, WorkerResponseType.OK);
+        return;
+      }
+      break;
+    }
+
+    case WorkerRequestType.REGISTER_OPFS_FILE:
+      reply(client, request, WorkerResponseType.ERROR, { message: OPFS_UNAVAILABLE });
+      return;
+
+    case WorkerRequestType.CLOSE:
+      await release(client);
+      reply(client, request, WorkerResponseType.OK);
+      return;
+
+    case WorkerRequestType.PIPELINE: {
+      const { operations } = data as PipelineRequest;
+      const lifecycle = operations.find((operation) => LIFECYCLE_REQUESTS.has(operation.type));
+      if (lifecycle) {
+        const message = `${lifecycle.type} cannot be pipelined in a shared worker`;
+        reply(client, request, WorkerResponseType.ERROR, { message });
+        return;
+      }
+      break;
+    }
+  }
+
+  // Other pages' connections look the same as connections that do not exist
+  const foreign = connectionIds(type, data).find((id) => !client.connections.has(id));
+  if (foreign !== undefined) {
+    const message = `Connection ${foreign} not found`;
+    reply(client, request, WorkerResponseType.ERROR, { message });
+    return;
+  }
+
+  const messageId = nextMessageId++;
+  routes.set(messageId, { client, request });
+  try {
+    await dispatcher.onMessage({ data: { ...request, messageId } } as MessageEvent);
+  } finally {
+    routes.delete(messageId);
+  }
+}
+
+/**
+ * Pick the next client with a waiting request, in turn.
+ */
+function nextClient(): Client | undefined {
+  for (let i = 0; i < clients.length; i++) {
+    const index = (turn + i) % clients.length;
+    if (clients[index].queue.length > 0) {
+      turn = (index + 1) % clients.length;
+      return clients[index];
+    }
+  }
+  return undefined;
+}
+
+/**
+ * Run waiting requests until every queue is empty.
+ */
+async function schedule(): Promise<void> {
+  if (running) {
+    return;
+  }
+  running = true;
+  try {
+    for (let client = nextClient(); client; client = nextClient()) {
+      const job = client.queue.shift() as () => Promise<void>;
+      await job();
+      if (client.detached && client.queue.length === 0) {
+        const index = clients.indexOf(client);
+        clients.splice(index, 1);
+        if (index < turn) {
+          turn--;
+        }
+      }
+    }
+  } finally {
+    running = false;
+  }
+}
+
+/**
+ * Drop a client's waiting requests and release what it holds.
+ */
+function detach(client: Client): void {
+  if (client.detached) {
+    return;
+  }
+  client.detached = true;
+  client.queue = [
+    async () => {
+      await release(client);
+      // Close the database once no page uses it
+      if (opened && clients.every((other) => other.detached)) {
+        await runInternal(WorkerRequestType.CLOSE);
+        opened = false;
+      }
+    },
+  ];
+  schedule();
+}
+
+self.addEventListener('connect', (event) => {
+  const port = (event as MessageEvent).ports[0];
+  const client: Client = { port, queue: [], connections: new Set(), detached: false };
+  clients.push(client);
+
+  port.onmessage = (message: MessageEvent) => {
+    const request = message.data as WorkerRequest;
+    if (client.detached) {
+      return;
+    }
+    if (request.type === WorkerRequestType.DETACH) {
+      detach(client);
+      return;
+    }
+    client.queue.push(async () => {
+      try {
+        await run(client, request);
+      } catch (error) {
+        const message = error instanceof Error ? error.message : String(error);
+        reply(client, request, WorkerResponseType.ERROR, { message });
+      }
+    });
+    schedule();
+  };
+  // Fired where supported when the page's side of the port is gone
+  port.addEventListener('close', () => detach(client));
+
+  port.postMessage({ type: 'WORKER_READY' });
+});
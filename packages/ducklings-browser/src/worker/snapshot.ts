@@ -0,0 +1,169 @@
+/**
+ * Memory snapshots of an initialized database
+ *
+ * A snapshot is the WASM linear memory taken after the database was opened and set up,
+ * so a later start can restore it in place of opening the database, loading the built-in
+ * extensions and running setup SQL. Memory only holds valid state between calls into
+ * WASM, so snapshots are taken and restored while no call is running, and they are only
+ * valid for the exact build they were taken with: function pointers and static data
+ * addresses in the image refer to that build's layout.
+ *
+ * Layout: `DKSN` magic, format version (u32), header length (u32), JSON header, padding
+ * to 8 bytes, then the 64 KiB pages listed in the header. Pages that are all zero are
+ * left out, which drops most of the unused heap.
+ *
+ * @packageDocumentation
+ */
+
+import type { EmscriptenModule } from '../types.js';
+
+const MAGIC = 0x4e534b44; // 'DKSN' little-endian
+const FORMAT_VERSION = 1;
+const PAGE_SIZE = 65536;
+
+/**
+ * Metadata stored in front of the memory pages.
+ */
+export interface SnapshotHeader {
+  /** WASM build the snapshot was taken with ('baseline', 'simd', ...) */
+  variant: string;
+  /** DuckDB library version of the build */
+  libraryVersion: string;
+  /** Address of the version string, which moves with the build's static data layout */
+  libraryVersionPtr: number;
+  /** Size of linear memory when the snapshot was taken */
+  memoryBytes: number;
+  /** duckdb_database handle of the snapshotted database */
+  dbPtr: number;
+  /** Indices of the stored (non-zero) pages, in order */
+  pages: number[];
+}
+
+/**
+ * Identify the build of a module the way snapshots record it.
+ */
+function buildIdentity(mod: EmscriptenModule): {
+  libraryVersion: string;
+  libraryVersionPtr: number;
+} {
+  const libraryVersionPtr = mod.ccall('duckdb_library_version', 'number', [], []) as number;
+  return { libraryVersion: mod.UTF8ToString(libraryVersionPtr), libraryVersionPtr };
+}
+
+/**
+ * Check whether a memory page holds any non-zero byte.
+ */
+function isPageUsed(words: Uint32Array, page: number): boolean {
+  const end = (page + 1) * (PAGE_SIZE / 4);
+  for (let i = page * (PAGE_SIZE / 4); i < end; i++) {
+    if (words[i] !== 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Serialize the module's linear memory with the database handle to restore.
+ */
+export function captureSnapshot(mod: EmscriptenModule, dbPtr: number, variant: string): Uint8Array {
+  const heap = mod.HEAPU8;
+  const words = new Uint32Array(heap.buffer, heap.byteOffset, heap.byteLength / 4);
+  const pageCount = Math.ceil(heap.byteLength / PAGE_SIZE);
+
+  const pages: number[] = [];
+  for (let page = 0; page < pageCount; page++) {
+    if (isPageUsed(words, page)) {
+      pages.push(page);
+    }
+  }
+
+  const header: SnapshotHeader = {
+    variant,
+    ...buildIdentity(mod),
+    memoryBytes: heap.byteLength,
+    dbPtr,
+    pages,
+  };
+  const headerBytes = new TextEncoder().encode(JSON.stringify(header));
+  const dataOffset = Math.ceil((12 + headerBytes.length) / 8) * 8;
+
+  const snapshot = new Uint8Array(dataOffset + pages.length * PAGE_SIZE);
+  const view = new DataView(snapshot.buffer);
+  view.setUint32(0, MAGIC, true);
+  view.setUint32(4, FORMAT_VERSION, true);
+  view.setUint32(8, headerBytes.length, true);
+  snapshot.set(headerBytes, 12);
+  for (let i = 0; i < pages.length; i++) {
+    const start = pages[i] * PAGE_SIZE;
+    snapshot.set(heap.subarray(start, start + PAGE_SIZE), dataOffset + i * PAGE_SIZE);
+  }
+  return snapshot;
+}
+
+/**
+ * Read the header of a snapshot without restoring it.
+ */
+export function readSnapshotHeader(snapshot: Uint8Array): {
+  header: SnapshotHeader;
+  dataOffset: number;
+} {
+  const view = new DataView(snapshot.buffer, snapshot.byteOffset, snapshot.byteLength);
+  if (snapshot.byteLength < 12 || view.getUint32(0, true) !== MAGIC) {
+    throw new Error('Not a Ducklings snapshot');
+  }
+  const format = view.getUint32(4, true);
+  if (format !== FORMAT_VERSION) {
+    throw new Error(`Unsupported snapshot format ${format}`);
+  }
+  const headerLength = view.getUint32(8, true);
+  const header = JSON.parse(
+    new TextDecoder().decode(snapshot.subarray(12, 12 + headerLength)),
+  ) as SnapshotHeader;
+  return { header, dataOffset: Math.ceil((12 + headerLength) / 8) * 8 };
+}
+
+/**
+ * Overwrite the memory of a freshly instantiated module with a snapshot.
+ *
+ * @returns The duckdb_database handle of the restored database
+ */
+export function restoreSnapshot(
+  mod: EmscriptenModule,
+  snapshot: Uint8Array,
+  variant: string,
+): number {
+  const { header, dataOffset } = readSnapshotHeader(snapshot);
+  const identity = buildIdentity(mod);
+  if (
+    header.variant !== variant ||
+    header.libraryVersion !== identity.libraryVersion ||
+    header.libraryVersionPtr !== identity.libraryVersionPtr
+  ) {
+    throw new Error(
+      `Snapshot was taken with another build (${header.variant}, ` +
+        `DuckDB ${header.libraryVersion}); create it again with this version`,
+    );
+  }
+  if (snapshot.byteLength < dataOffset + header.pages.length * PAGE_SIZE) {
+    throw new Error('Snapshot is truncated');
+  }
+
+  // Grow memory through the allocator so the module's heap views are refreshed
+  if (mod.HEAPU8.byteLength < header.memoryBytes) {
+    const ptr = mod._malloc(header.memoryBytes - mod.HEAPU8.byteLength);
+    if (!ptr) {
+      throw new Error('Not enough memory to restore the snapshot');
+    }
+    mod._free(ptr);
+  }
+
+  // Every byte is rewritten: stored pages are copied, all others are zero
+  const heap = mod.HEAPU8;
+  heap.fill(0);
+  for (let i = 0; i < header.pages.length; i++) {
+    const start = dataOffset + i * PAGE_SIZE;
+    heap.set(snapshot.subarray(start, start + PAGE_SIZE), header.pages[i] * PAGE_SIZE);
+  }
+  return header.dbPtr;
+}
@@ -0,0 +1,73 @@
+import { describe, it, expect, beforeAll } from 'vitest';
+import { getDB, type Connection } from './testDb';
+import { tableFromIPC } from '@uwdata/flechette';
+
+function concat(parts: Uint8Array[]): Uint8Array {
+  const bytes = new Uint8Array(parts.reduce((total, part) => total + part.length, 0));
+  let offset = 0;
+  for (const part of parts) {
+    bytes.set(part, offset);
+    offset += part.length;
+  }
+  return bytes;
+}
+
+describe('Arrow IPC streams', () => {
+  let conn: Connection;
+
+  beforeAll(async () => {
+    conn = await getDB().connect();
+  });
+
+  // Note: Don't close connection - it's shared across test files via getDB()
+
+  it('should stream one part per chunk that together form an IPC stream', async () => {
+    const stream = await conn.queryArrowStream('SELECT i, i * 2 AS doubled FROM range(10000) t(i)');
+    const parts: Uint8Array[] = [];
+    for await (const bytes of stream) {
+      parts.push(bytes);
+    }
+    expect(parts.length).toBeGreaterThan(1);
+    expect(stream.isClosed()).toBe(true);
+
+    const table = tableFromIPC(concat(parts));
+    expect(table.numRows).toBe(10000);
+    expect(Number(table.getChild('doubled')?.at(9999))).toBe(19998);
+  });
+
+  it('should group chunks by batchRows', async () => {
+    const stream = await conn.queryArrowStream('SELECT i FROM range(10000) t(i)', {
+      batchRows: 100000,
+    });
+    const parts: Uint8Array[] = [];
+    for await (const bytes of stream) {
+      parts.push(bytes);
+    }
+    expect(parts).toHaveLength(1);
+    expect(tableFromIPC(parts[0]).numRows).toBe(10000);
+  });
+
+  it('should keep streaming after other queries on the connection', async () => {
+    const stream = await conn.queryArrowStream('SELECT i FROM range(10000) t(i)');
+    const first = await stream.next();
+    expect(first).not.toBeNull();
+
+    expect(await conn.query('SELECT 1 AS one')).toEqual([{ one: 1 }]);
+
+    const parts = [first!];
+    for await (const bytes of stream) {
+      parts.push(bytes);
+    }
+    expect(tableFromIPC(concat(parts)).numRows).toBe(10000);
+  });
+
+  it('should work as a ReadableStream', async () => {
+    const stream = await conn.queryArrowStream('SELECT 42 AS answer');
+    const bytes = new Uint8Array(await new Response(stream.toReadableStream()).arrayBuffer());
+    expect(tableFromIPC(bytes).getChild('answer')?.at(0)).toBe(42);
+  });
+
+  it('should reject invalid queries', async () => {
+    await expect(conn.queryArrowStream('SELECT * FROM missing_table')).rejects.toThrow();
+  });
+});
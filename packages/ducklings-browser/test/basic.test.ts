@@ -122,5 +122,17 @@ describe('DuckDB Basic Operations', () => {
       expect(schema.fields[0].name).toBe('id');
       expect(schema.fields[1].name).toBe('name');
     });
+
+    it('should preserve nulls across multiple chunks', async () => {
+      const table = await conn.queryArrow(
+        'SELECT CASE WHEN i % 1000 = 0 THEN NULL ELSE i END AS v FROM range(5000) t(i)',
+      );
+      expect(table.numRows).toBe(5000);
+      const values = table.getChild('v')!.toArray();
+      expect(values[0]).toBeNull();
+      expect(values[1]).toBe(1);
+      expect(values[4000]).toBeNull();
+      expect(values[4999]).toBe(4999);
+    });
   });
 });
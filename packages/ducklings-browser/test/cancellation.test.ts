@@ -0,0 +1,67 @@
+import { describe, it, expect, beforeAll } from 'vitest';
+import { getDB, DuckDBError, type Connection, type QueryProgress } from './testDb';
+
+const LONG_QUERY = 'SELECT count(*) AS n FROM range(200000000) t(i) WHERE i % 7 = 3';
+
+describe('Cancellation and progress', () => {
+  let conn: Connection;
+
+  beforeAll(async () => {
+    conn = await getDB().connect();
+  });
+
+  // Note: Don't close connection - it's shared across test files via getDB()
+
+  describe('signal', () => {
+    it('should reject right away when already aborted', async () => {
+      const controller = new AbortController();
+      controller.abort();
+      await expect(conn.query('SELECT 1', { signal: controller.signal })).rejects.toMatchObject({
+        code: 'INTERRUPTED',
+      });
+    });
+
+    it('should reject a running query when aborted', async () => {
+      const controller = new AbortController();
+      const pending = conn.query(LONG_QUERY, { signal: controller.signal });
+      controller.abort();
+      await expect(pending).rejects.toBeInstanceOf(DuckDBError);
+      await expect(pending).rejects.toMatchObject({ code: 'INTERRUPTED' });
+    });
+
+    it('should not affect queries that finish first', async () => {
+      const controller = new AbortController();
+      const rows = await conn.query('SELECT 42 AS answer', { signal: controller.signal });
+      controller.abort();
+      expect(rows).toEqual([{ answer: 42 }]);
+    });
+  });
+
+  describe('cancel()', () => {
+    it('should reject running statements and keep the connection usable', async () => {
+      const pending = conn.execute(`CREATE TEMP TABLE cancelled AS ${LONG_QUERY}`);
+      conn.cancel();
+      await expect(pending).rejects.toMatchObject({ code: 'INTERRUPTED' });
+
+      const rows = await conn.query('SELECT 1 AS one');
+      expect(rows).toEqual([{ one: 1 }]);
+    });
+  });
+
+  describe('onProgress', () => {
+    it('should report progress while the query runs', async () => {
+      const updates: QueryProgress[] = [];
+      const rows = await conn.query(LONG_QUERY, {
+        progressInterval: 0,
+        onProgress: (progress) => updates.push(progress),
+      });
+
+      expect(rows).toHaveLength(1);
+      expect(updates.length).toBeGreaterThan(0);
+      for (const update of updates) {
+        expect(typeof update.percentage).toBe('number');
+        expect(update.rowsProcessed).toBeGreaterThanOrEqual(0);
+      }
+    });
+  });
+});
@@ -6,6 +6,7 @@ const {
   getJsDelivrBundle,
   getUnpkgBundle,
   createWorker,
+  isSimdSupported,
   PACKAGE_NAME,
   PACKAGE_VERSION,
 } = cdn;
@@ -46,6 +47,17 @@ describe('CDN Utilities', () => {
       );
     });
 
+    it('should include SIMD build URLs', () => {
+      const bundle = getJsDelivrBundle();
+
+      expect(bundle.wasmSimdModule).toBe(
+        `https://cdn.jsdelivr.net/npm/${PACKAGE_NAME}@${PACKAGE_VERSION}/dist/wasm/duckdb-simd.wasm`
+      );
+      expect(bundle.wasmSimdJs).toBe(
+        `https://cdn.jsdelivr.net/npm/${PACKAGE_NAME}@${PACKAGE_VERSION}/dist/wasm/duckdb-simd.js`
+      );
+    });
+
     it('should use custom version when provided', () => {
       const bundle = getJsDelivrBundle('2.0.0');
 
@@ -109,6 +121,16 @@ describe('CDN Utilities', () => {
     });
   });
 
+  describe('isSimdSupported()', () => {
+    it('should return a boolean', () => {
+      expect(typeof isSimdSupported()).toBe('boolean');
+    });
+
+    it('should be true on Node.js 16+ (SIMD is enabled by default)', () => {
+      expect(isSimdSupported()).toBe(true);
+    });
+  });
+
   describe('createWorker()', () => {
     let originalFetch: typeof fetch;
     let originalWorker: typeof Worker;
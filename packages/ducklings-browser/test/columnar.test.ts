@@ -0,0 +1,56 @@
+import { describe, it, expect, beforeAll } from 'vitest';
+import { getDB, type Connection } from './testDb';
+
+describe('Columnar Results', () => {
+  let conn: Connection;
+
+  beforeAll(async () => {
+    conn = await getDB().connect();
+  });
+
+  // Note: Don't close connection - it's shared across test files via getDB()
+
+  it('should read values through row proxies', async () => {
+    const result = await conn.queryColumnar<{ id: number; name: string | null }>(
+      "SELECT i AS id, CASE WHEN i % 2 = 0 THEN 'even' END AS name FROM range(5000) t(i)",
+    );
+    expect(result.rowCount).toBe(5000);
+    expect(result.columnCount).toBe(2);
+    expect(result.getChunks().length).toBeGreaterThan(1);
+
+    // Rows of later chunks are found as well
+    const row = result.get(4098);
+    expect(row.id).toBe(4098);
+    expect(row.name).toBe('even');
+    expect(result.get(4099).name).toBeNull();
+    expect(() => result.get(5000)).toThrow('out of bounds');
+  });
+
+  it('should behave like plain objects for keys, spreading and JSON', async () => {
+    const result = await conn.queryColumnar("SELECT 1 AS a, 'x' AS b, true AS c");
+    const row = result.get(0);
+    expect(Object.keys(row)).toEqual(['a', 'b', 'c']);
+    expect({ ...row }).toEqual({ a: 1, b: 'x', c: true });
+    expect(JSON.stringify(row)).toBe('{"a":1,"b":"x","c":true}');
+    expect('a' in row).toBe(true);
+    expect('missing' in row).toBe(false);
+  });
+
+  it('should match query() for toArray() and iteration', async () => {
+    const sql =
+      "SELECT i, i::VARCHAR AS s, i * 1.5 AS d, DATE '2024-01-01' + i::INTEGER AS day " +
+      'FROM range(10) t(i)';
+    const rows = await conn.query(sql);
+    const result = await conn.queryColumnar(sql);
+    expect(result.toArray()).toEqual(rows);
+    expect([...result].map((row) => ({ ...row }))).toEqual(rows);
+    expect(result.getColumnByName('s')).toEqual(rows.map((row) => row.s));
+  });
+
+  it('should handle empty results', async () => {
+    const result = await conn.queryColumnar('SELECT * FROM range(0) t(i)');
+    expect(result.rowCount).toBe(0);
+    expect(result.getColumns()[0].name).toBe('i');
+    expect(result.toArray()).toEqual([]);
+  });
+});
@@ -0,0 +1,17 @@
+import { describe, it, expect, beforeAll } from 'vitest';
+import { getDB, type Connection } from './testDb';
+
+describe('Memory limit', () => {
+  let conn: Connection;
+
+  beforeAll(async () => {
+    conn = await getDB().connect();
+  });
+
+  // Note: Don't close connection - it's shared across test files via getDB()
+
+  it('should default memory_limit to 75% of the memory ceiling', async () => {
+    const rows = await conn.query("SELECT current_setting('memory_limit') AS memory_limit");
+    expect(rows[0].memory_limit).toBe('3.0 GiB');
+  });
+});
@@ -0,0 +1,72 @@
+import { describe, it, expect, beforeAll } from 'vitest';
+import { getDB, type Connection } from './testDb';
+
+describe('Pipelining', () => {
+  let conn: Connection;
+
+  beforeAll(async () => {
+    conn = await getDB().connect();
+  });
+
+  // Note: Don't close connection - it's shared across test files via getDB()
+
+  describe('pipeline()', () => {
+    it('should run operations in order and return all results', async () => {
+      const pipeline = getDB().pipeline();
+      const pipeConn = pipeline.connect();
+      pipeline.execute(pipeConn, 'CREATE TABLE test_pipeline (id INTEGER)');
+      const inserted = pipeline.execute(pipeConn, 'INSERT INTO test_pipeline VALUES (1), (2), (3)');
+      const rows = pipeline.query(pipeConn, 'SELECT sum(id)::INTEGER AS total FROM test_pipeline');
+
+      const results = await pipeline.run();
+      expect(results.ok).toBe(true);
+      expect(results.get(inserted)).toBe(3);
+      expect(results.get(rows)).toEqual([{ total: 6 }]);
+
+      // The connection opened in the pipeline is usable afterwards
+      const opened = results.get(pipeConn);
+      const after = await opened.query('SELECT count(*)::INTEGER AS n FROM test_pipeline');
+      expect(after[0].n).toBe(3);
+
+      await opened.execute('DROP TABLE test_pipeline');
+      await opened.close();
+    });
+
+    it('should accept existing connections', async () => {
+      const pipeline = getDB().pipeline();
+      const rows = pipeline.query(conn, 'SELECT 42 AS answer');
+      const results = await pipeline.run();
+      expect(results.get(rows)).toEqual([{ answer: 42 }]);
+    });
+
+    it('should skip operations after a failure', async () => {
+      const pipeline = getDB().pipeline();
+      const first = pipeline.query(conn, 'SELECT 1 AS one');
+      const failing = pipeline.execute(conn, 'SELECT * FROM missing_pipeline_table');
+      const skipped = pipeline.query(conn, 'SELECT 2 AS two');
+
+      const results = await pipeline.run();
+      expect(results.ok).toBe(false);
+      expect(results.get(first)).toEqual([{ one: 1 }]);
+      expect(() => results.get(failing)).toThrow(/missing_pipeline_table/);
+      expect(() => results.get(skipped)).toThrow(/Skipped/);
+    });
+
+    it('should only run once', async () => {
+      const pipeline = getDB().pipeline();
+      pipeline.query(conn, 'SELECT 1');
+      await pipeline.run();
+      await expect(pipeline.run()).rejects.toThrow('already been run');
+    });
+  });
+
+  describe('executeAndForget()', () => {
+    it('should apply statements before later requests', async () => {
+      conn.executeAndForget('CREATE TABLE test_forget (id INTEGER)');
+      conn.executeAndForget('INSERT INTO test_forget VALUES (1), (2)');
+      const rows = await conn.query('SELECT count(*)::INTEGER AS n FROM test_forget');
+      expect(rows[0].n).toBe(2);
+      await conn.execute('DROP TABLE test_forget');
+    });
+  });
+});
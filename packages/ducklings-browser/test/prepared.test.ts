@@ -170,6 +170,56 @@ describe('Prepared Statements', () => {
     });
   });
 
+  describe('executeBatch()', () => {
+    it('should insert columnar parameters in one call', async () => {
+      await conn.execute('CREATE TABLE test_batch (id INTEGER, name VARCHAR, score DOUBLE, big BIGINT)');
+      const stmt = await conn.prepare('INSERT INTO test_batch VALUES (?, ?, ?, ?)');
+
+      const rowCount = 1000;
+      const ids = new Int32Array(rowCount).map((_, i) => i);
+      const names = Array.from({ length: rowCount }, (_, i) => (i % 10 === 0 ? null : `name-${i}`));
+      const scores = new Float64Array(rowCount).map((_, i) => i / 2);
+      const bigs = { values: new BigInt64Array(rowCount), nulls: new Uint8Array(rowCount).fill(1) };
+
+      const changed = await stmt.executeBatch([ids, names, scores, bigs]);
+      expect(changed).toBe(rowCount);
+      // Caller-owned typed arrays are not detached
+      expect(ids.length).toBe(rowCount);
+      await stmt.close();
+
+      const result = await conn.query(
+        'SELECT count(*)::INTEGER AS n, count(name)::INTEGER AS names, sum(score) AS total, count(big)::INTEGER AS bigs FROM test_batch',
+      );
+      expect(result[0]).toEqual({ n: 1000, names: 900, total: 249750, bigs: 0 });
+
+      const row = await conn.query('SELECT * FROM test_batch WHERE id = 7');
+      expect(row[0]).toEqual({ id: 7, name: 'name-7', score: 3.5, big: null });
+
+      await conn.execute('DROP TABLE test_batch');
+    });
+
+    it('should roll back the whole batch when a row fails', async () => {
+      await conn.execute('CREATE TABLE test_batch_fail (id INTEGER PRIMARY KEY)');
+      const stmt = await conn.prepare('INSERT INTO test_batch_fail VALUES (?)');
+
+      await expect(stmt.executeBatch([new Int32Array([1, 2, 2, 3])])).rejects.toThrow(/Row 2/);
+      await stmt.close();
+
+      const result = await conn.query('SELECT count(*)::INTEGER AS n FROM test_batch_fail');
+      expect(result[0].n).toBe(0);
+
+      await conn.execute('DROP TABLE test_batch_fail');
+    });
+
+    it('should reject columns of different lengths', async () => {
+      const stmt = await conn.prepare('SELECT ?::INTEGER, ?::INTEGER');
+      await expect(
+        stmt.executeBatch([new Int32Array([1, 2]), new Int32Array([1])]),
+      ).rejects.toThrow('Parameter 2 has 1 rows, expected 2');
+      await stmt.close();
+    });
+  });
+
   describe('Error handling', () => {
     it('should throw on invalid SQL during prepare', async () => {
       await expect(conn.prepare('INVALID SQL')).rejects.toThrow();
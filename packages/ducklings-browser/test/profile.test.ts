@@ -0,0 +1,37 @@
+import { describe, it, expect, beforeAll } from 'vitest';
+import { getDB, type Connection } from './testDb';
+
+describe('Query profiles', () => {
+  let conn: Connection;
+
+  beforeAll(async () => {
+    conn = await getDB().connect();
+  });
+
+  // Note: Don't close connection - it's shared across test files via getDB()
+
+  it('should attach a profile to the rows when requested', async () => {
+    const rows = await conn.query('SELECT sum(i) AS total FROM range(100000) t(i)', {
+      profile: true,
+    });
+    expect(rows).toHaveLength(1);
+    expect(rows[0].total).toBeDefined();
+
+    const { profile } = rows;
+    expect(profile.totalTimeMs).toBeGreaterThanOrEqual(0);
+    expect(profile.execution).not.toBeNull();
+    expect(profile.http.urls).toEqual([]);
+    expect(profile.httpTimeMs).toBe(0);
+    expect(profile.http.latencyBoundsMs.length).toBeGreaterThan(0);
+  });
+
+  it('should not attach a profile by default', async () => {
+    const rows = await conn.query('SELECT 1 AS one');
+    expect(rows).toEqual([{ one: 1 }]);
+    expect('profile' in rows).toBe(false);
+  });
+
+  it('should still report query errors', async () => {
+    await expect(conn.query('SELECT * FROM missing_table', { profile: true })).rejects.toThrow();
+  });
+});
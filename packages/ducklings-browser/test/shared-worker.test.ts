@@ -0,0 +1,104 @@
+import { describe, it, expect } from 'vitest';
+import { DuckDB, workerUrl } from './testDb';
+
+const sharedWorkerUrl = workerUrl.replace(/worker\.js$/, 'shared-worker.js');
+
+/**
+ * Connect to a shared worker the way init({ sharedWorker }) does.
+ */
+async function attach(open = true): Promise<InstanceType<typeof DuckDB>> {
+  const { port } = new SharedWorker(sharedWorkerUrl, { type: 'module' });
+  port.start();
+  await new Promise<void>((resolve) => {
+    const handler = (event: MessageEvent) => {
+      if (event.data?.type === 'WORKER_READY') {
+        port.removeEventListener('message', handler);
+        resolve();
+      }
+    };
+    port.addEventListener('message', handler);
+  });
+  const db = new DuckDB(port);
+  await db.instantiate(undefined, undefined, 'baseline');
+  if (open) {
+    await db.open();
+  }
+  return db;
+}
+
+describe('SharedWorker', () => {
+  it('should run queries through the shared worker', async () => {
+    const db = await attach();
+    const conn = await db.connect();
+    const rows = await conn.query<{ answer: number }>('SELECT 42 AS answer');
+    expect(rows).toEqual([{ answer: 42 }]);
+    await conn.close();
+    await db.close();
+  });
+
+  it('should answer a repeated instantiate and open with the running database', async () => {
+    const db = await attach();
+    const conn = await db.connect();
+    await conn.execute('CREATE TABLE shared_kept (id INTEGER)');
+    await conn.execute('INSERT INTO shared_kept VALUES (1), (2)');
+
+    await db.instantiate(undefined, undefined, 'baseline');
+    await db.open();
+    const rows = await conn.query('SELECT count(*)::INTEGER AS n FROM shared_kept');
+    expect(rows).toEqual([{ n: 2 }]);
+    await db.close();
+  });
+
+  it('should reject snapshots once the database is running', async () => {
+    const db = await attach();
+    await expect(
+      db.instantiate(undefined, undefined, 'baseline', new Uint8Array(16)),
+    ).rejects.toThrow('shared with other pages');
+    await db.close();
+  });
+
+  it('should run pipelines that open their own connection', async () => {
+    const db = await attach();
+    const pipeline = db.pipeline();
+    const conn = pipeline.connect();
+    const rows = pipeline.query(conn, 'SELECT 1 AS one');
+    const results = await pipeline.run();
+    expect(results.get(rows)).toEqual([{ one: 1 }]);
+
+    // The pipelined connection belongs to this page
+    const connection = results.get(conn);
+    expect(await connection.query('SELECT 2 AS two')).toEqual([{ two: 2 }]);
+    await connection.close();
+    await db.close();
+  });
+
+  it("should not expose another page's prepared statements", async () => {
+    const first = await attach();
+    const second = await attach();
+    const mine = await first.connect();
+    const theirs = await second.connect();
+    const stmt = await mine.prepare('SELECT 1 AS one');
+
+    // Name the first page's statement from the second page, on the second page's connection
+    const { preparedStatementId } = stmt as unknown as { preparedStatementId: number };
+    const forged = await theirs.prepare('SELECT 2 AS two');
+    Object.assign(forged, { preparedStatementId });
+    await expect(forged.run()).rejects.toThrow(
+      `Prepared statement ${preparedStatementId} not found`,
+    );
+
+    expect(await stmt.run()).toEqual([{ one: 1 }]);
+    await first.close();
+    await second.close();
+  });
+
+  it('should reject OPFS databases and files', async () => {
+    const db = await attach(false);
+    await expect(db.open({ path: 'opfs://shared.duckdb' })).rejects.toThrow('dedicated worker');
+    await expect(db.open({ tempDirectory: 'opfs://tmp' })).rejects.toThrow('dedicated worker');
+
+    await db.open();
+    await expect(db.registerOPFSFile('events.parquet')).rejects.toThrow('dedicated worker');
+    await db.close();
+  });
+});
@@ -0,0 +1,65 @@
+import { describe, it, expect } from 'vitest';
+import { DuckDB, getDB, workerUrl } from './testDb';
+
+/**
+ * Start a second worker, as init() only manages the global one.
+ */
+async function startWorker(): Promise<InstanceType<typeof DuckDB>> {
+  const worker = new Worker(workerUrl, { type: 'module' });
+  await new Promise<void>((resolve) => {
+    const handler = (event: MessageEvent) => {
+      if (event.data?.type === 'WORKER_READY') {
+        worker.removeEventListener('message', handler);
+        resolve();
+      }
+    };
+    worker.addEventListener('message', handler);
+  });
+  return new DuckDB(worker);
+}
+
+describe('Snapshots', () => {
+  it('should restore tables created before the snapshot', async () => {
+    const conn = await getDB().connect();
+    await conn.execute('CREATE TABLE snapshot_cities (name VARCHAR, population INTEGER)');
+    await conn.execute("INSERT INTO snapshot_cities VALUES ('Berlin', 3850000), ('Hamburg', 1890000)");
+    await conn.close();
+
+    const snapshot = await getDB().createSnapshot();
+    expect(snapshot).toBeInstanceOf(Uint8Array);
+    expect(new TextDecoder().decode(snapshot.subarray(0, 4))).toBe('DKSN');
+
+    const restored = await startWorker();
+    await restored.instantiate(undefined, undefined, 'baseline', snapshot);
+    const restoredConn = await restored.connect();
+    const rows = await restoredConn.query(
+      'SELECT name FROM snapshot_cities ORDER BY population DESC',
+    );
+    expect(rows).toEqual([{ name: 'Berlin' }, { name: 'Hamburg' }]);
+    await restoredConn.close();
+    await restored.close();
+
+    // The original database keeps working
+    const after = await getDB().connect();
+    await after.execute('DROP TABLE snapshot_cities');
+    await after.close();
+  });
+
+  it('should refuse snapshots while connections are open', async () => {
+    const conn = await getDB().connect();
+    await expect(getDB().createSnapshot()).rejects.toThrow('Close all connections');
+    await conn.close();
+  });
+
+  it('should reject snapshots of another build', async () => {
+    const snapshot = await getDB().createSnapshot();
+    const other = await startWorker();
+    await expect(other.instantiate(undefined, undefined, 'simd', snapshot)).rejects.toThrow(
+      'another build',
+    );
+
+    // The worker can still load the module without the snapshot
+    await other.instantiate(undefined, undefined, 'baseline');
+    await other.close();
+  });
+});
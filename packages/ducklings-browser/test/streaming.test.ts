@@ -198,6 +198,39 @@ describe('Streaming Results', () => {
     });
   });
 
+  describe('DataChunk column vectors', () => {
+    it('should expose numeric columns as typed arrays', async () => {
+      const stream = await conn.queryStreaming(
+        'SELECT i::INTEGER AS i, i * 0.5::DOUBLE AS d FROM range(4) AS t(i)',
+      );
+      for await (const chunk of stream) {
+        const ints = chunk.getColumnVector(0);
+        const doubles = chunk.getColumnVector(1);
+        expect(ints.kind).toBe('fixed');
+        expect(doubles.kind).toBe('fixed');
+        if (ints.kind === 'fixed' && doubles.kind === 'fixed') {
+          expect(ints.data).toBeInstanceOf(Int32Array);
+          expect(Array.from(ints.data)).toEqual([0, 1, 2, 3]);
+          expect(doubles.data).toBeInstanceOf(Float64Array);
+          expect(doubles.data[3]).toBeCloseTo(1.5, 5);
+        }
+      }
+    });
+
+    it('should expose strings as offsets and bytes', async () => {
+      const stream = await conn.queryStreaming(
+        "SELECT CASE WHEN i = 1 THEN NULL ELSE 'ü_' || i::VARCHAR END AS s FROM range(3) AS t(i)",
+      );
+      for await (const chunk of stream) {
+        const vector = chunk.getColumnVector(0);
+        expect(vector.kind).toBe('string');
+        expect(chunk.isNull(0, 0)).toBe(false);
+        expect(chunk.isNull(1, 0)).toBe(true);
+        expect(chunk.getColumn(0)).toEqual(['ü_0', null, 'ü_2']);
+      }
+    });
+  });
+
   describe('DataChunk toArray()', () => {
     it('should convert chunk to array of objects', async () => {
       const stream = await conn.queryStreaming('SELECT i AS id, \'item_\' || i::VARCHAR AS name FROM range(3) AS t(i)');
@@ -253,4 +286,51 @@ describe('Streaming Results', () => {
       expect(table.numCols).toBe(2);
     });
   });
+
+  describe('Concurrent streams', () => {
+    it('should interleave two streams on the same connection', async () => {
+      const first = await conn.queryStreaming('SELECT * FROM range(5000) AS t(num)');
+      const firstChunk = await first.nextChunk();
+      expect(firstChunk).not.toBeNull();
+
+      const second = await conn.queryStreaming('SELECT * FROM range(5000, 10000) AS t(num)');
+      const secondRows = await second.toArray<{ num: number }>();
+      expect(secondRows).toHaveLength(5000);
+      expect(secondRows[0].num).toBe(5000);
+
+      const firstRows = [
+        ...firstChunk!.toArray<{ num: number }>(),
+        ...(await first.toArray<{ num: number }>()),
+      ];
+      expect(firstRows).toHaveLength(5000);
+      expect(firstRows[0].num).toBe(0);
+      expect(firstRows[4999].num).toBe(4999);
+    });
+
+    it('should keep a stream readable after another query on its connection', async () => {
+      const stream = await conn.queryStreaming('SELECT * FROM range(3000) AS t(num)');
+      await stream.nextChunk();
+
+      const rows = await conn.query<{ answer: number }>('SELECT 42 AS answer');
+      expect(rows[0].answer).toBe(42);
+
+      let remaining = 0;
+      for await (const chunk of stream) {
+        remaining += chunk.rowCount;
+      }
+      expect(remaining).toBeGreaterThan(0);
+      expect(stream.isDone()).toBe(true);
+    });
+  });
+
+  describe('Closing the connection', () => {
+    it('should release streams left open on the connection', async () => {
+      const other = await getDB().connect();
+      const stream = await other.queryStreaming('SELECT * FROM range(10000) AS t(num)');
+      await stream.nextChunk();
+
+      await other.close();
+      await expect(stream.nextChunk()).rejects.toThrow('not found');
+    });
+  });
 });
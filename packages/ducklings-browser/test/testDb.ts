@@ -33,7 +33,7 @@ const duckdb = await import('../dist/index.js');
 
 // Get absolute URL for worker file
 const workerPath = join(__dirname, '../dist/worker.js');
-const workerUrl = pathToFileURL(workerPath).href;
+export const workerUrl = pathToFileURL(workerPath).href;
 
 // Initialize - the dispatcher will use globalThis modules instead of dynamic import
 await duckdb.init({
@@ -54,4 +54,4 @@ export const DuckDBType = duckdb.DuckDBType;
 // DuckDB and Connection types are derived from the value exports above to match runtime types
 export type DuckDB = InstanceType<typeof DuckDB>;
 export type Connection = InstanceType<typeof Connection>;
-export type { DuckDBTypeId, ColumnInfo, InitOptions } from '../src/index';
+export type { DuckDBTypeId, ColumnInfo, InitOptions, QueryProgress } from '../src/index';
@@ -46,4 +46,23 @@ export default defineConfig([
       };
     },
   },
+  // SharedWorker bundle
+  {
+    entry: { 'shared-worker': 'src/worker/shared-worker.ts' },
+    format: ['esm'],
+    dts: false,
+    sourcemap: true,
+    clean: false,
+    minify: true,
+    treeshake: true,
+    splitting: false,
+    outDir: 'dist',
+    external: ['../wasm/duckdb.js', 'env'],
+    noExternal: ['@uwdata/flechette'],
+    esbuildOptions(options) {
+      options.banner = {
+        js: '// Ducklings SharedWorker',
+      };
+    },
+  },
 ]);
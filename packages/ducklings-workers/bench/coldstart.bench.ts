@@ -0,0 +1,42 @@
+/**
+ * Binary size and time to first query.
+ *
+ * Does not use test/testDb.ts: this file times the startup that testDb.ts performs
+ * on import. Each bench file gets a fresh module, so this is a real cold start.
+ */
+import { readFile } from 'node:fs/promises';
+import { dirname, join } from 'node:path';
+import { fileURLToPath } from 'node:url';
+import { gzipSync } from 'node:zlib';
+import { describe } from 'vitest';
+import { benchmark } from '../../../bench/harness';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+const distDir = join(__dirname, '../dist');
+
+describe('cold start', () => {
+  benchmark('duckdb-workers.wasm', async (bench) => {
+    const wasmBytes = await readFile(join(distDir, 'wasm/duckdb-workers.wasm'));
+    bench.value('wasm size', wasmBytes.byteLength, 'bytes');
+    bench.value('wasm size (gzip)', gzipSync(wasmBytes).byteLength, 'bytes');
+
+    const start = performance.now();
+    const wasmModule = await WebAssembly.compile(wasmBytes);
+    const compiled = performance.now();
+    bench.value('compile', compiled - start, 'ms');
+
+    const duckdb = await import(join(distDir, 'index.js'));
+    await duckdb.init({ wasmModule });
+    const initialized = performance.now();
+    bench.value('init', initialized - compiled, 'ms');
+
+    const db = new duckdb.DuckDB();
+    const conn = db.connect();
+    await conn.query('SELECT 42 AS answer');
+    const queried = performance.now();
+    bench.value('first query', queried - initialized, 'ms');
+    bench.value('time to first query', queried - start, 'ms');
+    conn.close();
+    db.close();
+  });
+});
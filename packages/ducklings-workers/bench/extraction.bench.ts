@@ -0,0 +1,36 @@
+import { afterAll, beforeAll, describe } from 'vitest';
+import { DuckDB } from '../test/testDb';
+import { benchmark } from '../../../bench/harness';
+
+const ROWS = 1_000_000;
+
+describe('extraction', () => {
+  let db: DuckDB;
+  let conn: ReturnType<DuckDB['connect']>;
+
+  beforeAll(async () => {
+    db = new DuckDB();
+    conn = db.connect();
+    await conn.execute(`
+      CREATE TABLE extraction AS
+      SELECT range AS id, range * 0.5 AS score, 'name_' || (range % 1000) AS name,
+             range % 7 = 0 AS flag
+      FROM range(${ROWS})
+    `);
+  });
+
+  afterAll(() => {
+    conn.close();
+    db.close();
+  });
+
+  benchmark('query', async (bench) => {
+    const ms = await bench.time('query', () => conn.query('SELECT * FROM extraction'));
+    bench.value('query throughput', ROWS / (ms / 1000), 'rows/s');
+  });
+
+  benchmark('queryArrow', async (bench) => {
+    const ms = await bench.time('queryArrow', () => conn.queryArrow('SELECT * FROM extraction'));
+    bench.value('queryArrow throughput', ROWS / (ms / 1000), 'rows/s');
+  });
+});
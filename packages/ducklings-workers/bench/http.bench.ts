@@ -0,0 +1,99 @@
+/**
+ * Remote Parquet scans through the WASM HTTP client.
+ *
+ * Serves a TPC-H Parquet file from a local server that supports range requests and
+ * counts the requests and bytes each scan needs; round trips dominate remote scans
+ * in a Worker, so the counts are tracked next to the timings.
+ */
+import { createReadStream, statSync } from 'node:fs';
+import { createServer, type Server } from 'node:http';
+import type { AddressInfo } from 'node:net';
+import { join } from 'node:path';
+import { afterAll, beforeAll, describe } from 'vitest';
+import { DuckDB } from '../test/testDb';
+import { benchmark, type Recorder, tpchDataDir } from '../../../bench/harness';
+
+const dataDir = tpchDataDir('0.1');
+
+interface ServerStats {
+  requests: number;
+  bytes: number;
+}
+
+/**
+ * Serve a file with HEAD and single-range GET support.
+ */
+function serveFile(path: string, stats: ServerStats): Promise<Server> {
+  const size = statSync(path).size;
+  const server = createServer((req, res) => {
+    stats.requests++;
+    const range = /^bytes=(\d+)-(\d*)$/.exec(req.headers.range ?? '');
+    const start = range ? Number(range[1]) : 0;
+    const end = range && range[2] ? Math.min(Number(range[2]), size - 1) : size - 1;
+    res.writeHead(range ? 206 : 200, {
+      'Accept-Ranges': 'bytes',
+      'Content-Length': end - start + 1,
+      ...(range ? { 'Content-Range': `bytes ${start}-${end}/${size}` } : {}),
+    });
+    if (req.method === 'HEAD') {
+      res.end();
+      return;
+    }
+    stats.bytes += end - start + 1;
+    createReadStream(path, { start, end }).pipe(res);
+  });
+  return new Promise((resolve) => server.listen(0, '127.0.0.1', () => resolve(server)));
+}
+
+describe.skipIf(!dataDir)('remote Parquet', () => {
+  const stats: ServerStats = { requests: 0, bytes: 0 };
+  let server: Server;
+  let url: string;
+  let db: DuckDB;
+  let conn: ReturnType<DuckDB['connect']>;
+
+  beforeAll(async () => {
+    server = await serveFile(join(dataDir as string, 'lineitem.parquet'), stats);
+    url = `http://127.0.0.1:${(server.address() as AddressInfo).port}`;
+    db = new DuckDB();
+    conn = db.connect();
+  });
+
+  afterAll(async () => {
+    conn.close();
+    db.close();
+    await new Promise((resolve) => server.close(resolve));
+  });
+
+  // The server ignores the path: each benchmark scans its own URL so that its first run
+  // starts without cached metadata
+
+  /**
+   * Run a scan once and record the requests and bytes it took.
+   */
+  async function countRoundTrips(bench: Recorder, label: string, sql: string): Promise<void> {
+    stats.requests = 0;
+    stats.bytes = 0;
+    await conn.query(sql);
+    bench.value(`${label} requests`, stats.requests, 'requests');
+    bench.value(`${label} bytes`, stats.bytes, 'bytes');
+  }
+
+  benchmark('count(*)', async (bench) => {
+    const sql = `SELECT count(*) AS n FROM '${url}/count/lineitem.parquet'`;
+    await countRoundTrips(bench, 'first run', sql);
+    await countRoundTrips(bench, 'repeat run', sql);
+    await bench.time('count(*)', () => conn.query(sql));
+  });
+
+  benchmark('filtered column scan', async (bench) => {
+    const sql = `
+      SELECT sum(l_extendedprice * l_discount) AS revenue
+      FROM '${url}/filtered/lineitem.parquet'
+      WHERE l_shipdate >= DATE '1994-01-01' AND l_shipdate < DATE '1995-01-01'
+    `;
+    await countRoundTrips(bench, 'first run', sql);
+    await countRoundTrips(bench, 'repeat run', sql);
+    await bench.time('filtered column scan', () => conn.query(sql));
+  });
+});
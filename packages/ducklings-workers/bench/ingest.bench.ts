@@ -0,0 +1,42 @@
+import { bool, float64, int32, tableFromArrays, tableToIPC, utf8 } from '@uwdata/flechette';
+import { afterAll, beforeAll, describe } from 'vitest';
+import { DuckDB } from '../test/testDb';
+import { benchmark } from '../../../bench/harness';
+
+const ROWS = 1_000_000;
+
+describe('ingest', () => {
+  let db: DuckDB;
+  let conn: ReturnType<DuckDB['connect']>;
+  let ipc: Uint8Array;
+  let run = 0;
+
+  beforeAll(() => {
+    db = new DuckDB();
+    conn = db.connect();
+    const ids = Int32Array.from({ length: ROWS }, (_, i) => i);
+    const table = tableFromArrays(
+      {
+        id: ids,
+        score: Float64Array.from(ids, (i) => i * 0.5),
+        name: Array.from(ids, (i) => `name_${i % 1000}`),
+        flag: Array.from(ids, (i) => i % 7 === 0),
+      },
+      { types: { id: int32(), score: float64(), name: utf8(), flag: bool() } },
+    );
+    ipc = tableToIPC(table, { format: 'stream' }) as Uint8Array;
+  });
+
+  afterAll(() => {
+    conn.close();
+    db.close();
+  });
+
+  benchmark('insertArrowFromIPCStream', async (bench) => {
+    const ms = await bench.time('insertArrowFromIPCStream', () =>
+      conn.insertArrowFromIPCStream(`ingest_${run++}`, ipc),
+    );
+    bench.value('IPC size', ipc.byteLength, 'bytes');
+    bench.value('insertArrowFromIPCStream throughput', ipc.byteLength / 1e6 / (ms / 1000), 'MB/s');
+  });
+});
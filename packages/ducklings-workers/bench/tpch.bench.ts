@@ -0,0 +1,46 @@
+import { openAsBlob } from 'node:fs';
+import { join } from 'node:path';
+import { afterAll, beforeAll, describe } from 'vitest';
+import { DuckDB } from '../test/testDb';
+import {
+  benchmark,
+  TPCH_SCALE_FACTORS,
+  TPCH_TABLES,
+  tpchDataDir,
+  tpchQueries,
+} from '../../../bench/harness';
+
+const ITERATIONS = Number(process.env.BENCH_TPCH_ITERATIONS ?? 3);
+
+for (const scaleFactor of TPCH_SCALE_FACTORS) {
+  const dataDir = tpchDataDir(scaleFactor);
+
+  // Skipped (and reported as skipped) until `make bench-data` generated the files
+  describe.skipIf(!dataDir)(`TPC-H SF${scaleFactor}`, () => {
+    let db: DuckDB;
+    let conn: ReturnType<DuckDB['connect']>;
+
+    beforeAll(async () => {
+      db = new DuckDB();
+      conn = db.connect();
+      for (const table of TPCH_TABLES) {
+        // File-backed Blobs are read by range, like R2 objects in a Worker
+        const name = `tpch_sf${scaleFactor}_${table}.parquet`;
+        const file = await openAsBlob(join(dataDir as string, `${table}.parquet`));
+        await db.registerFileHandle(name, file);
+        await conn.execute(`CREATE VIEW ${table} AS SELECT * FROM '${name}'`);
+      }
+    });
+
+    afterAll(() => {
+      conn.close();
+      db.close();
+    });
+
+    for (const { name, sql } of tpchQueries()) {
+      benchmark(name, async (bench) => {
+        await bench.time(name, () => conn.query(sql), { iterations: ITERATIONS });
+      });
+    }
+  });
+}
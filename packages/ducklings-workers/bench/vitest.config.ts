@@ -0,0 +1,24 @@
+import { defineConfig } from 'vitest/config';
+import { resolve } from 'path';
+import JsonBenchReporter from '../../../bench/reporter';
+
+export default defineConfig({
+  resolve: {
+    // The shared harness lives outside the package; resolve its vitest import from here
+    dedupe: ['vitest'],
+  },
+  test: {
+    root: resolve(__dirname, '..'),
+    include: ['bench/**/*.bench.ts'],
+    reporters: ['default', new JsonBenchReporter()],
+    watch: false,
+    testTimeout: 600000,
+    hookTimeout: 600000,
+    // One benchmark at a time, each file with a fresh WASM instance (cold start)
+    fileParallelism: false,
+    isolate: true,
+    sequence: {
+      concurrent: false,
+    },
+  },
+});
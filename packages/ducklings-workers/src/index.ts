@@ -23,6 +23,7 @@ import {
   type Table,
   TimeUnit,
   tableFromArrays,
+  tableFromIPC,
   timestamp,
   uint8,
   uint16,
@@ -336,6 +337,182 @@ export interface ColumnInfo {
   alias?: string;
 }
 
+/**
+ * Options for Arrow IPC insertion.
+ * @category Types
+ */
+export interface ArrowIPCInsertOptions {
+  /** Append to an existing table instead of creating it */
+  append?: boolean;
+}
+
+/**
+ * Options for `queryArrowStream()`.
+ * @category Types
+ */
+export interface ArrowStreamOptions {
+  /**
+   * Rows to encode into each part of the stream (default: one DuckDB chunk, 2048 rows).
+   * Larger parts need fewer calls into WASM and hold more memory.
+   */
+  batchRows?: number;
+}
+
+/**
+ * Progress of a running query, as estimated by DuckDB.
+ * @category Types
+ */
+export interface QueryProgress {
+  /** Estimated completion in percent (0-100), or -1 when DuckDB cannot estimate it */
+  percentage: number;
+  /** Rows processed so far */
+  rowsProcessed: number;
+  /** Estimated number of rows to process */
+  totalRows: number;
+}
+
+/**
+ * Options for cancelling a query and following its progress.
+ * @category Types
+ */
+export interface QueryOptions {
+  /**
+   * Cancels the query when aborted. The Workers runtime only runs other JavaScript
+   * (timers, abort handlers) while the query waits on I/O, so an abort takes effect
+   * at the next fetch or file read of the query, or when it finishes.
+   */
+  signal?: AbortSignal;
+  /** Called between execution tasks whenever the progress estimate changes */
+  onProgress?: (progress: QueryProgress) => void;
+}
+
+/**
+ * Options of {@link Connection.query}.
+ * @category Types
+ */
+export interface QueryRowsOptions extends QueryOptions {
+  /** Collect a {@link QueryProfile} and attach it to the rows as `profile` */
+  profile?: boolean;
+}
+
+/**
+ * HTTP traffic to one URL during a profiled query.
+ * @category Types
+ */
+export interface HTTPURLProfile {
+  url: string;
+  /** Requests sent, including HEAD requests */
+  requests: number;
+  /** HEAD requests sent */
+  headRequests: number;
+  /** Requests that failed or returned an error status */
+  errors: number;
+  /** Response body bytes received */
+  bytesReceived: number;
+  /** Request body bytes sent */
+  bytesSent: number;
+  /** Range reads answered from the HTTP block cache */
+  rangeCacheHits: number;
+  /** HEAD requests answered from the metadata cache */
+  metadataCacheHits: number;
+  /** Summed latency of all requests in milliseconds */
+  totalLatencyMs: number;
+  /** Requests per latency bucket; see {@link HTTPProfile.latencyBoundsMs} */
+  latencyHistogram: number[];
+}
+
+/**
+ * HTTP traffic during a profiled query.
+ * @category Types
+ */
+export interface HTTPProfile {
+  /**
+   * Upper bounds of the latency buckets in milliseconds. Bucket `i` counts requests up to
+   * `latencyBoundsMs[i]`; the last bucket counts the slower ones.
+   */
+  latencyBoundsMs: number[];
+  /** Traffic per URL, in no particular order */
+  urls: HTTPURLProfile[];
+}
+
+/**
+ * Where a query spent its time.
+ *
+ * HTTP counters are process-wide: queries profiled at the same time share them.
+ * Latencies are measured around each fetch() and include the time until the module
+ * resumed after the response arrived.
+ * @category Types
+ */
+export interface QueryProfile {
+  /** Wall time of the query, including HTTP waits, in milliseconds */
+  totalTimeMs: number;
+  /** Time spent waiting on HTTP requests (overlapping requests are summed) */
+  httpTimeMs: number;
+  /**
+   * DuckDB's profiler tree (operators with timings and cardinalities), or null when the
+   * statement produced none
+   */
+  execution: Record<string, unknown> | null;
+  /** HTTP counters per URL */
+  http: HTTPProfile;
+}
+
+/**
+ * Rows returned by `query()` with `profile: true`.
+ * @category Types
+ */
+export type ProfiledRows<T> = T[] & { profile: QueryProfile };
+
+/**
+ * Console output levels, from none to every HTTP request.
+ * @category Types
+ */
+export type LogLevel = 'silent' | 'error' | 'warn' | 'debug';
+
+/**
+ * Values of one parameter for {@link PreparedStatement.executeBatch}, one entry per row.
+ *
+ * Typed arrays bind as the matching DuckDB type (Int32Array as INTEGER, Float64Array as
+ * DOUBLE, BigInt64Array as BIGINT, Uint8Array as UTINYINT, ...). Plain arrays bind by
+ * element type: strings as VARCHAR, booleans as BOOLEAN, numbers as DOUBLE, bigints as
+ * BIGINT and Uint8Arrays as BLOB, with `null` entries binding NULL.
+ * @category Types
+ */
+export type ColumnarParamValues =
+  | Int8Array
+  | Uint8Array
+  | Int16Array
+  | Uint16Array
+  | Int32Array
+  | Uint32Array
+  | BigInt64Array
+  | BigUint64Array
+  | Float32Array
+  | Float64Array
+  | readonly (string | null)[]
+  | readonly (boolean | null)[]
+  | readonly (number | null)[]
+  | readonly (bigint | null)[]
+  | readonly (Uint8Array | null)[];
+
+/**
+ * A typed array parameter column with NULLs.
+ * @category Types
+ */
+export interface ColumnarParam {
+  /** Values, one per row (entries for NULL rows are ignored) */
+  values: ColumnarParamValues;
+  /** One byte per row, non-zero for NULL */
+  nulls: Uint8Array;
+}
+
+/**
+ * Parameter columns for {@link PreparedStatement.executeBatch}, in parameter order.
+ * All columns must have the same number of rows.
+ * @category Types
+ */
+export type ColumnarParams = readonly (ColumnarParamValues | ColumnarParam)[];
+
 // Emscripten module interface
 interface EmscriptenModule {
   ccall: (
@@ -368,11 +545,245 @@ interface EmscriptenModule {
   HEAPU32: Uint32Array;
   HEAPF32: Float32Array;
   HEAPF64: Float64Array;
+  jsFiles: JSFileRegistry;
+}
+
+/**
+ * An object in an R2 bucket to register as a file.
+ * @category Types
+ */
+export interface R2FileSource {
+  /** The R2 bucket binding */
+  bucket: R2Bucket;
+  /** The object key */
+  key: string;
+}
+
+/**
+ * A source that can be registered as a file without copying it into WASM memory.
+ * @category Types
+ */
+export type FileHandleSource = Blob | R2FileSource | ReadableStream<Uint8Array>;
+
+/**
+ * Options for {@link DuckDB.registerR2Bucket}.
+ * @category Types
+ */
+export interface RegisterR2BucketOptions {
+  /**
+   * Seconds an object's size and ETag are reused before the bucket is asked again
+   * (default: 30). Reads always check the ETag, so a replaced object fails the query
+   * instead of returning mixed contents.
+   */
+  ttl?: number;
+}
+
+/**
+ * Options for {@link DuckDB.registerFileHandle}.
+ * @category Types
+ */
+export interface RegisterFileHandleOptions {
+  /** Byte length of a ReadableStream source, if known (e.g. from Content-Length) */
+  size?: number;
+}
+
+/**
+ * A file DuckDB reads through the module's JS-backed file system (src/fs/js_files.js).
+ * Reads suspend the query until the promise resolves.
+ * @internal
+ */
+interface JSFile {
+  readAsync(at: number, length: number): Promise<Uint8Array>;
+  getSize(): number;
+  close(): void;
+  /** Stream sources can only be read front to back */
+  sequential?: boolean;
+}
+
+/**
+ * Registry of JS-backed files exposed by the Emscripten module.
+ * @internal
+ */
+interface JSFileRegistry {
+  register(path: string, file: JSFile, exists?: boolean): number;
+  unregister(path: string): JSFile | null;
+  setResolver(prefix: string, resolver: JSFileResolver | null): void;
+}
+
+/**
+ * Looks up files below a path prefix when DuckDB first opens or globs them.
+ * @internal
+ */
+interface JSFileResolver {
+  open(path: string): Promise<JSFile | null>;
+  list(prefix: string): Promise<{ path: string; file: JSFile }[]>;
+  /** Milliseconds a looked up file is reused */
+  ttl: number;
+}
+
+/**
+ * Wrap a Blob; each read slices exactly the requested range.
+ * @internal
+ */
+function blobFile(blob: Blob): JSFile {
+  return {
+    readAsync: async (at, length) =>
+      new Uint8Array(await blob.slice(at, Math.min(at + length, blob.size)).arrayBuffer()),
+    getSize: () => blob.size,
+    close: () => {},
+  };
+}
+
+/**
+ * Wrap an R2 object; each read is a ranged GET for exactly the requested bytes.
+ * @internal
+ */
+async function r2File(source: R2FileSource): Promise<JSFile> {
+  const head = await source.bucket.head(source.key);
+  if (!head) {
+    throw new DuckDBError(`R2 object not found: ${source.key}`);
+  }
+  return r2ObjectFile(source.bucket, source.key, head);
+}
+
+/**
+ * Wrap an R2 object whose size and ETag are already known (from `head` or `list`).
+ * @internal
+ */
+function r2ObjectFile(bucket: R2Bucket, key: string, object: R2Object): JSFile {
+  const { size, etag } = object;
+  return {
+    readAsync: async (at, length) => {
+      const end = Math.min(at + length, size);
+      if (end <= at) {
+        return new Uint8Array(0);
+      }
+      const object = await bucket.get(key, {
+        range: { offset: at, length: end - at },
+        onlyIf: { etagMatches: etag },
+      });
+      if (!object || !('arrayBuffer' in object)) {
+        throw new DuckDBError(`R2 object changed or was removed: ${key}`);
+      }
+      return new Uint8Array(await object.arrayBuffer());
+    },
+    getSize: () => size,
+    close: () => {},
+  };
+}
+
+/**
+ * Wrap a ReadableStream; reads must move forward, skipped bytes are discarded.
+ * @internal
+ */
+function streamFile(stream: ReadableStream<Uint8Array>, size: number): JSFile {
+  const reader = stream.getReader();
+  // Stream offset of the first buffered chunk
+  let position = 0;
+  const chunks: Uint8Array[] = [];
+  let buffered = 0;
+  return {
+    sequential: true,
+    readAsync: async (at, length) => {
+      if (at < position) {
+        throw new DuckDBError('Stream files can only be read sequentially');
+      }
+      let skip = at - position;
+      while (buffered < skip + length) {
+        const { done, value } = await reader.read();
+        if (done) {
+          break;
+        }
+        chunks.push(value);
+        buffered += value.length;
+      }
+      const bytes = new Uint8Array(Math.max(Math.min(length, buffered - skip), 0));
+      let written = 0;
+      while (chunks.length > 0 && (skip > 0 || written < bytes.length)) {
+        const chunk = chunks[0];
+        if (skip >= chunk.length) {
+          skip -= chunk.length;
+          buffered -= chunk.length;
+          chunks.shift();
+          continue;
+        }
+        const piece = chunk.subarray(skip, skip + bytes.length - written);
+        bytes.set(piece, written);
+        written += piece.length;
+        buffered -= skip + piece.length;
+        const rest = chunk.subarray(skip + piece.length);
+        skip = 0;
+        if (rest.length > 0) {
+          chunks[0] = rest;
+        } else {
+          chunks.shift();
+        }
+      }
+      position = at + written;
+      return bytes;
+    },
+    getSize: () => size,
+    close: () => {
+      reader.cancel().catch(() => {});
+    },
+  };
 }
 
 // Module state
 let module: EmscriptenModule | null = null;
 let initPromise: Promise<EmscriptenModule> | null = null;
+/** Build of the loaded module ('asyncify' or 'jspi'), recorded in snapshots */
+let moduleVariant = 'asyncify';
+/** Database restored from a snapshot, adopted by the next DuckDB created */
+let snapshotDbPtr = 0;
+
+/** Module['logLevel'] values read by DucklingsLog (src/http/http_async.js) */
+const LOG_LEVELS: Record<LogLevel, number> = { silent: 0, error: 1, warn: 2, debug: 3 };
+
+/** Memory ceiling of the workers builds (MAXIMUM_MEMORY in scripts/build-duckdb.sh) */
+const MAX_MEMORY = 128 * 1024 ** 2;
+/** Smallest memory the builds instantiate with (Emscripten's default INITIAL_MEMORY) */
+const MIN_MEMORY = 16 * 1024 ** 2;
+const WASM_PAGE_SIZE = 65536;
+
+/**
+ * Share of the memory ceiling given to DuckDB as memory_limit, so its buffer manager
+ * evicts before the heap runs out. The rest is left for what it does not track: the
+ * stack, allocator overhead and results being copied out of WASM memory.
+ */
+const MEMORY_LIMIT_SHARE = 0.75;
+
+/** Largest size the loaded module's memory can grow to */
+let memoryCeiling = MAX_MEMORY;
+
+/**
+ * Create the module's memory with the requested initial and maximum size.
+ * @internal
+ */
+function createMemory(options: MemoryOptions | undefined): WebAssembly.Memory {
+  const initial = options?.initial ?? MIN_MEMORY;
+  const maximum = options?.maximum ?? MAX_MEMORY;
+  if (maximum > MAX_MEMORY) {
+    throw new DuckDBError(`Maximum memory cannot exceed ${MAX_MEMORY / 1024 ** 2} MB`);
+  }
+  if (initial < MIN_MEMORY || initial > maximum) {
+    throw new DuckDBError(
+      `Initial memory must be between ${MIN_MEMORY / 1024 ** 2} MB and the maximum memory`,
+    );
+  }
+  return new WebAssembly.Memory({
+    initial: Math.ceil(initial / WASM_PAGE_SIZE),
+    maximum: Math.floor(maximum / WASM_PAGE_SIZE),
+  });
+}
+
+/**
+ * The memory_limit setting for a memory ceiling, in MiB.
+ * @internal
+ */
+function memoryLimit(ceiling: number): string {
+  return `${Math.floor((ceiling * MEMORY_LIMIT_SHARE) / 1024 ** 2)}MiB`;
+}
 
 /**
  * Helper to get the current module, throwing if not initialized.
@@ -398,19 +809,295 @@ export interface InitOptions {
    * import wasmModule from '@ducklings/workers/wasm';
    * await init({ wasmModule });
    * ```
+   *
+   * Either the Asyncify build (`@ducklings/workers/wasm`) or the JSPI build
+   * (`@ducklings/workers/wasm/jspi`) can be passed; the matching glue code is
+   * picked from the module's exports.
    */
   wasmModule: WebAssembly.Module;
+
+  /**
+   * Asyncify build to use when `wasmModule` is a JSPI build but the runtime
+   * has no JavaScript Promise Integration (`WebAssembly.Suspending`).
+   *
+   * @example
+   * ```typescript
+   * import wasmModule from '@ducklings/workers/wasm/jspi';
+   * import fallbackWasmModule from '@ducklings/workers/wasm';
+   * await init({ wasmModule, fallbackWasmModule });
+   * ```
+   */
+  fallbackWasmModule?: WebAssembly.Module;
+
+  /**
+   * Memory snapshot from {@link DuckDB.createSnapshot} to restore at instantiation.
+   *
+   * The first `new DuckDB()` then gets the snapshotted database with its tables,
+   * settings and extensions instead of opening and setting up a new one. A snapshot
+   * only restores into the build it was taken with (Asyncify or JSPI, same version).
+   *
+   * @example
+   * ```typescript
+   * import wasmModule from '@ducklings/workers/wasm';
+   * import snapshot from './duckdb.snapshot';
+   *
+   * await init({ wasmModule, snapshot });
+   * const db = new DuckDB();
+   * ```
+   */
+  snapshot?: Uint8Array | ArrayBuffer;
+
+  /**
+   * How much the library writes to the console (default: `'warn'`).
+   * `'debug'` also traces every HTTP request and response.
+   */
+  logLevel?: LogLevel;
+
+  /**
+   * Cache remote reads in the Workers Cache API, so repeated reads of the same files
+   * are served from the data center's cache instead of the origin.
+   *
+   * @example
+   * ```typescript
+   * await init({ wasmModule, httpCache: { cache: caches.default } });
+   * ```
+   */
+  httpCache?: HTTPCacheOptions;
+
+  /**
+   * Initial and maximum size of the WebAssembly memory. DuckDB's `memory_limit` defaults
+   * to 75% of the maximum, so large queries fail with an out-of-memory error before the
+   * heap runs out; set `memory_limit` in `customConfig` to override it.
+   */
+  memory?: MemoryOptions;
+}
+
+/**
+ * Size of the WebAssembly memory, in bytes.
+ *
+ * @category Types
+ * @example
+ * ```typescript
+ * // Reserve 64 MB up front to avoid growing the heap step by step
+ * await init({ wasmModule, memory: { initial: 64 * 1024 ** 2 } });
+ * ```
+ */
+export interface MemoryOptions {
+  /** Memory allocated at startup; at least 16 MB (default: 16 MB) */
+  initial?: number;
+  /** Largest size the memory may grow to; at most 128 MB (default: 128 MB) */
+  maximum?: number;
+}
+
+/**
+ * Options for caching remote reads in the Workers Cache API.
+ *
+ * Ranged reads are cached per range under the file's ETag (or Last-Modified), so a changed
+ * file never serves stale blocks; a file's size and ETag are cached for `metadataTtl`.
+ * Cache writes finish in the background and are skipped for files without a validator.
+ * @category Types
+ */
+export interface HTTPCacheOptions {
+  /** The cache to use, e.g. `caches.default` or `await caches.open('ducklings')` */
+  cache: Cache;
+  /** Seconds a range stays cached (default: 86400) */
+  ttl?: number;
+  /** Seconds a file's size and ETag stay cached; 0 disables (default: 30) */
+  metadataTtl?: number;
+}
+
+/**
+ * Check whether the runtime supports JavaScript Promise Integration.
+ *
+ * JSPI builds suspend natively on async fetch() calls instead of unwinding
+ * the stack with Asyncify, which keeps the query engine's hot loops free of
+ * Asyncify instrumentation.
+ *
+ * @category Database
+ * @returns True if `WebAssembly.Suspending` and `WebAssembly.promising` are available
+ */
+export function isJspiSupported(): boolean {
+  const wasm = WebAssembly as unknown as Record<string, unknown>;
+  return typeof wasm.Suspending === 'function' && typeof wasm.promising === 'function';
+}
+
+/**
+ * Asyncify builds export their unwind entry points, JSPI builds do not.
+ * @internal
+ */
+function isAsyncifyModule(wasmModule: WebAssembly.Module): boolean {
+  return WebAssembly.Module.exports(wasmModule).some((exp) => exp.name === 'asyncify_start_unwind');
+}
+
+// ============================================================================
+// Snapshots
+// ============================================================================
+//
+// A snapshot is the linear memory taken after a database was opened and set up.
+// Memory only holds valid state between calls into WASM, and function pointers and
+// static data addresses in it refer to one build's layout, so snapshots are taken and
+// restored while no call runs and only into the build they came from.
+//
+// Layout: `DKSN` magic, format version (u32), header length (u32), JSON header,
+// padding to 8 bytes, then the 64 KiB pages listed in the header (all-zero pages are
+// left out). The format matches the one of @ducklings/browser.
+
+const SNAPSHOT_MAGIC = 0x4e534b44; // 'DKSN' little-endian
+const SNAPSHOT_FORMAT_VERSION = 1;
+const SNAPSHOT_PAGE_SIZE = 65536;
+
+/**
+ * Metadata stored in front of the memory pages of a snapshot.
+ */
+interface SnapshotHeader {
+  /** Build the snapshot was taken with */
+  variant: string;
+  /** DuckDB library version of the build */
+  libraryVersion: string;
+  /** Address of the version string, which moves with the build's static data layout */
+  libraryVersionPtr: number;
+  /** Size of linear memory when the snapshot was taken */
+  memoryBytes: number;
+  /** duckdb_database handle of the snapshotted database */
+  dbPtr: number;
+  /** Indices of the stored (non-zero) pages, in order */
+  pages: number[];
+}
+
+/**
+ * Options for {@link DuckDB.createSnapshot}.
+ * @category Types
+ */
+export interface SnapshotOptions {
+  /** Configuration of the snapshotted database */
+  config?: DuckDBConfig;
+  /**
+   * SQL run before the snapshot is taken, e.g. to create tables or load data.
+   * Runs before the configuration is locked, so it may change settings.
+   */
+  setupSql?: string | string[];
+}
+
+/**
+ * Identify the build of a module the way snapshots record it.
+ */
+function snapshotBuildIdentity(mod: EmscriptenModule): {
+  libraryVersion: string;
+  libraryVersionPtr: number;
+} {
+  const libraryVersionPtr = mod.ccall('duckdb_library_version', 'number', [], []) as number;
+  return { libraryVersion: mod.UTF8ToString(libraryVersionPtr), libraryVersionPtr };
+}
+
+/**
+ * Serialize the module's linear memory with the database handle to restore.
+ */
+function captureSnapshot(mod: EmscriptenModule, dbPtr: number): Uint8Array {
+  const heap = mod.HEAPU8;
+  const words = new Uint32Array(heap.buffer, heap.byteOffset, heap.byteLength / 4);
+  const wordsPerPage = SNAPSHOT_PAGE_SIZE / 4;
+
+  const pages: number[] = [];
+  for (let page = 0; page * SNAPSHOT_PAGE_SIZE < heap.byteLength; page++) {
+    for (let i = page * wordsPerPage; i < (page + 1) * wordsPerPage; i++) {
+      if (words[i] !== 0) {
+        pages.push(page);
+        break;
+      }
+    }
+  }
+
+  const header: SnapshotHeader = {
+    variant: moduleVariant,
+    ...snapshotBuildIdentity(mod),
+    memoryBytes: heap.byteLength,
+    dbPtr,
+    pages,
+  };
+  const headerBytes = new TextEncoder().encode(JSON.stringify(header));
+  const dataOffset = Math.ceil((12 + headerBytes.length) / 8) * 8;
+
+  const snapshot = new Uint8Array(dataOffset + pages.length * SNAPSHOT_PAGE_SIZE);
+  const view = new DataView(snapshot.buffer);
+  view.setUint32(0, SNAPSHOT_MAGIC, true);
+  view.setUint32(4, SNAPSHOT_FORMAT_VERSION, true);
+  view.setUint32(8, headerBytes.length, true);
+  snapshot.set(headerBytes, 12);
+  for (let i = 0; i < pages.length; i++) {
+    const start = pages[i] * SNAPSHOT_PAGE_SIZE;
+    const page = heap.subarray(start, start + SNAPSHOT_PAGE_SIZE);
+    snapshot.set(page, dataOffset + i * SNAPSHOT_PAGE_SIZE);
+  }
+  return snapshot;
+}
+
+/**
+ * Overwrite the memory of a freshly instantiated module with a snapshot.
+ *
+ * @returns The duckdb_database handle of the restored database
+ */
+function restoreSnapshot(mod: EmscriptenModule, snapshot: Uint8Array): number {
+  const view = new DataView(snapshot.buffer, snapshot.byteOffset, snapshot.byteLength);
+  if (snapshot.byteLength < 12 || view.getUint32(0, true) !== SNAPSHOT_MAGIC) {
+    throw new DuckDBError('Not a Ducklings snapshot');
+  }
+  const format = view.getUint32(4, true);
+  if (format !== SNAPSHOT_FORMAT_VERSION) {
+    throw new DuckDBError(`Unsupported snapshot format ${format}`);
+  }
+  const headerLength = view.getUint32(8, true);
+  const header = JSON.parse(
+    new TextDecoder().decode(snapshot.subarray(12, 12 + headerLength)),
+  ) as SnapshotHeader;
+  const dataOffset = Math.ceil((12 + headerLength) / 8) * 8;
+
+  const identity = snapshotBuildIdentity(mod);
+  if (
+    header.variant !== moduleVariant ||
+    header.libraryVersion !== identity.libraryVersion ||
+    header.libraryVersionPtr !== identity.libraryVersionPtr
+  ) {
+    throw new DuckDBError(
+      `Snapshot was taken with another build (${header.variant}, ` +
+        `DuckDB ${header.libraryVersion}); create it again with this version`,
+    );
+  }
+  if (snapshot.byteLength < dataOffset + header.pages.length * SNAPSHOT_PAGE_SIZE) {
+    throw new DuckDBError('Snapshot is truncated');
+  }
+
+  // Grow memory through the allocator so the module's heap views are refreshed
+  if (mod.HEAPU8.byteLength < header.memoryBytes) {
+    const ptr = mod._malloc(header.memoryBytes - mod.HEAPU8.byteLength);
+    if (!ptr) {
+      throw new DuckDBError('Not enough memory to restore the snapshot');
+    }
+    mod._free(ptr);
+  }
+
+  // Every byte is rewritten: stored pages are copied, all others are zero
+  const heap = mod.HEAPU8;
+  heap.fill(0);
+  for (let i = 0; i < header.pages.length; i++) {
+    const start = dataOffset + i * SNAPSHOT_PAGE_SIZE;
+    const page = snapshot.subarray(start, start + SNAPSHOT_PAGE_SIZE);
+    heap.set(page, header.pages[i] * SNAPSHOT_PAGE_SIZE);
+  }
+  return header.dbPtr;
 }
 
 /**
- * Initialize the DuckDB WASM module (workers build with Asyncify).
+ * Initialize the DuckDB WASM module (workers build with Asyncify or JSPI).
  *
  * This version is optimized for Cloudflare Workers and uses the workers-specific
- * WASM build that includes Asyncify support for async HTTP operations.
+ * WASM build that supports async HTTP operations. A JSPI build is used when the
+ * runtime supports `WebAssembly.Suspending`; otherwise `fallbackWasmModule`
+ * (an Asyncify build) is used.
  *
  * @category Database
  * @param options - Initialization options with pre-compiled WASM module
  * @returns Promise that resolves when initialization is complete
+ * @throws {@link DuckDBError} If a JSPI build is passed without a fallback on a runtime without JSPI
  *
  * @example
  * ```typescript
@@ -443,25 +1130,57 @@ export async function init(options: InitOptions): Promise<void> {
     );
   }
 
+  let wasmModule = options.wasmModule;
+  let jspi = !isAsyncifyModule(wasmModule);
+  if (jspi && !isJspiSupported()) {
+    if (!options.fallbackWasmModule) {
+      throw new DuckDBError(
+        'This runtime does not support JavaScript Promise Integration (WebAssembly.Suspending). ' +
+          'Pass the Asyncify build as { fallbackWasmModule } or use @ducklings/workers/wasm.',
+      );
+    }
+    wasmModule = options.fallbackWasmModule;
+    jspi = false;
+  }
+
   initPromise = (async () => {
     // Dynamic import of the workers-specific Emscripten-generated JavaScript
-    const DuckDBModule = (await import('./wasm/duckdb-workers.js')).default;
+    // matching the module's async mode
+    const DuckDBModule = jspi
+      ? (await import('./wasm/duckdb-workers-jspi.js')).default
+      : (await import('./wasm/duckdb-workers.js')).default;
 
     // Initialize the Emscripten module with pre-compiled WASM
     const config: Record<string, unknown> = {
+      logLevel: LOG_LEVELS[options.logLevel ?? 'warn'],
+      wasmMemory: createMemory(options.memory),
+      httpCache: options.httpCache && {
+        cache: options.httpCache.cache,
+        ttl: options.httpCache.ttl ?? 86400,
+        metadataTtl: options.httpCache.metadataTtl ?? 30,
+      },
       instantiateWasm: (
         imports: WebAssembly.Imports,
         receiveInstance: (instance: WebAssembly.Instance) => void,
       ) => {
-        WebAssembly.instantiate(options.wasmModule, imports).then((instance) => {
+        WebAssembly.instantiate(wasmModule, imports).then((instance) => {
           receiveInstance(instance);
         });
         return {}; // Return empty exports, will be filled by receiveInstance
       },
     };
 
-    const mod = await DuckDBModule(config);
-    return mod as EmscriptenModule;
+    const mod = (await DuckDBModule(config)) as EmscriptenModule;
+    moduleVariant = jspi ? 'jspi' : 'asyncify';
+    memoryCeiling = options.memory?.maximum ?? MAX_MEMORY;
+    if (options.snapshot) {
+      const { snapshot } = options;
+      snapshotDbPtr = restoreSnapshot(
+        mod,
+        snapshot instanceof ArrayBuffer ? new Uint8Array(snapshot) : snapshot,
+      );
+    }
+    return mod;
   })();
 
   module = await initPromise;
@@ -690,18 +1409,152 @@ function readColumnData(
   return result;
 }
 
+/**
+ * One parameter column in the layout duckdb_wasm_execute_batch reads.
+ * VARCHAR and BLOB columns hold their bytes back to back with `rowCount + 1` offsets.
+ * @internal
+ */
+interface BatchParamColumn {
+  type: DuckDBTypeId;
+  data: ArrayBufferView;
+  offsets?: Uint32Array;
+  /** One byte per row, non-zero for NULL */
+  nulls?: Uint8Array;
+}
+
+const utf8Encoder = new TextEncoder();
+
+function typedArrayType(values: ArrayBufferView): DuckDBTypeId {
+  if (values instanceof Int8Array) return DuckDBType.TINYINT;
+  if (values instanceof Uint8Array) return DuckDBType.UTINYINT;
+  if (values instanceof Int16Array) return DuckDBType.SMALLINT;
+  if (values instanceof Uint16Array) return DuckDBType.USMALLINT;
+  if (values instanceof Int32Array) return DuckDBType.INTEGER;
+  if (values instanceof Uint32Array) return DuckDBType.UINTEGER;
+  if (values instanceof BigInt64Array) return DuckDBType.BIGINT;
+  if (values instanceof BigUint64Array) return DuckDBType.UBIGINT;
+  if (values instanceof Float32Array) return DuckDBType.FLOAT;
+  if (values instanceof Float64Array) return DuckDBType.DOUBLE;
+  throw new DuckDBError(`Unsupported parameter array: ${values.constructor.name}`);
+}
+
+/**
+ * Concatenate byte strings into one buffer with `length + 1` offsets.
+ */
+function packBytes(parts: (Uint8Array | null)[]): { data: Uint8Array; offsets: Uint32Array } {
+  const offsets = new Uint32Array(parts.length + 1);
+  for (let i = 0; i < parts.length; i++) {
+    offsets[i + 1] = offsets[i] + (parts[i]?.length ?? 0);
+  }
+  const data = new Uint8Array(offsets[parts.length]);
+  for (let i = 0; i < parts.length; i++) {
+    const part = parts[i];
+    if (part) {
+      data.set(part, offsets[i]);
+    }
+  }
+  return { data, offsets };
+}
+
+/**
+ * Convert a plain array column to typed arrays, deriving the type from its values.
+ */
+function encodeArrayColumn(values: readonly unknown[], parameter: number): BatchParamColumn {
+  const first = values.find((value) => value !== null && value !== undefined);
+  const checkType = (check: (value: unknown) => boolean, name: string) => {
+    for (const value of values) {
+      if (value !== null && value !== undefined && !check(value)) {
+        throw new DuckDBError(`Parameter ${parameter} mixes ${name} values with other types`);
+      }
+    }
+  };
+
+  let nulls: Uint8Array | undefined;
+  if (values.some((value) => value === null || value === undefined)) {
+    nulls = Uint8Array.from(values, (value) => (value === null || value === undefined ? 1 : 0));
+  }
+
+  if (typeof first === 'boolean') {
+    checkType((value) => typeof value === 'boolean', 'boolean');
+    return { type: DuckDBType.BOOLEAN, data: Uint8Array.from(values, (v) => (v ? 1 : 0)), nulls };
+  }
+  if (typeof first === 'number') {
+    checkType((value) => typeof value === 'number', 'number');
+    return {
+      type: DuckDBType.DOUBLE,
+      data: Float64Array.from(values, (v) => (v as number | null) ?? 0),
+      nulls,
+    };
+  }
+  if (typeof first === 'bigint') {
+    checkType((value) => typeof value === 'bigint', 'bigint');
+    return {
+      type: DuckDBType.BIGINT,
+      data: BigInt64Array.from(values, (v) => (v as bigint | null) ?? BigInt(0)),
+      nulls,
+    };
+  }
+  if (first instanceof Uint8Array) {
+    checkType((value) => value instanceof Uint8Array, 'Uint8Array');
+    return { type: DuckDBType.BLOB, ...packBytes(values as (Uint8Array | null)[]), nulls };
+  }
+
+  checkType((value) => typeof value === 'string', 'string');
+  const encoded = values.map((value) =>
+    typeof value === 'string' ? utf8Encoder.encode(value) : null,
+  );
+  return { type: DuckDBType.VARCHAR, ...packBytes(encoded), nulls };
+}
+
+/**
+ * Validate parameter columns and convert them to typed arrays.
+ * @internal
+ */
+function encodeColumnarParams(params: ColumnarParams): {
+  rowCount: number;
+  columns: BatchParamColumn[];
+} {
+  let rowCount = -1;
+  const columns = params.map((param, index) => {
+    const { values, nulls } =
+      ArrayBuffer.isView(param) || Array.isArray(param)
+        ? { values: param as ColumnarParamValues, nulls: undefined }
+        : (param as ColumnarParam);
+
+    if (rowCount === -1) {
+      rowCount = values.length;
+    } else if (values.length !== rowCount) {
+      throw new DuckDBError(
+        `Parameter ${index + 1} has ${values.length} rows, expected ${rowCount}`,
+      );
+    }
+    if (nulls && nulls.length < values.length) {
+      throw new DuckDBError(`Parameter ${index + 1} has fewer NULL flags than rows`);
+    }
+
+    if (ArrayBuffer.isView(values)) {
+      return { type: typedArrayType(values), data: values, nulls };
+    }
+    const column = encodeArrayColumn(values, index + 1);
+    return nulls ? { ...column, nulls } : column;
+  });
+  return { rowCount: Math.max(rowCount, 0), columns };
+}
+
 /**
  * A prepared SQL statement with parameter binding.
  * @category Query Results
  */
 export class PreparedStatement {
   private stmtPtr: number;
+  private connPtr: number;
   private closed = false;
   private readonly sql: string;
 
   /** @internal */
-  constructor(stmtPtr: number, _connPtr: number, sql: string) {
+  constructor(stmtPtr: number, connPtr: number, sql: string) {
     this.stmtPtr = stmtPtr;
+    this.connPtr = connPtr;
     this.sql = sql;
   }
 
@@ -1049,6 +1902,96 @@ export class PreparedStatement {
     }
   }
 
+  /**
+   * Execute the statement once per row of columnar parameters.
+   *
+   * Binding and execution loop inside WASM, so a batch costs one call instead of one
+   * bind and execute per row. Outside an explicit transaction the batch runs in a
+   * transaction of its own, so either all rows are applied or none are. Bindings set
+   * with the bind methods are not used.
+   *
+   * @param params - One column of values per parameter, all with the same number of rows
+   * @returns The number of rows changed, summed over all executions
+   *
+   * @example
+   * ```typescript
+   * const stmt = conn.prepare('INSERT INTO events VALUES (?, ?)');
+   * await stmt.executeBatch([new Int32Array([1, 2, 3]), ['click', 'view', null]]);
+   * stmt.close();
+   * ```
+   */
+  async executeBatch(params: ColumnarParams): Promise<number> {
+    if (this.closed) throw new DuckDBError('Statement is closed');
+    const mod = getModule();
+    const { rowCount, columns } = encodeColumnarParams(params);
+
+    // Copy every column into the heap and describe it with a duckdb_wasm_batch_column
+    // (4 x i32: type, data, offsets, nulls)
+    const allocations: number[] = [];
+    const copyToHeap = (view: ArrayBufferView | undefined): number => {
+      if (!view) {
+        return 0;
+      }
+      const ptr = mod._malloc(Math.max(view.byteLength, 1));
+      allocations.push(ptr);
+      mod.HEAPU8.set(new Uint8Array(view.buffer, view.byteOffset, view.byteLength), ptr);
+      return ptr;
+    };
+
+    const columnsPtr = mod._malloc(Math.max(columns.length * 16, 16));
+    const outRowsPtr = mod._malloc(8);
+    const outErrorPtr = mod._malloc(4);
+    try {
+      for (let i = 0; i < columns.length; i++) {
+        const base = columnsPtr + i * 16;
+        mod.setValue(base, columns[i].type, 'i32');
+        mod.setValue(base + 4, copyToHeap(columns[i].data), 'i32');
+        mod.setValue(base + 8, copyToHeap(columns[i].offsets), 'i32');
+        mod.setValue(base + 12, copyToHeap(columns[i].nulls), 'i32');
+      }
+
+      // idx_t arguments are passed as (low, high) pairs
+      const status = (await mod.ccall(
+        'duckdb_wasm_execute_batch',
+        'number',
+        ['number', 'number', 'number', 'number', 'number', 'number', 'number', 'number', 'number'],
+        [
+          this.connPtr,
+          this.stmtPtr,
+          columnsPtr,
+          columns.length,
+          0,
+          rowCount,
+          0,
+          outRowsPtr,
+          outErrorPtr,
+        ],
+        { async: true },
+      )) as number;
+
+      if (status !== 0) {
+        const errorPtr = mod.getValue(outErrorPtr, '*');
+        const errorMsg = errorPtr ? mod.UTF8ToString(errorPtr) : 'Prepared statement batch failed';
+        if (errorPtr) {
+          mod._free(errorPtr);
+        }
+        throw new DuckDBError(errorMsg, undefined, this.sql);
+      }
+
+      return (
+        (mod.getValue(outRowsPtr, 'i32') >>> 0) +
+        (mod.getValue(outRowsPtr + 4, 'i32') >>> 0) * 0x100000000
+      );
+    } finally {
+      for (const ptr of allocations) {
+        mod._free(ptr);
+      }
+      mod._free(columnsPtr);
+      mod._free(outRowsPtr);
+      mod._free(outErrorPtr);
+    }
+  }
+
   close(): void {
     if (this.closed) return;
     const mod = getModule();
@@ -1376,91 +2319,363 @@ export class StreamingResult implements Iterable<DataChunk> {
     }
   }
 
-  toArray<T = Record<string, unknown>>(): T[] {
-    const allRows: T[] = [];
-    for (const chunk of this) {
-      allRows.push(...chunk.toArray<T>());
-    }
-    return allRows;
+  toArray<T = Record<string, unknown>>(): T[] {
+    const allRows: T[] = [];
+    for (const chunk of this) {
+      allRows.push(...chunk.toArray<T>());
+    }
+    return allRows;
+  }
+
+  /**
+   * Converts the streaming result into a Flechette Arrow Table.
+   *
+   * Reads all remaining chunks and aggregates them into a single Arrow table.
+   * DuckDB column types are mapped to the corresponding Flechette types.
+   *
+   * @returns A Flechette {@link Table} containing all result data
+   *
+   * @example
+   * ```typescript
+   * const stream = conn.queryStreaming('SELECT * FROM large_table');
+   * const arrowTable = stream.toArrowTable();
+   * console.log(arrowTable.numRows);
+   * ```
+   */
+  toArrowTable(): Table {
+    const columnData: Record<string, unknown[]> = {};
+    const types: Record<string, DataType> = {};
+
+    for (const col of this.columns) {
+      columnData[col.name] = [];
+      types[col.name] = this.getFlechetteType(col.type);
+    }
+
+    for (const chunk of this) {
+      for (let c = 0; c < this.columns.length; c++) {
+        const colName = this.columns[c].name;
+        const chunkData = chunk.getColumn(c);
+        columnData[colName].push(...chunkData);
+      }
+    }
+
+    return tableFromArrays(columnData, { types });
+  }
+
+  private getFlechetteType(duckdbType: DuckDBTypeId): DataType {
+    switch (duckdbType) {
+      case DuckDBType.BOOLEAN:
+        return bool();
+      case DuckDBType.TINYINT:
+        return int8();
+      case DuckDBType.SMALLINT:
+        return int16();
+      case DuckDBType.INTEGER:
+        return int32();
+      case DuckDBType.BIGINT:
+        return int64();
+      case DuckDBType.UTINYINT:
+        return uint8();
+      case DuckDBType.USMALLINT:
+        return uint16();
+      case DuckDBType.UINTEGER:
+        return uint32();
+      case DuckDBType.UBIGINT:
+        return uint64();
+      case DuckDBType.FLOAT:
+        return float32();
+      case DuckDBType.DOUBLE:
+        return float64();
+      case DuckDBType.VARCHAR:
+        return utf8();
+      case DuckDBType.DATE:
+        return dateDay();
+      case DuckDBType.TIMESTAMP:
+      case DuckDBType.TIMESTAMP_TZ:
+        return timestamp(TimeUnit.MICROSECOND);
+      default:
+        return utf8();
+    }
+  }
+
+  close(): void {
+    if (this.closed) return;
+    const mod = getModule();
+    mod.ccall('duckdb_destroy_result', null, ['number'], [this.resultPtr]);
+    this.closed = true;
+    this.resultPtr = 0;
+  }
+}
+
+/**
+ * An incremental Arrow IPC ingest into a table.
+ *
+ * Bytes of an Arrow IPC stream can be pushed in pieces of any size, e.g. as
+ * they arrive from a request body. Each record batch is written to the table
+ * as soon as it is complete, so only one batch is held in WASM memory.
+ *
+ * @category Data Insertion
+ * @example
+ * ```typescript
+ * const ingest = conn.openArrowIPCIngest('events', { append: true });
+ * try {
+ *   for await (const bytes of request.body!) {
+ *     await ingest.push(bytes);
+ *   }
+ *   await ingest.finish();
+ * } finally {
+ *   ingest.close();
+ * }
+ * ```
+ */
+export class ArrowIPCIngest {
+  private ingestPtr: number;
+  private closed = false;
+
+  /** @internal */
+  constructor(ingestPtr: number) {
+    this.ingestPtr = ingestPtr;
+  }
+
+  private checkClosed(): EmscriptenModule {
+    if (this.closed || !module) {
+      throw new DuckDBError('Arrow IPC ingest is closed');
+    }
+    return module;
+  }
+
+  private getError(mod: EmscriptenModule): string {
+    const errorPtr = mod.ccall(
+      'duckdb_wasm_arrow_ipc_ingest_error',
+      'number',
+      ['number'],
+      [this.ingestPtr],
+    ) as number;
+    return errorPtr ? mod.UTF8ToString(errorPtr) : 'Arrow IPC ingest failed';
+  }
+
+  /**
+   * Push the next bytes of the IPC stream.
+   *
+   * @param bytes - The next part of the Arrow IPC stream
+   * @throws {@link DuckDBError} If a completed batch cannot be decoded or written
+   */
+  async push(bytes: Uint8Array): Promise<void> {
+    const mod = this.checkClosed();
+
+    const bufPtr = mod._malloc(bytes.length);
+    mod.HEAPU8.set(bytes, bufPtr);
+
+    try {
+      const result = (await mod.ccall(
+        'duckdb_wasm_arrow_ipc_ingest_push',
+        'number',
+        ['number', 'number', 'number'],
+        [this.ingestPtr, bufPtr, bytes.length],
+        { async: true },
+      )) as number;
+
+      if (result !== 0) {
+        throw new DuckDBError(this.getError(mod));
+      }
+    } finally {
+      mod._free(bufPtr);
+    }
+  }
+
+  /**
+   * Finish the ingest and release it.
+   *
+   * @throws {@link DuckDBError} If the stream ended in the middle of a message or had no schema
+   */
+  async finish(): Promise<void> {
+    const mod = this.checkClosed();
+
+    try {
+      const result = (await mod.ccall(
+        'duckdb_wasm_arrow_ipc_ingest_finish',
+        'number',
+        ['number'],
+        [this.ingestPtr],
+        { async: true },
+      )) as number;
+
+      if (result !== 0) {
+        throw new DuckDBError(this.getError(mod));
+      }
+    } finally {
+      this.close();
+    }
+  }
+
+  /**
+   * Release the ingest without finishing it.
+   *
+   * Batches that were already written stay in the table.
+   */
+  close(): void {
+    if (this.closed || !module) return;
+
+    module.ccall('duckdb_wasm_arrow_ipc_ingest_destroy', null, ['number'], [this.ingestPtr]);
+    this.closed = true;
+    this.ingestPtr = 0;
+  }
+}
+
+/**
+ * A query result read as an Arrow IPC stream, one part at a time.
+ *
+ * The record batches of each part are encoded only when it is read, so neither the
+ * whole result nor its IPC bytes are held in WASM memory at once. The first part starts
+ * with the schema message and the last one ends with the end-of-stream marker;
+ * concatenated in order, the parts form a complete Arrow IPC stream.
+ *
+ * @category Query Results
+ * @example
+ * ```typescript
+ * const stream = await conn.queryArrowStream('SELECT * FROM large_table');
+ * return new Response(stream.toReadableStream(), {
+ *   headers: { 'Content-Type': 'application/vnd.apache.arrow.stream' },
+ * });
+ * ```
+ */
+export class ArrowIPCStream implements AsyncIterable<Uint8Array> {
+  private streamPtr: number;
+  private readonly batchRows: number;
+  private readonly sql: string;
+  private closed = false;
+  private done = false;
+
+  /** @internal */
+  constructor(streamPtr: number, batchRows: number, sql: string) {
+    this.streamPtr = streamPtr;
+    this.batchRows = batchRows;
+    this.sql = sql;
+  }
+
+  /**
+   * Check if the stream has been fully read.
+   */
+  isDone(): boolean {
+    return this.done;
   }
 
   /**
-   * Converts the streaming result into a Flechette Arrow Table.
-   *
-   * Reads all remaining chunks and aggregates them into a single Arrow table.
-   * DuckDB column types are mapped to the corresponding Flechette types.
-   *
-   * @returns A Flechette {@link Table} containing all result data
-   *
-   * @example
-   * ```typescript
-   * const stream = conn.queryStreaming('SELECT * FROM large_table');
-   * const arrowTable = stream.toArrowTable();
-   * console.log(arrowTable.numRows);
-   * ```
+   * Check if the stream is closed.
    */
-  toArrowTable(): Table {
-    const columnData: Record<string, unknown[]> = {};
-    const types: Record<string, DataType> = {};
+  isClosed(): boolean {
+    return this.closed;
+  }
 
-    for (const col of this.columns) {
-      columnData[col.name] = [];
-      types[col.name] = this.getFlechetteType(col.type);
+  /**
+   * Read the next part of the stream.
+   *
+   * @returns Promise resolving to the next IPC bytes, or null once the stream is complete
+   * @throws {@link DuckDBError} If the query fails while its result is read
+   */
+  async next(): Promise<Uint8Array | null> {
+    if (this.closed || !module) {
+      throw new DuckDBError('Arrow IPC stream is closed');
     }
-
-    for (const chunk of this) {
-      for (let c = 0; c < this.columns.length; c++) {
-        const colName = this.columns[c].name;
-        const chunkData = chunk.getColumn(c);
-        columnData[colName].push(...chunkData);
-      }
+    if (this.done) {
+      return null;
     }
+    const mod = module;
 
-    return tableFromArrays(columnData, { types });
-  }
+    // Out-params: uint8_t** buffer, size_t* length
+    const outPtr = mod._malloc(8);
+    try {
+      mod.setValue(outPtr, 0, 'i32');
+      mod.setValue(outPtr + 4, 0, 'i32');
+      const status = (await mod.ccall(
+        'duckdb_wasm_arrow_ipc_stream_next',
+        'number',
+        ['number', 'number', 'number', 'number'],
+        [this.streamPtr, this.batchRows, outPtr, outPtr + 4],
+        { async: true },
+      )) as number;
 
-  private getFlechetteType(duckdbType: DuckDBTypeId): DataType {
-    switch (duckdbType) {
-      case DuckDBType.BOOLEAN:
-        return bool();
-      case DuckDBType.TINYINT:
-        return int8();
-      case DuckDBType.SMALLINT:
-        return int16();
-      case DuckDBType.INTEGER:
-        return int32();
-      case DuckDBType.BIGINT:
-        return int64();
-      case DuckDBType.UTINYINT:
-        return uint8();
-      case DuckDBType.USMALLINT:
-        return uint16();
-      case DuckDBType.UINTEGER:
-        return uint32();
-      case DuckDBType.UBIGINT:
-        return uint64();
-      case DuckDBType.FLOAT:
-        return float32();
-      case DuckDBType.DOUBLE:
-        return float64();
-      case DuckDBType.VARCHAR:
-        return utf8();
-      case DuckDBType.DATE:
-        return dateDay();
-      case DuckDBType.TIMESTAMP:
-      case DuckDBType.TIMESTAMP_TZ:
-        return timestamp(TimeUnit.MICROSECOND);
-      default:
-        return utf8();
+      if (status !== 0) {
+        const errorPtr = mod.ccall(
+          'duckdb_wasm_arrow_ipc_stream_error',
+          'number',
+          ['number'],
+          [this.streamPtr],
+        ) as number;
+        throw new DuckDBError(
+          errorPtr ? mod.UTF8ToString(errorPtr) : 'Query failed',
+          undefined,
+          this.sql,
+        );
+      }
+
+      const bufPtr = mod.getValue(outPtr, 'i32');
+      const bufLen = mod.getValue(outPtr + 4, 'i32');
+      if (!bufPtr) {
+        this.done = true;
+        return null;
+      }
+      // Copy out of the WASM heap, which may grow (and detach views) later
+      const ipcBuffer = mod.HEAPU8.slice(bufPtr, bufPtr + bufLen);
+      mod._free(bufPtr);
+      return ipcBuffer;
+    } finally {
+      mod._free(outPtr);
     }
   }
 
+  /**
+   * Close the stream and release its query result.
+   */
   close(): void {
-    if (this.closed) return;
-    const mod = getModule();
-    mod.ccall('duckdb_destroy_result', null, ['number'], [this.resultPtr]);
+    if (this.closed || !module) return;
+
+    module.ccall('duckdb_wasm_arrow_ipc_stream_destroy', null, ['number'], [this.streamPtr]);
     this.closed = true;
-    this.resultPtr = 0;
+    this.streamPtr = 0;
+  }
+
+  /**
+   * Expose the stream as a `ReadableStream` of IPC bytes, e.g. for a `Response` body.
+   *
+   * Each pull reads the next part; cancelling the stream closes it.
+   */
+  toReadableStream(): ReadableStream<Uint8Array> {
+    return new ReadableStream<Uint8Array>(
+      {
+        pull: async (controller) => {
+          try {
+            const bytes = await this.next();
+            if (bytes) {
+              controller.enqueue(bytes);
+              return;
+            }
+            controller.close();
+          } catch (error) {
+            controller.error(error);
+          }
+          this.close();
+        },
+        cancel: () => this.close(),
+      },
+      // Only read ahead when the consumer asks for the next part
+      { highWaterMark: 0 },
+    );
+  }
+
+  /**
+   * Returns an async iterator over the parts of this stream.
+   */
+  async *[Symbol.asyncIterator](): AsyncIterator<Uint8Array> {
+    try {
+      let bytes = await this.next();
+      while (bytes !== null) {
+        yield bytes;
+        bytes = await this.next();
+      }
+    } finally {
+      this.close();
+    }
   }
 }
 
@@ -1509,6 +2724,16 @@ export class DuckDB {
     // Store module reference for use in closures
     const mod = module;
 
+    // Adopt the database restored from a snapshot; it was configured when it was taken
+    if (snapshotDbPtr) {
+      if (Object.keys(config).length > 0) {
+        throw new DuckDBError('The database restored from a snapshot cannot be configured');
+      }
+      this.dbPtr = snapshotDbPtr;
+      snapshotDbPtr = 0;
+      return;
+    }
+
     // Apply defaults
     const finalConfig = {
       accessMode: config.accessMode ?? AccessMode.AUTOMATIC,
@@ -1558,11 +2783,17 @@ export class DuckDB {
         setConfig('enable_external_access', 'false');
       }
 
+      // Keep the buffer manager below the memory ceiling; customConfig may override it
+      setConfig('memory_limit', memoryLimit(memoryCeiling));
+
       // Apply custom config options
       for (const [key, value] of Object.entries(finalConfig.customConfig)) {
         setConfig(key, value);
       }
 
+      // Route registered Blob, R2 and stream files to the JS-backed file system
+      mod.ccall('duckdb_wasm_fs_configure', null, ['number'], [configPtr]);
+
       // Open database with config
       const dbPtrPtr = mod._malloc(4);
       const errorPtrPtr = mod._malloc(4);
@@ -1642,6 +2873,50 @@ export class DuckDB {
     return new DuckDB(config);
   }
 
+  /**
+   * Creates a database, runs the setup SQL and returns a memory snapshot of it.
+   *
+   * Pass the snapshot to {@link init} (`{ snapshot }`) to start with this database
+   * without opening it or running the setup again, which takes the database setup out
+   * of the cold start. Take the snapshot with the same WASM build that restores it, for
+   * example at build time with the `ducklings-snapshot` CLI. Files registered with
+   * {@link DuckDB.registerFileHandle} are not part of the snapshot.
+   *
+   * @param options - Database configuration and setup SQL
+   * @returns The snapshot bytes
+   *
+   * @example
+   * ```typescript
+   * await init({ wasmModule });
+   * const snapshot = await DuckDB.createSnapshot({
+   *   setupSql: "CREATE TABLE airports AS SELECT * FROM 'https://example.com/airports.parquet'",
+   * });
+   * ```
+   */
+  static async createSnapshot(options: SnapshotOptions = {}): Promise<Uint8Array> {
+    const mod = getModule();
+    const config = options.config ?? {};
+    const db = new DuckDB({ ...config, lockConfiguration: false });
+    try {
+      const conn = db.connect();
+      try {
+        const statements =
+          typeof options.setupSql === 'string' ? [options.setupSql] : (options.setupSql ?? []);
+        for (const sql of statements) {
+          await conn.execute(sql);
+        }
+        if (config.lockConfiguration !== false) {
+          await conn.execute('SET lock_configuration = true');
+        }
+      } finally {
+        conn.close();
+      }
+      return captureSnapshot(mod, db.dbPtr);
+    } finally {
+      db.close();
+    }
+  }
+
   connect(): Connection {
     if (this.closed || !module) {
       throw new DuckDBError('Database is closed');
@@ -1660,42 +2935,325 @@ export class DuckDB {
         throw new DuckDBError('Failed to create connection');
       }
 
-      const connPtr = module.getValue(connPtrPtr, '*');
-      return new Connection(connPtr);
-    } finally {
-      module._free(connPtrPtr);
-    }
-  }
+      const connPtr = module.getValue(connPtrPtr, '*');
+      return new Connection(connPtr);
+    } finally {
+      module._free(connPtrPtr);
+    }
+  }
+
+  /**
+   * Register a Blob, R2 object or ReadableStream as a virtual file without copying it.
+   *
+   * The contents are never loaded into WASM memory as a whole: each read DuckDB makes
+   * asks the source for exactly the requested byte range (`Blob.slice`, or a ranged R2
+   * `get`), so memory use follows the columns a query scans rather than the file size.
+   *
+   * A ReadableStream can only be read front to back. DuckDB reads it like a pipe,
+   * which suits CSV and newline-delimited JSON but not Parquet.
+   *
+   * @param name - The virtual file name to use in queries
+   * @param source - The file contents
+   * @param options - Stream size, if known
+   *
+   * @example
+   * ```typescript
+   * await db.registerFileHandle('events.parquet', { bucket: env.DATA, key: 'events.parquet' });
+   * const rows = await conn.query("SELECT count(*) FROM 'events.parquet'");
+   *
+   * const upload = await fetch(url);
+   * await db.registerFileHandle('upload.csv', upload.body!);
+   * ```
+   */
+  async registerFileHandle(
+    name: string,
+    source: FileHandleSource,
+    options: RegisterFileHandleOptions = {},
+  ): Promise<void> {
+    const mod = getModule();
+    let file: JSFile;
+    if (source instanceof Blob) {
+      file = blobFile(source);
+    } else if (source instanceof ReadableStream) {
+      file = streamFile(source, options.size ?? 0);
+    } else {
+      file = await r2File(source);
+    }
+    mod.jsFiles.unregister(name)?.close();
+    mod.jsFiles.register(name, file);
+  }
+
+  /**
+   * Remove a file registered with {@link DuckDB.registerFileHandle}.
+   *
+   * @param name - The virtual file name to remove
+   */
+  dropFile(name: string): void {
+    getModule().jsFiles.unregister(name)?.close();
+  }
+
+  /**
+   * Make every object of an R2 bucket binding readable as `r2-binding://<name>/<key>`.
+   *
+   * Objects are looked up when a query first opens them, and globs list the bucket, so
+   * nothing needs to be registered per file. Reads go through the binding (ranged `get`)
+   * instead of the S3 API, without credentials or public URLs.
+   *
+   * The scheme is not `r2://`, which httpfs uses for R2's S3 API.
+   *
+   * @param name - Name used in paths, usually the binding name
+   * @param bucket - The R2 bucket binding
+   * @param options - How long object metadata is reused
+   *
+   * @example
+   * ```typescript
+   * db.registerR2Bucket('DATA', env.DATA);
+   * const rows = await conn.query(
+   *   "SELECT count(*) FROM read_parquet('r2-binding://DATA/events/*.parquet')",
+   * );
+   * ```
+   */
+  registerR2Bucket(name: string, bucket: R2Bucket, options: RegisterR2BucketOptions = {}): void {
+    const prefix = `r2-binding://${name}/`;
+    const file = (object: R2Object) => ({
+      path: prefix + object.key,
+      file: r2ObjectFile(bucket, object.key, object),
+    });
+    getModule().jsFiles.setResolver(prefix, {
+      ttl: (options.ttl ?? 30) * 1000,
+      open: async (path) => {
+        const key = path.slice(prefix.length);
+        const head = await bucket.head(key);
+        return head ? r2ObjectFile(bucket, key, head) : null;
+      },
+      list: async (listPrefix) => {
+        const files = [];
+        let cursor: string | undefined;
+        do {
+          const listed = await bucket.list({ prefix: listPrefix.slice(prefix.length), cursor });
+          files.push(...listed.objects.map(file));
+          cursor = listed.truncated ? listed.cursor : undefined;
+        } while (cursor);
+        return files;
+      },
+    });
+  }
+
+  /**
+   * Stop serving a bucket registered with {@link DuckDB.registerR2Bucket}.
+   *
+   * @param name - The name the bucket was registered under
+   */
+  dropR2Bucket(name: string): void {
+    getModule().jsFiles.setResolver(`r2-binding://${name}/`, null);
+  }
+
+  close(): void {
+    if (this.closed || !module) return;
+
+    const dbPtrPtr = module._malloc(4);
+    try {
+      module.setValue(dbPtrPtr, this.dbPtr, '*');
+      module.ccall('duckdb_close', null, ['number'], [dbPtrPtr]);
+    } finally {
+      module._free(dbPtrPtr);
+    }
+
+    this.closed = true;
+    this.dbPtr = 0;
+  }
+}
+
+/** duckdb_pending_state values of a query that still has tasks to run */
+const PENDING_RESULT_NOT_READY = 1;
+const PENDING_NO_TASKS_AVAILABLE = 3;
+
+/**
+ * A connection to a DuckDB database (async API for Cloudflare Workers).
+ *
+ * All query methods in this class are async and return Promises.
+ * @category Connection
+ */
+export class Connection {
+  private connPtr: number;
+  private closed: boolean = false;
+  /** Interrupt callbacks of the queries in flight, for cancel() */
+  private running: Set<() => void> = new Set();
+
+  /** @internal */
+  constructor(connPtr: number) {
+    this.connPtr = connPtr;
+  }
+
+  /**
+   * Run a query into resultPtr, returning its duckdb_state.
+   *
+   * An abort of the signal or cancel() interrupts the query through duckdb_interrupt,
+   * which only sets a flag the engine checks while executing, so it is safe to call
+   * while the query is suspended on I/O. With onProgress the query is executed task by
+   * task so the estimate can be read in between.
+   */
+  private async runQuery(sql: string, resultPtr: number, options?: QueryOptions): Promise<number> {
+    const mod = getModule();
+    const signal = options?.signal;
+    if (signal?.aborted) {
+      throw new DuckDBError('Query was cancelled', 'INTERRUPTED', sql);
+    }
+
+    let interrupted = false;
+    const interrupt = () => {
+      if (!interrupted) {
+        interrupted = true;
+        mod.ccall('duckdb_interrupt', null, ['number'], [this.connPtr]);
+      }
+    };
+    this.running.add(interrupt);
+    signal?.addEventListener('abort', interrupt, { once: true });
+    try {
+      const status = options?.onProgress
+        ? await this.runPendingQuery(mod, sql, resultPtr, options.onProgress, () => interrupted)
+        : ((await mod.ccall(
+            'duckdb_query',
+            'number',
+            ['number', 'string', 'number'],
+            [this.connPtr, sql, resultPtr],
+            { async: true },
+          )) as number);
+
+      if (interrupted) {
+        // Also when the query finished before the engine saw the interrupt
+        mod.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
+        throw new DuckDBError('Query was cancelled', 'INTERRUPTED', sql);
+      }
+      return status;
+    } finally {
+      this.running.delete(interrupt);
+      signal?.removeEventListener('abort', interrupt);
+    }
+  }
+
+  /**
+   * Execute a query task by task, reporting progress between tasks.
+   * SQL that cannot be prepared as one statement runs in a single duckdb_query call.
+   */
+  private async runPendingQuery(
+    mod: EmscriptenModule,
+    sql: string,
+    resultPtr: number,
+    onProgress: (progress: QueryProgress) => void,
+    isInterrupted: () => boolean,
+  ): Promise<number> {
+    const ptrPtr = mod._malloc(4);
+    const progressPtr = mod._malloc(24);
+    let stmtPtr = 0;
+    let pendingPtr = 0;
+    try {
+      // Binding can read remote files, so the prepare may suspend in the fetch imports
+      const prepareStatus = (await mod.ccall(
+        'duckdb_prepare',
+        'number',
+        ['number', 'string', 'number'],
+        [this.connPtr, sql, ptrPtr],
+        { async: true },
+      )) as number;
+      stmtPtr = mod.getValue(ptrPtr, 'i32');
+      if (prepareStatus !== 0) {
+        if (stmtPtr) {
+          mod.ccall('duckdb_destroy_prepare', null, ['number'], [ptrPtr]);
+          stmtPtr = 0;
+        }
+        return (await mod.ccall(
+          'duckdb_query',
+          'number',
+          ['number', 'string', 'number'],
+          [this.connPtr, sql, resultPtr],
+          { async: true },
+        )) as number;
+      }
+
+      const status = (await mod.ccall(
+        'duckdb_pending_prepared',
+        'number',
+        ['number', 'number'],
+        [stmtPtr, ptrPtr],
+        { async: true },
+      )) as number;
+      pendingPtr = mod.getValue(ptrPtr, 'i32');
+      if (status !== 0) {
+        const errorPtr = pendingPtr
+          ? (mod.ccall('duckdb_pending_error', 'number', ['number'], [pendingPtr]) as number)
+          : 0;
+        const error = errorPtr ? mod.UTF8ToString(errorPtr) : 'Query failed';
+        throw new DuckDBError(error, undefined, sql);
+      }
+
+      let lastPercentage = Number.NaN;
+      for (;;) {
+        const state = (await mod.ccall(
+          'duckdb_pending_execute_task',
+          'number',
+          ['number'],
+          [pendingPtr],
+          { async: true },
+        )) as number;
+        if (state !== PENDING_RESULT_NOT_READY && state !== PENDING_NO_TASKS_AVAILABLE) {
+          break;
+        }
+        if (isInterrupted()) {
+          continue;
+        }
 
-  close(): void {
-    if (this.closed || !module) return;
+        mod.ccall(
+          'duckdb_wasm_query_progress',
+          null,
+          ['number', 'number', 'number', 'number'],
+          [this.connPtr, progressPtr, progressPtr + 8, progressPtr + 16],
+        );
+        const percentage = mod.getValue(progressPtr, 'double');
+        if (percentage !== lastPercentage) {
+          lastPercentage = percentage;
+          onProgress({
+            percentage,
+            rowsProcessed: mod.getValue(progressPtr + 8, 'double'),
+            totalRows: mod.getValue(progressPtr + 16, 'double'),
+          });
+        }
+      }
 
-    const dbPtrPtr = module._malloc(4);
-    try {
-      module.setValue(dbPtrPtr, this.dbPtr, '*');
-      module.ccall('duckdb_close', null, ['number'], [dbPtrPtr]);
+      // Materializes the result, or reports the error (including an interrupt)
+      return (await mod.ccall(
+        'duckdb_execute_pending',
+        'number',
+        ['number', 'number'],
+        [pendingPtr, resultPtr],
+        { async: true },
+      )) as number;
     } finally {
-      module._free(dbPtrPtr);
+      // Also reached when running the tasks or onProgress throws
+      if (pendingPtr) {
+        mod.setValue(ptrPtr, pendingPtr, 'i32');
+        mod.ccall('duckdb_destroy_pending', null, ['number'], [ptrPtr]);
+      }
+      if (stmtPtr) {
+        mod.setValue(ptrPtr, stmtPtr, 'i32');
+        mod.ccall('duckdb_destroy_prepare', null, ['number'], [ptrPtr]);
+      }
+      mod._free(progressPtr);
+      mod._free(ptrPtr);
     }
-
-    this.closed = true;
-    this.dbPtr = 0;
   }
-}
 
-/**
- * A connection to a DuckDB database (async API for Cloudflare Workers).
- *
- * All query methods in this class are async and return Promises.
- * @category Connection
- */
-export class Connection {
-  private connPtr: number;
-  private closed: boolean = false;
-
-  /** @internal */
-  constructor(connPtr: number) {
-    this.connPtr = connPtr;
+  /**
+   * Interrupts the queries and statements of this connection that are still running.
+   *
+   * Their promises reject with a {@link DuckDBError} with code `INTERRUPTED`. Covers
+   * `query()` and `execute()`; like an aborted signal, the interrupt is seen by the
+   * engine once the query resumes from its current I/O wait.
+   */
+  cancel(): void {
+    for (const interrupt of this.running) {
+      interrupt();
+    }
   }
 
   /**
@@ -1703,22 +3261,54 @@ export class Connection {
    * This is async to support httpfs in Cloudflare Workers.
    *
    * @param sql - The SQL query to execute
-   * @returns Promise resolving to array of result rows as objects
+   * @param options - Optional abort signal, progress callback and profiling
+   * @returns Promise resolving to array of result rows as objects, with a `profile`
+   *   property when `options.profile` is set
+   *
+   * @example
+   * ```typescript
+   * // Stop a remote scan that takes longer than 2 seconds
+   * const rows = await conn.query("SELECT count(*) FROM 'https://example.com/big.parquet'", {
+   *   signal: AbortSignal.timeout(2000),
+   * });
+   *
+   * // See how much of a query is spent waiting on fetch()
+   * const result = await conn.query("SELECT count(*) FROM 'https://example.com/big.parquet'", {
+   *   profile: true,
+   * });
+   * console.log(result.profile.httpTimeMs, result.profile.http.urls);
+   * ```
    */
-  async query<T = Record<string, unknown>>(sql: string): Promise<T[]> {
+  query<T = Record<string, unknown>>(
+    sql: string,
+    options: QueryRowsOptions & { profile: true },
+  ): Promise<ProfiledRows<T>>;
+  query<T = Record<string, unknown>>(sql: string, options?: QueryRowsOptions): Promise<T[]>;
+  async query<T = Record<string, unknown>>(sql: string, options?: QueryRowsOptions): Promise<T[]> {
     if (this.closed || !module) {
       throw new DuckDBError('Connection is closed');
     }
 
     const resultPtr = module._malloc(64);
     try {
-      const status = (await module.ccall(
-        'duckdb_query',
-        'number',
-        ['number', 'string', 'number'],
-        [this.connPtr, sql, resultPtr],
-        { async: true },
-      )) as number;
+      const start = performance.now();
+      const previous = options?.profile
+        ? (module.ccall(
+            'duckdb_wasm_profile_begin',
+            'number',
+            ['number'],
+            [this.connPtr],
+          ) as number)
+        : 0;
+      let status: number;
+      let profile: QueryProfile | undefined;
+      try {
+        status = await this.runQuery(sql, resultPtr, options);
+      } finally {
+        if (options?.profile) {
+          profile = this.endProfile(module, previous, performance.now() - start);
+        }
+      }
 
       if (status !== 0) {
         const errorPtr = module.ccall(
@@ -1831,12 +3421,39 @@ export class Connection {
 
       module.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
 
+      if (profile) {
+        return Object.assign(rows, { profile });
+      }
       return rows;
     } finally {
       module._free(resultPtr);
     }
   }
 
+  /**
+   * Stop profiling the connection and collect the profile of its last query.
+   */
+  private endProfile(mod: EmscriptenModule, previous: number, totalTimeMs: number): QueryProfile {
+    const jsonPtr = mod.ccall(
+      'duckdb_wasm_profile_end',
+      'number',
+      ['number', 'number'],
+      [this.connPtr, previous],
+    ) as number;
+    if (!jsonPtr) {
+      throw new DuckDBError('Failed to collect the query profile');
+    }
+    const json = mod.UTF8ToString(jsonPtr);
+    mod._free(jsonPtr);
+
+    const { execution, http } = JSON.parse(json) as {
+      execution: Record<string, unknown> | null;
+      http: HTTPProfile;
+    };
+    const httpTimeMs = http.urls.reduce((sum, url) => sum + url.totalLatencyMs, 0);
+    return { totalTimeMs, httpTimeMs, execution, http };
+  }
+
   private readColumnData(
     dataPtr: number,
     nullmaskPtr: number,
@@ -2054,184 +3671,111 @@ export class Connection {
       throw new DuckDBError('Connection is closed');
     }
 
-    const resultPtr = module._malloc(64);
+    // Out-params: uint8_t** buffer, size_t* length, char** error
+    const outPtr = module._malloc(12);
     try {
+      module.setValue(outPtr, 0, 'i32');
+      module.setValue(outPtr + 4, 0, 'i32');
+      module.setValue(outPtr + 8, 0, 'i32');
+
+      // DuckDB converts each chunk to Arrow, nanoarrow serializes the IPC stream
       const status = (await module.ccall(
-        'duckdb_query',
+        'duckdb_wasm_query_arrow_ipc',
         'number',
-        ['number', 'string', 'number'],
-        [this.connPtr, sql, resultPtr],
+        ['number', 'string', 'number', 'number', 'number'],
+        [this.connPtr, sql, outPtr, outPtr + 4, outPtr + 8],
         { async: true },
       )) as number;
 
       if (status !== 0) {
-        const errorPtr = module.ccall(
-          'duckdb_result_error',
-          'number',
-          ['number'],
-          [resultPtr],
-        ) as number;
+        const errorPtr = module.getValue(outPtr + 8, 'i32');
         const error = errorPtr ? module.UTF8ToString(errorPtr) : 'Query failed';
-        module.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
-        throw new DuckDBError(error, undefined, sql);
-      }
-
-      const columnCount = module.ccall(
-        'duckdb_column_count',
-        'number',
-        ['number'],
-        [resultPtr],
-      ) as number;
-
-      const rowCount = module.ccall(
-        'duckdb_row_count',
-        'number',
-        ['number'],
-        [resultPtr],
-      ) as number;
-
-      const columns: { name: string; type: number; flechetteType: DataType }[] = [];
-      for (let i = 0; i < columnCount; i++) {
-        const namePtr = module.ccall(
-          'duckdb_column_name',
-          'number',
-          ['number', 'number'],
-          [resultPtr, i],
-        ) as number;
-
-        const type = module.ccall(
-          'duckdb_column_type',
-          'number',
-          ['number', 'number'],
-          [resultPtr, i],
-        ) as number;
-
-        columns.push({
-          name: module.UTF8ToString(namePtr),
-          type,
-          flechetteType: this.getFlechetteType(type) || utf8(),
-        });
-      }
-
-      const tableData: Record<string, unknown[]> = {};
-      const types: Record<string, DataType> = {};
-
-      for (let colIdx = 0; colIdx < columnCount; colIdx++) {
-        const col = columns[colIdx];
-
-        const dataPtr = module.ccall(
-          'duckdb_column_data',
-          'number',
-          ['number', 'number'],
-          [resultPtr, colIdx],
-        ) as number;
-
-        const nullmaskPtr = module.ccall(
-          'duckdb_nullmask_data',
-          'number',
-          ['number', 'number'],
-          [resultPtr, colIdx],
-        ) as number;
-
-        if (col.type === DuckDBType.VARCHAR || dataPtr === 0) {
-          const values: unknown[] = new Array(rowCount);
-          for (let rowIdx = 0; rowIdx < rowCount; rowIdx++) {
-            const isNull = module.ccall(
-              'duckdb_value_is_null',
-              'number',
-              ['number', 'number', 'number', 'number', 'number'],
-              [resultPtr, colIdx, 0, rowIdx, 0],
-            ) as number;
-
-            if (isNull) {
-              values[rowIdx] = null;
-            } else {
-              const strPtr = module.ccall(
-                'duckdb_value_varchar',
-                'number',
-                ['number', 'number', 'number', 'number', 'number'],
-                [resultPtr, colIdx, 0, rowIdx, 0],
-              ) as number;
-              if (strPtr) {
-                values[rowIdx] = module.UTF8ToString(strPtr);
-                module._free(strPtr);
-              } else {
-                values[rowIdx] = null;
-              }
-            }
-          }
-          tableData[col.name] = values;
-        } else {
-          tableData[col.name] = this.readColumnData(dataPtr, nullmaskPtr, rowCount, col.type);
+        if (errorPtr) {
+          module._free(errorPtr);
         }
-
-        types[col.name] = col.flechetteType;
+        throw new DuckDBError(error, undefined, sql);
       }
 
-      module.ccall('duckdb_destroy_result', null, ['number'], [resultPtr]);
+      const bufPtr = module.getValue(outPtr, 'i32');
+      const bufLen = module.getValue(outPtr + 4, 'i32');
+      // Copy out of the WASM heap, which may grow (and detach views) later
+      const ipcBuffer = module.HEAPU8.slice(bufPtr, bufPtr + bufLen);
+      module._free(bufPtr);
 
-      return tableFromArrays(tableData, { types });
+      return tableFromIPC(ipcBuffer);
     } finally {
-      module._free(resultPtr);
+      module._free(outPtr);
     }
   }
 
-  private getFlechetteType(duckdbType: number): DataType | null {
-    switch (duckdbType) {
-      case DuckDBType.BOOLEAN:
-        return bool();
-      case DuckDBType.TINYINT:
-        return int8();
-      case DuckDBType.SMALLINT:
-        return int16();
-      case DuckDBType.INTEGER:
-        return int32();
-      case DuckDBType.BIGINT:
-        return int64();
-      case DuckDBType.UTINYINT:
-        return uint8();
-      case DuckDBType.USMALLINT:
-        return uint16();
-      case DuckDBType.UINTEGER:
-        return uint32();
-      case DuckDBType.UBIGINT:
-        return uint64();
-      case DuckDBType.FLOAT:
-        return float32();
-      case DuckDBType.DOUBLE:
-        return float64();
-      case DuckDBType.VARCHAR:
-        return utf8();
-      case DuckDBType.DATE:
-        return dateDay();
-      case DuckDBType.TIMESTAMP:
-      case DuckDBType.TIMESTAMP_TZ:
-        return timestamp(TimeUnit.MICROSECOND);
-      default:
-        return utf8();
+  /**
+   * Executes a SQL query and reads its result as an Arrow IPC stream.
+   *
+   * Unlike `queryArrow()`, the result is not built up first: the query runs with a
+   * streaming result and each part's record batches are encoded when it is read, so the
+   * first bytes can be sent before the query has finished and memory stays bounded by
+   * the part size. Read the stream to the end or close it before running other
+   * statements on the connection; they end its streaming result.
+   *
+   * @param sql - The SQL query to execute
+   * @param options - Rows per part of the stream
+   * @returns Promise resolving to an ArrowIPCStream of IPC bytes
+   *
+   * @example
+   * ```typescript
+   * const stream = await conn.queryArrowStream('SELECT * FROM events');
+   * return new Response(stream.toReadableStream(), {
+   *   headers: { 'Content-Type': 'application/vnd.apache.arrow.stream' },
+   * });
+   * ```
+   */
+  async queryArrowStream(sql: string, options?: ArrowStreamOptions): Promise<ArrowIPCStream> {
+    if (this.closed || !module) {
+      throw new DuckDBError('Connection is closed');
+    }
+
+    // The query runs with a streaming result; batches are encoded as they are read
+    const streamPtr = (await module.ccall(
+      'duckdb_wasm_arrow_ipc_stream_open',
+      'number',
+      ['number', 'string'],
+      [this.connPtr, sql],
+      { async: true },
+    )) as number;
+    if (!streamPtr) {
+      throw new DuckDBError('Failed to open Arrow IPC stream', undefined, sql);
+    }
+
+    const errorPtr = module.ccall(
+      'duckdb_wasm_arrow_ipc_stream_error',
+      'number',
+      ['number'],
+      [streamPtr],
+    ) as number;
+    if (errorPtr) {
+      const error = module.UTF8ToString(errorPtr);
+      module.ccall('duckdb_wasm_arrow_ipc_stream_destroy', null, ['number'], [streamPtr]);
+      throw new DuckDBError(error, undefined, sql);
     }
+
+    return new ArrowIPCStream(streamPtr, options?.batchRows ?? 0, sql);
   }
 
   /**
    * Executes a SQL statement without returning results.
    *
    * @param sql - The SQL statement to execute
+   * @param options - Optional abort signal and progress callback
    * @returns Promise resolving to number of rows affected
    */
-  async execute(sql: string): Promise<number> {
+  async execute(sql: string, options?: QueryOptions): Promise<number> {
     if (this.closed || !module) {
       throw new DuckDBError('Connection is closed');
     }
 
     const resultPtr = module._malloc(64);
     try {
-      const status = (await module.ccall(
-        'duckdb_query',
-        'number',
-        ['number', 'string', 'number'],
-        [this.connPtr, sql, resultPtr],
-        { async: true },
-      )) as number;
+      const status = await this.runQuery(sql, resultPtr, options);
 
       if (status !== 0) {
         const errorPtr = module.ccall(
@@ -2273,8 +3817,9 @@ export class Connection {
 
     const stmtPtrPtr = module._malloc(4);
     try {
+      // duckdb_prepare returns a promise in JSPI builds; this entry point never does
       const result = module.ccall(
-        'duckdb_prepare',
+        'duckdb_wasm_prepare_sync',
         'number',
         ['number', 'string', 'number'],
         [this.connPtr, sql, stmtPtrPtr],
@@ -2332,6 +3877,7 @@ export class Connection {
    *
    * Creates a new table with the given name from the Arrow IPC data. If the table
    * already exists, the call is a no-op (uses `CREATE TABLE IF NOT EXISTS`).
+   * Pass `{ append: true }` to insert the rows into an existing table instead.
    *
    * **Important:** The IPC stream must not contain dictionary-encoded columns.
    * Flechette's `tableFromArrays()` defaults to `dictionary(utf8())` for string
@@ -2339,6 +3885,7 @@ export class Connection {
    *
    * @param tableName - The name of the table to create
    * @param ipcBuffer - Arrow IPC stream bytes (use `tableToIPC(table, { format: 'stream' })`)
+   * @param options - Optional insertion options
    * @throws {@link DuckDBError} If the connection is closed or the IPC data is invalid
    *
    * @example
@@ -2351,33 +3898,91 @@ export class Connection {
    * );
    * const ipcBuffer = tableToIPC(table, { format: 'stream' });
    * await conn.insertArrowFromIPCStream('users', ipcBuffer);
+   *
+   * // Add more rows later
+   * await conn.insertArrowFromIPCStream('users', moreIpcBuffer, { append: true });
    * ```
    *
    * @category Data Insertion
    */
-  async insertArrowFromIPCStream(tableName: string, ipcBuffer: Uint8Array): Promise<void> {
+  async insertArrowFromIPCStream(
+    tableName: string,
+    ipcBuffer: Uint8Array,
+    options?: ArrowIPCInsertOptions,
+  ): Promise<void> {
     if (this.closed || !module) {
       throw new DuckDBError('Connection is closed');
     }
 
     const bufPtr = module._malloc(ipcBuffer.length);
     module.HEAPU8.set(ipcBuffer, bufPtr);
+    const outErrorPtr = module._malloc(4);
+    module.setValue(outErrorPtr, 0, '*');
 
     try {
       const result = (await module.ccall(
-        'duckdb_wasm_insert_arrow_ipc',
+        options?.append ? 'duckdb_wasm_append_arrow_ipc' : 'duckdb_wasm_insert_arrow_ipc',
         'number',
-        ['number', 'string', 'number', 'number'],
-        [this.connPtr, tableName, bufPtr, ipcBuffer.length],
+        ['number', 'string', 'number', 'number', 'number'],
+        [this.connPtr, tableName, bufPtr, ipcBuffer.length, outErrorPtr],
         { async: true },
       )) as number;
 
       if (result !== 0) {
-        throw new DuckDBError(`Failed to insert Arrow IPC data into "${tableName}"`);
+        const errorPtr = module.getValue(outErrorPtr, '*');
+        const error = errorPtr ? module.UTF8ToString(errorPtr) : 'Arrow IPC insert failed';
+        if (errorPtr) {
+          module._free(errorPtr);
+        }
+        throw new DuckDBError(`Failed to insert Arrow IPC data into "${tableName}": ${error}`);
       }
     } finally {
       module._free(bufPtr);
+      module._free(outErrorPtr);
+    }
+  }
+
+  /**
+   * Start an incremental Arrow IPC ingest into a table.
+   *
+   * Unlike {@link Connection.insertArrowFromIPCStream}, the IPC stream does not
+   * have to be held in one buffer: push it in pieces and each record batch is
+   * written as soon as it is complete. Without `append`, the table is created
+   * from the stream schema and must not exist yet.
+   *
+   * @param tableName - The name of the table to write to
+   * @param options - Optional insertion options
+   * @returns An ArrowIPCIngest to push bytes into
+   * @throws {@link DuckDBError} If the connection is closed
+   *
+   * @example
+   * ```typescript
+   * const ingest = conn.openArrowIPCIngest('events', { append: true });
+   * for (const part of parts) {
+   *   await ingest.push(part);
+   * }
+   * await ingest.finish();
+   * ```
+   *
+   * @category Data Insertion
+   */
+  openArrowIPCIngest(tableName: string, options?: ArrowIPCInsertOptions): ArrowIPCIngest {
+    if (this.closed || !module) {
+      throw new DuckDBError('Connection is closed');
+    }
+
+    const ingestPtr = module.ccall(
+      'duckdb_wasm_arrow_ipc_ingest_open',
+      'number',
+      ['number', 'string', 'number'],
+      [this.connPtr, tableName, options?.append ? 1 : 0],
+    ) as number;
+
+    if (!ingestPtr) {
+      throw new DuckDBError(`Failed to start Arrow IPC ingest into "${tableName}"`);
     }
+
+    return new ArrowIPCIngest(ingestPtr);
   }
 
   close(): void {
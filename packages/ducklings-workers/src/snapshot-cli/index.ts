@@ -0,0 +1,85 @@
+/**
+ * Build-time snapshot CLI for @ducklings/workers
+ *
+ * Opens a database with the bundled WASM build, runs setup SQL and writes the memory
+ * snapshot that `init({ wasmModule, snapshot })` restores, so Workers skip the database
+ * setup on a cold start.
+ *
+ * @example
+ * ```sh
+ * ducklings-snapshot --sql schema.sql --set memory_limit=96MB duckdb.snapshot
+ * ```
+ *
+ * @packageDocumentation
+ */
+
+import { readFile, writeFile } from 'node:fs/promises';
+import { dirname, resolve } from 'node:path';
+import { fileURLToPath } from 'node:url';
+import { parseArgs } from 'node:util';
+import { DuckDB, init } from '../index.js';
+
+const USAGE = `Usage: ducklings-snapshot [options] <output>
+
+Options:
+  --sql <file>         Setup SQL file to run before the snapshot (repeatable)
+  --set <key=value>    DuckDB setting for the database (repeatable)
+  --jspi               Snapshot the JSPI build instead of the Asyncify build
+  --wasm <file>        WASM build to snapshot (overrides --jspi)
+  -h, --help           Show this help`;
+
+async function main(): Promise<void> {
+  const { values, positionals } = parseArgs({
+    options: {
+      sql: { type: 'string', multiple: true },
+      set: { type: 'string', multiple: true },
+      jspi: { type: 'boolean' },
+      wasm: { type: 'string' },
+      help: { type: 'boolean', short: 'h' },
+    },
+    allowPositionals: true,
+  });
+
+  if (values.help || positionals.length !== 1) {
+    console.log(USAGE);
+    process.exit(values.help ? 0 : 1);
+  }
+
+  const customConfig: Record<string, string> = {};
+  for (const setting of values.set ?? []) {
+    const separator = setting.indexOf('=');
+    if (separator <= 0) {
+      throw new Error(`Invalid setting "${setting}", expected key=value`);
+    }
+    customConfig[setting.slice(0, separator)] = setting.slice(separator + 1);
+  }
+
+  // The snapshot must come from the build the Worker deploys
+  const wasmPath =
+    values.wasm ??
+    resolve(
+      dirname(fileURLToPath(import.meta.url)),
+      'wasm',
+      values.jspi ? 'duckdb-workers-jspi.wasm' : 'duckdb-workers.wasm',
+    );
+  const wasmModule = await WebAssembly.compile(await readFile(wasmPath));
+  await init({ wasmModule });
+
+  const setupSql: string[] = [];
+  for (const file of values.sql ?? []) {
+    setupSql.push(await readFile(file, 'utf8'));
+  }
+
+  const snapshot = await DuckDB.createSnapshot({ config: { customConfig }, setupSql });
+  await writeFile(positionals[0], snapshot);
+  console.log(
+    `[ducklings] Snapshot of ${wasmPath} written to ${positionals[0]} ` +
+      `(${(snapshot.byteLength / 1048576).toFixed(1)} MB)`,
+  );
+}
+
+main().catch((error) => {
+  const message = error instanceof Error ? error.message : String(error);
+  console.error('[ducklings] Failed to create snapshot:', message);
+  process.exit(1);
+});
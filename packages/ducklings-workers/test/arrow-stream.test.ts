@@ -0,0 +1,74 @@
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import { tableFromIPC } from '@uwdata/flechette';
+import { DuckDB } from './testDb';
+
+function concat(parts: Uint8Array[]): Uint8Array {
+  const bytes = new Uint8Array(parts.reduce((total, part) => total + part.length, 0));
+  let offset = 0;
+  for (const part of parts) {
+    bytes.set(part, offset);
+    offset += part.length;
+  }
+  return bytes;
+}
+
+describe('Arrow IPC streams (Async)', () => {
+  let db: DuckDB;
+  let conn: ReturnType<DuckDB['connect']>;
+
+  beforeAll(() => {
+    db = new DuckDB();
+    conn = db.connect();
+  });
+
+  afterAll(() => {
+    conn.close();
+    db.close();
+  });
+
+  it('should stream one part per chunk that together form an IPC stream', async () => {
+    const stream = await conn.queryArrowStream('SELECT i, i * 2 AS doubled FROM range(10000) t(i)');
+    const parts: Uint8Array[] = [];
+    for await (const bytes of stream) {
+      parts.push(bytes);
+    }
+    expect(parts.length).toBeGreaterThan(1);
+    expect(stream.isClosed()).toBe(true);
+
+    const table = tableFromIPC(concat(parts));
+    expect(table.numRows).toBe(10000);
+    expect(Number(table.getChild('doubled')?.at(9999))).toBe(19998);
+  });
+
+  it('should group chunks by batchRows', async () => {
+    const stream = await conn.queryArrowStream('SELECT i FROM range(10000) t(i)', {
+      batchRows: 100000,
+    });
+    const parts: Uint8Array[] = [];
+    for await (const bytes of stream) {
+      parts.push(bytes);
+    }
+    expect(parts).toHaveLength(1);
+    expect(tableFromIPC(parts[0]).numRows).toBe(10000);
+  });
+
+  it('should serve a Response body', async () => {
+    const stream = await conn.queryArrowStream('SELECT 42 AS answer');
+    const response = new Response(stream.toReadableStream());
+    const bytes = new Uint8Array(await response.arrayBuffer());
+    expect(tableFromIPC(bytes).getChild('answer')?.at(0)).toBe(42);
+    expect(stream.isClosed()).toBe(true);
+  });
+
+  it('should release the result when closed early', async () => {
+    const stream = await conn.queryArrowStream('SELECT i FROM range(100000) t(i)');
+    expect(await stream.next()).not.toBeNull();
+    stream.close();
+    await expect(stream.next()).rejects.toThrow('Arrow IPC stream is closed');
+    expect(await conn.query('SELECT 1 AS one')).toEqual([{ one: 1 }]);
+  });
+
+  it('should reject invalid queries', async () => {
+    await expect(conn.queryArrowStream('SELECT * FROM missing_table')).rejects.toThrow();
+  });
+});
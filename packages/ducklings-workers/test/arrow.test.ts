@@ -257,6 +257,119 @@ describe('Arrow IPC (Async)', () => {
 
       await conn.execute('DROP TABLE arrow_nooverwrite_test');
     });
+
+    it('should append to an existing table with append: true', async () => {
+      const ipc1 = tableToIPC(tableFromArrays({ id: [1, 2] }), { format: 'stream' });
+      await conn.insertArrowFromIPCStream('arrow_append_test', ipc1);
+
+      const ipc2 = tableToIPC(tableFromArrays({ id: [3, 4] }), { format: 'stream' });
+      await conn.insertArrowFromIPCStream('arrow_append_test', ipc2, { append: true });
+
+      const rows = await conn.query<{ id: number }>(
+        'SELECT * FROM arrow_append_test ORDER BY id',
+      );
+      expect(rows.map((r) => r.id)).toEqual([1, 2, 3, 4]);
+
+      await conn.execute('DROP TABLE arrow_append_test');
+    });
+
+    it("should report DuckDB's error when the insert fails", async () => {
+      const ipc = tableToIPC(tableFromArrays({ id: [1] }), { format: 'stream' });
+      await expect(
+        conn.insertArrowFromIPCStream('arrow_missing_table', ipc, { append: true }),
+      ).rejects.toThrow('arrow_missing_table does not exist');
+    });
+  });
+
+  describe('openArrowIPCIngest()', () => {
+    it('should ingest a stream pushed in small pieces', async () => {
+      const table = tableFromArrays({
+        id: [1, 2, 3],
+        value: ['a', 'b', 'c'],
+      }, { types: { value: utf8() } });
+      const ipcBytes: Uint8Array = tableToIPC(table, { format: 'stream' });
+
+      const ingest = conn.openArrowIPCIngest('arrow_ingest_test');
+      for (let offset = 0; offset < ipcBytes.length; offset += 7) {
+        await ingest.push(ipcBytes.subarray(offset, offset + 7));
+      }
+      await ingest.finish();
+
+      const rows = await conn.query<{ id: number; value: string }>(
+        'SELECT * FROM arrow_ingest_test ORDER BY id',
+      );
+      expect(rows).toEqual([
+        { id: 1, value: 'a' },
+        { id: 2, value: 'b' },
+        { id: 3, value: 'c' },
+      ]);
+
+      await conn.execute('DROP TABLE arrow_ingest_test');
+    });
+
+    it('should append several streams to an existing table', async () => {
+      await conn.execute('CREATE TABLE arrow_ingest_append_test (id INTEGER)');
+
+      // Each stream goes through its own ingest, pushed in two parts
+      for (const ids of [[1, 2], [3, 4, 5]]) {
+        const ipc: Uint8Array = tableToIPC(
+          tableFromArrays({ id: ids }, { types: { id: int32() } }),
+          { format: 'stream' },
+        );
+        const ingest = conn.openArrowIPCIngest('arrow_ingest_append_test', { append: true });
+        const half = Math.floor(ipc.length / 2);
+        await ingest.push(ipc.subarray(0, half));
+        await ingest.push(ipc.subarray(half));
+        await ingest.finish();
+      }
+
+      const rows = await conn.query<{ cnt: number; total: number }>(
+        'SELECT COUNT(*) AS cnt, SUM(id)::INTEGER AS total FROM arrow_ingest_append_test',
+      );
+      expect(rows[0].cnt).toBe(5);
+      expect(rows[0].total).toBe(15);
+
+      await conn.execute('DROP TABLE arrow_ingest_append_test');
+    });
+
+    it('should interleave ingests on two connections', async () => {
+      const conn2 = db.connect();
+      try {
+        const ipcA: Uint8Array = tableToIPC(tableFromArrays({ a: [1, 2, 3] }), { format: 'stream' });
+        const ipcB: Uint8Array = tableToIPC(tableFromArrays({ b: [4, 5] }), { format: 'stream' });
+
+        const ingestA = conn.openArrowIPCIngest('arrow_ingest_a');
+        const ingestB = conn2.openArrowIPCIngest('arrow_ingest_b');
+        const half = Math.floor(Math.min(ipcA.length, ipcB.length) / 2);
+        await ingestA.push(ipcA.subarray(0, half));
+        await ingestB.push(ipcB.subarray(0, half));
+        await ingestA.push(ipcA.subarray(half));
+        await ingestB.push(ipcB.subarray(half));
+        await ingestA.finish();
+        await ingestB.finish();
+
+        const rowsA = await conn.query<{ a: number }>('SELECT * FROM arrow_ingest_a ORDER BY a');
+        const rowsB = await conn.query<{ b: number }>('SELECT * FROM arrow_ingest_b ORDER BY b');
+        expect(rowsA.map((r) => r.a)).toEqual([1, 2, 3]);
+        expect(rowsB.map((r) => r.b)).toEqual([4, 5]);
+      } finally {
+        conn2.close();
+        await conn.execute('DROP TABLE IF EXISTS arrow_ingest_a');
+        await conn.execute('DROP TABLE IF EXISTS arrow_ingest_b');
+      }
+    });
+
+    it('should fail to finish a truncated stream', async () => {
+      const ipcBytes: Uint8Array = tableToIPC(tableFromArrays({ id: [1, 2, 3] }), {
+        format: 'stream',
+      });
+
+      const ingest = conn.openArrowIPCIngest('arrow_ingest_truncated_test');
+      await ingest.push(ipcBytes.subarray(0, ipcBytes.length - 12));
+      await expect(ingest.finish()).rejects.toThrow();
+
+      await conn.execute('DROP TABLE IF EXISTS arrow_ingest_truncated_test');
+    });
   });
 
   describe('queryArrow() + insertArrowFromIPCStream() round-trip', () => {
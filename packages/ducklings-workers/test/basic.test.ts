@@ -1,5 +1,5 @@
 import { describe, it, expect, beforeAll, afterAll } from 'vitest';
-import { DuckDB, version, DuckDBError } from './testDb';
+import { DuckDB, version, DuckDBError, isJspiSupported } from './testDb';
 type DuckDBErrorInstance = InstanceType<typeof DuckDBError>;
 
 describe('DuckDB Basic Operations (Async)', () => {
@@ -11,6 +11,15 @@ describe('DuckDB Basic Operations (Async)', () => {
     });
   });
 
+  describe('isJspiSupported()', () => {
+    it('should report WebAssembly.Suspending support', () => {
+      const wasm = WebAssembly as unknown as Record<string, unknown>;
+      expect(isJspiSupported()).toBe(
+        typeof wasm.Suspending === 'function' && typeof wasm.promising === 'function',
+      );
+    });
+  });
+
   describe('DuckDB class', () => {
     it('should create and close a database', () => {
       const db = new DuckDB();
@@ -142,6 +151,18 @@ describe('DuckDB Basic Operations (Async)', () => {
       expect(schema.fields[1].name).toBe('name');
     });
 
+    it('should preserve nulls across multiple chunks', async () => {
+      const table = await conn.queryArrow(
+        'SELECT CASE WHEN i % 1000 = 0 THEN NULL ELSE i END AS v FROM range(5000) t(i)',
+      );
+      expect(table.numRows).toBe(5000);
+      const values = table.getChild('v')!.toArray();
+      expect(values[0]).toBeNull();
+      expect(values[1]).toBe(1);
+      expect(values[4000]).toBeNull();
+      expect(values[4999]).toBe(4999);
+    });
+
     afterAll(() => {
       conn.close();
       db.close();
@@ -0,0 +1,66 @@
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import { DuckDB, DuckDBError, type QueryProgress } from './testDb';
+
+describe('Cancellation and progress (Async)', () => {
+  let db: DuckDB;
+  let conn: ReturnType<DuckDB['connect']>;
+
+  beforeAll(() => {
+    db = new DuckDB();
+    conn = db.connect();
+  });
+
+  afterAll(() => {
+    conn.close();
+    db.close();
+  });
+
+  describe('signal', () => {
+    it('should reject when already aborted', async () => {
+      const controller = new AbortController();
+      controller.abort();
+      const pending = conn.query('SELECT 1', { signal: controller.signal });
+      await expect(pending).rejects.toBeInstanceOf(DuckDBError);
+      await expect(pending).rejects.toMatchObject({ code: 'INTERRUPTED' });
+    });
+
+    it('should interrupt a query aborted while it runs', async () => {
+      const controller = new AbortController();
+      const pending = conn.query('SELECT count(*) AS n FROM range(100000000)', {
+        signal: controller.signal,
+        // Progress callbacks run between tasks, while the query is still executing
+        onProgress: () => controller.abort(),
+      });
+      await expect(pending).rejects.toMatchObject({ code: 'INTERRUPTED' });
+
+      // The connection stays usable
+      const rows = await conn.query('SELECT 1 AS one');
+      expect(rows).toEqual([{ one: 1 }]);
+    });
+
+    it('should not affect queries that finished', async () => {
+      const controller = new AbortController();
+      const changed = await conn.execute('SELECT 1', { signal: controller.signal });
+      controller.abort();
+      expect(changed).toBe(0);
+    });
+  });
+
+  describe('onProgress', () => {
+    it('should report progress while the query runs', async () => {
+      const updates: QueryProgress[] = [];
+      const rows = await conn.query('SELECT count(*)::INTEGER AS n FROM range(100000000)', {
+        onProgress: (progress) => updates.push(progress),
+      });
+
+      expect(rows).toEqual([{ n: 100000000 }]);
+      expect(updates.length).toBeGreaterThan(0);
+      expect(updates.every((update) => typeof update.percentage === 'number')).toBe(true);
+    });
+
+    it('should run statements that cannot be prepared', async () => {
+      const rows = await conn.query('SELECT 1 AS a; SELECT 2 AS b', { onProgress: () => {} });
+      expect(rows).toEqual([{ b: 2 }]);
+    });
+  });
+});
@@ -0,0 +1,117 @@
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import { DuckDB } from './testDb';
+import type { Connection } from './testDb';
+
+const csv = 'id,name\n1,Alice\n2,Bob\n3,Carol\n';
+
+describe('File Handles (Async)', () => {
+  let db: DuckDB;
+  let conn: Connection;
+
+  beforeAll(() => {
+    db = new DuckDB();
+    conn = db.connect();
+  });
+
+  afterAll(() => {
+    conn.close();
+    db.close();
+  });
+
+  it('should read a registered Blob', async () => {
+    await db.registerFileHandle('blob.csv', new Blob([csv]));
+    const rows = await conn.query("SELECT count(*)::INTEGER AS n FROM read_csv('blob.csv')");
+    expect(rows).toEqual([{ n: 3 }]);
+    db.dropFile('blob.csv');
+  });
+
+  it('should read an R2 object with ranged gets', async () => {
+    const bytes = new TextEncoder().encode(csv);
+    const ranges: { offset: number; length: number }[] = [];
+    const bucket = {
+      head: async (key: string) => (key === 'data.csv' ? { size: bytes.length, etag: 'v1' } : null),
+      get: async (_key: string, options: { range: { offset: number; length: number } }) => {
+        ranges.push(options.range);
+        const { offset, length } = options.range;
+        return {
+          arrayBuffer: async () => bytes.slice(offset, offset + length).buffer,
+        };
+      },
+    };
+
+    await db.registerFileHandle('r2.csv', { bucket: bucket as never, key: 'data.csv' });
+    const rows = await conn.query("SELECT name FROM read_csv('r2.csv') WHERE id = 2");
+    expect(rows).toEqual([{ name: 'Bob' }]);
+    expect(ranges.length).toBeGreaterThan(0);
+    expect(ranges.every((range) => range.offset + range.length <= bytes.length)).toBe(true);
+    db.dropFile('r2.csv');
+  });
+
+  it('should reject a missing R2 object', async () => {
+    const bucket = { head: async () => null, get: async () => null };
+    await expect(
+      db.registerFileHandle('missing.csv', { bucket: bucket as never, key: 'missing.csv' }),
+    ).rejects.toThrow('R2 object not found');
+  });
+
+  it('should read a ReadableStream front to back', async () => {
+    const encoded = new TextEncoder().encode(csv);
+    const stream = new ReadableStream<Uint8Array>({
+      start(controller) {
+        // Deliver in small pieces to exercise chunk boundaries
+        for (let i = 0; i < encoded.length; i += 5) {
+          controller.enqueue(encoded.slice(i, i + 5));
+        }
+        controller.close();
+      },
+    });
+
+    await db.registerFileHandle('stream.csv', stream, { size: encoded.length });
+    const rows = await conn.query("SELECT sum(id)::INTEGER AS total FROM read_csv('stream.csv')");
+    expect(rows).toEqual([{ total: 6 }]);
+    db.dropFile('stream.csv');
+  });
+
+  it('should read and glob objects of a bound R2 bucket', async () => {
+    const objects = new Map([
+      ['events/a.csv', new TextEncoder().encode(csv)],
+      ['events/b.csv', new TextEncoder().encode('id,name\n4,Dave\n')],
+      ['other/c.csv', new TextEncoder().encode(csv)],
+    ]);
+    const meta = (key: string) => ({ key, size: objects.get(key)!.length, etag: `${key}-v1` });
+    const bucket = {
+      head: async (key: string) => (objects.has(key) ? meta(key) : null),
+      list: async ({ prefix }: { prefix: string }) => ({
+        objects: [...objects.keys()].filter((key) => key.startsWith(prefix)).map(meta),
+        truncated: false,
+      }),
+      get: async (key: string, options: { range: { offset: number; length: number } }) => {
+        const { offset, length } = options.range;
+        return {
+          arrayBuffer: async () => objects.get(key)!.slice(offset, offset + length).buffer,
+        };
+      },
+    };
+
+    db.registerR2Bucket('DATA', bucket as never);
+    const one = await conn.query(
+      "SELECT count(*)::INTEGER AS n FROM read_csv('r2-binding://DATA/events/a.csv')",
+    );
+    expect(one).toEqual([{ n: 3 }]);
+    const all = await conn.query(
+      "SELECT sum(id)::INTEGER AS total FROM read_csv('r2-binding://DATA/events/*.csv')",
+    );
+    expect(all).toEqual([{ total: 10 }]);
+
+    db.dropR2Bucket('DATA');
+    await expect(
+      conn.query("SELECT * FROM read_csv('r2-binding://DATA/events/a.csv')"),
+    ).rejects.toThrow();
+  });
+
+  it('should fail queries on a dropped file', async () => {
+    await db.registerFileHandle('dropped.csv', new Blob([csv]));
+    db.dropFile('dropped.csv');
+    await expect(conn.query("SELECT * FROM read_csv('dropped.csv')")).rejects.toThrow();
+  });
+});
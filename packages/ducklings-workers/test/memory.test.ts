@@ -0,0 +1,22 @@
+import { describe, it, expect } from 'vitest';
+import { DuckDB } from './testDb';
+
+describe('Memory limit (Async)', () => {
+  it('should default memory_limit to 75% of the memory ceiling', async () => {
+    const db = new DuckDB();
+    const conn = db.connect();
+    const rows = await conn.query("SELECT current_setting('memory_limit') AS memory_limit");
+    expect(rows[0].memory_limit).toBe('96.0 MiB');
+    conn.close();
+    db.close();
+  });
+
+  it('should let customConfig override memory_limit', async () => {
+    const db = new DuckDB({ customConfig: { memory_limit: '64MiB' } });
+    const conn = db.connect();
+    const rows = await conn.query("SELECT current_setting('memory_limit') AS memory_limit");
+    expect(rows[0].memory_limit).toBe('64.0 MiB');
+    conn.close();
+    db.close();
+  });
+});
@@ -202,6 +202,43 @@ describe('Prepared Statements (Async)', () => {
     });
   });
 
+  describe('executeBatch()', () => {
+    it('should insert columnar parameters in one call', async () => {
+      await conn.query('CREATE TABLE test_batch (id INTEGER, name VARCHAR, active BOOLEAN)');
+
+      const stmt = conn.prepare('INSERT INTO test_batch VALUES (?, ?, ?)');
+      const affected = await stmt.executeBatch([
+        new Int32Array([1, 2, 3]),
+        ['first', null, 'third'],
+        [true, false, null],
+      ]);
+      expect(affected).toBe(3);
+      stmt.close();
+
+      const result = await conn.query('SELECT * FROM test_batch ORDER BY id');
+      expect(result).toEqual([
+        { id: 1, name: 'first', active: true },
+        { id: 2, name: null, active: false },
+        { id: 3, name: 'third', active: null },
+      ]);
+
+      await conn.query('DROP TABLE test_batch');
+    });
+
+    it('should roll back the whole batch when a row fails', async () => {
+      await conn.query('CREATE TABLE test_batch_fail (id INTEGER PRIMARY KEY)');
+
+      const stmt = conn.prepare('INSERT INTO test_batch_fail VALUES (?)');
+      await expect(stmt.executeBatch([new Int32Array([1, 2, 2])])).rejects.toThrow(/Row 2/);
+      stmt.close();
+
+      const result = await conn.query('SELECT count(*)::INTEGER AS n FROM test_batch_fail');
+      expect(result[0].n).toBe(0);
+
+      await conn.query('DROP TABLE test_batch_fail');
+    });
+  });
+
   describe('parameterCount()', () => {
     it('should return correct parameter count', () => {
       const stmt1 = conn.prepare('SELECT ?');
@@ -0,0 +1,41 @@
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import { DuckDB } from './testDb';
+
+describe('Query profiles (Async)', () => {
+  let db: DuckDB;
+  let conn: ReturnType<DuckDB['connect']>;
+
+  beforeAll(() => {
+    db = new DuckDB();
+    conn = db.connect();
+  });
+
+  afterAll(() => {
+    conn.close();
+    db.close();
+  });
+
+  it('should attach a profile to the rows when requested', async () => {
+    const rows = await conn.query('SELECT sum(i) AS total FROM range(100000) t(i)', {
+      profile: true,
+    });
+    expect(rows).toHaveLength(1);
+
+    const { profile } = rows;
+    expect(profile.totalTimeMs).toBeGreaterThanOrEqual(0);
+    expect(profile.execution).not.toBeNull();
+    expect(profile.http.urls).toEqual([]);
+    expect(profile.httpTimeMs).toBe(0);
+    expect(profile.http.latencyBoundsMs.length).toBeGreaterThan(0);
+  });
+
+  it('should not attach a profile by default', async () => {
+    const rows = await conn.query('SELECT 1 AS one');
+    expect(rows).toEqual([{ one: 1 }]);
+    expect('profile' in rows).toBe(false);
+  });
+
+  it('should still report query errors', async () => {
+    await expect(conn.query('SELECT * FROM missing_table', { profile: true })).rejects.toThrow();
+  });
+});
@@ -0,0 +1,44 @@
+import { describe, it, expect } from 'vitest';
+import { DuckDB } from './testDb';
+
+function readHeader(snapshot: Uint8Array): Record<string, unknown> {
+  const view = new DataView(snapshot.buffer, snapshot.byteOffset, snapshot.byteLength);
+  const length = view.getUint32(8, true);
+  return JSON.parse(new TextDecoder().decode(snapshot.subarray(12, 12 + length)));
+}
+
+describe('Snapshots (Async)', () => {
+  it('should create a snapshot of the set up database', async () => {
+    const snapshot = await DuckDB.createSnapshot({
+      setupSql: ['CREATE TABLE items AS SELECT range AS id FROM range(1000)'],
+    });
+
+    expect(snapshot).toBeInstanceOf(Uint8Array);
+    expect(new TextDecoder().decode(snapshot.subarray(0, 4))).toBe('DKSN');
+
+    const header = readHeader(snapshot);
+    expect(header.variant).toBe('asyncify');
+    expect(header.libraryVersion).toMatch(/^v\d+\.\d+\.\d+/);
+    expect(Array.isArray(header.pages)).toBe(true);
+    // Zero pages are left out
+    expect((header.pages as number[]).length * 65536).toBeLessThanOrEqual(
+      header.memoryBytes as number,
+    );
+  });
+
+  it('should reject failing setup SQL', async () => {
+    const pending = DuckDB.createSnapshot({ setupSql: 'SELECT * FROM missing_table' });
+    await expect(pending).rejects.toThrow();
+  });
+
+  it('should leave the module usable after creating a snapshot', async () => {
+    await DuckDB.createSnapshot({ setupSql: 'CREATE TABLE t (x INTEGER)' });
+
+    const db = new DuckDB();
+    const conn = db.connect();
+    const rows = await conn.query('SELECT 42 AS answer');
+    expect(rows).toEqual([{ answer: 42 }]);
+    conn.close();
+    db.close();
+  });
+});
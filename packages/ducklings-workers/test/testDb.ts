@@ -37,8 +37,9 @@ export const DuckDBType = duckdb.DuckDBType;
 export const AccessMode = duckdb.AccessMode;
 export const sanitizeSql = duckdb.sanitizeSql;
 export const checkSql = duckdb.checkSql;
+export const isJspiSupported = duckdb.isJspiSupported;
 
 // Export types (classes need separate type export for use as type annotations)
 // DuckDB type is derived from the value export above
 export type DuckDB = InstanceType<typeof DuckDB>;
-export type { Connection, DuckDBTypeId, ColumnInfo, InitOptions, DuckDBConfig, SanitizeSqlOptions, SanitizeResult } from '../src/index';
+export type { Connection, DuckDBTypeId, ColumnInfo, InitOptions, DuckDBConfig, QueryProgress, SanitizeSqlOptions, SanitizeResult } from '../src/index';
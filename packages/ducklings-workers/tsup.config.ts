@@ -12,7 +12,7 @@ export default defineConfig([
     treeshake: true,
     splitting: false,
     outDir: 'dist',
-    external: ['./wasm/duckdb-workers.js', 'env'],
+    external: ['./wasm/duckdb-workers.js', './wasm/duckdb-workers-jspi.js', 'env'],
     noExternal: ['@uwdata/flechette'],
     esbuildOptions(options) {
       options.banner = {
@@ -20,6 +20,25 @@ export default defineConfig([
       };
     },
   },
+  // Snapshot CLI build
+  {
+    entry: { 'snapshot-cli': 'src/snapshot-cli/index.ts' },
+    format: ['esm'],
+    dts: false,
+    sourcemap: true,
+    clean: false,
+    minify: true,
+    treeshake: true,
+    splitting: false,
+    outDir: 'dist',
+    external: ['./wasm/duckdb-workers.js', './wasm/duckdb-workers-jspi.js', 'env'],
+    noExternal: ['@uwdata/flechette'],
+    esbuildOptions(options) {
+      options.banner = {
+        js: '#!/usr/bin/env node\n// Ducklings Workers - Snapshot CLI',
+      };
+    },
+  },
   // Vite plugin build
   {
     entry: { 'vite-plugin': 'src/vite-plugin/index.ts' },
@@ -0,0 +1,44 @@
+#!/bin/bash
+# Generate the TPC-H Parquet files used by the benchmark suites
+# Uses the native DuckDB CLI (tpch extension) and writes one directory per scale
+# factor to bench/data/tpch-sf<sf>/ with a Parquet file per table. Existing
+# directories are kept, so the data only has to be generated once.
+# Usage: ./scripts/bench-data.sh [scale factor...]   (default: 0.1 1)
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_ROOT="$(dirname "$SCRIPT_DIR")"
+DATA_DIR="${PROJECT_ROOT}/bench/data"
+
+SCALE_FACTORS="${*:-0.1 1}"
+
+# Colors for output
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+NC='\033[0m' # No Color
+
+log_info() {
+    echo -e "${GREEN}[INFO]${NC} $1"
+}
+
+log_error() {
+    echo -e "${RED}[ERROR]${NC} $1"
+}
+
+if ! command -v duckdb >/dev/null 2>&1; then
+    log_error "duckdb CLI not found. Install: brew install duckdb"
+    exit 1
+fi
+
+for sf in $SCALE_FACTORS; do
+    out="${DATA_DIR}/tpch-sf${sf}"
+    if [ -f "${out}/lineitem.parquet" ]; then
+        log_info "TPC-H SF${sf} already exists at ${out}"
+        continue
+    fi
+
+    log_info "Generating TPC-H SF${sf}..."
+    mkdir -p "$out"
+    duckdb -c "INSTALL tpch; LOAD tpch; CALL dbgen(sf = ${sf}); EXPORT DATABASE '${out}' (FORMAT parquet);"
+    log_info "TPC-H SF${sf} written to ${out}"
+done
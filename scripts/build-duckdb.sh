@@ -1,25 +1,41 @@
 #!/bin/bash
 # Build DuckDB to WebAssembly using Emscripten
 # Includes httpfs extension statically with WASM HTTP client
-# Supports two build targets:
+# Supports four build targets:
 #   - browser (default): Optimized for size, uses synchronous XMLHttpRequest
+#   - browser-mt: Browser build with pthreads (needs a cross-origin isolated page)
+#   - browser-simd: Browser build with WASM SIMD (simd128), optimized for speed
 #   - workers: Uses Asyncify + fetch() for Cloudflare Workers compatibility
+#   - workers-jspi: Uses JSPI (JavaScript Promise Integration) + fetch() instead of Asyncify
 set -euo pipefail
 
-# Parse build target argument (browser, workers, or link-only)
+# Parse build target argument (browser, browser-mt, browser-simd, workers, workers-jspi, or link-only)
 TARGET="${1:-browser}"
 LINK_ONLY=false
+# How the workers build suspends on async fetch(): asyncify or jspi
+ASYNC_MODE="asyncify"
 
 if [ "$TARGET" = "link-workers" ]; then
     TARGET="workers"
     LINK_ONLY=true
+elif [ "$TARGET" = "link-workers-jspi" ]; then
+    TARGET="workers"
+    ASYNC_MODE="jspi"
+    LINK_ONLY=true
+elif [ "$TARGET" = "workers-jspi" ]; then
+    TARGET="workers"
+    ASYNC_MODE="jspi"
 fi
 
-if [ "$TARGET" != "browser" ] && [ "$TARGET" != "workers" ]; then
-    echo "Usage: $0 [browser|workers|link-workers]"
+if [ "$TARGET" != "browser" ] && [ "$TARGET" != "browser-mt" ] && [ "$TARGET" != "browser-simd" ] && [ "$TARGET" != "workers" ]; then
+    echo "Usage: $0 [browser|browser-mt|browser-simd|workers|workers-jspi|link-workers|link-workers-jspi]"
     echo "  browser (default): Browser build with sync XMLHttpRequest"
+    echo "  browser-mt: Multithreaded browser build (pthreads + SharedArrayBuffer)"
+    echo "  browser-simd: Browser build with simd128 vector instructions (-O3)"
     echo "  workers: Cloudflare Workers build with Asyncify + fetch()"
+    echo "  workers-jspi: Cloudflare Workers build with JSPI + fetch()"
     echo "  link-workers: Link only (for fast JS library iteration)"
+    echo "  link-workers-jspi: Link only, JSPI variant"
     exit 1
 fi
 
@@ -39,7 +55,9 @@ if [ "$TARGET" = "workers" ]; then
     # an HTTP request is made. This includes execution, operators, I/O, etc.
 
     # Specify which JS imports can cause async operations
-    ASYNCIFY_IMPORTS="['em_async_head_request','em_async_request']"
+    # (em_js_file_read_async reads registered Blob, R2 and stream files; em_js_file_resolve_async
+    # and em_js_file_list_async look up files of bound R2 buckets)
+    ASYNCIFY_IMPORTS="['em_async_head_request','em_async_request','em_async_batch_request','em_async_stream_open','em_async_stream_read','em_async_upload_part','em_js_file_read_async','em_js_file_resolve_async','em_js_file_list_async']"
 
     ASYNCIFY_ADD="["
     # HTTP layer
@@ -93,6 +111,16 @@ if [ "$TARGET" = "workers" ]; then
     ASYNCIFY_ADD+="]"
     ASYNCIFY_FLAGS="-sASYNCIFY -sASYNCIFY_STACK_SIZE=131072 -sASYNCIFY_IMPORTS=${ASYNCIFY_IMPORTS} -sASYNCIFY_ADD=${ASYNCIFY_ADD} -sASYNCIFY_PROPAGATE_ADD"
 
+    if [ "$ASYNC_MODE" = "jspi" ]; then
+        # JSPI configuration:
+        # The engine suspends the whole WASM stack natively, so no function needs
+        # instrumenting: only the fetch() imports suspend, and only the exports
+        # that are called with ccall({ async: true }) return promises. This keeps
+        # the vectorized executor free of unwind/rewind checks and lets wasm-opt run.
+        JSPI_EXPORTS="['duckdb_query','duckdb_prepare','duckdb_pending_prepared','duckdb_execute_prepared','duckdb_pending_execute_task','duckdb_execute_pending','duckdb_wasm_execute_batch','duckdb_wasm_query_arrow_ipc','duckdb_wasm_arrow_ipc_stream_open','duckdb_wasm_arrow_ipc_stream_next','duckdb_wasm_insert_arrow_ipc','duckdb_wasm_append_arrow_ipc','duckdb_wasm_arrow_ipc_ingest_push','duckdb_wasm_arrow_ipc_ingest_finish']"
+        ASYNCIFY_FLAGS="-sJSPI -sJSPI_IMPORTS=${ASYNCIFY_IMPORTS} -sJSPI_EXPORTS=${JSPI_EXPORTS}"
+    fi
+
     # Workers-specific memory/thread settings
     # CF Workers has 128MB memory limit (256MB on paid plans), no threading
     WORKERS_MEMORY_FLAGS="-s PTHREAD_POOL_SIZE=0"
@@ -100,7 +128,11 @@ if [ "$TARGET" = "workers" ]; then
     # Workers needs Asyncify in runtime methods
     RUNTIME_METHODS="['ccall','cwrap','getValue','setValue','UTF8ToString','stringToUTF8','lengthBytesUTF8','stackAlloc','stackSave','stackRestore','HEAPU8','HEAP8','HEAP16','HEAP32','HEAPU16','HEAPU32','HEAPF32','HEAPF64','FS','Asyncify']"
 
-    OUTPUT_SUFFIX="-workers"
+    if [ "$ASYNC_MODE" = "jspi" ]; then
+        OUTPUT_SUFFIX="-workers-jspi"
+    else
+        OUTPUT_SUFFIX="-workers"
+    fi
 else
     ASYNCIFY_FLAGS=""
     WORKERS_MEMORY_FLAGS=""
@@ -111,13 +143,50 @@ else
     OUTPUT_SUFFIX=""
 fi
 
+# Threading configuration
+# Single-threaded builds compile DuckDB without its TaskScheduler threads.
+# browser-mt compiles everything with -pthread (objects with and without atomics
+# cannot be linked into one shared-memory module, so it gets its own build dir)
+# and pre-spawns one pthread worker per core so DuckDB's scheduler threads start
+# without waiting on worker creation.
+if [ "$TARGET" = "browser-mt" ]; then
+    THREAD_FLAGS="-pthread"
+    THREAD_LINK_FLAGS="-pthread -s PTHREAD_POOL_SIZE=navigator.hardwareConcurrency -s EXPORT_ES6=1"
+    DUCKDB_PLATFORM="wasm_threads"
+    BUILD_DIR_SUFFIX="-mt"
+    OUTPUT_SUFFIX="-mt"
+else
+    THREAD_FLAGS="-DDUCKDB_NO_THREADS=1"
+    THREAD_LINK_FLAGS=""
+    DUCKDB_PLATFORM="wasm_mvp"
+    BUILD_DIR_SUFFIX=""
+fi
+
+# Optimization configuration
+# Default builds optimize for size. browser-simd lets the compiler vectorize
+# DuckDB's kernels (filters, hashing, decompression, string compares) with
+# simd128 and optimizes for speed, trading a larger binary for throughput.
+# The loader only picks it when WebAssembly.validate accepts a SIMD probe.
+if [ "$TARGET" = "browser-simd" ]; then
+    OPT_FLAGS="-O3 -msimd128"
+    WASM_OPT_FLAGS="-O3 --enable-simd"
+    BUILD_DIR_SUFFIX="-simd"
+    OUTPUT_SUFFIX="-simd"
+else
+    OPT_FLAGS="-Oz"
+    WASM_OPT_FLAGS="-Oz"
+fi
+
 PROJECT_ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
 DUCKDB_SRC="${PROJECT_ROOT}/deps/duckdb"
 HTTPFS_SRC="${PROJECT_ROOT}/deps/duckdb-httpfs"
 NANOARROW_SRC="${PROJECT_ROOT}/deps/nanoarrow"
 HTTP_WASM_SRC="${PROJECT_ROOT}/src/http"
 ARROW_IPC_SRC="${PROJECT_ROOT}/src/arrow"
-BUILD_DIR="${PROJECT_ROOT}/build/emscripten"
+JS_FS_SRC="${PROJECT_ROOT}/src/fs"
+PREPARED_SRC="${PROJECT_ROOT}/src/prepared"
+QUERY_SRC="${PROJECT_ROOT}/src/query"
+BUILD_DIR="${PROJECT_ROOT}/build/emscripten${BUILD_DIR_SUFFIX}"
 DIST_DIR="${PROJECT_ROOT}/dist"
 
 # Number of parallel jobs
@@ -215,10 +284,10 @@ configure_duckdb() {
         -DENABLE_UBSAN=OFF \
         -DBUILD_EXTENSIONS="json" \
         -DSKIP_EXTENSIONS="jemalloc" \
-        -DDUCKDB_EXPLICIT_PLATFORM=wasm_mvp \
+        -DDUCKDB_EXPLICIT_PLATFORM=${DUCKDB_PLATFORM} \
         -DSMALLER_BINARY=TRUE \
-        -DCMAKE_CXX_FLAGS="-Oz -DNDEBUG -DDUCKDB_NO_THREADS=1 -DDUCKDB_DISABLE_EXTENSION_LOAD=1 -sDISABLE_EXCEPTION_CATCHING=0" \
-        -DCMAKE_C_FLAGS="-Oz -DNDEBUG"
+        -DCMAKE_CXX_FLAGS="${OPT_FLAGS} -DNDEBUG ${THREAD_FLAGS} -DDUCKDB_DISABLE_EXTENSION_LOAD=1 -sDISABLE_EXCEPTION_CATCHING=0" \
+        -DCMAKE_C_FLAGS="${OPT_FLAGS} -DNDEBUG $([ "$TARGET" = "browser-mt" ] && echo "-pthread")"
 }
 
 build_duckdb() {
@@ -263,10 +332,10 @@ build_httpfs() {
     for src in "${HTTPFS_SOURCES[@]}"; do
         obj="${src%.cpp}.o"
         log_info "  Compiling $src..."
-        emcc -Oz \
+        emcc ${OPT_FLAGS} \
             -std=c++17 \
             -DNDEBUG \
-            -DDUCKDB_NO_THREADS=1 \
+            ${THREAD_FLAGS} \
             -I"${DUCKDB_SRC}/src/include" \
             -I"${HTTPFS_SRC}/src/include" \
             -I"${BUILD_DIR}/src/include" \
@@ -291,18 +360,48 @@ build_http_wasm_client() {
     cd "${BUILD_DIR}/http_wasm"
 
     # Compile WASM HTTP client
-    emcc -Oz \
+    emcc ${OPT_FLAGS} \
         -std=c++17 \
         -DNDEBUG \
-        -DDUCKDB_NO_THREADS=1 \
+        ${THREAD_FLAGS} \
         -I"${DUCKDB_SRC}/src/include" \
         -I"${BUILD_DIR}/src/include" \
         -I"${HTTPFS_SRC}/src/include" \
         -c "${HTTP_WASM_SRC}/http_wasm.cpp" \
         -o http_wasm.o
 
-    # httpfs init is now in main.cpp, so just create library with http_wasm.o
-    emar rcs libhttp_wasm.a http_wasm.o
+    # Compile the shared HTTP range-read block cache
+    emcc ${OPT_FLAGS} \
+        -std=c++17 \
+        -DNDEBUG \
+        ${THREAD_FLAGS} \
+        -I"${DUCKDB_SRC}/src/include" \
+        -I"${BUILD_DIR}/src/include" \
+        -c "${HTTP_WASM_SRC}/http_range_cache.cpp" \
+        -o http_range_cache.o
+
+    # Compile the shared HEAD metadata cache
+    emcc ${OPT_FLAGS} \
+        -std=c++17 \
+        -DNDEBUG \
+        ${THREAD_FLAGS} \
+        -I"${DUCKDB_SRC}/src/include" \
+        -I"${BUILD_DIR}/src/include" \
+        -c "${HTTP_WASM_SRC}/http_metadata_cache.cpp" \
+        -o http_metadata_cache.o
+
+    # Compile the per-URL HTTP counters reported with query profiles
+    emcc ${OPT_FLAGS} \
+        -std=c++17 \
+        -DNDEBUG \
+        ${THREAD_FLAGS} \
+        -I"${DUCKDB_SRC}/src/include" \
+        -I"${BUILD_DIR}/src/include" \
+        -c "${HTTP_WASM_SRC}/http_stats.cpp" \
+        -o http_stats.o
+
+    # httpfs init is now in main.cpp, so just create library with the client objects
+    emar rcs libhttp_wasm.a http_wasm.o http_range_cache.o http_metadata_cache.o http_stats.o
 
     log_info "WASM HTTP client built!"
 }
@@ -326,15 +425,15 @@ build_nanoarrow() {
 
     cd "${BUILD_DIR}/nanoarrow"
 
-    emcc -Oz -DNDEBUG \
+    emcc ${OPT_FLAGS} -DNDEBUG ${THREAD_FLAGS} \
         -I"${BUILD_DIR}/nanoarrow" \
         -c nanoarrow.c -o nanoarrow.o
 
-    emcc -Oz -DNDEBUG \
+    emcc ${OPT_FLAGS} -DNDEBUG ${THREAD_FLAGS} \
         -I"${BUILD_DIR}/nanoarrow" \
         -c nanoarrow_ipc.c -o nanoarrow_ipc.o
 
-    emcc -Oz -DNDEBUG \
+    emcc ${OPT_FLAGS} -DNDEBUG ${THREAD_FLAGS} \
         -I"${BUILD_DIR}/nanoarrow" \
         -c flatcc.c -o flatcc.o
 
@@ -350,21 +449,110 @@ build_arrow_ipc_insert() {
     mkdir -p "${BUILD_DIR}/arrow_ipc_insert"
     cd "${BUILD_DIR}/arrow_ipc_insert"
 
-    emcc -Oz \
+    # Uses DuckDB's C++ API (relations over arrow_scan), so match the library's flags
+    emcc ${OPT_FLAGS} \
         -std=c++17 \
         -DNDEBUG \
+        ${THREAD_FLAGS} \
+        -sDISABLE_EXCEPTION_CATCHING=0 \
         -I"${BUILD_DIR}/nanoarrow" \
         -I"${DUCKDB_SRC}/src/include" \
         -I"${BUILD_DIR}/src/include" \
         -c "${ARROW_IPC_SRC}/arrow_ipc_insert.cpp" \
         -o arrow_ipc_insert.o
 
-    emar rcs libarrow_ipc_insert.a arrow_ipc_insert.o
+    emcc ${OPT_FLAGS} \
+        -std=c++17 \
+        -DNDEBUG \
+        ${THREAD_FLAGS} \
+        -I"${BUILD_DIR}/nanoarrow" \
+        -I"${DUCKDB_SRC}/src/include" \
+        -I"${BUILD_DIR}/src/include" \
+        -c "${ARROW_IPC_SRC}/arrow_ipc_export.cpp" \
+        -o arrow_ipc_export.o
+
+    emar rcs libarrow_ipc_insert.a arrow_ipc_insert.o arrow_ipc_export.o
 
     cd "${PROJECT_ROOT}"
     log_info "Arrow IPC insert bridge built!"
 }
 
+build_js_file_system() {
+    log_info "Building JS-backed file system..."
+
+    mkdir -p "${BUILD_DIR}/js_fs"
+    cd "${BUILD_DIR}/js_fs"
+
+    emcc ${OPT_FLAGS} \
+        -std=c++17 \
+        -DNDEBUG \
+        ${THREAD_FLAGS} \
+        -I"${DUCKDB_SRC}/src/include" \
+        -I"${BUILD_DIR}/src/include" \
+        -c "${JS_FS_SRC}/js_file_system.cpp" \
+        -o js_file_system.o
+
+    emar rcs libjs_fs.a js_file_system.o
+
+    cd "${PROJECT_ROOT}"
+    log_info "JS-backed file system built!"
+}
+
+build_prepared_batch() {
+    log_info "Building prepared statement batch execution..."
+
+    mkdir -p "${BUILD_DIR}/prepared_batch"
+    cd "${BUILD_DIR}/prepared_batch"
+
+    # Reads the connection's transaction state through the C++ API, so match the library's flags
+    emcc ${OPT_FLAGS} \
+        -std=c++17 \
+        -DNDEBUG \
+        ${THREAD_FLAGS} \
+        -sDISABLE_EXCEPTION_CATCHING=0 \
+        -I"${DUCKDB_SRC}/src/include" \
+        -I"${BUILD_DIR}/src/include" \
+        -c "${PREPARED_SRC}/prepared_batch.cpp" \
+        -o prepared_batch.o
+
+    emar rcs libprepared_batch.a prepared_batch.o
+
+    cd "${PROJECT_ROOT}"
+    log_info "Prepared statement batch execution built!"
+}
+
+build_query_progress() {
+    log_info "Building query progress reporting and profiling..."
+
+    mkdir -p "${BUILD_DIR}/query_progress"
+    cd "${BUILD_DIR}/query_progress"
+
+    emcc ${OPT_FLAGS} \
+        -std=c++17 \
+        -DNDEBUG \
+        ${THREAD_FLAGS} \
+        -I"${DUCKDB_SRC}/src/include" \
+        -I"${BUILD_DIR}/src/include" \
+        -c "${QUERY_SRC}/query_progress.cpp" \
+        -o query_progress.o
+
+    # Query profiles combine DuckDB's profiler output with the HTTP counters
+    emcc ${OPT_FLAGS} \
+        -std=c++17 \
+        -DNDEBUG \
+        ${THREAD_FLAGS} \
+        -I"${DUCKDB_SRC}/src/include" \
+        -I"${BUILD_DIR}/src/include" \
+        -I"${HTTP_WASM_SRC}" \
+        -c "${QUERY_SRC}/query_profile.cpp" \
+        -o query_profile.o
+
+    emar rcs libquery_progress.a query_progress.o query_profile.o
+
+    cd "${PROJECT_ROOT}"
+    log_info "Query progress reporting and profiling built!"
+}
+
 find_duckdb_libraries() {
     # Find all required static libraries
     local LIBS=""
@@ -434,6 +622,21 @@ find_duckdb_libraries() {
         LIBS="${LIBS} ${BUILD_DIR}/arrow_ipc_insert/libarrow_ipc_insert.a"
     fi
 
+    # Add JS-backed file system (OPFS)
+    if [ -f "${BUILD_DIR}/js_fs/libjs_fs.a" ]; then
+        LIBS="${LIBS} ${BUILD_DIR}/js_fs/libjs_fs.a"
+    fi
+
+    # Add prepared statement batch execution
+    if [ -f "${BUILD_DIR}/prepared_batch/libprepared_batch.a" ]; then
+        LIBS="${LIBS} ${BUILD_DIR}/prepared_batch/libprepared_batch.a"
+    fi
+
+    # Add query progress reporting
+    if [ -f "${BUILD_DIR}/query_progress/libquery_progress.a" ]; then
+        LIBS="${LIBS} ${BUILD_DIR}/query_progress/libquery_progress.a"
+    fi
+
     echo "${LIBS}"
 }
 
@@ -454,6 +657,8 @@ link_wasm_module() {
 #include "httpfs.hpp"
 #include "httpfs_extension.hpp"
 #include "http_wasm.hpp"
+#include "http_range_cache.hpp"
+#include "http_metadata_cache.hpp"
 #include "json_extension.hpp"
 #include "parquet_extension.hpp"
 
@@ -485,6 +690,27 @@ void duckdb_wasm_httpfs_init(duckdb_database db) {
             config.http_util = duckdb::make_shared_ptr<duckdb::HTTPWasmUtil>();
         }
 
+        // Settings for the in-memory HTTP range cache and read-ahead (read in HTTPWasmUtil::InitializeParameters)
+        config.AddExtensionOption("http_wasm_cache_size",
+                                  "Byte budget of the in-memory HTTP range-read cache (0 disables it)",
+                                  duckdb::LogicalType::UBIGINT,
+                                  duckdb::Value::UBIGINT(duckdb::HTTPRangeCache::DEFAULT_CACHE_SIZE));
+        config.AddExtensionOption("http_wasm_cache_block_size",
+                                  "Block size that HTTP range reads are rounded up to for caching",
+                                  duckdb::LogicalType::UBIGINT,
+                                  duckdb::Value::UBIGINT(duckdb::HTTPRangeCache::DEFAULT_BLOCK_SIZE));
+        config.AddExtensionOption("http_wasm_prefetch_blocks",
+                                  "Blocks read ahead concurrently on forward scans (Workers build only, 0 disables)",
+                                  duckdb::LogicalType::UBIGINT,
+                                  duckdb::Value::UBIGINT(duckdb::HTTPRangeCache::DEFAULT_PREFETCH_BLOCKS));
+        config.AddExtensionOption("http_wasm_metadata_cache_ttl",
+                                  "Seconds a HEAD response (size, ETag, Last-Modified) is reused across queries (0 disables it)",
+                                  duckdb::LogicalType::UBIGINT,
+                                  duckdb::Value::UBIGINT(duckdb::HTTPMetadataCache::DEFAULT_TTL_SECONDS));
+        config.AddExtensionOption("http_wasm_compressed_transport",
+                                  "Accept gzip and brotli bodies for whole-file GETs (Workers build only)",
+                                  duckdb::LogicalType::BOOLEAN, duckdb::Value::BOOLEAN(true));
+
         // Load httpfs extension
         // This registers all file systems (HTTP, S3, HuggingFace) and secret types (s3, aws, r2, gcs)
         {
@@ -520,6 +746,24 @@ duckdb_state duckdb_wasm_clear_bindings(duckdb_prepared_statement stmt) {
     return duckdb_clear_bindings(stmt);
 }
 
+// Render a single vector value as a malloc'd string (NULL for SQL NULL).
+// Used by streaming chunk reads for types without a fixed-width JS mapping.
+char *duckdb_wasm_vector_value_varchar(duckdb_vector vector, uint32_t row) {
+    if (!vector) return nullptr;
+    try {
+        auto &vec = *reinterpret_cast<duckdb::Vector *>(vector);
+        auto value = vec.GetValue(row);
+        if (value.IsNull()) return nullptr;
+        auto str = value.ToString();
+        auto *out = static_cast<char *>(malloc(str.size() + 1));
+        if (!out) return nullptr;
+        memcpy(out, str.c_str(), str.size() + 1);
+        return out;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
 } // extern "C"
 
 int main() { return 0; }
@@ -555,6 +799,17 @@ MAINEOF
         '_duckdb_vector_get_validity', \
         '_duckdb_destroy_data_chunk', \
         '_duckdb_validity_row_is_valid', \
+        '_duckdb_fetch_chunk', \
+        '_duckdb_pending_prepared_streaming', \
+        '_duckdb_execute_pending', \
+        '_duckdb_pending_error', \
+        '_duckdb_destroy_pending', \
+        '_duckdb_pending_prepared', \
+        '_duckdb_pending_execute_task', \
+        '_duckdb_interrupt', \
+        '_duckdb_wasm_query_progress', \
+        '_duckdb_wasm_profile_begin', \
+        '_duckdb_wasm_profile_end', \
         '_duckdb_prepare', \
         '_duckdb_destroy_prepare', \
         '_duckdb_nparams', \
@@ -591,7 +846,22 @@ MAINEOF
         '_duckdb_value_timestamp', \
         '_duckdb_wasm_httpfs_init', \
         '_duckdb_wasm_clear_bindings', \
+        '_duckdb_wasm_vector_value_varchar', \
         '_duckdb_wasm_insert_arrow_ipc', \
+        '_duckdb_wasm_append_arrow_ipc', \
+        '_duckdb_wasm_arrow_ipc_ingest_open', \
+        '_duckdb_wasm_arrow_ipc_ingest_push', \
+        '_duckdb_wasm_arrow_ipc_ingest_finish', \
+        '_duckdb_wasm_arrow_ipc_ingest_error', \
+        '_duckdb_wasm_arrow_ipc_ingest_destroy', \
+        '_duckdb_wasm_query_arrow_ipc', \
+        '_duckdb_wasm_arrow_ipc_stream_open', \
+        '_duckdb_wasm_arrow_ipc_stream_next', \
+        '_duckdb_wasm_arrow_ipc_stream_error', \
+        '_duckdb_wasm_arrow_ipc_stream_destroy', \
+        '_duckdb_wasm_fs_configure', \
+        '_duckdb_wasm_execute_batch', \
+        '_duckdb_wasm_prepare_sync', \
         '_duckdb_create_config', \
         '_duckdb_set_config', \
         '_duckdb_destroy_config', \
@@ -605,22 +875,34 @@ MAINEOF
     fi
 
     log_info "Building for target: $TARGET"
-    if [ -n "$ASYNCIFY_FLAGS" ]; then
+    if [ "$ASYNC_MODE" = "jspi" ] && [ "$TARGET" = "workers" ]; then
+        log_info "  Using JSPI for async fetch() support"
+    elif [ -n "$ASYNCIFY_FLAGS" ]; then
         log_info "  Using Asyncify for async fetch() support"
     fi
 
     # Include JS library for HTTP functions (needed for both builds)
     # Browser uses em_has_xhr() to detect XHR support and use sync path
     # Workers uses em_async_* functions via Asyncify
-    local JS_LIBRARY_FLAGS="--js-library ${HTTP_WASM_SRC}/http_async.js"
+    # $HTTPHeaderBlock and $DucklingsLog are force-included because the browser's EM_ASM XHR code uses them too
+    local JS_LIBRARY_FLAGS="--js-library ${HTTP_WASM_SRC}/http_async.js -s DEFAULT_LIBRARY_FUNCS_TO_INCLUDE=['\$HTTPHeaderBlock','\$DucklingsLog']"
     log_info "  Including HTTP library: ${HTTP_WASM_SRC}/http_async.js"
 
+    # JS-backed files (OPFS sync access handles, registered Blobs) used by JSFileSystem
+    JS_LIBRARY_FLAGS="${JS_LIBRARY_FLAGS} --js-library ${JS_FS_SRC}/js_files.js"
+    log_info "  Including file library: ${JS_FS_SRC}/js_files.js"
+
+    # The memory is imported so the loaders can create it with the initial and maximum
+    # size passed to init() (Module['wasmMemory']); MAXIMUM_MEMORY is the upper bound and
+    # the loaders set DuckDB's memory_limit below the maximum they pick
+    local MEMORY_FLAGS="-s IMPORTED_MEMORY=1"
+
     # Link with Emscripten
-    emcc -Oz \
+    emcc ${OPT_FLAGS} \
         -flto \
         -std=c++17 \
         -DNDEBUG \
-        -DDUCKDB_NO_THREADS=1 \
+        ${THREAD_FLAGS} \
         ${TARGET_DEFINES} \
         -I"${DUCKDB_SRC}/src/include" \
         -I"${BUILD_DIR}/src/include" \
@@ -640,6 +922,7 @@ MAINEOF
         -s MALLOC=emmalloc \
         -s ERROR_ON_UNDEFINED_SYMBOLS=0 \
         -s ALLOW_MEMORY_GROWTH=1 \
+        ${MEMORY_FLAGS} \
         $([ "$TARGET" = "workers" ] && echo "-s MAXIMUM_MEMORY=128MB" || echo "-s MAXIMUM_MEMORY=4GB") \
         -s STACK_SIZE=1048576 \
         -s NO_EXIT_RUNTIME=1 \
@@ -647,6 +930,7 @@ MAINEOF
         -s WASM_BIGINT=0 \
         ${ASYNCIFY_FLAGS} \
         ${WORKERS_MEMORY_FLAGS} \
+        ${THREAD_LINK_FLAGS} \
         ${JS_LIBRARY_FLAGS} \
         -s EXPORTED_FUNCTIONS="${EXPORTED_FUNCTIONS}" \
         -s EXPORTED_RUNTIME_METHODS="${RUNTIME_METHODS}" \
@@ -666,8 +950,11 @@ CFPATCH
     cat "${DIST_DIR}/duckdb${OUTPUT_SUFFIX}.js" >> "${DIST_DIR}/duckdb${OUTPUT_SUFFIX}.js.tmp"
     mv "${DIST_DIR}/duckdb${OUTPUT_SUFFIX}.js.tmp" "${DIST_DIR}/duckdb${OUTPUT_SUFFIX}.js"
 
-    echo "" >> "${DIST_DIR}/duckdb${OUTPUT_SUFFIX}.js"
-    echo "export default DuckDBModule;" >> "${DIST_DIR}/duckdb${OUTPUT_SUFFIX}.js"
+    # EXPORT_ES6 builds (browser-mt) already end with an ES module export
+    if [ "$TARGET" != "browser-mt" ]; then
+        echo "" >> "${DIST_DIR}/duckdb${OUTPUT_SUFFIX}.js"
+        echo "export default DuckDBModule;" >> "${DIST_DIR}/duckdb${OUTPUT_SUFFIX}.js"
+    fi
 
     # Remove CommonJS/AMD module.exports to avoid ESM/CJS conflict warnings
     log_info "Removing CommonJS/AMD exports for pure ESM..."
@@ -678,9 +965,10 @@ CFPATCH
 
     # Run wasm-opt (skip for workers build as Asyncify transforms are incompatible with some optimizations)
     # Also skip for browser build - aggressive optimization breaks prepared statement binding
-    if [ "$TARGET" = "browser" ] && [ "${SKIP_WASM_OPT:-0}" != "1" ] && command -v wasm-opt &> /dev/null; then
+    if { [ "$TARGET" != "workers" ] || [ "$ASYNC_MODE" = "jspi" ]; } && [ "${SKIP_WASM_OPT:-0}" != "1" ] && command -v wasm-opt &> /dev/null; then
         log_info "Running wasm-opt for additional size optimization..."
-        wasm-opt -Oz \
+        wasm-opt ${WASM_OPT_FLAGS} \
+            $([ "$TARGET" = "browser-mt" ] && echo "--enable-threads") \
             --enable-mutable-globals \
             --enable-bulk-memory \
             --enable-nontrapping-float-to-int \
@@ -689,10 +977,10 @@ CFPATCH
             --strip-dwarf \
             --strip-producers \
             --converge \
-            -o "${DIST_DIR}/duckdb-opt.wasm" "${DIST_DIR}/duckdb.wasm"
-        mv "${DIST_DIR}/duckdb-opt.wasm" "${DIST_DIR}/duckdb.wasm"
+            -o "${DIST_DIR}/duckdb${OUTPUT_SUFFIX}-opt.wasm" "${DIST_DIR}/duckdb${OUTPUT_SUFFIX}.wasm"
+        mv "${DIST_DIR}/duckdb${OUTPUT_SUFFIX}-opt.wasm" "${DIST_DIR}/duckdb${OUTPUT_SUFFIX}.wasm"
         log_info "wasm-opt optimization complete!"
-    elif [ "$TARGET" = "workers" ]; then
+    elif [ "$TARGET" = "workers" ] && [ "$ASYNC_MODE" != "jspi" ]; then
         log_info "Skipping wasm-opt for workers build (Asyncify incompatible)"
     elif [ "${SKIP_WASM_OPT:-0}" = "1" ]; then
         log_info "Skipping wasm-opt (SKIP_WASM_OPT=1)"
@@ -726,8 +1014,14 @@ print_summary() {
 
     echo ""
     log_info "Built with static httpfs extension (WASM HTTP client)"
-    if [ "$TARGET" = "workers" ]; then
+    if [ "$TARGET" = "workers" ] && [ "$ASYNC_MODE" = "jspi" ]; then
+        log_info "This build uses JSPI + fetch() and needs a runtime with WebAssembly.Suspending"
+    elif [ "$TARGET" = "workers" ]; then
         log_info "This build uses Asyncify + fetch() for Cloudflare Workers"
+    elif [ "$TARGET" = "browser-mt" ]; then
+        log_info "This build uses pthreads and requires a cross-origin isolated page (COOP/COEP)"
+    elif [ "$TARGET" = "browser-simd" ]; then
+        log_info "This build uses WASM SIMD (simd128) and is loaded only where SIMD is supported"
     else
         log_info "This build uses synchronous XMLHttpRequest for browsers"
     fi
@@ -758,6 +1052,9 @@ main() {
         bundle_nanoarrow
         build_nanoarrow
         build_arrow_ipc_insert
+        build_js_file_system
+        build_prepared_batch
+        build_query_progress
         link_wasm_module
         print_summary
     fi
@@ -0,0 +1,62 @@
+#!/usr/bin/env node
+// Compare two benchmark result files written by `make bench`
+// Prints every metric present in both files with its relative change and marks
+// regressions larger than the threshold. Exits with 1 on regressions when --fail is set.
+// Usage: node scripts/compare-bench.mjs <base.json> <head.json> [--threshold 10] [--fail]
+
+import { readFileSync } from 'node:fs';
+import { parseArgs } from 'node:util';
+
+// Units where a higher value is better; all others (ms, bytes, requests) are costs
+const HIGHER_IS_BETTER = new Set(['rows/s', 'MB/s']);
+
+const { values, positionals } = parseArgs({
+  options: {
+    threshold: { type: 'string', default: '10' },
+    fail: { type: 'boolean', default: false },
+  },
+  allowPositionals: true,
+});
+
+if (positionals.length !== 2) {
+  console.error('Usage: compare-bench.mjs <base.json> <head.json> [--threshold 10] [--fail]');
+  process.exit(1);
+}
+
+const threshold = Number(values.threshold);
+const [base, head] = positionals.map((path) => JSON.parse(readFileSync(path, 'utf8')));
+
+const key = (result) => `${result.suite}|${result.benchmark}|${result.metric}`;
+const baseResults = new Map(base.results.map((result) => [key(result), result]));
+
+console.log(`Base: ${base.package} ${base.commit} (${base.createdAt})`);
+console.log(`Head: ${head.package} ${head.commit} (${head.createdAt})`);
+console.log('');
+
+let regressions = 0;
+for (const result of head.results) {
+  const previous = baseResults.get(key(result));
+  if (!previous || previous.unit !== result.unit) {
+    continue;
+  }
+  const change =
+    previous.value === 0 ? 0 : ((result.value - previous.value) / previous.value) * 100;
+  const worse = HIGHER_IS_BETTER.has(result.unit) ? -change : change;
+  const regressed = worse > threshold;
+  if (regressed) {
+    regressions++;
+  }
+  const sign = change > 0 ? '+' : '';
+  const name = `${result.benchmark} > ${result.metric}`;
+  const range = `${String(previous.value).padStart(14)} -> ${String(result.value).padStart(14)}`;
+  console.log(
+    `${regressed ? '!' : ' '} ${name.padEnd(70)} ${range} ${result.unit.padEnd(8)} ` +
+      `${sign}${change.toFixed(1)}%`,
+  );
+}
+
+console.log('');
+console.log(`${regressions} regression(s) above ${threshold}%`);
+if (values.fail && regressions > 0) {
+  process.exit(1);
+}
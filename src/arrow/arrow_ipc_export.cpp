@@ -0,0 +1,306 @@
+#include "arrow_ipc_export.hpp"
+#include "nanoarrow/nanoarrow.h"
+#include "nanoarrow/nanoarrow_ipc.h"
+#include "duckdb.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Copy a message into a malloc'd buffer the JS side can read and _free()
+static char *copy_error(const char *message) {
+    if (!message) {
+        message = "Unknown error";
+    }
+    size_t len = std::strlen(message);
+    char *copy = static_cast<char*>(std::malloc(len + 1));
+    if (copy) {
+        std::memcpy(copy, message, len + 1);
+    }
+    return copy;
+}
+
+struct duckdb_wasm_arrow_ipc_stream {
+    duckdb_prepared_statement prepared;
+    duckdb_result result;
+    bool has_result;
+    duckdb_arrow_options arrow_options;
+    struct ArrowSchema schema;
+    struct ArrowArrayView view;
+    // Messages encoded by the current next() call; handed to the caller when it returns
+    struct ArrowBuffer output;
+    struct ArrowIpcWriter writer;
+    bool writer_initialized;
+    bool schema_written;
+    bool finished;
+    std::string error;
+};
+
+static duckdb_state StreamFail(duckdb_wasm_arrow_ipc_stream *stream, const char *message) {
+    stream->error = message ? message : "Unknown error";
+    return DuckDBError;
+}
+
+// Take ownership of a DuckDB error, recording it on the stream if it carried one
+static bool ConsumeErrorData(duckdb_wasm_arrow_ipc_stream *stream, duckdb_error_data error_data) {
+    if (!error_data) {
+        return false;
+    }
+    bool has_error = duckdb_error_data_has_error(error_data);
+    if (has_error) {
+        StreamFail(stream, duckdb_error_data_message(error_data));
+    }
+    duckdb_destroy_error_data(&error_data);
+    return has_error;
+}
+
+// Run the query with a streaming result, so chunks are only produced as they are
+// encoded. SQL that cannot be prepared as one statement (e.g. several statements)
+// falls back to a materialized result, which is read through the same chunk API.
+static duckdb_state StreamExecute(duckdb_wasm_arrow_ipc_stream *stream, duckdb_connection connection,
+                                  const char *sql) {
+    if (duckdb_prepare(connection, sql, &stream->prepared) != DuckDBSuccess) {
+        duckdb_destroy_prepare(&stream->prepared);
+        stream->has_result = true;
+        if (duckdb_query(connection, sql, &stream->result) != DuckDBSuccess) {
+            return StreamFail(stream, duckdb_result_error(&stream->result));
+        }
+        return DuckDBSuccess;
+    }
+
+    duckdb_pending_result pending = nullptr;
+    if (duckdb_pending_prepared_streaming(stream->prepared, &pending) != DuckDBSuccess) {
+        StreamFail(stream, pending ? duckdb_pending_error(pending) : "Query failed");
+        duckdb_destroy_pending(&pending);
+        return DuckDBError;
+    }
+    stream->has_result = true;
+    duckdb_state state = duckdb_execute_pending(pending, &stream->result);
+    duckdb_destroy_pending(&pending);
+    if (state != DuckDBSuccess) {
+        return StreamFail(stream, duckdb_result_error(&stream->result));
+    }
+    return DuckDBSuccess;
+}
+
+// Build the Arrow schema from the result's column types and names and set up the
+// IPC writer, whose output stream appends to stream->output
+static duckdb_state StreamInitWriter(duckdb_wasm_arrow_ipc_stream *stream, duckdb_connection connection) {
+    // Honour the connection's Arrow settings (e.g. arrow_lossless_conversion)
+    duckdb_connection_get_arrow_options(connection, &stream->arrow_options);
+
+    idx_t column_count = duckdb_column_count(&stream->result);
+    std::vector<duckdb_logical_type> types(column_count);
+    std::vector<const char*> names(column_count);
+    for (idx_t i = 0; i < column_count; i++) {
+        types[i] = duckdb_column_logical_type(&stream->result, i);
+        names[i] = duckdb_column_name(&stream->result, i);
+    }
+    bool failed = ConsumeErrorData(
+        stream, duckdb_to_arrow_schema(stream->arrow_options, types.data(), names.data(), column_count,
+                                       &stream->schema));
+    for (auto &type : types) {
+        duckdb_destroy_logical_type(&type);
+    }
+    if (failed) {
+        return DuckDBError;
+    }
+
+    struct ArrowError error;
+    error.message[0] = '\0';
+    if (ArrowArrayViewInitFromSchema(&stream->view, &stream->schema, &error) != NANOARROW_OK) {
+        return StreamFail(stream, error.message);
+    }
+
+    // The writer owns the output stream once initialized
+    struct ArrowIpcOutputStream output_stream;
+    std::memset(&output_stream, 0, sizeof(output_stream));
+    if (ArrowIpcOutputStreamInitBuffer(&output_stream, &stream->output) != NANOARROW_OK ||
+        ArrowIpcWriterInit(&stream->writer, &output_stream) != NANOARROW_OK) {
+        if (output_stream.release) {
+            output_stream.release(&output_stream);
+        }
+        return StreamFail(stream, "Failed to initialize Arrow IPC writer");
+    }
+    stream->writer_initialized = true;
+    return DuckDBSuccess;
+}
+
+// Encode the next chunk of the result as a record batch, or the end-of-stream
+// marker once the result is exhausted. Sets *rows to the chunk's row count.
+static duckdb_state StreamWriteChunk(duckdb_wasm_arrow_ipc_stream *stream, idx_t *rows) {
+    struct ArrowError error;
+    error.message[0] = '\0';
+    *rows = 0;
+
+    duckdb_data_chunk chunk = duckdb_fetch_chunk(stream->result);
+    if (!chunk) {
+        // A streaming result reports errors of the remaining execution here
+        const char *message = duckdb_result_error(&stream->result);
+        if (message) {
+            return StreamFail(stream, message);
+        }
+        // A NULL view writes the end-of-stream marker
+        if (ArrowIpcWriterWriteArrayView(&stream->writer, nullptr, &error) != NANOARROW_OK) {
+            return StreamFail(stream, error.message);
+        }
+        stream->finished = true;
+        return DuckDBSuccess;
+    }
+
+    *rows = duckdb_data_chunk_get_size(chunk);
+    struct ArrowArray array;
+    std::memset(&array, 0, sizeof(array));
+    bool failed = ConsumeErrorData(stream, duckdb_data_chunk_to_arrow(stream->arrow_options, chunk, &array));
+    duckdb_destroy_data_chunk(&chunk);
+    if (failed) {
+        return DuckDBError;
+    }
+
+    int rc = ArrowArrayViewSetArray(&stream->view, &array, &error);
+    if (rc == NANOARROW_OK) {
+        rc = ArrowIpcWriterWriteArrayView(&stream->writer, &stream->view, &error);
+    }
+    if (array.release) {
+        array.release(&array);
+    }
+    if (rc != NANOARROW_OK) {
+        return StreamFail(stream, error.message);
+    }
+    return DuckDBSuccess;
+}
+
+extern "C" {
+
+duckdb_wasm_arrow_ipc_stream *duckdb_wasm_arrow_ipc_stream_open(
+    duckdb_connection connection,
+    const char *sql
+) {
+    if (!connection || !sql) {
+        return nullptr;
+    }
+
+    auto *stream = new duckdb_wasm_arrow_ipc_stream();
+    stream->prepared = nullptr;
+    std::memset(&stream->result, 0, sizeof(stream->result));
+    stream->has_result = false;
+    stream->arrow_options = nullptr;
+    std::memset(&stream->schema, 0, sizeof(stream->schema));
+    ArrowArrayViewInitFromType(&stream->view, NANOARROW_TYPE_UNINITIALIZED);
+    ArrowBufferInit(&stream->output);
+    std::memset(&stream->writer, 0, sizeof(stream->writer));
+    stream->writer_initialized = false;
+    stream->schema_written = false;
+    stream->finished = false;
+
+    if (StreamExecute(stream, connection, sql) == DuckDBSuccess) {
+        StreamInitWriter(stream, connection);
+    }
+    return stream;
+}
+
+duckdb_state duckdb_wasm_arrow_ipc_stream_next(
+    duckdb_wasm_arrow_ipc_stream *stream,
+    size_t min_rows,
+    uint8_t **out_buffer,
+    size_t *out_length
+) {
+    if (!stream || !out_buffer || !out_length) {
+        return DuckDBError;
+    }
+    *out_buffer = nullptr;
+    *out_length = 0;
+    if (!stream->error.empty()) {
+        return DuckDBError;
+    }
+    if (stream->finished) {
+        return DuckDBSuccess;
+    }
+
+    struct ArrowError error;
+    error.message[0] = '\0';
+    if (!stream->schema_written) {
+        if (ArrowIpcWriterWriteSchema(&stream->writer, &stream->schema, &error) != NANOARROW_OK) {
+            return StreamFail(stream, error.message);
+        }
+        stream->schema_written = true;
+    }
+
+    // At least one record batch, more until min_rows rows are encoded
+    idx_t rows = 0;
+    do {
+        idx_t chunk_rows = 0;
+        if (StreamWriteChunk(stream, &chunk_rows) != DuckDBSuccess) {
+            ArrowBufferReset(&stream->output);
+            return DuckDBError;
+        }
+        rows += chunk_rows;
+    } while (!stream->finished && rows < min_rows);
+
+    // Hand the buffer to the caller; nanoarrow's default allocator is malloc, and
+    // the output stream keeps appending to the now empty buffer
+    *out_buffer = stream->output.data;
+    *out_length = static_cast<size_t>(stream->output.size_bytes);
+    stream->output.data = nullptr;
+    stream->output.size_bytes = 0;
+    stream->output.capacity_bytes = 0;
+    return DuckDBSuccess;
+}
+
+const char *duckdb_wasm_arrow_ipc_stream_error(duckdb_wasm_arrow_ipc_stream *stream) {
+    if (!stream || stream->error.empty()) {
+        return nullptr;
+    }
+    return stream->error.c_str();
+}
+
+void duckdb_wasm_arrow_ipc_stream_destroy(duckdb_wasm_arrow_ipc_stream *stream) {
+    if (!stream) {
+        return;
+    }
+    ArrowArrayViewReset(&stream->view);
+    if (stream->writer_initialized) {
+        ArrowIpcWriterReset(&stream->writer);
+    }
+    ArrowBufferReset(&stream->output);
+    if (stream->schema.release) {
+        stream->schema.release(&stream->schema);
+    }
+    duckdb_destroy_arrow_options(&stream->arrow_options);
+    if (stream->has_result) {
+        duckdb_destroy_result(&stream->result);
+    }
+    duckdb_destroy_prepare(&stream->prepared);
+    delete stream;
+}
+
+duckdb_state duckdb_wasm_query_arrow_ipc(
+    duckdb_connection connection,
+    const char *sql,
+    uint8_t **out_buffer,
+    size_t *out_length,
+    char **out_error
+) {
+    if (out_error) {
+        *out_error = nullptr;
+    }
+    if (!connection || !sql || !out_buffer || !out_length) {
+        return DuckDBError;
+    }
+    *out_buffer = nullptr;
+    *out_length = 0;
+
+    // The whole result in one call: schema, every record batch and end-of-stream
+    duckdb_wasm_arrow_ipc_stream *stream = duckdb_wasm_arrow_ipc_stream_open(connection, sql);
+    duckdb_state state = stream->error.empty()
+                             ? duckdb_wasm_arrow_ipc_stream_next(stream, SIZE_MAX, out_buffer, out_length)
+                             : DuckDBError;
+    if (state != DuckDBSuccess && out_error) {
+        *out_error = copy_error(duckdb_wasm_arrow_ipc_stream_error(stream));
+    }
+    duckdb_wasm_arrow_ipc_stream_destroy(stream);
+    return state;
+}
+
+} // extern "C"
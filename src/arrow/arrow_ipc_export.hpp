@@ -0,0 +1,95 @@
+#pragma once
+
+#include "duckdb.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Execute a query and serialize its result as an Arrow IPC stream.
+ *
+ * DuckDB's own Arrow converter produces the ArrowSchema and one ArrowArray
+ * per data chunk; nanoarrow's IPC writer encodes them into a single
+ * malloc'd buffer (schema message, record batches, end-of-stream marker).
+ * Same as reading a duckdb_wasm_arrow_ipc_stream to the end in one call.
+ *
+ * @param connection  Active DuckDB connection
+ * @param sql         SQL query to execute
+ * @param out_buffer  Receives a pointer to the IPC bytes (caller frees with free/_free)
+ * @param out_length  Receives the length of the IPC buffer in bytes
+ * @param out_error   Receives a malloc'd error message on failure (caller frees), or NULL
+ * @return DuckDBSuccess on success, DuckDBError on failure
+ */
+duckdb_state duckdb_wasm_query_arrow_ipc(
+    duckdb_connection connection,
+    const char *sql,
+    uint8_t **out_buffer,
+    size_t *out_length,
+    char **out_error
+);
+
+/**
+ * Arrow IPC stream of a query result, encoded batch by batch.
+ *
+ * The query runs with a streaming result, so DuckDB only produces the chunks
+ * being encoded. Each call to next returns the following IPC messages as one
+ * buffer; concatenated in order they form a complete IPC stream. Only those
+ * messages are held in memory instead of the whole result.
+ */
+typedef struct duckdb_wasm_arrow_ipc_stream duckdb_wasm_arrow_ipc_stream;
+
+/**
+ * Execute a query whose result is read as an Arrow IPC stream.
+ *
+ * Running the query on the connection again, or any other query on it, ends
+ * a streaming result, so keep the connection to the stream until it is read.
+ *
+ * @param connection  Active DuckDB connection
+ * @param sql         SQL query to execute
+ * @return Stream handle, or NULL on invalid arguments. If the query failed,
+ *         duckdb_wasm_arrow_ipc_stream_error returns the message.
+ */
+duckdb_wasm_arrow_ipc_stream *duckdb_wasm_arrow_ipc_stream_open(
+    duckdb_connection connection,
+    const char *sql
+);
+
+/**
+ * Encode the next part of the stream.
+ *
+ * The first call starts with the schema message. Each call encodes one record
+ * batch per data chunk until at least min_rows rows are encoded (0 for a single
+ * chunk), and the end-of-stream marker after the last chunk. Once the stream is
+ * complete, calls succeed with a NULL buffer and a length of 0.
+ *
+ * @param stream      Stream handle
+ * @param min_rows    Rows to encode before returning, unless the result ends first
+ * @param out_buffer  Receives a pointer to the IPC bytes (caller frees with free/_free)
+ * @param out_length  Receives the length of the IPC bytes
+ * @return DuckDBSuccess on success, DuckDBError on failure (see duckdb_wasm_arrow_ipc_stream_error)
+ */
+duckdb_state duckdb_wasm_arrow_ipc_stream_next(
+    duckdb_wasm_arrow_ipc_stream *stream,
+    size_t min_rows,
+    uint8_t **out_buffer,
+    size_t *out_length
+);
+
+/**
+ * Get the error message of the failed query or the last failed next.
+ *
+ * @return Error message owned by the stream, or NULL if there was no error
+ */
+const char *duckdb_wasm_arrow_ipc_stream_error(duckdb_wasm_arrow_ipc_stream *stream);
+
+/**
+ * Destroy a stream handle and the query result it reads.
+ */
+void duckdb_wasm_arrow_ipc_stream_destroy(duckdb_wasm_arrow_ipc_stream *stream);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,8 +2,14 @@
 #include "nanoarrow/nanoarrow.h"
 #include "nanoarrow/nanoarrow_ipc.h"
 #include "duckdb.h"
+#include "duckdb.hpp"
+#include "duckdb/common/arrow/arrow_wrapper.hpp"
+#include "duckdb/function/table/arrow.hpp"
+#include <cerrno>
+#include <cstdlib>
 #include <cstring>
 #include <string>
+#include <vector>
 
 // No-op deallocator: the WASM caller owns the buffer memory
 static void noop_deallocator(struct ArrowBufferAllocator* allocator, uint8_t* ptr, int64_t size) {
@@ -12,15 +18,101 @@ static void noop_deallocator(struct ArrowBufferAllocator* allocator, uint8_t* pt
     (void)size;
 }
 
-extern "C" {
+// Copy a message into a malloc'd buffer the JS side can read and _free()
+static char *copy_error(const std::string &message) {
+    char *copy = static_cast<char*>(std::malloc(message.size() + 1));
+    if (copy) {
+        std::memcpy(copy, message.c_str(), message.size() + 1);
+    }
+    return copy;
+}
 
-duckdb_state duckdb_wasm_insert_arrow_ipc(
+// How the scanned Arrow data is written to the target table
+enum class IngestMode {
+    CREATE_IF_NOT_EXISTS,
+    CREATE,
+    APPEND
+};
+
+// arrow_scan stream factory: the factory pointer is the ArrowArrayStream itself.
+// The scan gets a borrowed view of it; the caller of IngestArrowStream keeps ownership.
+static void BorrowedStreamRelease(struct ArrowArrayStream *stream) {
+    stream->release = nullptr;
+}
+
+static duckdb::unique_ptr<duckdb::ArrowArrayStreamWrapper> ProduceBorrowedStream(
+    uintptr_t factory_ptr,
+    duckdb::ArrowStreamParameters &parameters
+) {
+    (void)parameters;
+    auto *stream = reinterpret_cast<struct ArrowArrayStream *>(factory_ptr);
+    auto wrapper = duckdb::make_uniq<duckdb::ArrowArrayStreamWrapper>();
+    wrapper->arrow_array_stream = *stream;
+    wrapper->arrow_array_stream.release = BorrowedStreamRelease;
+    return wrapper;
+}
+
+static void GetBorrowedStreamSchema(struct ArrowArrayStream *factory_ptr, struct ArrowSchema &schema) {
+    factory_ptr->get_schema(factory_ptr, &schema);
+}
+
+// Scan an ArrowArrayStream into a table. Takes ownership of the stream.
+//
+// The stream is bound directly as the arrow_scan table function argument, so no
+// catalog entry is created: concurrent ingests on different connections (or the
+// same connection, one after another) never share any state.
+static duckdb_state IngestArrowStream(
+    duckdb_connection connection,
+    const char *table_name,
+    struct ArrowArrayStream *stream,
+    IngestMode mode,
+    std::string *error
+) {
+    auto *conn = reinterpret_cast<duckdb::Connection *>(connection);
+    duckdb_state state = DuckDBSuccess;
+
+    try {
+        if (mode == IngestMode::CREATE_IF_NOT_EXISTS && conn->TableInfo(table_name)) {
+            // Existing table is left untouched (CREATE TABLE IF NOT EXISTS semantics)
+        } else {
+            duckdb::vector<duckdb::Value> parameters {
+                duckdb::Value::POINTER(reinterpret_cast<uintptr_t>(stream)),
+                duckdb::Value::POINTER(reinterpret_cast<uintptr_t>(&ProduceBorrowedStream)),
+                duckdb::Value::POINTER(reinterpret_cast<uintptr_t>(&GetBorrowedStreamSchema)),
+            };
+            auto relation = conn->TableFunction("arrow_scan", parameters);
+            if (mode == IngestMode::APPEND) {
+                relation->Insert(table_name);
+            } else {
+                relation->Create(table_name);
+            }
+        }
+    } catch (std::exception &ex) {
+        if (error) {
+            *error = duckdb::ErrorData(ex).Message();
+        }
+        state = DuckDBError;
+    }
+
+    // Release the stream
+    if (stream->release) {
+        stream->release(stream);
+    }
+
+    return state;
+}
+
+// Decode a complete IPC stream held in WASM memory and write it to a table
+static duckdb_state IngestArrowIpcBuffer(
     duckdb_connection connection,
     const char *table_name,
     const uint8_t *ipc_buffer,
-    size_t buffer_length
+    size_t buffer_length,
+    IngestMode mode,
+    std::string &error
 ) {
     if (!connection || !table_name || !ipc_buffer || buffer_length == 0) {
+        error = "Empty Arrow IPC buffer";
         return DuckDBError;
     }
 
@@ -38,6 +130,7 @@ duckdb_state duckdb_wasm_insert_arrow_ipc(
     int rc = ArrowIpcInputStreamInitBuffer(&input, &buf);
     if (rc != NANOARROW_OK) {
         ArrowBufferReset(&buf);
+        error = "Failed to read the Arrow IPC buffer";
         return DuckDBError;
     }
 
@@ -49,47 +142,316 @@ duckdb_state duckdb_wasm_insert_arrow_ipc(
         if (input.release) {
             input.release(&input);
         }
+        error = "Failed to decode the Arrow IPC stream";
         return DuckDBError;
     }
 
-    // Feed the ArrowArrayStream to DuckDB via duckdb_arrow_scan.
-    // duckdb_arrow_scan expects a duckdb_arrow_stream, which is just
-    // a reinterpret_cast'd ArrowArrayStream* internally.
-    const char *view_name = "__ducklings_arrow_tmp";
-    duckdb_state state = duckdb_arrow_scan(
-        connection,
-        view_name,
-        reinterpret_cast<duckdb_arrow_stream>(&stream)
-    );
+    return IngestArrowStream(connection, table_name, &stream, mode, &error);
+}
 
-    if (state != DuckDBSuccess) {
-        if (stream.release) {
-            stream.release(&stream);
+// Run IngestArrowIpcBuffer, handing a failure's message to the JS side
+static duckdb_state IngestArrowIpcBufferWithError(
+    duckdb_connection connection,
+    const char *table_name,
+    const uint8_t *ipc_buffer,
+    size_t buffer_length,
+    IngestMode mode,
+    char **out_error
+) {
+    std::string error;
+    duckdb_state state = IngestArrowIpcBuffer(connection, table_name, ipc_buffer, buffer_length, mode, error);
+    if (state != DuckDBSuccess && out_error) {
+        *out_error = copy_error(error.empty() ? "Arrow IPC insert failed" : error);
+    }
+    return state;
+}
+
+// ArrowArrayStream over one decoded record batch (or none, for an empty table)
+struct SingleBatchStream {
+    struct ArrowSchema schema;
+    struct ArrowArray array;
+};
+
+static int SingleBatchGetSchema(struct ArrowArrayStream *stream, struct ArrowSchema *out) {
+    auto *data = static_cast<SingleBatchStream *>(stream->private_data);
+    return ArrowSchemaDeepCopy(&data->schema, out);
+}
+
+static int SingleBatchGetNext(struct ArrowArrayStream *stream, struct ArrowArray *out) {
+    auto *data = static_cast<SingleBatchStream *>(stream->private_data);
+    if (data->array.release) {
+        ArrowArrayMove(&data->array, out);
+    } else {
+        out->release = nullptr;
+    }
+    return NANOARROW_OK;
+}
+
+static const char *SingleBatchGetLastError(struct ArrowArrayStream *stream) {
+    (void)stream;
+    return nullptr;
+}
+
+static void SingleBatchRelease(struct ArrowArrayStream *stream) {
+    auto *data = static_cast<SingleBatchStream *>(stream->private_data);
+    if (data->array.release) {
+        data->array.release(&data->array);
+    }
+    if (data->schema.release) {
+        data->schema.release(&data->schema);
+    }
+    delete data;
+    stream->release = nullptr;
+}
+
+// Build a stream from a copy of the schema and (optionally) one batch. Takes ownership of array.
+static int InitSingleBatchStream(struct ArrowArrayStream *out, const struct ArrowSchema *schema,
+                                 struct ArrowArray *array) {
+    auto *data = new SingleBatchStream();
+    data->array.release = nullptr;
+    int rc = ArrowSchemaDeepCopy(schema, &data->schema);
+    if (rc != NANOARROW_OK) {
+        if (array && array->release) {
+            array->release(array);
         }
-        return DuckDBError;
+        delete data;
+        return rc;
+    }
+    if (array) {
+        ArrowArrayMove(array, &data->array);
     }
 
-    // Materialize the view into a table
-    std::string create_sql = std::string("CREATE TABLE IF NOT EXISTS \"") +
-                             table_name +
-                             "\" AS SELECT * FROM \"" +
-                             view_name + "\"";
+    out->get_schema = SingleBatchGetSchema;
+    out->get_next = SingleBatchGetNext;
+    out->get_last_error = SingleBatchGetLastError;
+    out->release = SingleBatchRelease;
+    out->private_data = data;
+    return NANOARROW_OK;
+}
 
-    duckdb_result result;
-    state = duckdb_query(connection, create_sql.c_str(), &result);
-    duckdb_destroy_result(&result);
+struct duckdb_wasm_arrow_ipc_ingest {
+    duckdb_connection connection;
+    std::string table_name;
+    bool append;
+    // Set once the table exists (append mode, or after the first batch created it)
+    bool table_ready;
+    bool end_of_stream;
+    struct ArrowIpcDecoder decoder;
+    // Stream schema; release is null until the schema message has been decoded
+    struct ArrowSchema schema;
+    // Bytes of the message currently being received
+    std::vector<uint8_t> pending;
+    std::string error;
+};
 
-    // Cleanup the temporary view
-    duckdb_result drop_result;
-    duckdb_query(connection, "DROP VIEW IF EXISTS \"__ducklings_arrow_tmp\"", &drop_result);
-    duckdb_destroy_result(&drop_result);
+static duckdb_state IngestFail(duckdb_wasm_arrow_ipc_ingest *ingest, const std::string &message) {
+    ingest->error = message;
+    return DuckDBError;
+}
 
-    // Release the stream
-    if (stream.release) {
-        stream.release(&stream);
+static duckdb_state IngestBatch(duckdb_wasm_arrow_ipc_ingest *ingest, struct ArrowArray *array) {
+    struct ArrowArrayStream stream;
+    if (InitSingleBatchStream(&stream, &ingest->schema, array) != NANOARROW_OK) {
+        return IngestFail(ingest, "Failed to copy Arrow schema");
+    }
+
+    IngestMode mode = ingest->table_ready ? IngestMode::APPEND : IngestMode::CREATE;
+    duckdb_state state = IngestArrowStream(
+        ingest->connection, ingest->table_name.c_str(), &stream, mode, &ingest->error);
+    if (state == DuckDBSuccess) {
+        ingest->table_ready = true;
+    }
+    return state;
+}
+
+// Decode and ingest every complete message in the pending bytes
+static duckdb_state ProcessPendingMessages(duckdb_wasm_arrow_ipc_ingest *ingest) {
+    struct ArrowError error;
+    size_t offset = 0;
+    duckdb_state state = DuckDBSuccess;
+
+    while (!ingest->end_of_stream && state == DuckDBSuccess) {
+        struct ArrowBufferView view;
+        view.data.as_uint8 = ingest->pending.data() + offset;
+        view.size_bytes = static_cast<int64_t>(ingest->pending.size() - offset);
+
+        int32_t prefix_size_bytes = 0;
+        int rc = ArrowIpcDecoderPeekHeader(&ingest->decoder, view, &prefix_size_bytes, &error);
+        if (rc == ENODATA) {
+            // End-of-stream marker; anything after it is ignored
+            ingest->end_of_stream = true;
+            offset = ingest->pending.size();
+            break;
+        }
+        if (rc == ESPIPE) {
+            // Header not fully received yet
+            break;
+        }
+        if (rc != NANOARROW_OK) {
+            state = IngestFail(ingest, error.message);
+            break;
+        }
+
+        int64_t header_size = ingest->decoder.header_size_bytes;
+        if (view.size_bytes < header_size) {
+            break;
+        }
+        struct ArrowBufferView header = view;
+        header.size_bytes = header_size;
+        if (ArrowIpcDecoderDecodeHeader(&ingest->decoder, header, &error) != NANOARROW_OK) {
+            state = IngestFail(ingest, error.message);
+            break;
+        }
+
+        int64_t message_size = header_size + ingest->decoder.body_size_bytes;
+        if (view.size_bytes < message_size) {
+            // Body not fully received yet
+            break;
+        }
+        struct ArrowBufferView body;
+        body.data.as_uint8 = view.data.as_uint8 + header_size;
+        body.size_bytes = ingest->decoder.body_size_bytes;
+
+        switch (ingest->decoder.message_type) {
+        case NANOARROW_IPC_MESSAGE_TYPE_SCHEMA:
+            if (ingest->schema.release) {
+                state = IngestFail(ingest, "Arrow IPC stream contains more than one schema");
+                break;
+            }
+            if (ArrowIpcDecoderDecodeSchema(&ingest->decoder, &ingest->schema, &error) != NANOARROW_OK ||
+                ArrowIpcDecoderSetSchema(&ingest->decoder, &ingest->schema, &error) != NANOARROW_OK) {
+                state = IngestFail(ingest, error.message);
+            }
+            break;
+        case NANOARROW_IPC_MESSAGE_TYPE_RECORD_BATCH: {
+            if (!ingest->schema.release) {
+                state = IngestFail(ingest, "Arrow IPC record batch received before the schema");
+                break;
+            }
+            // Decoding copies the body, so the pending bytes can be dropped afterwards
+            struct ArrowArray array;
+            if (ArrowIpcDecoderDecodeArray(&ingest->decoder, body, -1, &array,
+                                           NANOARROW_VALIDATION_LEVEL_FULL, &error) != NANOARROW_OK) {
+                state = IngestFail(ingest, error.message);
+                break;
+            }
+            state = IngestBatch(ingest, &array);
+            break;
+        }
+        default:
+            state = IngestFail(ingest, "Unsupported Arrow IPC message (dictionary batches are not supported)");
+            break;
+        }
+
+        offset += static_cast<size_t>(message_size);
     }
 
+    ingest->pending.erase(ingest->pending.begin(), ingest->pending.begin() + offset);
     return state;
 }
 
+extern "C" {
+
+duckdb_state duckdb_wasm_insert_arrow_ipc(
+    duckdb_connection connection,
+    const char *table_name,
+    const uint8_t *ipc_buffer,
+    size_t buffer_length,
+    char **out_error
+) {
+    return IngestArrowIpcBufferWithError(connection, table_name, ipc_buffer, buffer_length,
+                                         IngestMode::CREATE_IF_NOT_EXISTS, out_error);
+}
+
+duckdb_state duckdb_wasm_append_arrow_ipc(
+    duckdb_connection connection,
+    const char *table_name,
+    const uint8_t *ipc_buffer,
+    size_t buffer_length,
+    char **out_error
+) {
+    return IngestArrowIpcBufferWithError(connection, table_name, ipc_buffer, buffer_length,
+                                         IngestMode::APPEND, out_error);
+}
+
+duckdb_wasm_arrow_ipc_ingest *duckdb_wasm_arrow_ipc_ingest_open(
+    duckdb_connection connection,
+    const char *table_name,
+    int append
+) {
+    if (!connection || !table_name) {
+        return nullptr;
+    }
+
+    auto *ingest = new duckdb_wasm_arrow_ipc_ingest();
+    ingest->connection = connection;
+    ingest->table_name = table_name;
+    ingest->append = append != 0;
+    ingest->table_ready = ingest->append;
+    ingest->end_of_stream = false;
+    ingest->schema.release = nullptr;
+    if (ArrowIpcDecoderInit(&ingest->decoder) != NANOARROW_OK) {
+        delete ingest;
+        return nullptr;
+    }
+    return ingest;
+}
+
+duckdb_state duckdb_wasm_arrow_ipc_ingest_push(
+    duckdb_wasm_arrow_ipc_ingest *ingest,
+    const uint8_t *data,
+    size_t length
+) {
+    if (!ingest) {
+        return DuckDBError;
+    }
+    if (!ingest->error.empty()) {
+        return DuckDBError;
+    }
+    if (length == 0 || ingest->end_of_stream) {
+        return DuckDBSuccess;
+    }
+
+    ingest->pending.insert(ingest->pending.end(), data, data + length);
+    return ProcessPendingMessages(ingest);
+}
+
+duckdb_state duckdb_wasm_arrow_ipc_ingest_finish(duckdb_wasm_arrow_ipc_ingest *ingest) {
+    if (!ingest) {
+        return DuckDBError;
+    }
+    if (!ingest->error.empty()) {
+        return DuckDBError;
+    }
+    if (!ingest->pending.empty()) {
+        return IngestFail(ingest, "Arrow IPC stream ended in the middle of a message");
+    }
+    if (!ingest->schema.release) {
+        return IngestFail(ingest, "Arrow IPC stream contains no schema");
+    }
+    if (!ingest->table_ready) {
+        // Schema but no batches: create the empty table
+        return IngestBatch(ingest, nullptr);
+    }
+    return DuckDBSuccess;
+}
+
+const char *duckdb_wasm_arrow_ipc_ingest_error(duckdb_wasm_arrow_ipc_ingest *ingest) {
+    if (!ingest || ingest->error.empty()) {
+        return nullptr;
+    }
+    return ingest->error.c_str();
+}
+
+void duckdb_wasm_arrow_ipc_ingest_destroy(duckdb_wasm_arrow_ipc_ingest *ingest) {
+    if (!ingest) {
+        return;
+    }
+    ArrowIpcDecoderReset(&ingest->decoder);
+    if (ingest->schema.release) {
+        ingest->schema.release(&ingest->schema);
+    }
+    delete ingest;
+}
+
 } // extern "C"
@@ -12,21 +12,103 @@ extern "C" {
  * Insert Arrow IPC stream bytes into a DuckDB table.
  *
  * Uses nanoarrow to decode the IPC bytes into an ArrowArrayStream,
- * then feeds it to duckdb_arrow_scan to materialize into a table.
+ * then binds it directly to the arrow_scan table function to materialize
+ * into a table. No temporary view is registered, so calls on different
+ * connections can run concurrently.
  *
  * @param connection  Active DuckDB connection
  * @param table_name  Name of the table to create (CREATE TABLE IF NOT EXISTS ... AS SELECT *)
  * @param ipc_buffer  Pointer to Arrow IPC stream bytes in WASM heap
  * @param buffer_length  Length of the IPC buffer in bytes
+ * @param out_error   Receives a malloc'd error message on failure (caller frees), or NULL
  * @return DuckDBSuccess on success, DuckDBError on failure
  */
 duckdb_state duckdb_wasm_insert_arrow_ipc(
     duckdb_connection connection,
     const char *table_name,
     const uint8_t *ipc_buffer,
-    size_t buffer_length
+    size_t buffer_length,
+    char **out_error
 );
 
+/**
+ * Append Arrow IPC stream bytes to an existing DuckDB table.
+ *
+ * Same as duckdb_wasm_insert_arrow_ipc, but runs INSERT INTO ... SELECT *
+ * so the record batches are added to the rows already in the table.
+ *
+ * @param connection  Active DuckDB connection
+ * @param table_name  Name of an existing table with compatible columns
+ * @param ipc_buffer  Pointer to Arrow IPC stream bytes in WASM heap
+ * @param buffer_length  Length of the IPC buffer in bytes
+ * @param out_error   Receives a malloc'd error message on failure (caller frees), or NULL
+ * @return DuckDBSuccess on success, DuckDBError on failure
+ */
+duckdb_state duckdb_wasm_append_arrow_ipc(
+    duckdb_connection connection,
+    const char *table_name,
+    const uint8_t *ipc_buffer,
+    size_t buffer_length,
+    char **out_error
+);
+
+/**
+ * Incremental Arrow IPC ingest.
+ *
+ * Bytes of an IPC stream are pushed in pieces of any size. Each complete
+ * record batch is decoded and written to the table as soon as it arrives,
+ * so only one message is buffered at a time instead of the whole stream.
+ */
+typedef struct duckdb_wasm_arrow_ipc_ingest duckdb_wasm_arrow_ipc_ingest;
+
+/**
+ * Start an incremental ingest into a table.
+ *
+ * @param connection  Active DuckDB connection
+ * @param table_name  Target table name
+ * @param append  Non-zero to append to an existing table; zero to create the
+ *                table from the stream schema (fails if it already exists)
+ * @return Ingest handle, or NULL on invalid arguments
+ */
+duckdb_wasm_arrow_ipc_ingest *duckdb_wasm_arrow_ipc_ingest_open(
+    duckdb_connection connection,
+    const char *table_name,
+    int append
+);
+
+/**
+ * Push the next bytes of the IPC stream.
+ *
+ * The bytes are copied; the caller may free them after the call returns.
+ *
+ * @return DuckDBSuccess on success, DuckDBError on failure (see duckdb_wasm_arrow_ipc_ingest_error)
+ */
+duckdb_state duckdb_wasm_arrow_ipc_ingest_push(
+    duckdb_wasm_arrow_ipc_ingest *ingest,
+    const uint8_t *data,
+    size_t length
+);
+
+/**
+ * Finish the ingest, failing if the stream ended in the middle of a message.
+ * Creates an empty table when the stream held a schema but no batches.
+ *
+ * @return DuckDBSuccess on success, DuckDBError on failure (see duckdb_wasm_arrow_ipc_ingest_error)
+ */
+duckdb_state duckdb_wasm_arrow_ipc_ingest_finish(duckdb_wasm_arrow_ipc_ingest *ingest);
+
+/**
+ * Get the error message of the last failed push or finish.
+ *
+ * @return Error message owned by the ingest, or NULL if there was no error
+ */
+const char *duckdb_wasm_arrow_ipc_ingest_error(duckdb_wasm_arrow_ipc_ingest *ingest);
+
+/**
+ * Destroy an ingest handle. Batches already written stay in the table.
+ */
+void duckdb_wasm_arrow_ipc_ingest_destroy(duckdb_wasm_arrow_ipc_ingest *ingest);
+
 #ifdef __cplusplus
 }
 #endif
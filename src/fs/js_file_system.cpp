@@ -0,0 +1,312 @@
+#include "js_file_system.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/virtual_file_system.hpp"
+#include "duckdb/main/config.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+// ============================================================================
+// External JavaScript functions (defined in js_files.js)
+// File ids are positive; 0 means the path is not registered, negative values are errors
+// ============================================================================
+
+// em_js_file_read result for files that can only be read asynchronously (e.g. a Blob or
+// an R2 object in Workers); those are read through the suspending em_js_file_read_async
+static constexpr int JS_FILE_READ_ASYNC = -2;
+
+extern "C" {
+    extern int em_js_file_handles(const char *path);
+    extern int em_js_file_exists(const char *path);
+    extern int em_js_file_is_pipe(const char *path);
+    extern int em_js_file_open(const char *path, int create);
+    extern int em_js_file_resolve_async(const char *path);
+    extern int em_js_file_list_async(const char *prefix);
+    extern int em_js_file_read(int file_id, void *buffer, int nr_bytes, double offset);
+    extern int em_js_file_read_async(int file_id, void *buffer, int nr_bytes, double offset);
+    extern int em_js_file_write(int file_id, const void *buffer, int nr_bytes, double offset);
+    extern double em_js_file_size(int file_id);
+    extern double em_js_file_modified(int file_id);
+    extern int em_js_file_truncate(int file_id, double new_size);
+    extern int em_js_file_sync(int file_id);
+    extern int em_js_file_remove(const char *path);
+    extern int em_js_file_move(const char *source, const char *target);
+    extern char *em_js_file_list(const char *prefix);
+}
+
+class JSFileHandle : public FileHandle {
+public:
+    JSFileHandle(FileSystem &file_system, const string &path, FileOpenFlags flags, int file_id)
+        : FileHandle(file_system, path, flags), file_id(file_id) {
+    }
+
+    void Close() override {
+        // The JS host owns the underlying file and closes it when it is unregistered
+    }
+
+    int file_id;
+    idx_t position = 0;
+};
+
+static JSFileHandle &CastHandle(FileHandle &handle) {
+    return handle.Cast<JSFileHandle>();
+}
+
+static int ReadFromJS(int file_id, void *buffer, int nr_bytes, double offset) {
+    int bytes_read = em_js_file_read(file_id, buffer, nr_bytes, offset);
+    if (bytes_read == JS_FILE_READ_ASYNC) {
+        bytes_read = em_js_file_read_async(file_id, buffer, nr_bytes, offset);
+    }
+    return bytes_read;
+}
+
+unique_ptr<FileHandle> JSFileSystem::OpenFile(const string &path, FileOpenFlags flags,
+                                              optional_ptr<FileOpener> opener) {
+    bool create = flags.CreateFileIfNotExists() || flags.OverwriteExistingFile();
+    if (!create) {
+        em_js_file_resolve_async(path.c_str());
+    }
+    int file_id = em_js_file_open(path.c_str(), create ? 1 : 0);
+    if (file_id <= 0) {
+        if (file_id == 0 && flags.ReturnNullIfNotExists()) {
+            return nullptr;
+        }
+        throw IOException("Cannot open file \"%s\": %s", path,
+                          file_id == 0 ? "no such file is registered" : "the JS host failed to open it");
+    }
+
+    auto handle = make_uniq<JSFileHandle>(*this, path, flags, file_id);
+    if (flags.OverwriteExistingFile()) {
+        Truncate(*handle, 0);
+    } else if (flags.OpenForAppending()) {
+        handle->position = NumericCast<idx_t>(GetFileSize(*handle));
+    }
+    return std::move(handle);
+}
+
+void JSFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+    auto &js_handle = CastHandle(handle);
+    int bytes_read = ReadFromJS(js_handle.file_id, buffer, (int)nr_bytes, (double)location);
+    if (bytes_read != nr_bytes) {
+        throw IOException("Could not read all bytes from file \"%s\": wanted=%lld read=%lld", handle.path,
+                          nr_bytes, (int64_t)bytes_read);
+    }
+}
+
+void JSFileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+    auto &js_handle = CastHandle(handle);
+    int bytes_written = em_js_file_write(js_handle.file_id, buffer, (int)nr_bytes, (double)location);
+    if (bytes_written != nr_bytes) {
+        throw IOException("Could not write all bytes to file \"%s\": wanted=%lld wrote=%lld", handle.path,
+                          nr_bytes, (int64_t)bytes_written);
+    }
+}
+
+int64_t JSFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes) {
+    auto &js_handle = CastHandle(handle);
+    int bytes_read = ReadFromJS(js_handle.file_id, buffer, (int)nr_bytes, (double)js_handle.position);
+    if (bytes_read < 0) {
+        throw IOException("Could not read from file \"%s\"", handle.path);
+    }
+    js_handle.position += bytes_read;
+    return bytes_read;
+}
+
+int64_t JSFileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes) {
+    auto &js_handle = CastHandle(handle);
+    Write(handle, buffer, nr_bytes, js_handle.position);
+    js_handle.position += nr_bytes;
+    return nr_bytes;
+}
+
+int64_t JSFileSystem::GetFileSize(FileHandle &handle) {
+    double size = em_js_file_size(CastHandle(handle).file_id);
+    if (size < 0) {
+        throw IOException("Could not get the size of file \"%s\"", handle.path);
+    }
+    return (int64_t)size;
+}
+
+timestamp_t JSFileSystem::GetLastModifiedTime(FileHandle &handle) {
+    return Timestamp::FromEpochMs((int64_t)em_js_file_modified(CastHandle(handle).file_id));
+}
+
+FileType JSFileSystem::GetFileType(FileHandle &handle) {
+    return FileType::FILE_TYPE_REGULAR;
+}
+
+void JSFileSystem::Truncate(FileHandle &handle, int64_t new_size) {
+    auto &js_handle = CastHandle(handle);
+    if (em_js_file_truncate(js_handle.file_id, (double)new_size) != 0) {
+        throw IOException("Could not truncate file \"%s\"", handle.path);
+    }
+    js_handle.position = MinValue<idx_t>(js_handle.position, NumericCast<idx_t>(new_size));
+}
+
+void JSFileSystem::FileSync(FileHandle &handle) {
+    if (em_js_file_sync(CastHandle(handle).file_id) != 0) {
+        throw IOException("Could not sync file \"%s\"", handle.path);
+    }
+}
+
+void JSFileSystem::Seek(FileHandle &handle, idx_t location) {
+    CastHandle(handle).position = location;
+}
+
+idx_t JSFileSystem::SeekPosition(FileHandle &handle) {
+    return CastHandle(handle).position;
+}
+
+bool JSFileSystem::DirectoryExists(const string &directory, optional_ptr<FileOpener> opener) {
+    return em_js_file_handles(directory.c_str()) == 1;
+}
+
+void JSFileSystem::CreateDirectory(const string &directory, optional_ptr<FileOpener> opener) {
+}
+
+void JSFileSystem::RemoveDirectory(const string &directory, optional_ptr<FileOpener> opener) {
+    for (auto &path : ListPaths(directory + "/")) {
+        em_js_file_remove(path.c_str());
+    }
+}
+
+bool JSFileSystem::ListFiles(const string &directory, const std::function<void(const string &, bool)> &callback,
+                             FileOpener *opener) {
+    auto prefix = StringUtil::EndsWith(directory, "/") ? directory : directory + "/";
+    for (auto &path : ListPaths(prefix)) {
+        auto name = path.substr(prefix.size());
+        auto slash = name.find('/');
+        if (slash == string::npos) {
+            callback(name, false);
+        }
+    }
+    return true;
+}
+
+bool JSFileSystem::FileExists(const string &filename, optional_ptr<FileOpener> opener) {
+    // Paths under a resolver prefix are looked up on demand; others answer without suspending
+    em_js_file_resolve_async(filename.c_str());
+    return em_js_file_exists(filename.c_str()) == 1;
+}
+
+void JSFileSystem::MoveFile(const string &source, const string &target, optional_ptr<FileOpener> opener) {
+    if (em_js_file_move(source.c_str(), target.c_str()) != 1) {
+        throw IOException("Could not move file \"%s\" to \"%s\"", source, target);
+    }
+}
+
+void JSFileSystem::RemoveFile(const string &filename, optional_ptr<FileOpener> opener) {
+    if (!TryRemoveFile(filename, opener)) {
+        throw IOException("Could not remove file \"%s\": no such file is registered", filename);
+    }
+}
+
+bool JSFileSystem::TryRemoveFile(const string &filename, optional_ptr<FileOpener> opener) {
+    return em_js_file_remove(filename.c_str()) == 1;
+}
+
+// Match a path against a glob pattern: '*' and '?' stay within one path segment, '**' crosses them
+static bool GlobMatch(const char *str, const char *pattern) {
+    while (*pattern) {
+        if (pattern[0] == '*' && pattern[1] == '*') {
+            pattern += 2;
+            for (const char *s = str;; s++) {
+                if (GlobMatch(s, pattern)) {
+                    return true;
+                }
+                if (!*s) {
+                    return false;
+                }
+            }
+        }
+        if (*pattern == '*') {
+            pattern++;
+            for (const char *s = str;; s++) {
+                if (GlobMatch(s, pattern)) {
+                    return true;
+                }
+                if (!*s || *s == '/') {
+                    return false;
+                }
+            }
+        }
+        if (!*str || (*pattern != '?' && *pattern != *str) || (*pattern == '?' && *str == '/')) {
+            return false;
+        }
+        pattern++;
+        str++;
+    }
+    return !*str;
+}
+
+vector<OpenFileInfo> JSFileSystem::Glob(const string &path, FileOpener *opener) {
+    vector<OpenFileInfo> result;
+    if (!FileSystem::HasGlob(path)) {
+        if (FileExists(path)) {
+            result.emplace_back(path);
+        }
+        return result;
+    }
+    // Only the part before the first wildcard narrows the listing
+    auto prefix = path.substr(0, path.find_first_of("*?["));
+    for (auto &candidate : ListPaths(prefix)) {
+        if (GlobMatch(candidate.c_str(), path.c_str())) {
+            result.emplace_back(candidate);
+        }
+    }
+    return result;
+}
+
+bool JSFileSystem::IsPipe(const string &filename, optional_ptr<FileOpener> opener) {
+    return em_js_file_is_pipe(filename.c_str()) == 1;
+}
+
+bool JSFileSystem::CanHandleFile(const string &fpath) {
+    return em_js_file_handles(fpath.c_str()) == 1;
+}
+
+vector<string> JSFileSystem::ListPaths(const string &prefix) {
+    vector<string> paths;
+    // Let a resolver register what it has below prefix first (e.g. a bound R2 bucket listing)
+    if (em_js_file_list_async(prefix.c_str()) < 0) {
+        throw IOException("Could not list files below \"%s\"", prefix);
+    }
+    char *block = em_js_file_list(prefix.c_str());
+    if (!block) {
+        return paths;
+    }
+    // 4-byte little-endian length followed by NUL-terminated paths
+    auto bytes = reinterpret_cast<const uint8_t *>(block);
+    uint32_t len = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+    const char *pos = block + 4;
+    const char *end = pos + len;
+    while (pos < end) {
+        auto path_end = (const char *)memchr(pos, '\0', end - pos);
+        if (!path_end) {
+            break;
+        }
+        paths.emplace_back(pos, path_end - pos);
+        pos = path_end + 1;
+    }
+    free(block);
+    return paths;
+}
+
+} // namespace duckdb
+
+extern "C" {
+
+void duckdb_wasm_fs_configure(duckdb_config config) {
+    if (!config) {
+        return;
+    }
+    auto &db_config = *reinterpret_cast<duckdb::DBConfig *>(config);
+    auto fs = duckdb::make_uniq<duckdb::VirtualFileSystem>();
+    fs->RegisterSubSystem(duckdb::make_uniq<duckdb::JSFileSystem>());
+    db_config.file_system = std::move(fs);
+}
+
+} // extern "C"
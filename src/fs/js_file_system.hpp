@@ -0,0 +1,70 @@
+#pragma once
+
+#include "duckdb.h"
+#include "duckdb/common/file_system.hpp"
+
+namespace duckdb {
+
+// File system over files that the JS host registers in the worker (see js_files.js),
+// e.g. OPFS FileSystemSyncAccessHandles behind opfs:// paths or registered Blobs. Every
+// read and write is a positional call into JS, so files are never copied into the WASM
+// heap as a whole.
+class JSFileSystem : public FileSystem {
+public:
+    unique_ptr<FileHandle> OpenFile(const string &path, FileOpenFlags flags,
+                                    optional_ptr<FileOpener> opener = nullptr) override;
+
+    void Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
+    void Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
+    int64_t Read(FileHandle &handle, void *buffer, int64_t nr_bytes) override;
+    int64_t Write(FileHandle &handle, void *buffer, int64_t nr_bytes) override;
+
+    int64_t GetFileSize(FileHandle &handle) override;
+    timestamp_t GetLastModifiedTime(FileHandle &handle) override;
+    FileType GetFileType(FileHandle &handle) override;
+    void Truncate(FileHandle &handle, int64_t new_size) override;
+    void FileSync(FileHandle &handle) override;
+
+    void Seek(FileHandle &handle, idx_t location) override;
+    idx_t SeekPosition(FileHandle &handle) override;
+    bool CanSeek() override {
+        return true;
+    }
+    bool OnDiskFile(FileHandle &handle) override {
+        return true;
+    }
+    // Stream-backed files can only be read front to back, like a pipe
+    bool IsPipe(const string &filename, optional_ptr<FileOpener> opener = nullptr) override;
+
+    // Directories are implicit: a directory exists while files are registered below it
+    bool DirectoryExists(const string &directory, optional_ptr<FileOpener> opener = nullptr) override;
+    void CreateDirectory(const string &directory, optional_ptr<FileOpener> opener = nullptr) override;
+    void RemoveDirectory(const string &directory, optional_ptr<FileOpener> opener = nullptr) override;
+    bool ListFiles(const string &directory, const std::function<void(const string &, bool)> &callback,
+                   FileOpener *opener = nullptr) override;
+
+    bool FileExists(const string &filename, optional_ptr<FileOpener> opener = nullptr) override;
+    void MoveFile(const string &source, const string &target, optional_ptr<FileOpener> opener = nullptr) override;
+    void RemoveFile(const string &filename, optional_ptr<FileOpener> opener = nullptr) override;
+    bool TryRemoveFile(const string &filename, optional_ptr<FileOpener> opener = nullptr) override;
+
+    vector<OpenFileInfo> Glob(const string &path, FileOpener *opener = nullptr) override;
+
+    bool CanHandleFile(const string &fpath) override;
+
+    std::string GetName() const override {
+        return "JSFileSystem";
+    }
+
+private:
+    // Registered paths starting with prefix, as returned by em_js_file_list
+    static vector<string> ListPaths(const string &prefix);
+};
+
+} // namespace duckdb
+
+extern "C" {
+// Install a virtual file system with JSFileSystem registered on a config before
+// duckdb_open_ext, so the database file itself can live on a JS-backed path
+void duckdb_wasm_fs_configure(duckdb_config config);
+}
@@ -0,0 +1,446 @@
+// JavaScript-backed files for JSFileSystem (js_file_system.cpp)
+// This file is included via --js-library in the Emscripten build.
+//
+// The host registers file objects under DuckDB paths through Module.jsFiles. A file
+// object implements the synchronous subset of FileSystemSyncAccessHandle:
+//   read(view, { at }) / write(view, { at }) -> bytes, getSize(), truncate(size), flush()
+// Read-only sources that can only be read asynchronously (Blobs and R2 objects in
+// Workers) implement readAsync(at, length) -> Promise<Uint8Array> instead of read().
+// Streams that can only be read front to back also set sequential: true.
+// Path prefixes (e.g. "opfs://") can also get a creator that returns a new file object
+// for paths DuckDB creates on its own, such as spill files in temp_directory.
+// Read-only sources with many files (an R2 bucket binding in Workers) get a resolver
+// instead, which looks files up when DuckDB first opens or globs them.
+//
+// In the multithreaded build the imports are proxied to the thread that owns the handles.
+
+mergeInto(LibraryManager.library, {
+    $JSFiles__postset: 'Module["jsFiles"] = JSFiles;',
+    $JSFiles: {
+        nextId: 1,
+        // path -> { id, file, exists, modified, created }
+        entries: {},
+        // id -> entry
+        byId: {},
+        // path prefix -> function(path) returning a file object, or null when none is available
+        creators: {},
+        // path prefix -> { open(path) -> Promise<file|null>, list(prefix) -> Promise<[{ path, file }]>,
+        //                  ttl: ms a looked up file is used before it is looked up again }
+        resolvers: {},
+
+        // Register a file object under a path; exists=false registers a file DuckDB may create
+        register: function(path, file, exists) {
+            JSFiles.unregister(path);
+            var entry = {
+                id: JSFiles.nextId++,
+                path: path,
+                file: file,
+                exists: exists !== false,
+                modified: Date.now(),
+                created: false
+            };
+            JSFiles.entries[path] = entry;
+            JSFiles.byId[entry.id] = entry;
+            return entry.id;
+        },
+
+        // Remove a path, returning its file object to the host (which closes it)
+        unregister: function(path) {
+            var entry = JSFiles.entries[path];
+            if (!entry) return null;
+            delete JSFiles.entries[path];
+            delete JSFiles.byId[entry.id];
+            return entry.file;
+        },
+
+        // Remove every path, returning their file objects
+        unregisterAll: function() {
+            var files = [];
+            for (var path in JSFiles.entries) {
+                files.push(JSFiles.entries[path].file);
+            }
+            JSFiles.entries = {};
+            JSFiles.byId = {};
+            return files;
+        },
+
+        // Set (or clear, with null) the creator for a path prefix
+        setCreator: function(prefix, creator) {
+            if (creator) {
+                JSFiles.creators[prefix] = creator;
+            } else {
+                delete JSFiles.creators[prefix];
+            }
+        },
+
+        creatorFor: function(path) {
+            for (var prefix in JSFiles.creators) {
+                if (path.lastIndexOf(prefix, 0) === 0) return JSFiles.creators[prefix];
+            }
+            return null;
+        },
+
+        // Set (or clear, with null) the resolver for a path prefix. Clearing it removes the
+        // files it looked up and closes them.
+        setResolver: function(prefix, resolver) {
+            if (resolver) {
+                JSFiles.resolvers[prefix] = resolver;
+                return;
+            }
+            delete JSFiles.resolvers[prefix];
+            for (var path in JSFiles.entries) {
+                if (JSFiles.entries[path].resolvedAt !== undefined && path.lastIndexOf(prefix, 0) === 0) {
+                    var file = JSFiles.unregister(path);
+                    if (file && file.close) file.close();
+                }
+            }
+        },
+
+        resolverFor: function(path) {
+            for (var prefix in JSFiles.resolvers) {
+                if (path.lastIndexOf(prefix, 0) === 0) return JSFiles.resolvers[prefix];
+            }
+            return null;
+        },
+
+        // Register or refresh a file a resolver looked up. A refreshed path keeps its id,
+        // so handles DuckDB already holds read the current file object.
+        adopt: function(path, file) {
+            var entry = JSFiles.entries[path];
+            if (entry && entry.resolvedAt !== undefined) {
+                entry.file = file;
+            } else {
+                JSFiles.register(path, file, true);
+                entry = JSFiles.entries[path];
+            }
+            entry.exists = true;
+            entry.resolvedAt = Date.now();
+        },
+
+        // Heap view passed to a file object's read()/write()
+        view: function(ptr, len) {
+            return HEAPU8.subarray(ptr, ptr + len);
+        }
+    },
+
+    // 1 if JSFileSystem should handle this path (registered, or under a creator prefix)
+    em_js_file_handles__deps: ['$JSFiles'],
+    em_js_file_handles__proxy: 'sync',
+    em_js_file_handles: function(path_ptr) {
+        var path = UTF8ToString(path_ptr);
+        if (JSFiles.entries[path] || JSFiles.creatorFor(path) || JSFiles.resolverFor(path)) return 1;
+        for (var registered in JSFiles.entries) {
+            if (registered.lastIndexOf(path + "/", 0) === 0) return 1;
+        }
+        return 0;
+    },
+
+    em_js_file_exists__deps: ['$JSFiles'],
+    em_js_file_exists__proxy: 'sync',
+    em_js_file_exists: function(path_ptr) {
+        var entry = JSFiles.entries[UTF8ToString(path_ptr)];
+        return entry && entry.exists ? 1 : 0;
+    },
+
+    // Open a path: returns its file id, 0 if there is no such file, -1 on failure
+    em_js_file_open__deps: ['$JSFiles', '$DucklingsLog'],
+    em_js_file_open__proxy: 'sync',
+    em_js_file_open: function(path_ptr, create) {
+        var path = UTF8ToString(path_ptr);
+        var entry = JSFiles.entries[path];
+        if (!entry && create) {
+            var creator = JSFiles.creatorFor(path);
+            if (creator) {
+                try {
+                    var file = creator(path);
+                    if (!file) {
+                        DucklingsLog.error("No file available to create", path);
+                        return -1;
+                    }
+                    JSFiles.register(path, file, true);
+                    entry = JSFiles.entries[path];
+                    entry.created = true;
+                } catch (error) {
+                    DucklingsLog.error("Creating file failed:", path, error);
+                    return -1;
+                }
+            }
+        }
+        if (!entry) return 0;
+        if (!entry.exists) {
+            if (!create) return 0;
+            entry.exists = true;
+            entry.modified = Date.now();
+        }
+        return entry.id;
+    },
+
+    // 1 for stream-backed files, which DuckDB must read sequentially
+    em_js_file_is_pipe__deps: ['$JSFiles'],
+    em_js_file_is_pipe__proxy: 'sync',
+    em_js_file_is_pipe: function(path_ptr) {
+        var entry = JSFiles.entries[UTF8ToString(path_ptr)];
+        return entry && entry.file.sequential ? 1 : 0;
+    },
+
+    // Returns -2 for files that only implement readAsync (see em_js_file_read_async)
+    em_js_file_read__deps: ['$JSFiles', '$DucklingsLog'],
+    em_js_file_read__proxy: 'sync',
+    em_js_file_read: function(file_id, buffer_ptr, nr_bytes, offset) {
+        var entry = JSFiles.byId[file_id];
+        if (!entry) return -1;
+        if (!entry.file.read) return entry.file.readAsync ? -2 : -1;
+        try {
+            var total = 0;
+            while (total < nr_bytes) {
+                var n = entry.file.read(JSFiles.view(buffer_ptr + total, nr_bytes - total), { at: offset + total });
+                if (n <= 0) break;
+                total += n;
+            }
+            return total;
+        } catch (error) {
+            DucklingsLog.error("File read error:", entry.path, error);
+            return -1;
+        }
+    },
+
+    // Suspends until readAsync resolves; only reachable in the Asyncify and JSPI workers builds.
+    // The heap view is taken after each await since memory may have grown in between.
+    em_js_file_read_async__deps: ['$JSFiles', '$DucklingsLog'],
+    em_js_file_read_async__async: true,
+    em_js_file_read_async: function(file_id, buffer_ptr, nr_bytes, offset) {
+        var entry = JSFiles.byId[file_id];
+        if (!entry || !entry.file.readAsync) return -1;
+        return Asyncify.handleAsync(async function() {
+            try {
+                var total = 0;
+                while (total < nr_bytes) {
+                    var bytes = await entry.file.readAsync(offset + total, nr_bytes - total);
+                    if (!bytes || bytes.length === 0) break;
+                    var n = Math.min(bytes.length, nr_bytes - total);
+                    HEAPU8.set(bytes.subarray(0, n), buffer_ptr + total);
+                    total += n;
+                }
+                return total;
+            } catch (error) {
+                DucklingsLog.error("File read error:", entry.path, error);
+                return -1;
+            }
+        });
+    },
+
+    // Look up a path under a resolver prefix that is not registered yet, or whose lookup is
+    // older than the resolver's ttl. Returns 1 if the path is a file afterwards; other paths
+    // return 0 without suspending.
+    em_js_file_resolve_async__deps: ['$JSFiles', '$DucklingsLog'],
+    em_js_file_resolve_async__async: true,
+    em_js_file_resolve_async: function(path_ptr) {
+        var path = UTF8ToString(path_ptr);
+        var resolver = JSFiles.resolverFor(path);
+        if (!resolver) return 0;
+        var entry = JSFiles.entries[path];
+        if (entry && entry.resolvedAt === undefined) return entry.exists ? 1 : 0;
+        if (entry && Date.now() - entry.resolvedAt < (resolver.ttl || 0)) return 1;
+        return Asyncify.handleAsync(async function() {
+            try {
+                var file = await resolver.open(path);
+                if (!file) {
+                    if (entry) entry.exists = false;
+                    return 0;
+                }
+                JSFiles.adopt(path, file);
+                return 1;
+            } catch (error) {
+                DucklingsLog.error("File lookup failed:", path, error);
+                return 0;
+            }
+        });
+    },
+
+    // Register the files a resolver lists under prefix, so a glob sees them.
+    // Returns the number of files listed, or -1 on failure.
+    em_js_file_list_async__deps: ['$JSFiles', '$DucklingsLog'],
+    em_js_file_list_async__async: true,
+    em_js_file_list_async: function(prefix_ptr) {
+        var prefix = UTF8ToString(prefix_ptr);
+        var resolver = JSFiles.resolverFor(prefix);
+        if (!resolver || !resolver.list) return 0;
+        return Asyncify.handleAsync(async function() {
+            try {
+                var files = await resolver.list(prefix);
+                var listed = {};
+                for (var i = 0; i < files.length; i++) {
+                    JSFiles.adopt(files[i].path, files[i].file);
+                    listed[files[i].path] = true;
+                }
+                // Files looked up earlier that are gone from the source now
+                for (var path in JSFiles.entries) {
+                    var entry = JSFiles.entries[path];
+                    if (entry.resolvedAt !== undefined && !listed[path] && path.lastIndexOf(prefix, 0) === 0) {
+                        entry.exists = false;
+                    }
+                }
+                return files.length;
+            } catch (error) {
+                DucklingsLog.error("File listing failed:", prefix, error);
+                return -1;
+            }
+        });
+    },
+
+    em_js_file_write__deps: ['$JSFiles', '$DucklingsLog'],
+    em_js_file_write__proxy: 'sync',
+    em_js_file_write: function(file_id, buffer_ptr, nr_bytes, offset) {
+        var entry = JSFiles.byId[file_id];
+        if (!entry || !entry.file.write) return -1;
+        try {
+            var total = 0;
+            while (total < nr_bytes) {
+                var n = entry.file.write(JSFiles.view(buffer_ptr + total, nr_bytes - total), { at: offset + total });
+                if (n <= 0) break;
+                total += n;
+            }
+            entry.modified = Date.now();
+            return total;
+        } catch (error) {
+            DucklingsLog.error("File write error:", entry.path, error);
+            return -1;
+        }
+    },
+
+    em_js_file_size__deps: ['$JSFiles', '$DucklingsLog'],
+    em_js_file_size__proxy: 'sync',
+    em_js_file_size: function(file_id) {
+        var entry = JSFiles.byId[file_id];
+        if (!entry) return -1;
+        try {
+            return entry.file.getSize();
+        } catch (error) {
+            DucklingsLog.error("File size error:", entry.path, error);
+            return -1;
+        }
+    },
+
+    em_js_file_modified__deps: ['$JSFiles'],
+    em_js_file_modified__proxy: 'sync',
+    em_js_file_modified: function(file_id) {
+        var entry = JSFiles.byId[file_id];
+        return entry ? entry.modified : 0;
+    },
+
+    em_js_file_truncate__deps: ['$JSFiles', '$DucklingsLog'],
+    em_js_file_truncate__proxy: 'sync',
+    em_js_file_truncate: function(file_id, new_size) {
+        var entry = JSFiles.byId[file_id];
+        if (!entry || !entry.file.truncate) return -1;
+        try {
+            entry.file.truncate(new_size);
+            entry.modified = Date.now();
+            return 0;
+        } catch (error) {
+            DucklingsLog.error("File truncate error:", entry.path, error);
+            return -1;
+        }
+    },
+
+    em_js_file_sync__deps: ['$JSFiles', '$DucklingsLog'],
+    em_js_file_sync__proxy: 'sync',
+    em_js_file_sync: function(file_id) {
+        var entry = JSFiles.byId[file_id];
+        if (!entry) return -1;
+        try {
+            if (entry.file.flush) entry.file.flush();
+            return 0;
+        } catch (error) {
+            DucklingsLog.error("File sync error:", entry.path, error);
+            return -1;
+        }
+    },
+
+    // Remove a path: files made by a creator are handed back to it, registered files are
+    // emptied and kept registered so DuckDB can create them again (e.g. the WAL).
+    // Returns 1 if the file existed.
+    em_js_file_remove__deps: ['$JSFiles', '$DucklingsLog'],
+    em_js_file_remove__proxy: 'sync',
+    em_js_file_remove: function(path_ptr) {
+        var path = UTF8ToString(path_ptr);
+        var entry = JSFiles.entries[path];
+        if (!entry || !entry.exists) return 0;
+        try {
+            if (entry.file.truncate) entry.file.truncate(0);
+        } catch (error) {
+            DucklingsLog.warn("Emptying removed file failed:", path, error);
+        }
+        if (entry.created) {
+            var file = JSFiles.unregister(path);
+            if (file.release) file.release();
+        } else {
+            entry.exists = false;
+        }
+        return 1;
+    },
+
+    // Move a file. A registered target keeps its own file object (e.g. a named OPFS file),
+    // so the contents are copied into it; otherwise the source is renamed.
+    em_js_file_move__deps: ['$JSFiles', '$DucklingsLog'],
+    em_js_file_move__proxy: 'sync',
+    em_js_file_move: function(source_ptr, target_ptr) {
+        var source = UTF8ToString(source_ptr);
+        var target = UTF8ToString(target_ptr);
+        var entry = JSFiles.entries[source];
+        if (!entry || !entry.exists) return 0;
+        var targetEntry = JSFiles.entries[target];
+        if (!targetEntry) {
+            delete JSFiles.entries[source];
+            entry.path = target;
+            JSFiles.entries[target] = entry;
+            return 1;
+        }
+        try {
+            var size = entry.file.getSize();
+            var chunk = new Uint8Array(Math.min(size, 1024 * 1024));
+            targetEntry.file.truncate(0);
+            for (var offset = 0; offset < size; offset += chunk.length) {
+                var n = entry.file.read(chunk, { at: offset });
+                targetEntry.file.write(chunk.subarray(0, n), { at: offset });
+            }
+            if (targetEntry.file.flush) targetEntry.file.flush();
+            targetEntry.exists = true;
+            targetEntry.modified = Date.now();
+        } catch (error) {
+            DucklingsLog.error("File move error:", source, target, error);
+            return 0;
+        }
+        if (entry.file.truncate) entry.file.truncate(0);
+        if (entry.created) {
+            var file = JSFiles.unregister(source);
+            if (file.release) file.release();
+        } else {
+            entry.exists = false;
+        }
+        return 1;
+    },
+
+    // List existing paths starting with prefix as a length-prefixed block of NUL-terminated paths
+    em_js_file_list__deps: ['$JSFiles'],
+    em_js_file_list__proxy: 'sync',
+    em_js_file_list: function(prefix_ptr) {
+        var prefix = UTF8ToString(prefix_ptr);
+        var paths = [];
+        for (var path in JSFiles.entries) {
+            if (JSFiles.entries[path].exists && path.lastIndexOf(prefix, 0) === 0) paths.push(path);
+        }
+        var bytes = new TextEncoder().encode(paths.length ? paths.join("\0") + "\0" : "");
+        var len = bytes.length;
+        var resultPtr = _malloc(len + 4);
+        if (!resultPtr) return 0;
+
+        // Store length (little-endian)
+        HEAPU8[resultPtr] = len & 0xFF;
+        HEAPU8[resultPtr + 1] = (len >> 8) & 0xFF;
+        HEAPU8[resultPtr + 2] = (len >> 16) & 0xFF;
+        HEAPU8[resultPtr + 3] = (len >> 24) & 0xFF;
+        HEAPU8.set(bytes, resultPtr + 4);
+        return resultPtr;
+    }
+});
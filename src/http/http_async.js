@@ -1,55 +1,363 @@
 // HTTP async functions for Cloudflare Workers
 // This file is included via --js-library in the Emscripten build
+// Suspending imports are marked __async; Asyncify.handleAsync works in both
+// the Asyncify and the JSPI (JavaScript Promise Integration) workers builds
 
 mergeInto(LibraryManager.library, {
+    // Console output of the HTTP client and the JS-backed files, gated by Module.logLevel
+    // (0 = silent, 1 = error, 2 = warn, 3 = debug). Per-request tracing only runs at debug,
+    // so the default level keeps logging off the request path.
+    $DucklingsLog: {
+        level: function() {
+            var level = Module["logLevel"];
+            return typeof level === "number" ? level : 2;
+        },
+        debug: function() {
+            if (DucklingsLog.level() >= 3) console.log.apply(console, arguments);
+        },
+        warn: function() {
+            if (DucklingsLog.level() >= 2) console.warn.apply(console, arguments);
+        },
+        error: function() {
+            if (DucklingsLog.level() >= 1) console.error.apply(console, arguments);
+        }
+    },
+
+    // Open response body readers of streaming requests, keyed by stream id
+    $HTTPStreams: {
+        nextId: 1,
+        entries: {}
+    },
+
+    // Request and response headers cross the WASM boundary as one packed block:
+    // a 4-byte little-endian byte length followed by name\0value\0 pairs in UTF-8
+    $HTTPHeaderBlock: {
+        decoder: null,
+        encoder: null,
+
+        // Decode a packed header block into a plain headers object with one TextDecoder pass
+        decode: function(block_ptr) {
+            var headers = {};
+            if (!block_ptr) return headers;
+            var len = HEAPU8[block_ptr] | (HEAPU8[block_ptr + 1] << 8) |
+                (HEAPU8[block_ptr + 2] << 16) | (HEAPU8[block_ptr + 3] << 24);
+            if (len <= 0) return headers;
+            var bytes = HEAPU8.subarray(block_ptr + 4, block_ptr + 4 + len);
+            // TextDecoder rejects views on a SharedArrayBuffer (multithreaded build)
+            if (typeof SharedArrayBuffer !== "undefined" && bytes.buffer instanceof SharedArrayBuffer) {
+                bytes = bytes.slice();
+            }
+            if (!HTTPHeaderBlock.decoder) HTTPHeaderBlock.decoder = new TextDecoder();
+            var parts = HTTPHeaderBlock.decoder.decode(bytes).split("\0");
+            for (var i = 0; i + 1 < parts.length; i += 2) {
+                headers[parts[i]] = parts[i + 1];
+            }
+            return headers;
+        },
+
+        // Decode a header block for fetch(), skipping headers the runtime manages itself
+        decodeForFetch: function(block_ptr) {
+            var headers = HTTPHeaderBlock.decode(block_ptr);
+            delete headers["Host"];
+            delete headers["User-Agent"];
+            return headers;
+        },
+
+        // Pack [name, value, name, value, ...] into a malloc'd header block (0 on failure)
+        pack: function(parts) {
+            if (!HTTPHeaderBlock.encoder) HTTPHeaderBlock.encoder = new TextEncoder();
+            var bytes = HTTPHeaderBlock.encoder.encode(parts.length ? parts.join("\0") + "\0" : "");
+            var len = bytes.length;
+            var resultPtr = _malloc(len + 4);
+            if (!resultPtr) return 0;
+
+            // Store length (little-endian)
+            HEAPU8[resultPtr] = len & 0xFF;
+            HEAPU8[resultPtr + 1] = (len >> 8) & 0xFF;
+            HEAPU8[resultPtr + 2] = (len >> 16) & 0xFF;
+            HEAPU8[resultPtr + 3] = (len >> 24) & 0xFF;
+            HEAPU8.set(bytes, resultPtr + 4);
+            return resultPtr;
+        },
+
+        // Pack the header lines of XMLHttpRequest.getAllResponseHeaders()
+        packLines: function(text) {
+            var parts = [];
+            var lines = text.split("\r\n");
+            for (var i = 0; i < lines.length; i++) {
+                var colon = lines[i].indexOf(":");
+                if (colon <= 0) continue;
+                parts.push(lines[i].substring(0, colon), lines[i].substring(colon + 1).replace(/^ +/, ""));
+            }
+            return HTTPHeaderBlock.pack(parts);
+        }
+    },
+
+    // Optional second cache tier that outlives the isolate: a Cache API cache (e.g.
+    // caches.default in Cloudflare Workers) set as Module.httpCache = { cache, ttl, metadataTtl }.
+    // Range blocks are keyed by URL, validator (ETag) and byte range, so a changed object
+    // never hits old blocks; HEAD responses are keyed by URL and expire after metadataTtl.
+    $HTTPEdgeCache__deps: ['$DucklingsLog'],
+    $HTTPEdgeCache: {
+        config: function() {
+            var config = Module["httpCache"];
+            return config && config.cache ? config : null;
+        },
+
+        // Cache API keys are GET requests on http(s) URLs
+        key: function(kind, url, params) {
+            return "https://ducklings.cache/" + kind + "/" + encodeURIComponent(url) + (params ? "?" + params : "");
+        },
+
+        // Resolve to the cached body as an ArrayBuffer, or null on a miss or cache failure
+        match: function(key) {
+            var config = HTTPEdgeCache.config();
+            if (!config) return Promise.resolve(null);
+            return config.cache.match(key).then(function(response) {
+                return response ? response.arrayBuffer() : null;
+            }).catch(function(error) {
+                DucklingsLog.warn("Edge cache lookup failed:", error.message);
+                return null;
+            });
+        },
+
+        // Store a body without waiting for it; the cache only takes complete 200 responses
+        put: function(key, body, ttl) {
+            var config = HTTPEdgeCache.config();
+            if (!config || !(ttl > 0)) return;
+            var response = new Response(body, {
+                status: 200,
+                headers: { "Cache-Control": "max-age=" + Math.floor(ttl) }
+            });
+            config.cache.put(key, response).catch(function(error) {
+                DucklingsLog.warn("Edge cache store failed:", error.message);
+            });
+        }
+    },
+
+    // Identical HEAD/GET requests in flight share one fetch(); keyed by method, URL and headers.
+    // Each caller still copies the shared result into its own WASM buffer.
+    $HTTPInflight: {
+        requests: {},
+
+        key: function(method, url, headers) {
+            return method + " " + url + " " + JSON.stringify(headers);
+        },
+
+        // Return the pending promise for key, or start one with start()
+        share: function(key, start) {
+            var pending = HTTPInflight.requests[key];
+            if (pending) return pending;
+            pending = start();
+            HTTPInflight.requests[key] = pending;
+            var clear = function() {
+                delete HTTPInflight.requests[key];
+            };
+            pending.then(clear, clear);
+            return pending;
+        }
+    },
+
     // Async HEAD request using fetch()
     // Using Asyncify.handleAsync for explicit async handling in CF Workers
-    em_async_head_request: function(url_ptr, header_count, header_array) {
+    em_async_head_request__deps: ['$HTTPHeaderBlock', '$HTTPInflight', '$HTTPEdgeCache', '$DucklingsLog'],
+    em_async_head_request__async: true,
+    em_async_head_request: function(url_ptr, header_block) {
         var url = UTF8ToString(url_ptr);
 
-        console.log("em_async_head_request called for:", url);
-
-        // Parse headers from the header array (must be done synchronously before Asyncify)
-        var headers = {};
-        for (var i = 0; i < header_count * 2; i += 2) {
-            var ptr1 = HEAP32[(header_array >> 2) + i];
-            var ptr2 = HEAP32[(header_array >> 2) + i + 1];
-            try {
-                var headerName = UTF8ToString(ptr1);
-                var headerValue = UTF8ToString(ptr2);
-                // Skip problematic headers for CORS/fetch
-                if (headerName === "Host" || headerName === "User-Agent") continue;
-                headers[headerName] = headerValue;
-            } catch (error) {
-                console.warn("Error parsing header:", error);
-            }
+        // Decode the header block (must be done synchronously before Asyncify,
+        // the block lives in a buffer the client reuses for its next request)
+        var headers = HTTPHeaderBlock.decodeForFetch(header_block);
+
+        DucklingsLog.debug("Fetching HEAD", url);
+
+        return Asyncify.handleAsync(function() {
+            // Resolves to the response headers as [name, value, ...], or null on failure
+            var pending = HTTPInflight.share(HTTPInflight.key("HEAD", url, headers), function() {
+                var edgeConfig = HTTPEdgeCache.config();
+                var edgeKey = HTTPEdgeCache.key("head", url);
+                var lookup = edgeConfig && edgeConfig.metadataTtl > 0 ?
+                    HTTPEdgeCache.match(edgeKey) : Promise.resolve(null);
+                return lookup.then(function(cached) {
+                    if (cached) {
+                        DucklingsLog.debug("HEAD edge cache hit:", url);
+                        return JSON.parse(new TextDecoder().decode(cached));
+                    }
+                    return fetch(url, {
+                        method: "HEAD",
+                        headers: headers
+                    }).then(function(response) {
+                        DucklingsLog.debug("HEAD response:", url, response.status);
+
+                        if (!response.ok) {
+                            DucklingsLog.error("HEAD error:", response.status, response.statusText);
+                            return null;
+                        }
+
+                        var parts = [];
+                        response.headers.forEach(function(value, name) {
+                            parts.push(name, value);
+                        });
+                        if (edgeConfig) {
+                            HTTPEdgeCache.put(edgeKey, JSON.stringify(parts), edgeConfig.metadataTtl);
+                        }
+                        return parts;
+                    });
+                }).catch(function(error) {
+                    DucklingsLog.error("Fetch HEAD error:", error.name, error.message, error.stack);
+                    return null;
+                });
+            });
+
+            return pending.then(function(parts) {
+                if (!parts) return 0;
+
+                // Return the response headers as a packed header block
+                return HTTPHeaderBlock.pack(parts);
+            });
+        });
+    },
+
+    // Async general request using fetch()
+    // Using Asyncify.handleAsync for explicit async handling in CF Workers
+    em_async_request__deps: ['$HTTPHeaderBlock', '$HTTPInflight', '$DucklingsLog'],
+    em_async_request__async: true,
+    em_async_request: function(url_ptr, method_ptr, header_block, body_ptr, body_len) {
+        var url = UTF8ToString(url_ptr);
+        var method = UTF8ToString(method_ptr);
+
+        // Decode the header block (must be done synchronously before Asyncify,
+        // the block lives in a buffer the client reuses for its next request)
+        var headers = HTTPHeaderBlock.decodeForFetch(header_block);
+
+        // Prepare fetch options
+        var fetchOptions = {
+            method: method,
+            headers: headers
+        };
+
+        // Add body if present (must be done synchronously before Asyncify).
+        // fetch() snapshots the bytes of a BufferSource body when called,
+        // so a view on the WASM heap is enough.
+        if (body_ptr && body_len > 0) {
+            fetchOptions.body = HEAPU8.subarray(body_ptr, body_ptr + body_len);
         }
 
-        console.log("Fetching HEAD", url, "with headers:", JSON.stringify(headers));
+        DucklingsLog.debug("Fetching", method, url);
+
+        return Asyncify.handleAsync(function() {
+            // Resolves to the response body, or null on failure
+            var start = function() {
+                return fetch(url, fetchOptions).then(function(response) {
+                    DucklingsLog.debug("Response:", method, url, response.status);
+
+                    if (!response.ok && method !== "HEAD") {
+                        DucklingsLog.error("Request error:", response.status, response.statusText);
+                        return null;
+                    }
+
+                    return response.arrayBuffer().then(function(responseBody) {
+                        return new Uint8Array(responseBody);
+                    });
+                }).catch(function(error) {
+                    DucklingsLog.error("Fetch error:", error.name, error.message, error.stack);
+                    return null;
+                });
+            };
+
+            // Only requests without a body are safe to coalesce
+            var pending = (method === "GET" || method === "HEAD") && !fetchOptions.body
+                ? HTTPInflight.share(HTTPInflight.key(method, url, headers), start)
+                : start();
+
+            return pending.then(function(bodyBytes) {
+                if (!bodyBytes) return 0;
+                var len = bodyBytes.length;
+
+                // Allocate memory: 4 bytes for length + body
+                var resultPtr = _malloc(len + 4);
+                if (!resultPtr) return 0;
+
+                // Store length (little-endian)
+                HEAPU8[resultPtr] = len & 0xFF;
+                HEAPU8[resultPtr + 1] = (len >> 8) & 0xFF;
+                HEAPU8[resultPtr + 2] = (len >> 16) & 0xFF;
+                HEAPU8[resultPtr + 3] = (len >> 24) & 0xFF;
+
+                // Copy body data
+                HEAPU8.set(bodyBytes, resultPtr + 4);
+                return resultPtr;
+            });
+        });
+    },
+
+    // Streaming GET using fetch(): resolves once the response headers arrive and
+    // returns a stream id (0 on failure) whose body is read with em_async_stream_read
+    em_async_stream_open__deps: ['$HTTPStreams', '$HTTPHeaderBlock', '$DucklingsLog'],
+    em_async_stream_open__async: true,
+    em_async_stream_open: function(url_ptr, header_block) {
+        var url = UTF8ToString(url_ptr);
+
+        // Decode the header block (must be done synchronously before Asyncify,
+        // the block lives in a buffer the client reuses for its next request)
+        var headers = HTTPHeaderBlock.decodeForFetch(header_block);
 
         return Asyncify.handleAsync(function() {
             return fetch(url, {
-                method: "HEAD",
+                method: "GET",
                 headers: headers
             }).then(function(response) {
-                console.log("HEAD response received, status:", response.status, response.statusText);
-
                 if (!response.ok) {
-                    console.error("HEAD error:", response.status, response.statusText);
+                    DucklingsLog.error("Request error:", response.status, response.statusText);
                     return 0;
                 }
+                var id = HTTPStreams.nextId++;
+                HTTPStreams.entries[id] = {
+                    reader: response.body ? response.body.getReader() : null,
+                    pending: null
+                };
+                return id;
+            }).catch(function(error) {
+                DucklingsLog.error("Fetch error:", error.name, error.message, error.stack);
+                return 0;
+            });
+        });
+    },
+
+    // Read up to max_bytes of a streaming response body, coalescing ReadableStream chunks.
+    // Returns a 4-byte length-prefixed buffer (length 0 at end of body), or 0 on failure.
+    em_async_stream_read__deps: ['$HTTPStreams', '$DucklingsLog'],
+    em_async_stream_read__async: true,
+    em_async_stream_read: function(stream_id, max_bytes) {
+        var entry = HTTPStreams.entries[stream_id];
+        if (!entry) return 0;
+
+        return Asyncify.handleAsync(function() {
+            var parts = [];
+            var total = 0;
+            if (entry.pending) {
+                parts.push(entry.pending);
+                total += entry.pending.length;
+                entry.pending = null;
+            }
 
-                // Build response headers string
-                var responseHeaders = "";
-                response.headers.forEach(function(value, name) {
-                    responseHeaders += name + ": " + value + "\r\n";
+            function pump() {
+                if (total >= max_bytes || !entry.reader) return Promise.resolve();
+                return entry.reader.read().then(function(result) {
+                    if (result.done) {
+                        entry.reader = null;
+                        return;
+                    }
+                    parts.push(result.value);
+                    total += result.value.length;
+                    return pump();
                 });
-                console.log("Response headers length:", responseHeaders.length);
+            }
 
-                // Copy to WASM memory
-                var headerBytes = new TextEncoder().encode(responseHeaders);
-                var len = headerBytes.length;
+            return pump().then(function() {
+                var len = Math.min(total, max_bytes);
                 var resultPtr = _malloc(len + 4);
+                if (!resultPtr) return 0;
 
                 // Store length (little-endian)
                 HEAPU8[resultPtr] = len & 0xFF;
@@ -57,96 +365,229 @@ mergeInto(LibraryManager.library, {
                 HEAPU8[resultPtr + 2] = (len >> 16) & 0xFF;
                 HEAPU8[resultPtr + 3] = (len >> 24) & 0xFF;
 
-                // Copy header data
-                HEAPU8.set(headerBytes, resultPtr + 4);
-
-                console.log("em_async_head_request returning ptr:", resultPtr);
+                // Copy chunks; the part crossing max_bytes is kept for the next read
+                var offset = resultPtr + 4;
+                var remaining = len;
+                for (var i = 0; i < parts.length; i++) {
+                    var part = parts[i];
+                    if (part.length > remaining) {
+                        HEAPU8.set(part.subarray(0, remaining), offset);
+                        entry.pending = part.subarray(remaining);
+                        break;
+                    }
+                    HEAPU8.set(part, offset);
+                    offset += part.length;
+                    remaining -= part.length;
+                }
                 return resultPtr;
             }).catch(function(error) {
-                console.error("Fetch HEAD error:", error.name, error.message, error.stack);
+                DucklingsLog.error("Stream read error:", error.name, error.message);
                 return 0;
             });
         });
     },
 
-    // Async general request using fetch()
-    // Using Asyncify.handleAsync for explicit async handling in CF Workers
-    em_async_request: function(url_ptr, method_ptr, header_count, header_array, body_ptr, body_len) {
+    // Release a streaming response, cancelling the body if it was not fully read
+    em_async_stream_close__deps: ['$HTTPStreams'],
+    em_async_stream_close: function(stream_id) {
+        var entry = HTTPStreams.entries[stream_id];
+        if (!entry) return;
+        delete HTTPStreams.entries[stream_id];
+        if (entry.reader) {
+            entry.reader.cancel().catch(function() {});
+        }
+    },
+
+    // Concurrent range GETs using fetch() + Promise.all
+    // All requests share the given headers; range_array holds (start, end) doubles per request.
+    // Returns one buffer with, per request, a 4-byte length (0xFFFFFFFF on failure) and the body.
+    em_async_batch_request__deps: ['$HTTPHeaderBlock', '$HTTPInflight', '$HTTPEdgeCache', '$DucklingsLog'],
+    em_async_batch_request__async: true,
+    em_async_batch_request: function(url_ptr, request_count, range_array, header_block, validator_ptr) {
         var url = UTF8ToString(url_ptr);
-        var method = UTF8ToString(method_ptr);
+        // Blocks of objects without a validator cannot be told apart from newer versions
+        var validator = validator_ptr ? UTF8ToString(validator_ptr) : "";
+        var edgeConfig = validator ? HTTPEdgeCache.config() : null;
 
-        console.log("em_async_request called:", method, url);
-
-        // Parse headers (must be done synchronously before Asyncify)
-        var headers = {};
-        for (var i = 0; i < header_count * 2; i += 2) {
-            var ptr1 = HEAP32[(header_array >> 2) + i];
-            var ptr2 = HEAP32[(header_array >> 2) + i + 1];
-            try {
-                var headerName = UTF8ToString(ptr1);
-                var headerValue = UTF8ToString(ptr2);
-                if (headerName === "Host" || headerName === "User-Agent") continue;
-                headers[headerName] = headerValue;
-            } catch (error) {
-                console.warn("Error parsing header:", error);
-            }
+        // Decode the header block (must be done synchronously before Asyncify,
+        // the block lives in a buffer the client reuses for its next request)
+        var headers = HTTPHeaderBlock.decodeForFetch(header_block);
+
+        var ranges = [];
+        for (var i = 0; i < request_count; i++) {
+            ranges.push("bytes=" + HEAPF64[(range_array >> 3) + i * 2] + "-" + HEAPF64[(range_array >> 3) + i * 2 + 1]);
         }
 
-        // Prepare fetch options
-        var fetchOptions = {
-            method: method,
-            headers: headers
-        };
+        return Asyncify.handleAsync(function() {
+            return Promise.all(ranges.map(function(range) {
+                var requestHeaders = Object.assign({}, headers, { Range: range });
+                return HTTPInflight.share(HTTPInflight.key("GET", url, requestHeaders), function() {
+                    var edgeKey = HTTPEdgeCache.key("block", url,
+                        "validator=" + encodeURIComponent(validator) + "&range=" + range.slice(6));
+                    var lookup = edgeConfig ? HTTPEdgeCache.match(edgeKey) : Promise.resolve(null);
+                    return lookup.then(function(cached) {
+                        if (cached) {
+                            return new Uint8Array(cached);
+                        }
+                        return fetch(url, {
+                            method: "GET",
+                            headers: requestHeaders
+                        }).then(function(response) {
+                            if (!response.ok) {
+                                DucklingsLog.error("Range request error:", response.status, response.statusText);
+                                return null;
+                            }
+                            return response.arrayBuffer().then(function(body) {
+                                // A server that ignored Range sent the whole file, which is not a block
+                                if (edgeConfig && response.status === 206) {
+                                    HTTPEdgeCache.put(edgeKey, body.slice(0), edgeConfig.ttl);
+                                }
+                                return new Uint8Array(body);
+                            });
+                        });
+                    }).catch(function(error) {
+                        DucklingsLog.error("Fetch error:", error.name, error.message);
+                        return null;
+                    });
+                });
+            })).then(function(bodies) {
+                var total = 0;
+                for (var i = 0; i < bodies.length; i++) {
+                    total += 4 + (bodies[i] ? bodies[i].length : 0);
+                }
 
-        // Add body if present (must be done synchronously before Asyncify)
-        if (body_ptr && body_len > 0) {
-            var bodyData = new Uint8Array(body_len);
-            for (var i = 0; i < body_len; i++) {
-                bodyData[i] = HEAPU8[body_ptr + i];
-            }
-            fetchOptions.body = bodyData;
-        }
+                var resultPtr = _malloc(total);
+                if (!resultPtr) return 0;
 
-        console.log("Fetching", method, url);
+                var offset = resultPtr;
+                for (var i = 0; i < bodies.length; i++) {
+                    var len = bodies[i] ? bodies[i].length : 0xFFFFFFFF;
 
-        return Asyncify.handleAsync(function() {
-            return fetch(url, fetchOptions).then(function(response) {
-                console.log("Response status:", response.status);
+                    // Store length (little-endian)
+                    HEAPU8[offset] = len & 0xFF;
+                    HEAPU8[offset + 1] = (len >> 8) & 0xFF;
+                    HEAPU8[offset + 2] = (len >> 16) & 0xFF;
+                    HEAPU8[offset + 3] = (len >> 24) & 0xFF;
+                    offset += 4;
 
-                if (!response.ok && method !== "HEAD") {
-                    console.error("Request error:", response.status, response.statusText);
-                    return 0;
+                    if (bodies[i]) {
+                        HEAPU8.set(bodies[i], offset);
+                        offset += bodies[i].length;
+                    }
                 }
+                return resultPtr;
+            });
+        });
+    },
 
-                // Get response body
-                return response.arrayBuffer().then(function(responseBody) {
-                    var bodyBytes = new Uint8Array(responseBody);
-                    var len = bodyBytes.length;
-
-                    console.log("Response body length:", len);
+    // PUT of a multipart upload part using fetch(). Returns the response headers as a
+    // packed header block once the part is stored (0 on failure); they carry the ETag
+    // that httpfs lists in CompleteMultipartUpload.
+    em_async_upload_part__deps: ['$HTTPHeaderBlock', '$DucklingsLog'],
+    em_async_upload_part__async: true,
+    em_async_upload_part: function(url_ptr, header_block, body_ptr, body_len) {
+        var url = UTF8ToString(url_ptr);
 
-                    // Allocate memory: 4 bytes for length + body
-                    var resultPtr = _malloc(len + 4);
+        // Decode the header block (must be done synchronously before Asyncify,
+        // the block lives in a buffer the client reuses for its next request)
+        var headers = HTTPHeaderBlock.decodeForFetch(header_block);
 
-                    // Store length (little-endian)
-                    HEAPU8[resultPtr] = len & 0xFF;
-                    HEAPU8[resultPtr + 1] = (len >> 8) & 0xFF;
-                    HEAPU8[resultPtr + 2] = (len >> 16) & 0xFF;
-                    HEAPU8[resultPtr + 3] = (len >> 24) & 0xFF;
+        // fetch() snapshots the bytes of a BufferSource body when called
+        var body = HEAPU8.subarray(body_ptr, body_ptr + body_len);
 
-                    // Copy body data
-                    HEAPU8.set(bodyBytes, resultPtr + 4);
+        DucklingsLog.debug("Uploading part", url);
 
-                    console.log("em_async_request returning ptr:", resultPtr);
-                    return resultPtr;
+        return Asyncify.handleAsync(function() {
+            return fetch(url, {
+                method: "PUT",
+                headers: headers,
+                body: body
+            }).then(function(response) {
+                DucklingsLog.debug("Part response:", url, response.status);
+                if (!response.ok) {
+                    DucklingsLog.error("Part upload error:", response.status, response.statusText);
+                    return 0;
+                }
+                return response.arrayBuffer().then(function() {
+                    var parts = [];
+                    response.headers.forEach(function(value, name) {
+                        parts.push(name, value);
+                    });
+                    return HTTPHeaderBlock.pack(parts);
                 });
             }).catch(function(error) {
-                console.error("Fetch error:", error.name, error.message, error.stack);
+                DucklingsLog.error("Part upload error:", error.name, error.message);
                 return 0;
             });
         });
     },
 
+    // Whether the dispatcher started a fetch helper worker (packages/ducklings-browser/src/worker/fetch-helper.ts).
+    // Module.fetchHelper only exists on the thread that created the module, so pthreads ask it.
+    em_has_fetch_helper__proxy: 'sync',
+    em_has_fetch_helper: function() {
+        return Module["fetchHelper"] ? 1 : 0;
+    },
+
+    // Concurrent range GETs without Asyncify (browser mode): the helper worker runs them as
+    // parallel fetch() calls and writes the bodies into a SharedArrayBuffer while this
+    // thread blocks in Atomics.wait. Returns the same buffer as em_async_batch_request,
+    // or 0 if the batch did not finish within timeout_ms.
+    em_helper_batch_request__deps: ['$HTTPHeaderBlock', '$DucklingsLog'],
+    em_helper_batch_request__proxy: 'sync',
+    em_helper_batch_request: function(url_ptr, request_count, range_array, header_block, timeout_ms) {
+        var helper = Module["fetchHelper"];
+        if (!helper) return 0;
+        var url = UTF8ToString(url_ptr);
+        var headers = HTTPHeaderBlock.decodeForFetch(header_block);
+
+        var ranges = [];
+        var size = 4 * (request_count + 1);
+        for (var i = 0; i < request_count; i++) {
+            var start = HEAPF64[(range_array >> 3) + i * 2];
+            var end = HEAPF64[(range_array >> 3) + i * 2 + 1];
+            ranges.push([start, end]);
+            size += end - start + 1;
+        }
+
+        var buffer = new SharedArrayBuffer(size);
+        var control = new Int32Array(buffer, 0, request_count + 1);
+        DucklingsLog.debug("Fetching", request_count, "ranges in the fetch helper:", url);
+        helper.postMessage({ url: url, headers: headers, ranges: ranges, buffer: buffer });
+        if (Atomics.wait(control, 0, 0, timeout_ms) === "timed-out") {
+            DucklingsLog.warn("Fetch helper timed out:", url);
+            return 0;
+        }
+
+        var total = 0;
+        for (var i = 0; i < request_count; i++) {
+            total += 4 + Math.max(control[i + 1], 0);
+        }
+        var resultPtr = _malloc(total);
+        if (!resultPtr) return 0;
+
+        var bytes = new Uint8Array(buffer);
+        var from = 4 * (request_count + 1);
+        var offset = resultPtr;
+        for (var i = 0; i < request_count; i++) {
+            var len = control[i + 1] >= 0 ? control[i + 1] : 0xFFFFFFFF;
+
+            // Store length (little-endian)
+            HEAPU8[offset] = len & 0xFF;
+            HEAPU8[offset + 1] = (len >> 8) & 0xFF;
+            HEAPU8[offset + 2] = (len >> 16) & 0xFF;
+            HEAPU8[offset + 3] = (len >> 24) & 0xFF;
+            offset += 4;
+
+            if (control[i + 1] > 0) {
+                HEAPU8.set(bytes.subarray(from, from + control[i + 1]), offset);
+                offset += control[i + 1];
+            }
+            from += ranges[i][1] - ranges[i][0] + 1;
+        }
+        return resultPtr;
+    },
+
     // Check if we're in a browser environment (has XMLHttpRequest)
     em_has_xhr: function() {
         return (typeof XMLHttpRequest !== "undefined") ? 1 : 0;
@@ -0,0 +1,77 @@
+#include "http_metadata_cache.hpp"
+
+namespace duckdb {
+
+HTTPMetadataCache &HTTPMetadataCache::Get() {
+    static HTTPMetadataCache cache;
+    return cache;
+}
+
+void HTTPMetadataCache::Configure(idx_t new_ttl_seconds) {
+    lock_guard<mutex> guard(lock);
+    ttl_seconds = new_ttl_seconds;
+    if (ttl_seconds == 0) {
+        entries.clear();
+    }
+}
+
+bool HTTPMetadataCache::Lookup(const string &url, HTTPFileMetadata &metadata) {
+    lock_guard<mutex> guard(lock);
+    if (ttl_seconds == 0) {
+        return false;
+    }
+    auto it = entries.find(url);
+    if (it == entries.end()) {
+        return false;
+    }
+    if (Clock::now() - it->second.stored_at >= std::chrono::seconds(ttl_seconds)) {
+        entries.erase(it);
+        return false;
+    }
+    metadata = it->second.metadata;
+    return true;
+}
+
+void HTTPMetadataCache::Put(const string &url, const HTTPFileMetadata &metadata) {
+    lock_guard<mutex> guard(lock);
+    if (ttl_seconds == 0) {
+        return;
+    }
+    auto now = Clock::now();
+    if (entries.size() >= MAX_ENTRIES && entries.find(url) == entries.end()) {
+        EvictExpired(now);
+        if (entries.size() >= MAX_ENTRIES) {
+            // Still full of live entries: make room with an arbitrary victim
+            entries.erase(entries.begin());
+        }
+    }
+    entries[url] = CachedMetadata {metadata, now};
+}
+
+void HTTPMetadataCache::Invalidate(const string &url) {
+    lock_guard<mutex> guard(lock);
+    entries.erase(url);
+    // Multipart uploads address the object with a query string (?uploadId=...)
+    auto query_pos = url.find('?');
+    if (query_pos != string::npos) {
+        entries.erase(url.substr(0, query_pos));
+    }
+}
+
+void HTTPMetadataCache::Clear() {
+    lock_guard<mutex> guard(lock);
+    entries.clear();
+}
+
+void HTTPMetadataCache::EvictExpired(Clock::time_point now) {
+    auto ttl = std::chrono::seconds(ttl_seconds);
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (now - it->second.stored_at >= ttl) {
+            it = entries.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+} // namespace duckdb
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+
+#include <chrono>
+
+namespace duckdb {
+
+// Metadata of a remote file as reported by a HEAD response
+struct HTTPFileMetadata {
+    idx_t content_length = DConstants::INVALID_INDEX;
+    string etag;
+    string last_modified;
+    string accept_ranges;
+};
+
+// Process-wide cache of HEAD responses, shared by all HTTPWasmClient instances (httpfs
+// creates a new client per file handle). Lets a query re-open files the previous query
+// just stat'ed, e.g. a glob over many Parquet files, without a HEAD round trip per file.
+class HTTPMetadataCache {
+public:
+    static constexpr idx_t DEFAULT_TTL_SECONDS = 30;
+    static constexpr idx_t MAX_ENTRIES = 4096;
+
+    static HTTPMetadataCache &Get();
+
+    // Apply the http_wasm_metadata_cache_ttl setting (0 disables the cache)
+    void Configure(idx_t ttl_seconds);
+
+    // Look up the metadata of a URL; false on a miss or if the entry is older than the TTL
+    bool Lookup(const string &url, HTTPFileMetadata &metadata);
+
+    void Put(const string &url, const HTTPFileMetadata &metadata);
+
+    // Forget a URL after it was written (PUT, POST, DELETE)
+    void Invalidate(const string &url);
+
+    void Clear();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct CachedMetadata {
+        HTTPFileMetadata metadata;
+        Clock::time_point stored_at;
+    };
+
+    void EvictExpired(Clock::time_point now);
+
+    mutex lock;
+    idx_t ttl_seconds = DEFAULT_TTL_SECONDS;
+    unordered_map<string, CachedMetadata> entries;
+};
+
+} // namespace duckdb
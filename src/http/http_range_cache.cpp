@@ -0,0 +1,167 @@
+#include "http_range_cache.hpp"
+
+namespace duckdb {
+
+HTTPRangeCache &HTTPRangeCache::Get() {
+    static HTTPRangeCache cache;
+    return cache;
+}
+
+void HTTPRangeCache::Configure(idx_t new_block_size, idx_t new_cache_size, idx_t new_prefetch_blocks) {
+    lock_guard<mutex> guard(lock);
+    if (new_block_size == 0) {
+        new_block_size = DEFAULT_BLOCK_SIZE;
+    }
+    if (new_block_size != block_size) {
+        // Block indexes depend on the block size, so cached blocks become unusable
+        for (auto &entry : files) {
+            DropBlocks(entry.second);
+        }
+        block_size = new_block_size;
+    }
+    cache_size = new_cache_size;
+    prefetch_blocks = new_prefetch_blocks;
+    EvictToBudget();
+}
+
+void HTTPRangeCache::UpdateFileInfo(const string &url, const string &validator, idx_t file_size) {
+    lock_guard<mutex> guard(lock);
+    if (validator.empty()) {
+        // Without a validator we cannot tell whether cached bytes are stale
+        auto it = files.find(url);
+        if (it != files.end()) {
+            DropBlocks(it->second);
+            files.erase(it);
+        }
+        return;
+    }
+
+    auto &file = files[url];
+    if (file.validator != validator || file.file_size != file_size) {
+        DropBlocks(file);
+        file.validator = validator;
+        file.file_size = file_size;
+    }
+}
+
+bool HTTPRangeCache::IsCacheable(const string &url, idx_t &file_size) {
+    lock_guard<mutex> guard(lock);
+    if (cache_size == 0) {
+        return false;
+    }
+    auto it = files.find(url);
+    if (it == files.end()) {
+        return false;
+    }
+    file_size = it->second.file_size;
+    return true;
+}
+
+string HTTPRangeCache::Validator(const string &url) {
+    lock_guard<mutex> guard(lock);
+    auto it = files.find(url);
+    return it == files.end() ? string() : it->second.validator;
+}
+
+shared_ptr<const string> HTTPRangeCache::GetBlock(const string &url, idx_t block_idx) {
+    lock_guard<mutex> guard(lock);
+    auto file_it = files.find(url);
+    if (file_it == files.end()) {
+        return nullptr;
+    }
+    auto block_it = file_it->second.blocks.find(block_idx);
+    if (block_it == file_it->second.blocks.end()) {
+        return nullptr;
+    }
+    lru.splice(lru.begin(), lru, block_it->second.lru_pos);
+    return block_it->second.data;
+}
+
+void HTTPRangeCache::PutBlock(const string &url, idx_t block_idx, shared_ptr<const string> data) {
+    lock_guard<mutex> guard(lock);
+    if (!data || data->size() > cache_size) {
+        return;
+    }
+    auto file_it = files.find(url);
+    if (file_it == files.end()) {
+        return;
+    }
+    auto &blocks = file_it->second.blocks;
+    auto block_it = blocks.find(block_idx);
+    if (block_it != blocks.end()) {
+        used_bytes -= block_it->second.data->size();
+        lru.erase(block_it->second.lru_pos);
+        blocks.erase(block_it);
+    }
+
+    lru.emplace_front(url, block_idx);
+    used_bytes += data->size();
+    blocks[block_idx] = CachedBlock {std::move(data), lru.begin()};
+    EvictToBudget();
+}
+
+bool HTTPRangeCache::HasBlock(const string &url, idx_t block_idx) {
+    lock_guard<mutex> guard(lock);
+    auto file_it = files.find(url);
+    return file_it != files.end() && file_it->second.blocks.count(block_idx) > 0;
+}
+
+bool HTTPRangeCache::RecordRead(const string &url, idx_t start, idx_t end) {
+    lock_guard<mutex> guard(lock);
+    auto file_it = files.find(url);
+    if (file_it == files.end()) {
+        return false;
+    }
+    auto &file = file_it->second;
+    bool sequential = file.last_read_end != DConstants::INVALID_INDEX && start >= file.last_read_end &&
+                      start - file.last_read_end <= prefetch_blocks * block_size;
+    file.last_read_end = end + 1;
+    return sequential;
+}
+
+idx_t HTTPRangeCache::BlockSize() {
+    lock_guard<mutex> guard(lock);
+    return block_size;
+}
+
+idx_t HTTPRangeCache::CacheSize() {
+    lock_guard<mutex> guard(lock);
+    return cache_size;
+}
+
+idx_t HTTPRangeCache::PrefetchBlocks() {
+    lock_guard<mutex> guard(lock);
+    return prefetch_blocks;
+}
+
+void HTTPRangeCache::Clear() {
+    lock_guard<mutex> guard(lock);
+    files.clear();
+    lru.clear();
+    used_bytes = 0;
+}
+
+void HTTPRangeCache::EvictToBudget() {
+    while (used_bytes > cache_size && !lru.empty()) {
+        auto &victim = lru.back();
+        auto file_it = files.find(victim.first);
+        if (file_it != files.end()) {
+            auto block_it = file_it->second.blocks.find(victim.second);
+            if (block_it != file_it->second.blocks.end()) {
+                used_bytes -= block_it->second.data->size();
+                file_it->second.blocks.erase(block_it);
+            }
+        }
+        lru.pop_back();
+    }
+}
+
+void HTTPRangeCache::DropBlocks(CachedFile &file) {
+    for (auto &entry : file.blocks) {
+        used_bytes -= entry.second.data->size();
+        lru.erase(entry.second.lru_pos);
+    }
+    file.blocks.clear();
+}
+
+} // namespace duckdb
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+
+#include <list>
+
+namespace duckdb {
+
+// Process-wide cache of HTTP range-read blocks, shared by all HTTPWasmClient instances
+// (httpfs creates a new client per request). Blocks of a URL are only kept while its
+// validator (ETag, falling back to Last-Modified) matches the one from the latest HEAD.
+class HTTPRangeCache {
+public:
+    static constexpr idx_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+    static constexpr idx_t DEFAULT_CACHE_SIZE = 32 * 1024 * 1024;
+    static constexpr idx_t DEFAULT_PREFETCH_BLOCKS = 4;
+
+    static HTTPRangeCache &Get();
+
+    // Apply the http_wasm_cache_block_size / http_wasm_cache_size / http_wasm_prefetch_blocks settings
+    void Configure(idx_t block_size, idx_t cache_size, idx_t prefetch_blocks);
+
+    // Record validator and size from a HEAD response; a changed validator drops the URL's blocks
+    void UpdateFileInfo(const string &url, const string &validator, idx_t file_size);
+
+    // Returns true if range reads of this URL may be cached, along with its size
+    // (INVALID_INDEX if the HEAD response had no Content-Length)
+    bool IsCacheable(const string &url, idx_t &file_size);
+
+    // Validator recorded for a URL by the latest HEAD, or empty if none is known
+    string Validator(const string &url);
+
+    // Look up a block, marking it as recently used; returns nullptr on a miss
+    shared_ptr<const string> GetBlock(const string &url, idx_t block_idx);
+
+    // Insert a block, evicting least recently used blocks to stay within the budget
+    void PutBlock(const string &url, idx_t block_idx, shared_ptr<const string> data);
+
+    // Check for a block without touching its LRU position
+    bool HasBlock(const string &url, idx_t block_idx);
+
+    // Record a range read of [start, end]; returns true if it continues (or closely follows)
+    // the previous read of the URL, i.e. the caller is scanning forward and read-ahead pays off
+    bool RecordRead(const string &url, idx_t start, idx_t end);
+
+    idx_t BlockSize();
+    idx_t CacheSize();
+    idx_t PrefetchBlocks();
+
+    void Clear();
+
+private:
+    struct CachedBlock {
+        shared_ptr<const string> data;
+        std::list<std::pair<string, idx_t>>::iterator lru_pos;
+    };
+
+    struct CachedFile {
+        string validator;
+        idx_t file_size = DConstants::INVALID_INDEX;
+        idx_t last_read_end = DConstants::INVALID_INDEX;
+        unordered_map<idx_t, CachedBlock> blocks;
+    };
+
+    void EvictToBudget();
+    void DropBlocks(CachedFile &file);
+
+    mutex lock;
+    idx_t block_size = DEFAULT_BLOCK_SIZE;
+    idx_t cache_size = DEFAULT_CACHE_SIZE;
+    idx_t prefetch_blocks = DEFAULT_PREFETCH_BLOCKS;
+    idx_t used_bytes = 0;
+    unordered_map<string, CachedFile> files;
+    // Most recently used blocks at the front
+    std::list<std::pair<string, idx_t>> lru;
+};
+
+} // namespace duckdb
@@ -0,0 +1,126 @@
+#include "http_stats.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace duckdb {
+
+const double HTTPStats::LATENCY_BOUNDS_MS[HTTPURLStats::LATENCY_BUCKETS - 1] = {
+    1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 5000};
+
+HTTPStats &HTTPStats::Get() {
+    static HTTPStats stats;
+    return stats;
+}
+
+void HTTPStats::Begin() {
+    lock_guard<mutex> guard(lock);
+    if (collectors.fetch_add(1) == 0) {
+        urls.clear();
+    }
+}
+
+string HTTPStats::End() {
+    lock_guard<mutex> guard(lock);
+    auto json = ToJSON();
+    if (collectors.load() > 0) {
+        collectors--;
+    }
+    return json;
+}
+
+void HTTPStats::RecordRequest(const string &url, const char *method, idx_t bytes_received, idx_t bytes_sent,
+                              double latency_ms, bool ok) {
+    if (!Enabled()) {
+        return;
+    }
+    lock_guard<mutex> guard(lock);
+    auto &stats = urls[url];
+    stats.requests++;
+    if (strcmp(method, "HEAD") == 0) {
+        stats.head_requests++;
+    }
+    if (!ok) {
+        stats.errors++;
+    }
+    stats.bytes_received += bytes_received;
+    stats.bytes_sent += bytes_sent;
+    stats.total_latency_ms += latency_ms;
+    idx_t bucket = 0;
+    while (bucket < HTTPURLStats::LATENCY_BUCKETS - 1 && latency_ms > LATENCY_BOUNDS_MS[bucket]) {
+        bucket++;
+    }
+    stats.latency_histogram[bucket]++;
+}
+
+void HTTPStats::RecordRangeCacheHits(const string &url, idx_t blocks) {
+    if (!Enabled() || blocks == 0) {
+        return;
+    }
+    lock_guard<mutex> guard(lock);
+    urls[url].range_cache_hits += blocks;
+}
+
+void HTTPStats::RecordMetadataCacheHit(const string &url) {
+    if (!Enabled()) {
+        return;
+    }
+    lock_guard<mutex> guard(lock);
+    urls[url].metadata_cache_hits++;
+}
+
+static void AppendJSONString(string &out, const string &value) {
+    out += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((unsigned char)c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char)c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+static string FormatDouble(double value) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.3f", value);
+    return buffer;
+}
+
+// {"latencyBoundsMs":[...],"urls":[{"url":...,"requests":...,"latencyHistogram":[...]}, ...]}
+string HTTPStats::ToJSON() {
+    string out = "{\"latencyBoundsMs\":[";
+    for (idx_t i = 0; i < HTTPURLStats::LATENCY_BUCKETS - 1; i++) {
+        out += (i ? "," : "") + FormatDouble(LATENCY_BOUNDS_MS[i]);
+    }
+    out += "],\"urls\":[";
+    bool first = true;
+    for (auto &entry : urls) {
+        auto &stats = entry.second;
+        out += first ? "{\"url\":" : ",{\"url\":";
+        first = false;
+        AppendJSONString(out, entry.first);
+        out += ",\"requests\":" + to_string(stats.requests);
+        out += ",\"headRequests\":" + to_string(stats.head_requests);
+        out += ",\"errors\":" + to_string(stats.errors);
+        out += ",\"bytesReceived\":" + to_string(stats.bytes_received);
+        out += ",\"bytesSent\":" + to_string(stats.bytes_sent);
+        out += ",\"rangeCacheHits\":" + to_string(stats.range_cache_hits);
+        out += ",\"metadataCacheHits\":" + to_string(stats.metadata_cache_hits);
+        out += ",\"totalLatencyMs\":" + FormatDouble(stats.total_latency_ms);
+        out += ",\"latencyHistogram\":[";
+        for (idx_t i = 0; i < HTTPURLStats::LATENCY_BUCKETS; i++) {
+            out += (i ? "," : "") + to_string(stats.latency_histogram[i]);
+        }
+        out += "]}";
+    }
+    out += "]}";
+    return out;
+}
+
+} // namespace duckdb
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+
+#include <atomic>
+
+namespace duckdb {
+
+// HTTP traffic of one URL while collection is on
+struct HTTPURLStats {
+    static constexpr idx_t LATENCY_BUCKETS = 12;
+
+    idx_t requests = 0;
+    idx_t head_requests = 0;
+    idx_t errors = 0;
+    idx_t bytes_received = 0;
+    idx_t bytes_sent = 0;
+    // Range-read blocks served from HTTPRangeCache and HEADs served from HTTPMetadataCache
+    idx_t range_cache_hits = 0;
+    idx_t metadata_cache_hits = 0;
+    double total_latency_ms = 0;
+    idx_t latency_histogram[LATENCY_BUCKETS] = {};
+};
+
+// Process-wide counters of the requests made by all HTTPWasmClient instances, collected
+// for profiled queries (duckdb_wasm_profile_begin/end). While nobody collects, recording
+// is a single relaxed load, so the request path stays unchanged.
+class HTTPStats {
+public:
+    // Upper bounds of the latency histogram buckets in milliseconds; the last bucket is open
+    static const double LATENCY_BOUNDS_MS[HTTPURLStats::LATENCY_BUCKETS - 1];
+
+    static HTTPStats &Get();
+
+    bool Enabled() const {
+        return collectors.load(std::memory_order_relaxed) > 0;
+    }
+
+    // Start collecting; the first collector resets the counters
+    void Begin();
+
+    // Stop collecting and return the counters collected since Begin as JSON
+    string End();
+
+    // Record a completed request; latency includes the time the call was suspended
+    void RecordRequest(const string &url, const char *method, idx_t bytes_received, idx_t bytes_sent,
+                       double latency_ms, bool ok);
+
+    void RecordRangeCacheHits(const string &url, idx_t blocks);
+
+    void RecordMetadataCacheHit(const string &url);
+
+private:
+    string ToJSON();
+
+    std::atomic<idx_t> collectors {0};
+    mutex lock;
+    unordered_map<string, HTTPURLStats> urls;
+};
+
+} // namespace duckdb
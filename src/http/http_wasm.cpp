@@ -1,7 +1,13 @@
 #include "http_wasm.hpp"
+#include "http_range_cache.hpp"
+#include "http_metadata_cache.hpp"
+#include "http_stats.hpp"
+
+#include "duckdb/common/file_opener.hpp"
 
 #include <emscripten.h>
 #include <cstring>
+#include <memory>
 
 namespace duckdb {
 
@@ -10,15 +16,37 @@ namespace duckdb {
 // These are provided via --js-library in the build
 // ============================================================================
 
+// Header blocks are packed by HTTPWasmClient::PackHeaders (see HTTPHeaderBlock in http_async.js)
 extern "C" {
     // Async HEAD request using fetch() - for Cloudflare Workers
-    extern char* em_async_head_request(const char* url_ptr, int header_count, char** header_array);
+    extern char* em_async_head_request(const char* url_ptr, const char* header_block);
 
     // Async general request using fetch() - for Cloudflare Workers
-    extern char* em_async_request(const char* url_ptr, const char* method_ptr, int header_count, char** header_array, const char* body_ptr, int body_len);
+    extern char* em_async_request(const char* url_ptr, const char* method_ptr, const char* header_block, const char* body_ptr, int body_len);
+
+    // Streaming GET using fetch() + ReadableStream - for Cloudflare Workers
+    // open resolves once headers arrive; read returns the next chunk (length 0 at end of body)
+    extern int em_async_stream_open(const char* url_ptr, const char* header_block);
+    extern char* em_async_stream_read(int stream_id, int max_bytes);
+    extern void em_async_stream_close(int stream_id);
+
+    // Concurrent range GETs using fetch() + Promise.all - for Cloudflare Workers
+    // With a validator, blocks are also looked up in and stored to the edge cache (Cache API)
+    extern char* em_async_batch_request(const char* url_ptr, int request_count, const double* range_array,
+                                        const char* header_block, const char* validator_ptr);
+
+    // S3 multipart part upload using fetch() - for Cloudflare Workers
+    // Resolves once the part is stored and returns its response headers (with the ETag)
+    extern char* em_async_upload_part(const char* url_ptr, const char* header_block, const char* body_ptr,
+                                      int body_len);
 
     // Check if XMLHttpRequest is available (browser vs workers)
     extern int em_has_xhr();
+
+    // Concurrent range GETs through the browser's fetch helper worker, waited for with Atomics.wait
+    extern int em_has_fetch_helper();
+    extern char* em_helper_batch_request(const char* url_ptr, int request_count, const double* range_array,
+                                         const char* header_block, int timeout_ms);
 }
 
 // ============================================================================
@@ -26,11 +54,10 @@ extern "C" {
 // ============================================================================
 
 // Sync HEAD request using XMLHttpRequest - works in browsers
-static char* em_sync_head_request(const char* url, int header_count, char** header_array) {
+static char* em_sync_head_request(const char* url, const char* header_block) {
     return (char*)EM_ASM_PTR({
         var url = UTF8ToString($0);
-        var headerCount = $1;
-        var headerArray = $2;
+        var headerBlock = $1;
 
         if (typeof XMLHttpRequest === "undefined") {
             return 0;
@@ -40,56 +67,42 @@ static char* em_sync_head_request(const char* url, int header_count, char** head
         xhr.open("HEAD", url, false);
 
         // Set headers
-        for (var i = 0; i < headerCount * 2; i += 2) {
-            var ptr1 = HEAP32[(headerArray >> 2) + i];
-            var ptr2 = HEAP32[(headerArray >> 2) + i + 1];
+        var headers = HTTPHeaderBlock.decode(headerBlock);
+        for (var headerName in headers) {
             try {
-                var headerName = UTF8ToString(ptr1);
-                var headerValue = UTF8ToString(ptr2);
-                if (headerName === "Host") headerName = "X-Host-Override";
-                if (headerName === "User-Agent") headerName = "X-User-Agent";
-                xhr.setRequestHeader(headerName, headerValue);
+                var name = headerName;
+                if (name === "Host") name = "X-Host-Override";
+                if (name === "User-Agent") name = "X-User-Agent";
+                xhr.setRequestHeader(name, headers[headerName]);
             } catch (error) {
-                console.warn("Error setting header:", error);
+                DucklingsLog.warn("Error setting header:", error);
             }
         }
 
         try {
             xhr.send(null);
         } catch (error) {
-            console.error("XHR HEAD error:", error);
+            DucklingsLog.error("XHR HEAD error:", error);
             return 0;
         }
 
         if (xhr.status === 0 || xhr.status >= 400) {
-            console.error("HEAD error:", xhr.status, xhr.statusText);
+            DucklingsLog.error("HEAD error:", xhr.status, xhr.statusText);
             return 0;
         }
 
-        var responseHeaders = xhr.getAllResponseHeaders();
-        var headerBytes = new TextEncoder().encode(responseHeaders);
-        var len = headerBytes.length;
-        var resultPtr = _malloc(len + 4);
-
-        Module.HEAPU8[resultPtr] = len & 0xFF;
-        Module.HEAPU8[resultPtr + 1] = (len >> 8) & 0xFF;
-        Module.HEAPU8[resultPtr + 2] = (len >> 16) & 0xFF;
-        Module.HEAPU8[resultPtr + 3] = (len >> 24) & 0xFF;
-        Module.HEAPU8.set(headerBytes, resultPtr + 4);
-
-        return resultPtr;
-    }, url, header_count, header_array);
+        return HTTPHeaderBlock.packLines(xhr.getAllResponseHeaders());
+    }, url, header_block);
 }
 
 // Sync general request using XMLHttpRequest - works in browsers
-static char* em_sync_request(const char* url, const char* method, int header_count, char** header_array, const char* body, int body_len) {
+static char* em_sync_request(const char* url, const char* method, const char* header_block, const char* body, int body_len) {
     return (char*)EM_ASM_PTR({
         var url = UTF8ToString($0);
         var method = UTF8ToString($1);
-        var headerCount = $2;
-        var headerArray = $3;
-        var bodyPtr = $4;
-        var bodyLen = $5;
+        var headerBlock = $2;
+        var bodyPtr = $3;
+        var bodyLen = $4;
 
         if (typeof XMLHttpRequest === "undefined") {
             return 0;
@@ -100,37 +113,35 @@ static char* em_sync_request(const char* url, const char* method, int header_cou
         xhr.responseType = "arraybuffer";
 
         // Set headers
-        for (var i = 0; i < headerCount * 2; i += 2) {
-            var ptr1 = HEAP32[(headerArray >> 2) + i];
-            var ptr2 = HEAP32[(headerArray >> 2) + i + 1];
+        var headers = HTTPHeaderBlock.decode(headerBlock);
+        for (var headerName in headers) {
             try {
-                var headerName = UTF8ToString(ptr1);
-                var headerValue = UTF8ToString(ptr2);
-                if (headerName === "Host") headerName = "X-Host-Override";
-                if (headerName === "User-Agent") headerName = "X-User-Agent";
-                xhr.setRequestHeader(headerName, headerValue);
+                var name = headerName;
+                if (name === "Host") name = "X-Host-Override";
+                if (name === "User-Agent") name = "X-User-Agent";
+                xhr.setRequestHeader(name, headers[headerName]);
             } catch (error) {
-                console.warn("Error setting header:", error);
+                DucklingsLog.warn("Error setting header:", error);
             }
         }
 
         try {
             if (bodyPtr && bodyLen > 0) {
-                var bodyData = new Uint8Array(bodyLen);
-                for (var i = 0; i < bodyLen; i++) {
-                    bodyData[i] = Module.HEAPU8[bodyPtr + i];
-                }
-                xhr.send(bodyData);
+                // Sync send consumes the view before returning, so no copy is needed,
+                // except that send rejects views on a SharedArrayBuffer (multithreaded build)
+                var body = Module.HEAPU8.subarray(bodyPtr, bodyPtr + bodyLen);
+                if (!(body.buffer instanceof ArrayBuffer)) body = body.slice();
+                xhr.send(body);
             } else {
                 xhr.send(null);
             }
         } catch (error) {
-            console.error("XHR error:", error);
+            DucklingsLog.error("XHR error:", error);
             return 0;
         }
 
         if (xhr.status === 0 || xhr.status >= 400) {
-            console.error("Request error:", xhr.status, xhr.statusText);
+            DucklingsLog.error("Request error:", xhr.status, xhr.statusText);
             return 0;
         }
 
@@ -145,7 +156,53 @@ static char* em_sync_request(const char* url, const char* method, int header_cou
         Module.HEAPU8.set(responseBody, resultPtr + 4);
 
         return resultPtr;
-    }, url, method, header_count, header_array, body, body_len);
+    }, url, method, header_block, body, body_len);
+}
+
+// Sync PUT of a multipart upload part using XMLHttpRequest - works in browsers
+// Returns the packed response headers, which carry the part's ETag (the bucket's CORS
+// configuration has to expose it)
+static char* em_sync_upload_part(const char* url, const char* header_block, const char* body, int body_len) {
+    return (char*)EM_ASM_PTR({
+        var url = UTF8ToString($0);
+        var headerBlock = $1;
+
+        if (typeof XMLHttpRequest === "undefined") {
+            return 0;
+        }
+
+        var xhr = new XMLHttpRequest();
+        xhr.open("PUT", url, false);
+
+        var headers = HTTPHeaderBlock.decode(headerBlock);
+        for (var headerName in headers) {
+            try {
+                var name = headerName;
+                if (name === "Host") name = "X-Host-Override";
+                if (name === "User-Agent") name = "X-User-Agent";
+                xhr.setRequestHeader(name, headers[headerName]);
+            } catch (error) {
+                DucklingsLog.warn("Error setting header:", error);
+            }
+        }
+
+        try {
+            var body = Module.HEAPU8.subarray($2, $2 + $3);
+            // send rejects views on a SharedArrayBuffer (multithreaded build)
+            if (!(body.buffer instanceof ArrayBuffer)) body = body.slice();
+            xhr.send(body);
+        } catch (error) {
+            DucklingsLog.error("XHR part upload error:", error);
+            return 0;
+        }
+
+        if (xhr.status === 0 || xhr.status >= 400) {
+            DucklingsLog.error("Part upload error:", xhr.status, xhr.statusText);
+            return 0;
+        }
+
+        return HTTPHeaderBlock.packLines(xhr.getAllResponseHeaders());
+    }, url, header_block, body, body_len);
 }
 
 // ============================================================================
@@ -154,28 +211,51 @@ static char* em_sync_request(const char* url, const char* method, int header_cou
 
 class HTTPWasmClient : public HTTPClient {
 public:
-    HTTPWasmClient(HTTPFSParams &http_params, const string &proto_host_port) {
+    HTTPWasmClient(HTTPWasmParams &http_params, const string &proto_host_port) {
         host_port = proto_host_port;
+        compressed_transport = http_params.compressed_transport;
         // Check once at construction if we have XHR available
         use_sync_xhr = (em_has_xhr() == 1);
-        if (use_sync_xhr) {
-            printf("HTTPWasmClient: Using synchronous XMLHttpRequest (browser mode)\n");
-        } else {
-            printf("HTTPWasmClient: Using async fetch with Asyncify (workers mode)\n");
-        }
+        use_fetch_helper = use_sync_xhr && em_has_fetch_helper() == 1;
+        timeout_ms = (int)MinValue<uint64_t>(http_params.timeout * 1000, NumericLimits<int>::Maximum());
+        EM_ASM({
+            DucklingsLog.debug($0 ? "HTTPWasmClient: Using synchronous XMLHttpRequest (browser mode)"
+                                  : "HTTPWasmClient: Using async fetch (workers mode)");
+        }, use_sync_xhr);
     }
 
     void Initialize(HTTPParams &params) override {}
 
     string host_port;
     bool use_sync_xhr;
+    // Browser mode: range batches go to the fetch helper worker instead of sync XHR
+    bool use_fetch_helper;
+    int timeout_ms;
+    bool compressed_transport;
+    // Reused across requests so packing headers does not allocate once it has grown
+    vector<char> header_arena;
 
     unique_ptr<HTTPResponse> Get(GetRequestInfo &info) override {
-        return DoRequest("GET", info.url, info.headers, nullptr, 0, info.content_handler);
+        idx_t range_start, range_end;
+        if (info.content_handler && ParseRangeHeader(info.headers, range_start, range_end)) {
+            auto res = DoCachedRangeRequest(info, range_start, range_end);
+            if (res) {
+                return res;
+            }
+        }
+        HTTPHeaders headers = info.headers;
+        SetAcceptEncoding(headers, !info.headers.HasHeader("Range"));
+        if (!use_sync_xhr && info.content_handler) {
+            // Workers mode: feed the body to the handler as it arrives instead of buffering it whole
+            return DoStreamingRequest(info.url, headers, info.content_handler);
+        }
+        return DoRequest("GET", info.url, headers, nullptr, 0, info.content_handler);
     }
 
     unique_ptr<HTTPResponse> Head(HeadRequestInfo &info) override {
-        return DoHeadRequest(info.url, info.headers);
+        HTTPHeaders headers = info.headers;
+        SetAcceptEncoding(headers, false);
+        return DoHeadRequest(info.url, headers);
     }
 
     unique_ptr<HTTPResponse> Post(PostRequestInfo &info) override {
@@ -187,6 +267,11 @@ public:
     }
 
     unique_ptr<HTTPResponse> Put(PutRequestInfo &info) override {
+        auto upload_id = GetQueryParam(info.url, "uploadId");
+        auto part_number = GetQueryParam(info.url, "partNumber");
+        if (!upload_id.empty() && !part_number.empty()) {
+            return DoPartUpload(info.url, info.headers, info.buffer_in, info.buffer_in_len);
+        }
         return DoRequest("PUT", info.url, info.headers, info.buffer_in, info.buffer_in_len, nullptr);
     }
 
@@ -206,33 +291,316 @@ private:
         return path;
     }
 
-    char** PrepareHeaders(const HTTPHeaders &headers, int &count) {
-        count = 0;
+    // Pack headers into the client's arena as a 4-byte little-endian length followed by
+    // name\0value\0 pairs. The JS side decodes the block before its first await, so the
+    // arena can be reused by the next request as soon as the call returns.
+    const char *PackHeaders(const HTTPHeaders &headers) {
+        header_arena.resize(4);
         for (auto &h : headers) {
-            count++;
+            header_arena.insert(header_arena.end(), h.first.begin(), h.first.end());
+            header_arena.push_back('\0');
+            header_arena.insert(header_arena.end(), h.second.begin(), h.second.end());
+            header_arena.push_back('\0');
         }
+        uint32_t len = (uint32_t)(header_arena.size() - 4);
+        header_arena[0] = (char)(len & 0xFF);
+        header_arena[1] = (char)((len >> 8) & 0xFF);
+        header_arena[2] = (char)((len >> 16) & 0xFF);
+        header_arena[3] = (char)((len >> 24) & 0xFF);
+        return header_arena.data();
+    }
 
-        char **z = (char **)(void *)malloc(count * sizeof(char*) * 2);
+    // Value of a query parameter of a URL, or empty if it has none
+    static string GetQueryParam(const string &url, const string &name) {
+        auto pos = url.find('?');
+        while (pos != string::npos) {
+            pos++;
+            auto end = url.find('&', pos);
+            auto param = url.substr(pos, end == string::npos ? string::npos : end - pos);
+            if (param.size() > name.size() && param[name.size()] == '=' && StringUtil::StartsWith(param, name)) {
+                return param.substr(name.size() + 1);
+            }
+            pos = end;
+        }
+        return string();
+    }
+
+    // Split a packed block (4-byte length, then \0-terminated fields) into its fields
+    static vector<string> UnpackFields(const char *block) {
+        vector<string> fields;
+        const char *pos = block + 4;
+        const char *end = pos + ReadLength(block);
+        while (pos < end) {
+            auto field_end = (const char *)memchr(pos, '\0', end - pos);
+            if (!field_end) {
+                break;
+            }
+            fields.emplace_back(pos, field_end - pos);
+            pos = field_end + 1;
+        }
+        return fields;
+    }
 
-        int i = 0;
+    // Parse a single "Range: bytes=<start>-<end>" header
+    static bool ParseRangeHeader(const HTTPHeaders &headers, idx_t &start, idx_t &end) {
         for (auto &h : headers) {
-            z[i] = (char *)malloc(h.first.size() + 1);
-            memset(z[i], 0, h.first.size() + 1);
-            memcpy(z[i], h.first.c_str(), h.first.size());
-            i++;
-            z[i] = (char *)malloc(h.second.size() + 1);
-            memset(z[i], 0, h.second.size() + 1);
-            memcpy(z[i], h.second.c_str(), h.second.size());
-            i++;
-        }
-        return z;
+            if (!StringUtil::CIEquals(h.first, "Range")) {
+                continue;
+            }
+            auto &value = h.second;
+            if (!StringUtil::StartsWith(value, "bytes=") || value.find(',') != string::npos) {
+                return false;
+            }
+            auto dash = value.find('-', 6);
+            if (dash == string::npos || dash == 6 || dash + 1 >= value.size()) {
+                return false;
+            }
+            try {
+                start = std::stoull(value.substr(6, dash - 6));
+                end = std::stoull(value.substr(dash + 1));
+            } catch (...) {
+                return false;
+            }
+            return start <= end;
+        }
+        return false;
+    }
+
+    // A block-aligned range request filling blocks [first_block, last_block]
+    struct BlockFetch {
+        idx_t first_block;
+        idx_t last_block;
+        idx_t start;
+        idx_t end;
+        vector<shared_ptr<const string>> blocks;
+    };
+
+    // Split a response body into the fetch's blocks
+    static void FillBlocks(BlockFetch &fetch, const char *data, idx_t len, idx_t block_size) {
+        // A server that ignores Range sends the whole file from offset 0
+        idx_t base = len > fetch.end - fetch.start + 1 ? fetch.start : 0;
+        fetch.blocks.clear();
+        for (idx_t k = fetch.first_block; k <= fetch.last_block; k++) {
+            idx_t offset = base + (k - fetch.first_block) * block_size;
+            if (offset >= len) {
+                break;
+            }
+            fetch.blocks.push_back(make_shared_ptr<const string>(data + offset, MinValue<idx_t>(block_size, len - offset)));
+        }
+    }
+
+    static BlockFetch MakeBlockFetch(idx_t first_block, idx_t last_block, idx_t block_size, idx_t file_size) {
+        BlockFetch fetch;
+        fetch.first_block = first_block;
+        fetch.last_block = last_block;
+        fetch.start = first_block * block_size;
+        fetch.end = (last_block + 1) * block_size - 1;
+        if (file_size != DConstants::INVALID_INDEX) {
+            fetch.end = MinValue<idx_t>(fetch.end, file_size - 1);
+        }
+        return fetch;
+    }
+
+    // Run all range fetches concurrently, in one Asyncify suspension (workers mode) or one
+    // Atomics.wait on the fetch helper (browser mode).
+    // Fails if any request fails; read-ahead failures are not worth a partial result.
+    bool DoBatchRangeRequest(const string &path, const HTTPHeaders &headers, vector<BlockFetch> &fetches,
+                             idx_t block_size) {
+        const char *header_block = PackHeaders(headers);
+
+        // Offsets travel as doubles so ranges beyond 4GB survive the JS boundary
+        vector<double> ranges;
+        for (auto &fetch : fetches) {
+            ranges.push_back(static_cast<double>(fetch.start));
+            ranges.push_back(static_cast<double>(fetch.end));
+        }
+
+        auto &stats = HTTPStats::Get();
+        double start = stats.Enabled() ? emscripten_get_now() : 0;
+
+        char *result;
+        if (use_sync_xhr) {
+            result = em_helper_batch_request(path.c_str(), (int)fetches.size(), ranges.data(), header_block,
+                                             timeout_ms);
+        } else {
+            auto validator = HTTPRangeCache::Get().Validator(path);
+            result = em_async_batch_request(path.c_str(), (int)fetches.size(), ranges.data(), header_block,
+                                            validator.c_str());
+        }
+        if (!result) {
+            return false;
+        }
+
+        // The requests ran concurrently, so each one is recorded with the latency of the batch
+        double latency = stats.Enabled() ? emscripten_get_now() - start : 0;
+
+        // Result: per request a 4-byte little-endian length (0xFFFFFFFF on failure) and the body
+        bool ok = true;
+        idx_t offset = 0;
+        for (auto &fetch : fetches) {
+            uint32_t len = ReadLength(result + offset);
+            offset += 4;
+            if (len == 0xFFFFFFFF) {
+                stats.RecordRequest(path, "GET", 0, 0, latency, false);
+                ok = false;
+                continue;
+            }
+            stats.RecordRequest(path, "GET", len, 0, latency, true);
+            FillBlocks(fetch, result + offset, len, block_size);
+            offset += len;
+        }
+        free(result);
+        return ok;
+    }
+
+    // Read the 4-byte little-endian length prefix of a buffer returned by the JS side
+    static uint32_t ReadLength(const char *ptr) {
+        uint32_t len = 0;
+        len |= ((uint8_t *)ptr)[0];
+        len |= ((uint8_t *)ptr)[1] << 8;
+        len |= ((uint8_t *)ptr)[2] << 16;
+        len |= ((uint8_t *)ptr)[3] << 24;
+        return len;
     }
 
-    void FreeHeaders(char **z, int count) {
-        for (int i = 0; i < count * 2; i++) {
-            free(z[i]);
+    // Choose the Accept-Encoding of a fetch() request in workers mode. Browsers negotiate it
+    // themselves (XHR may not set it) and already decode compressed whole-body responses.
+    // Whole-body GETs (e.g. read_json with force_download) accept gzip and brotli, which
+    // fetch() decodes natively before the bytes reach DuckDB. HEAD and range requests ask for
+    // identity, so Content-Length and byte offsets refer to the stored object.
+    void SetAcceptEncoding(HTTPHeaders &headers, bool whole_body) const {
+        if (use_sync_xhr || !compressed_transport || headers.HasHeader("Accept-Encoding")) {
+            return;
         }
-        free(z);
+        headers.Insert("Accept-Encoding", whole_body ? "gzip, br" : "identity");
+    }
+
+    // Serve a range GET from the block cache, fetching missing blocks in coalesced,
+    // block-aligned requests. Returns nullptr if the URL is not cacheable.
+    unique_ptr<HTTPResponse> DoCachedRangeRequest(GetRequestInfo &info, idx_t range_start, idx_t range_end) {
+        auto &cache = HTTPRangeCache::Get();
+        string path = NormalizeUrl(info.url);
+
+        idx_t file_size = DConstants::INVALID_INDEX;
+        if (!cache.IsCacheable(path, file_size) || range_end - range_start + 1 > cache.CacheSize()) {
+            return nullptr;
+        }
+        if (file_size != DConstants::INVALID_INDEX) {
+            if (range_start >= file_size) {
+                return nullptr;
+            }
+            range_end = MinValue<idx_t>(range_end, file_size - 1);
+        }
+
+        idx_t block_size = cache.BlockSize();
+        idx_t first_block = range_start / block_size;
+        idx_t last_block = range_end / block_size;
+
+        vector<shared_ptr<const string>> blocks(last_block - first_block + 1);
+        idx_t cache_hits = 0;
+        for (idx_t b = first_block; b <= last_block; b++) {
+            blocks[b - first_block] = cache.GetBlock(path, b);
+            cache_hits += blocks[b - first_block] ? 1 : 0;
+        }
+        HTTPStats::Get().RecordRangeCacheHits(path, cache_hits);
+
+        // Each run of missing blocks becomes a single block-aligned request
+        vector<BlockFetch> fetches;
+        idx_t b = first_block;
+        while (b <= last_block) {
+            if (blocks[b - first_block]) {
+                b++;
+                continue;
+            }
+            idx_t run_end = b;
+            while (run_end < last_block && !blocks[run_end + 1 - first_block]) {
+                run_end++;
+            }
+            fetches.push_back(MakeBlockFetch(b, run_end, block_size, file_size));
+            b = run_end + 1;
+        }
+
+        // When the caller scans forward (e.g. Parquet column chunks of a row group), read
+        // ahead a few blocks so the next reads are cache hits. Only worth it with fetch(),
+        // where the requests run concurrently instead of one blocking XHR after the other.
+        bool concurrent = !use_sync_xhr || use_fetch_helper;
+        bool sequential = cache.RecordRead(path, range_start, range_end);
+        if (concurrent && sequential) {
+            idx_t prefetch_blocks = cache.PrefetchBlocks();
+            for (idx_t k = last_block + 1; k <= last_block + prefetch_blocks; k++) {
+                if (file_size != DConstants::INVALID_INDEX && k * block_size >= file_size) {
+                    break;
+                }
+                if (!cache.HasBlock(path, k)) {
+                    fetches.push_back(MakeBlockFetch(k, k, block_size, file_size));
+                }
+            }
+        }
+
+        HTTPHeaders headers;
+        for (auto &h : info.headers) {
+            if (!StringUtil::CIEquals(h.first, "Range")) {
+                headers.Insert(h.first, h.second);
+            }
+        }
+        SetAcceptEncoding(headers, false);
+
+        // Workers mode sends even a single fetch as a batch, which goes through the edge cache
+        bool batched = false;
+        if (concurrent && !fetches.empty()) {
+            batched = DoBatchRangeRequest(path, headers, fetches, block_size);
+            if (!batched && !use_sync_xhr) {
+                auto res = make_uniq<HTTPResponse>(HTTPStatusCode::NotFound_404);
+                res->reason = "Request failed - check console for errors";
+                return res;
+            }
+            // Browser mode retries a failed helper batch (e.g. a server ignoring Range, whose
+            // whole-file response does not fit the helper's buffer) with XHR below
+        }
+        if (!batched) {
+            for (auto &fetch : fetches) {
+                fetch.blocks.clear();
+                HTTPHeaders range_headers = headers;
+                range_headers.Insert("Range", "bytes=" + to_string(fetch.start) + "-" + to_string(fetch.end));
+                auto res = DoRequest("GET", info.url, range_headers, nullptr, 0,
+                                     [&](const_data_ptr_t data, idx_t len) {
+                                         FillBlocks(fetch, (const char *)data, len, block_size);
+                                     });
+                if (!res || res->status != HTTPStatusCode::OK_200) {
+                    return res;
+                }
+            }
+        }
+
+        for (auto &fetch : fetches) {
+            for (idx_t i = 0; i < fetch.blocks.size(); i++) {
+                idx_t k = fetch.first_block + i;
+                cache.PutBlock(path, k, fetch.blocks[i]);
+                if (k >= first_block && k <= last_block) {
+                    blocks[k - first_block] = fetch.blocks[i];
+                }
+            }
+        }
+
+        // Hand the requested slice of each block to the content handler
+        for (idx_t k = first_block; k <= last_block; k++) {
+            auto &data = blocks[k - first_block];
+            if (!data) {
+                break;
+            }
+            idx_t block_start = k * block_size;
+            idx_t from = MaxValue<idx_t>(range_start, block_start) - block_start;
+            idx_t to = MinValue<idx_t>(range_end + 1, block_start + data->size()) - block_start;
+            if (from < to) {
+                info.content_handler(const_data_ptr_cast(data->data() + from), to - from);
+            }
+            if (data->size() < block_size) {
+                // Short block: end of file
+                break;
+            }
+        }
+
+        return make_uniq<HTTPResponse>(HTTPStatusCode::OK_200);
     }
 
     unique_ptr<HTTPResponse> DoRequest(const char *method, const string &url,
@@ -242,27 +610,33 @@ private:
         unique_ptr<HTTPResponse> res;
         string path = NormalizeUrl(url);
 
-        int header_count = 0;
-        char **header_array = PrepareHeaders(headers, header_count);
-
-        char *payload = nullptr;
-        if (body_data && body_len > 0) {
-            payload = (char *)malloc(body_len);
-            memcpy(payload, body_data, body_len);
+        if (strcmp(method, "GET") != 0) {
+            // Writes make the cached size and validators of the object stale
+            HTTPMetadataCache::Get().Invalidate(path);
         }
 
+        const char *header_block = PackHeaders(headers);
+
+        // The request body is read by JS straight from the WASM heap, no staging copy
+        const char *payload = (body_data && body_len > 0) ? (const char *)body_data : nullptr;
+
         char *result = nullptr;
 
+        auto &stats = HTTPStats::Get();
+        double start = stats.Enabled() ? emscripten_get_now() : 0;
+
         if (use_sync_xhr) {
             // Browser mode: use synchronous XMLHttpRequest
-            result = em_sync_request(path.c_str(), method, header_count, header_array, payload, (int)body_len);
+            result = em_sync_request(path.c_str(), method, header_block, payload, (int)body_len);
         } else {
             // Workers mode: use async fetch via external JS library
-            result = em_async_request(path.c_str(), method, header_count, header_array, payload, (int)body_len);
+            result = em_async_request(path.c_str(), method, header_block, payload, (int)body_len);
         }
 
-        FreeHeaders(header_array, header_count);
-        if (payload) free(payload);
+        if (stats.Enabled()) {
+            stats.RecordRequest(path, method, result ? ReadLength(result) : 0, payload ? body_len : 0,
+                                emscripten_get_now() - start, result != nullptr);
+        }
 
         if (!result) {
             res = make_uniq<HTTPResponse>(HTTPStatusCode::NotFound_404);
@@ -270,17 +644,14 @@ private:
         } else {
             res = make_uniq<HTTPResponse>(HTTPStatusCode::OK_200);
 
-            // Read length from first 4 bytes
-            uint32_t len = 0;
-            len |= ((uint8_t *)result)[0];
-            len |= ((uint8_t *)result)[1] << 8;
-            len |= ((uint8_t *)result)[2] << 16;
-            len |= ((uint8_t *)result)[3] << 24;
-
-            res->body = string(result + 4, len);
+            uint32_t len = ReadLength(result);
 
+            // A content handler consumes the bytes in place (e.g. copying them into the
+            // caller's read buffer); only fill res->body when nobody else takes the data
             if (content_handler) {
                 content_handler((const_data_ptr_t)(result + 4), len);
+            } else {
+                res->body = string(result + 4, len);
             }
 
             free(result);
@@ -289,24 +660,146 @@ private:
         return res;
     }
 
+    // Upload one part of an S3 multipart upload (PUT ?partNumber=N&uploadId=...).
+    // httpfs reads the part's ETag from the response and signs it into the
+    // CompleteMultipartUpload body, so the part has to be stored before this returns.
+    unique_ptr<HTTPResponse> DoPartUpload(const string &url, const HTTPHeaders &headers, const_data_ptr_t body_data,
+                                          idx_t body_len) {
+        string path = NormalizeUrl(url);
+        HTTPMetadataCache::Get().Invalidate(path);
+
+        const char *header_block = PackHeaders(headers);
+        const char *payload = const_char_ptr_cast(body_data);
+
+        auto &stats = HTTPStats::Get();
+        double start = stats.Enabled() ? emscripten_get_now() : 0;
+
+        char *result = nullptr;
+        if (use_sync_xhr) {
+            // Browser mode: synchronous XMLHttpRequest
+            result = em_sync_upload_part(path.c_str(), header_block, payload, (int)body_len);
+        } else {
+            // Workers mode: async fetch, the module is suspended until the part is stored
+            result = em_async_upload_part(path.c_str(), header_block, payload, (int)body_len);
+        }
+
+        if (stats.Enabled()) {
+            stats.RecordRequest(path.substr(0, path.find('?')), "PUT", 0, body_len, emscripten_get_now() - start,
+                                result != nullptr);
+        }
+
+        if (!result) {
+            auto res = make_uniq<HTTPResponse>(HTTPStatusCode::NotFound_404);
+            res->reason = "Request failed - check console for errors";
+            return res;
+        }
+
+        auto res = make_uniq<HTTPResponse>(HTTPStatusCode::OK_200);
+        auto fields = UnpackFields(result);
+        free(result);
+        for (idx_t i = 0; i + 1 < fields.size(); i += 2) {
+            res->headers.Insert(std::move(fields[i]), std::move(fields[i + 1]));
+        }
+        return res;
+    }
+
+    // Bytes requested per em_async_stream_read call; bounds the memory held for one response
+    static constexpr int STREAM_CHUNK_SIZE = 1024 * 1024;
+
+    unique_ptr<HTTPResponse> DoStreamingRequest(const string &url, const HTTPHeaders &headers,
+                                                std::function<void(const_data_ptr_t, idx_t)> content_handler) {
+        string path = NormalizeUrl(url);
+
+        auto &stats = HTTPStats::Get();
+        double start = stats.Enabled() ? emscripten_get_now() : 0;
+        idx_t received = 0;
+
+        int stream_id = em_async_stream_open(path.c_str(), PackHeaders(headers));
+
+        if (stream_id <= 0) {
+            stats.RecordRequest(path, "GET", 0, 0, stats.Enabled() ? emscripten_get_now() - start : 0, false);
+            auto res = make_uniq<HTTPResponse>(HTTPStatusCode::NotFound_404);
+            res->reason = "Request failed - check console for errors";
+            return res;
+        }
+
+        try {
+            while (true) {
+                // Freed on every exit, including a content handler that throws
+                std::unique_ptr<char, decltype(&free)> chunk(em_async_stream_read(stream_id, STREAM_CHUNK_SIZE),
+                                                             &free);
+                if (!chunk) {
+                    em_async_stream_close(stream_id);
+                    stats.RecordRequest(path, "GET", received, 0,
+                                        stats.Enabled() ? emscripten_get_now() - start : 0, false);
+                    auto res = make_uniq<HTTPResponse>(HTTPStatusCode::NotFound_404);
+                    res->reason = "Reading response body failed - check console for errors";
+                    return res;
+                }
+                uint32_t len = ReadLength(chunk.get());
+                if (len == 0) {
+                    break;
+                }
+                received += len;
+                content_handler((const_data_ptr_t)(chunk.get() + 4), len);
+            }
+        } catch (...) {
+            em_async_stream_close(stream_id);
+            throw;
+        }
+
+        em_async_stream_close(stream_id);
+        // Latency of a streamed response runs until its last byte
+        stats.RecordRequest(path, "GET", received, 0, stats.Enabled() ? emscripten_get_now() - start : 0, true);
+        return make_uniq<HTTPResponse>(HTTPStatusCode::OK_200);
+    }
+
+    // Build a HEAD response from cached metadata
+    static unique_ptr<HTTPResponse> MakeHeadResponse(const HTTPFileMetadata &metadata) {
+        auto res = make_uniq<HTTPResponse>(HTTPStatusCode::OK_200);
+        if (metadata.content_length != DConstants::INVALID_INDEX) {
+            res->headers.Insert("Content-Length", to_string(metadata.content_length));
+        }
+        if (!metadata.etag.empty()) {
+            res->headers.Insert("ETag", metadata.etag);
+        }
+        if (!metadata.last_modified.empty()) {
+            res->headers.Insert("Last-Modified", metadata.last_modified);
+        }
+        if (!metadata.accept_ranges.empty()) {
+            res->headers.Insert("Accept-Ranges", metadata.accept_ranges);
+        }
+        return res;
+    }
+
     unique_ptr<HTTPResponse> DoHeadRequest(const string &url, const HTTPHeaders &headers) {
         unique_ptr<HTTPResponse> res;
         string path = NormalizeUrl(url);
 
-        int header_count = 0;
-        char **header_array = PrepareHeaders(headers, header_count);
+        HTTPFileMetadata metadata;
+        auto &stats = HTTPStats::Get();
+        if (HTTPMetadataCache::Get().Lookup(path, metadata)) {
+            stats.RecordMetadataCacheHit(path);
+            return MakeHeadResponse(metadata);
+        }
+
+        const char *header_block = PackHeaders(headers);
 
         char *result = nullptr;
 
+        double start = stats.Enabled() ? emscripten_get_now() : 0;
+
         if (use_sync_xhr) {
             // Browser mode: use synchronous XMLHttpRequest
-            result = em_sync_head_request(path.c_str(), header_count, header_array);
+            result = em_sync_head_request(path.c_str(), header_block);
         } else {
             // Workers mode: use async fetch via external JS library
-            result = em_async_head_request(path.c_str(), header_count, header_array);
+            result = em_async_head_request(path.c_str(), header_block);
         }
 
-        FreeHeaders(header_array, header_count);
+        if (stats.Enabled()) {
+            stats.RecordRequest(path, "HEAD", 0, 0, emscripten_get_now() - start, result != nullptr);
+        }
 
         if (!result) {
             res = make_uniq<HTTPResponse>(HTTPStatusCode::NotFound_404);
@@ -314,30 +807,45 @@ private:
         } else {
             res = make_uniq<HTTPResponse>(HTTPStatusCode::OK_200);
 
-            // Read length
-            uint32_t len = 0;
-            len |= ((uint8_t *)result)[0];
-            len |= ((uint8_t *)result)[1] << 8;
-            len |= ((uint8_t *)result)[2] << 16;
-            len |= ((uint8_t *)result)[3] << 24;
-
-            // Parse response headers
-            string headers_str(result + 4, len);
-            vector<string> header_lines = StringUtil::Split(headers_str, "\r\n");
-
-            for (auto &line : header_lines) {
-                size_t colon_pos = line.find(':');
-                if (colon_pos != string::npos) {
-                    string name = line.substr(0, colon_pos);
-                    string value = line.substr(colon_pos + 1);
-                    // Trim leading space from value
-                    while (!value.empty() && value[0] == ' ') {
-                        value = value.substr(1);
+            uint32_t len = ReadLength(result);
+
+            // Walk the packed response header block (name\0value\0 pairs) in place
+            const char *pos = result + 4;
+            const char *end = pos + len;
+
+            while (pos < end) {
+                auto name_end = (const char *)memchr(pos, '\0', end - pos);
+                if (!name_end || name_end + 1 >= end) {
+                    break;
+                }
+                auto value_end = (const char *)memchr(name_end + 1, '\0', end - name_end - 1);
+                if (!value_end) {
+                    break;
+                }
+                string name(pos, name_end - pos);
+                string value(name_end + 1, value_end - name_end - 1);
+                pos = value_end + 1;
+
+                if (StringUtil::CIEquals(name, "ETag")) {
+                    metadata.etag = value;
+                } else if (StringUtil::CIEquals(name, "Last-Modified")) {
+                    metadata.last_modified = value;
+                } else if (StringUtil::CIEquals(name, "Accept-Ranges")) {
+                    metadata.accept_ranges = value;
+                } else if (StringUtil::CIEquals(name, "Content-Length")) {
+                    try {
+                        metadata.content_length = std::stoull(value);
+                    } catch (...) {
                     }
-                    res->headers.Insert(name, value);
                 }
+                res->headers.Insert(std::move(name), std::move(value));
             }
 
+            // The validator decides whether cached range blocks of this URL are still fresh
+            HTTPRangeCache::Get().UpdateFileInfo(path, !metadata.etag.empty() ? metadata.etag : metadata.last_modified,
+                                                 metadata.content_length);
+            HTTPMetadataCache::Get().Put(path, metadata);
+
             free(result);
         }
 
@@ -345,8 +853,42 @@ private:
     }
 };
 
+unique_ptr<HTTPParams> HTTPWasmUtil::InitializeParameters(optional_ptr<FileOpener> opener,
+                                                        optional_ptr<FileOpenerInfo> info) {
+    auto result = make_uniq<HTTPWasmParams>(*this);
+    result->Initialize(opener);
+
+    // Pick up the range cache settings registered in duckdb_wasm_httpfs_init
+    idx_t block_size = HTTPRangeCache::DEFAULT_BLOCK_SIZE;
+    idx_t cache_size = HTTPRangeCache::DEFAULT_CACHE_SIZE;
+    idx_t prefetch_blocks = HTTPRangeCache::DEFAULT_PREFETCH_BLOCKS;
+    Value value;
+    if (FileOpener::TryGetCurrentSetting(opener, "http_wasm_cache_block_size", value, info) && !value.IsNull()) {
+        block_size = value.GetValue<uint64_t>();
+    }
+    if (FileOpener::TryGetCurrentSetting(opener, "http_wasm_cache_size", value, info) && !value.IsNull()) {
+        cache_size = value.GetValue<uint64_t>();
+    }
+    if (FileOpener::TryGetCurrentSetting(opener, "http_wasm_prefetch_blocks", value, info) && !value.IsNull()) {
+        prefetch_blocks = value.GetValue<uint64_t>();
+    }
+    HTTPRangeCache::Get().Configure(block_size, cache_size, prefetch_blocks);
+
+    idx_t metadata_ttl = HTTPMetadataCache::DEFAULT_TTL_SECONDS;
+    if (FileOpener::TryGetCurrentSetting(opener, "http_wasm_metadata_cache_ttl", value, info) && !value.IsNull()) {
+        metadata_ttl = value.GetValue<uint64_t>();
+    }
+    HTTPMetadataCache::Get().Configure(metadata_ttl);
+
+    if (FileOpener::TryGetCurrentSetting(opener, "http_wasm_compressed_transport", value, info) && !value.IsNull()) {
+        result->compressed_transport = value.GetValue<bool>();
+    }
+
+    return std::move(result);
+}
+
 unique_ptr<HTTPClient> HTTPWasmUtil::InitializeClient(HTTPParams &http_params, const string &proto_host_port) {
-    auto client = make_uniq<HTTPWasmClient>(http_params.Cast<HTTPFSParams>(), proto_host_port);
+    auto client = make_uniq<HTTPWasmClient>(http_params.Cast<HTTPWasmParams>(), proto_host_port);
     return std::move(client);
 }
 
@@ -4,15 +4,20 @@
 
 namespace duckdb {
 
+// httpfs parameters plus the settings of the WASM HTTP client
+struct HTTPWasmParams : public HTTPFSParams {
+    explicit HTTPWasmParams(HTTPUtil &http_util) : HTTPFSParams(http_util) {
+    }
+
+    // Accept compressed bodies for whole-file GETs (workers mode)
+    bool compressed_transport = true;
+};
+
 // WASM HTTP utility that uses XMLHttpRequest via Emscripten
 class HTTPWasmUtil : public HTTPUtil {
 public:
     unique_ptr<HTTPParams> InitializeParameters(optional_ptr<FileOpener> opener,
-                                                optional_ptr<FileOpenerInfo> info) override {
-        auto result = make_uniq<HTTPFSParams>(*this);
-        result->Initialize(opener);
-        return result;
-    }
+                                                optional_ptr<FileOpenerInfo> info) override;
 
     unique_ptr<HTTPClient> InitializeClient(HTTPParams &http_params, const string &proto_host_port) override;
 
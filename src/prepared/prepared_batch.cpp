@@ -0,0 +1,165 @@
+#include "prepared_batch.hpp"
+#include "duckdb/main/connection.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Copy a message into a malloc'd buffer the JS side can read and _free()
+static char *copy_error(const std::string &message) {
+    char *copy = static_cast<char*>(std::malloc(message.size() + 1));
+    if (copy) {
+        std::memcpy(copy, message.c_str(), message.size() + 1);
+    }
+    return copy;
+}
+
+template <class T>
+static T value_at(const duckdb_wasm_batch_column &column, idx_t row) {
+    T value;
+    std::memcpy(&value, static_cast<const uint8_t*>(column.data) + row * sizeof(T), sizeof(T));
+    return value;
+}
+
+// Bind one row of a column to parameter index (1-based)
+static duckdb_state bind_value(
+    duckdb_prepared_statement statement,
+    idx_t index,
+    const duckdb_wasm_batch_column &column,
+    idx_t row
+) {
+    if (column.nulls && column.nulls[row]) {
+        return duckdb_bind_null(statement, index);
+    }
+    switch (column.type) {
+    case DUCKDB_TYPE_BOOLEAN:
+        return duckdb_bind_boolean(statement, index, value_at<uint8_t>(column, row) != 0);
+    case DUCKDB_TYPE_TINYINT:
+        return duckdb_bind_int8(statement, index, value_at<int8_t>(column, row));
+    case DUCKDB_TYPE_SMALLINT:
+        return duckdb_bind_int16(statement, index, value_at<int16_t>(column, row));
+    case DUCKDB_TYPE_INTEGER:
+        return duckdb_bind_int32(statement, index, value_at<int32_t>(column, row));
+    case DUCKDB_TYPE_BIGINT:
+        return duckdb_bind_int64(statement, index, value_at<int64_t>(column, row));
+    case DUCKDB_TYPE_UTINYINT:
+        return duckdb_bind_uint8(statement, index, value_at<uint8_t>(column, row));
+    case DUCKDB_TYPE_USMALLINT:
+        return duckdb_bind_uint16(statement, index, value_at<uint16_t>(column, row));
+    case DUCKDB_TYPE_UINTEGER:
+        return duckdb_bind_uint32(statement, index, value_at<uint32_t>(column, row));
+    case DUCKDB_TYPE_UBIGINT:
+        return duckdb_bind_uint64(statement, index, value_at<uint64_t>(column, row));
+    case DUCKDB_TYPE_FLOAT:
+        return duckdb_bind_float(statement, index, value_at<float>(column, row));
+    case DUCKDB_TYPE_DOUBLE:
+        return duckdb_bind_double(statement, index, value_at<double>(column, row));
+    case DUCKDB_TYPE_VARCHAR:
+    case DUCKDB_TYPE_BLOB: {
+        if (!column.offsets) {
+            return DuckDBError;
+        }
+        const char *bytes = static_cast<const char*>(column.data) + column.offsets[row];
+        idx_t length = column.offsets[row + 1] - column.offsets[row];
+        return column.type == DUCKDB_TYPE_VARCHAR
+            ? duckdb_bind_varchar_length(statement, index, bytes, length)
+            : duckdb_bind_blob(statement, index, bytes, length);
+    }
+    default:
+        return DuckDBError;
+    }
+}
+
+// Run a transaction statement, returning false and setting out_error on failure
+static bool run_transaction_statement(duckdb_connection connection, const char *sql, char **out_error) {
+    duckdb_result result;
+    bool ok = duckdb_query(connection, sql, &result) == DuckDBSuccess;
+    if (!ok && out_error && !*out_error) {
+        const char *error = duckdb_result_error(&result);
+        *out_error = copy_error(error ? error : "Transaction statement failed");
+    }
+    duckdb_destroy_result(&result);
+    return ok;
+}
+
+extern "C" {
+
+duckdb_state duckdb_wasm_execute_batch(
+    duckdb_connection connection,
+    duckdb_prepared_statement statement,
+    const duckdb_wasm_batch_column *columns,
+    idx_t column_count,
+    idx_t row_count,
+    idx_t *out_rows_changed,
+    char **out_error
+) {
+    if (out_error) {
+        *out_error = nullptr;
+    }
+    if (!connection || !statement || (column_count > 0 && !columns) || !out_rows_changed) {
+        return DuckDBError;
+    }
+    *out_rows_changed = 0;
+
+    if (duckdb_nparams(statement) != column_count) {
+        if (out_error) {
+            *out_error = copy_error("Batch has " + std::to_string(column_count) + " columns, statement expects " +
+                                    std::to_string(duckdb_nparams(statement)) + " parameters");
+        }
+        return DuckDBError;
+    }
+
+    // One transaction for the whole batch instead of one commit per row
+    bool own_transaction = reinterpret_cast<duckdb::Connection*>(connection)->IsAutoCommit();
+    if (own_transaction && !run_transaction_statement(connection, "BEGIN TRANSACTION", out_error)) {
+        return DuckDBError;
+    }
+
+    idx_t rows_changed = 0;
+    for (idx_t row = 0; row < row_count; row++) {
+        std::string error;
+        for (idx_t col = 0; col < column_count && error.empty(); col++) {
+            if (bind_value(statement, col + 1, columns[col], row) != DuckDBSuccess) {
+                error = "Failed to bind parameter " + std::to_string(col + 1);
+            }
+        }
+
+        if (error.empty()) {
+            duckdb_result result;
+            if (duckdb_execute_prepared(statement, &result) == DuckDBSuccess) {
+                rows_changed += duckdb_rows_changed(&result);
+            } else {
+                const char *message = duckdb_result_error(&result);
+                error = message ? message : "Execute prepared failed";
+            }
+            duckdb_destroy_result(&result);
+        }
+
+        if (!error.empty()) {
+            if (out_error) {
+                *out_error = copy_error("Row " + std::to_string(row) + ": " + error);
+            }
+            if (own_transaction) {
+                run_transaction_statement(connection, "ROLLBACK", out_error);
+            }
+            return DuckDBError;
+        }
+    }
+
+    if (own_transaction && !run_transaction_statement(connection, "COMMIT", out_error)) {
+        return DuckDBError;
+    }
+
+    duckdb_clear_bindings(statement);
+    *out_rows_changed = rows_changed;
+    return DuckDBSuccess;
+}
+
+duckdb_state duckdb_wasm_prepare_sync(
+    duckdb_connection connection,
+    const char *query,
+    duckdb_prepared_statement *out_statement
+) {
+    return duckdb_prepare(connection, query, out_statement);
+}
+
+} // extern "C"
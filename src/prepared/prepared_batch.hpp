@@ -0,0 +1,72 @@
+#pragma once
+
+#include "duckdb.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * One parameter column of a batch, laid out in the WASM heap.
+ *
+ * Fixed-width columns store row_count values of the column type in data
+ * (BOOLEAN as one byte per row). VARCHAR and BLOB columns store their bytes
+ * back to back in data with row_count + 1 offsets delimiting each row.
+ */
+typedef struct {
+    /** DUCKDB_TYPE_* of the values in data */
+    int32_t type;
+    /** Column values */
+    const void *data;
+    /** Byte offsets for VARCHAR and BLOB columns, NULL otherwise */
+    const uint32_t *offsets;
+    /** One byte per row, non-zero for NULL; NULL when the column has no NULLs */
+    const uint8_t *nulls;
+} duckdb_wasm_batch_column;
+
+/**
+ * Execute a prepared statement once per row of columnar parameters.
+ *
+ * Binding and execution loop inside WASM, so a batch costs one call from JS
+ * regardless of its row count. Outside an explicit transaction the batch runs
+ * in its own transaction, committed after the last row and rolled back if any
+ * row fails; inside one, the caller's transaction is left to the caller.
+ *
+ * @param connection        Connection the statement was prepared on
+ * @param statement         Prepared statement with column_count parameters
+ * @param columns           Parameter columns, in parameter order
+ * @param column_count      Number of columns
+ * @param row_count         Number of rows in every column
+ * @param out_rows_changed  Receives the rows changed summed over all executions
+ * @param out_error         Receives a malloc'd error message on failure (caller frees), or NULL
+ * @return DuckDBSuccess on success, DuckDBError on failure
+ */
+duckdb_state duckdb_wasm_execute_batch(
+    duckdb_connection connection,
+    duckdb_prepared_statement statement,
+    const duckdb_wasm_batch_column *columns,
+    idx_t column_count,
+    idx_t row_count,
+    idx_t *out_rows_changed,
+    char **out_error
+);
+
+/**
+ * duckdb_prepare for synchronous callers.
+ *
+ * JSPI builds export duckdb_prepare as a promise-returning function so a prepare
+ * that binds over remote files can suspend in the fetch imports. This entry point
+ * stays out of JSPI_EXPORTS and returns its status directly; a prepare that needs
+ * to suspend fails here, as it does for synchronous calls under Asyncify.
+ */
+duckdb_state duckdb_wasm_prepare_sync(
+    duckdb_connection connection,
+    const char *query,
+    duckdb_prepared_statement *out_statement
+);
+
+#ifdef __cplusplus
+}
+#endif
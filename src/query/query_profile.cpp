@@ -0,0 +1,58 @@
+#include "query_profile.hpp"
+#include "http_stats.hpp"
+
+#include "duckdb/main/client_config.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/query_profiler.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+using duckdb::ClientConfig;
+using duckdb::Connection;
+using duckdb::HTTPStats;
+using duckdb::QueryProfiler;
+
+static constexpr int PROFILER_ENABLED = 1;
+static constexpr int PROFILER_EMITS_OUTPUT = 2;
+
+int duckdb_wasm_profile_begin(duckdb_connection connection) {
+    if (!connection) {
+        return 0;
+    }
+    auto &config = ClientConfig::GetConfig(*reinterpret_cast<Connection *>(connection)->context);
+    int previous = (config.enable_profiler ? PROFILER_ENABLED : 0) |
+                   (config.emit_profiler_output ? PROFILER_EMITS_OUTPUT : 0);
+    config.enable_profiler = true;
+    config.emit_profiler_output = false;
+    HTTPStats::Get().Begin();
+    return previous;
+}
+
+char *duckdb_wasm_profile_end(duckdb_connection connection, int previous) {
+    if (!connection) {
+        return nullptr;
+    }
+    auto &context = *reinterpret_cast<Connection *>(connection)->context;
+    auto &config = ClientConfig::GetConfig(context);
+
+    std::string json = "{\"execution\":";
+    try {
+        auto execution = QueryProfiler::Get(context).ToJSON();
+        json += execution.empty() ? "null" : execution;
+    } catch (...) {
+        json += "null";
+    }
+    json += ",\"http\":" + HTTPStats::Get().End() + "}";
+
+    config.enable_profiler = (previous & PROFILER_ENABLED) != 0;
+    config.emit_profiler_output = (previous & PROFILER_EMITS_OUTPUT) != 0;
+
+    auto result = static_cast<char *>(malloc(json.size() + 1));
+    if (!result) {
+        return nullptr;
+    }
+    memcpy(result, json.c_str(), json.size() + 1);
+    return result;
+}
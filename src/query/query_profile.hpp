@@ -0,0 +1,36 @@
+#pragma once
+
+#include "duckdb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Start profiling the queries of a connection.
+ *
+ * Enables DuckDB's query profiler for the connection without printing its output
+ * and starts collecting HTTP counters (see HTTPStats).
+ *
+ * @param connection Connection to profile
+ * @return The connection's previous profiler settings, for duckdb_wasm_profile_end
+ */
+int duckdb_wasm_profile_begin(duckdb_connection connection);
+
+/**
+ * Stop profiling and return the profile of the connection's last query.
+ *
+ * The JSON object has an "execution" member with DuckDB's profiler tree of the last
+ * query (null if none was profiled) and an "http" member with the HTTP counters
+ * per URL. HTTP counters are process-wide: requests of other queries running at the
+ * same time are included.
+ *
+ * @param connection Connection passed to duckdb_wasm_profile_begin
+ * @param previous   Value returned by duckdb_wasm_profile_begin
+ * @return malloc'd JSON string (caller frees with free/_free), or NULL on failure
+ */
+char *duckdb_wasm_profile_end(duckdb_connection connection, int previous);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,14 @@
+#include "query_progress.hpp"
+
+void duckdb_wasm_query_progress(
+    duckdb_connection connection,
+    double *out_percentage,
+    double *out_rows_processed,
+    double *out_total_rows
+) {
+    duckdb_query_progress_type progress = duckdb_query_progress(connection);
+    // Row counts are reported as doubles so they reach JS without 64-bit values
+    *out_percentage = progress.percentage;
+    *out_rows_processed = static_cast<double>(progress.rows_processed);
+    *out_total_rows = static_cast<double>(progress.total_rows_to_process);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "duckdb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Read the progress of the query running on a connection.
+ *
+ * duckdb_query_progress returns its struct by value, which JS cannot receive
+ * through ccall, so the fields are written to out-params instead.
+ *
+ * @param connection        Connection with a pending query
+ * @param out_percentage    Receives the estimated completion (0-100), or -1 if unknown
+ * @param out_rows_processed Receives the rows processed so far
+ * @param out_total_rows    Receives the estimated total rows to process
+ */
+void duckdb_wasm_query_progress(
+    duckdb_connection connection,
+    double *out_percentage,
+    double *out_rows_processed,
+    double *out_total_rows
+);
+
+#ifdef __cplusplus
+}
+#endif